@@ -458,6 +458,21 @@ struct MemoizationTraits<Eigen::Array<Scalar, Rows, Cols, Options, MaxRows, MaxC
     {
         return (a == b).all();
     }
+
+    /// Return true if two arrays are equal within a relative tolerance (comparing also the derivatives of `real` entries).
+    static auto approx(const CacheType& a, const Type& b, double reltol) -> bool
+    {
+        if(a.size() != b.size())
+            return false;
+        if constexpr(std::is_same_v<Scalar, real>)
+        {
+            for(Index i = 0; i < a.size(); ++i)
+                if(!MemoizationTraits<Scalar>::approx(a(i), b(i), reltol))
+                    return false;
+            return true;
+        }
+        else return ((a - b).abs() <= reltol * a.abs().max(b.abs())).all();
+    }
 };
 
 /// Specialize MemoizationTraits for Eigen ref types.
@@ -479,6 +494,12 @@ struct MemoizationTraits<Eigen::Ref<EigenType>>
     {
         return MemoizationTraits<CacheType>::assign(a, b);
     }
+
+    /// Return true if the two Eigen objects are equal within a relative tolerance.
+    static auto approx(const CacheType& a, const Type& b, double reltol) -> bool
+    {
+        return MemoizationTraits<CacheType>::approx(a, b, reltol);
+    }
 };
 
 } // namespace Reaktoro
@@ -19,10 +19,10 @@
 
 namespace Reaktoro {
 
-auto getMemoizationStatus() -> bool&
+auto getMemoizationStatus() -> std::atomic<bool>&
 {
     /// The global variable that holds status if memoization is currently enabled or disabled.
-    static bool memoization_active = true;
+    static std::atomic<bool> memoization_active = true;
     return memoization_active;
 }
 
@@ -46,4 +46,35 @@ auto Memoization::disable() -> void
     getMemoizationStatus() = false;
 }
 
+MemoizationStats::MemoizationStats()
+: counters(std::make_shared<Counters>())
+{}
+
+auto MemoizationStats::hits() const -> Index
+{
+    return counters->hits.load(std::memory_order_relaxed);
+}
+
+auto MemoizationStats::misses() const -> Index
+{
+    return counters->misses.load(std::memory_order_relaxed);
+}
+
+auto MemoizationStats::calls() const -> Index
+{
+    return hits() + misses();
+}
+
+auto MemoizationStats::hitRate() const -> double
+{
+    const auto total = calls();
+    return total == 0 ? 0.0 : static_cast<double>(hits()) / total;
+}
+
+auto MemoizationStats::reset() const -> void
+{
+    counters->hits.store(0, std::memory_order_relaxed);
+    counters->misses.store(0, std::memory_order_relaxed);
+}
+
 } // namespace Reaktoro
@@ -17,6 +17,13 @@
 
 #pragma once
 
+// C++ includes
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <list>
+#include <mutex>
+
 // Reaktoro includes
 #include <Reaktoro/Common/Meta.hpp>
 #include <Reaktoro/Common/TraitsUtils.hpp>
@@ -74,10 +81,40 @@ struct MemoizationTraits
     {
         a = b;
     }
+
+    /// Check if `a`, of type `CacheType`, is equal to `b`, of type `T`, within a relative tolerance.
+    /// This function is used when a positive relative tolerance is set in
+    /// MemoizationOptions::reltol. The default implementation compares
+    /// numbers within the tolerance and falls back to @ref equal for other
+    /// types. For `real` numbers, both the values and the derivatives are
+    /// compared, so that a result cached for an argument seeded differently
+    /// in an automatic differentiation is not returned. Redefine this function
+    /// in a template specialization for type `T` if tolerance-aware comparison
+    /// is also needed for this type.
+    static auto approx(const CacheType& a, const Type& b, double reltol) -> bool
+    {
+        auto approxnum = [reltol](double x, double y)
+        {
+            return std::abs(x - y) <= reltol * std::max(std::abs(x), std::abs(y));
+        };
+
+        if constexpr(isSame<Type, real>)
+            return approxnum(a[0], b[0]) && approxnum(a[1], b[1]);
+        else if constexpr(isArithmetic<Type>)
+            return approxnum(a, b);
+        else return equal(a, b);
+    }
 };
 
 namespace detail {
 
+/// Used to check if MemoizationTraits has been specialized with a tolerance-aware comparison function `approx`.
+template<typename T, typename = void>
+struct hasMemoizationApprox : std::false_type {};
+
+template<typename T>
+struct hasMemoizationApprox<T, std::void_t<decltype(&MemoizationTraits<T>::approx)>> : std::true_type {};
+
 /// Return true if `a` and `b` have the same value using `MemoizationTraits::equal`.
 template<typename CacheType, typename T>
 constexpr auto sameValue(const CacheType& a, const T& b)
@@ -85,6 +122,16 @@ constexpr auto sameValue(const CacheType& a, const T& b)
     return MemoizationTraits<Decay<T>>::equal(a, b);
 };
 
+/// Return true if `a` and `b` have the same value within a relative tolerance using `MemoizationTraits::approx` (if available).
+template<typename CacheType, typename T>
+constexpr auto sameValue(const CacheType& a, const T& b, double reltol) -> bool
+{
+    if constexpr(hasMemoizationApprox<Decay<T>>::value)
+        if(reltol > 0.0)
+            return MemoizationTraits<Decay<T>>::approx(a, b, reltol);
+    return MemoizationTraits<Decay<T>>::equal(a, b);
+};
+
 /// Assign the value of `b` into `a` using `MemoizationTraits::assign`.
 template<typename CacheType, typename T>
 constexpr auto assignValue(CacheType& a, const T& b)
@@ -108,6 +155,22 @@ auto sameValues(const Tuple1& tuple1, const Tuple2& tuple2)
     return res;
 }
 
+/// Return true if corresponding items in each tuple have the same value within a relative tolerance.
+template<typename Tuple1, typename Tuple2>
+auto sameValues(const Tuple1& tuple1, const Tuple2& tuple2, double reltol)
+{
+    using std::tuple_size_v;
+    using std::get;
+    constexpr auto N1 = tuple_size_v<Tuple1>;
+    constexpr auto N2 = tuple_size_v<Tuple2>;
+    static_assert(N1 == N2);
+    bool res = true;
+    For<N1>([&](auto i) constexpr {
+        res = res && sameValue(get<i>(tuple1), get<i>(tuple2), reltol);
+    });
+    return res;
+}
+
 /// Assign the values of `tuple2` into `tuple1`.
 template<typename Tuple1, typename Tuple2>
 auto assignValues(Tuple1& tuple1, const Tuple2& tuple2)
@@ -126,6 +189,55 @@ auto assignValues(Tuple1& tuple1, const Tuple2& tuple2)
 template<typename T>
 using CacheType = typename MemoizationTraits<Decay<T>>::CacheType;
 
+/// The cached arguments and result of the last call to a memoized function in a thread.
+template<typename Ret, typename... Args>
+struct MemoizationLastEntry
+{
+    /// The arguments used in the last call.
+    Tuple<CacheType<Args>...> args;
+
+    /// The result of the last call.
+    Ret result = Ret();
+
+    /// True if no call has been cached yet.
+    bool empty = true;
+};
+
+/// Return the cache entry of the current thread for the memoized function identified by `owner`.
+/// Every thread has its own cache entry for each memoized function, so that
+/// memoized functions can be evaluated concurrently without synchronization.
+/// The cache entries of memoized functions that no longer exist are removed
+/// from time to time.
+template<typename Entry>
+auto threadLocalEntry(SharedPtr<const void> const& owner) -> Entry&
+{
+    struct Slot
+    {
+        std::weak_ptr<const void> owner;
+        Entry entry;
+    };
+
+    static thread_local Map<const void*, Slot> slots;
+    static thread_local std::size_t purgesize = 64;
+
+    if(slots.size() >= purgesize)
+    {
+        for(auto it = slots.begin(); it != slots.end();)
+            it = it->second.owner.expired() ? slots.erase(it) : std::next(it);
+        purgesize = std::max<std::size_t>(64, 2 * slots.size());
+    }
+
+    auto& slot = slots[owner.get()];
+
+    if(slot.owner.expired()) // the slot is new or was used by a memoized function that no longer exists at this same address
+    {
+        slot.owner = owner;
+        slot.entry = Entry();
+    }
+
+    return slot.entry;
+}
+
 } // namespace detail
 
 /// The class used to control memoization in the application.
@@ -148,102 +260,220 @@ public:
     Memoization() = delete;
 };
 
-/// Return a memoized version of given function `f`.
+/// Used to count the cache hits and misses of memoized functions.
+/// Copies of a MemoizationStats object share the same counters, which can be
+/// safely updated from multiple threads. Counting is opt-in (see
+/// MemoizationOptions::stats), since the atomic updates of these shared
+/// counters add contention to memoized functions called from many threads.
+class MemoizationStats
+{
+public:
+    /// Construct a MemoizationStats object with zero counters.
+    MemoizationStats();
+
+    /// Return the number of calls in which a cached result was returned.
+    auto hits() const -> Index;
+
+    /// Return the number of calls in which the memoized function had to be evaluated.
+    auto misses() const -> Index;
+
+    /// Return the number of calls to the memoized function while memoization was enabled.
+    auto calls() const -> Index;
+
+    /// Return the fraction of calls in which a cached result was returned.
+    auto hitRate() const -> double;
+
+    /// Reset the counters to zero.
+    auto reset() const -> void;
+
+    /// Register a call in which a cached result was returned.
+    auto registerHit() const -> void
+    {
+        counters->hits.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Register a call in which the memoized function had to be evaluated.
+    auto registerMiss() const -> void
+    {
+        counters->misses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    struct Counters
+    {
+        std::atomic<Index> hits{0};
+        std::atomic<Index> misses{0};
+    };
+
+    SharedPtr<Counters> counters;
+};
+
+/// The options for the memoization of a function.
+struct MemoizationOptions
+{
+    /// The relative tolerance used to compare arguments with the cached ones (zero for exact comparison).
+    /// The tolerance is applied to arguments whose MemoizationTraits implement
+    /// `approx` (e.g., numbers and Eigen arrays). Note that a positive value
+    /// means a cached result may be returned for slightly different arguments.
+    double reltol = 0.0;
+
+    /// The maximum number of cached entries in functions memoized with @ref memoize.
+    Index capacity = 128;
+
+    /// The counters of cache hits and misses of the memoized function (none by default, in which case no counting is done).
+    Optional<MemoizationStats> stats;
+};
+
+/// Return a memoized version of given function `f` that caches the arguments and results of its most recent calls.
+/// At most MemoizationOptions::capacity entries are cached, with the least
+/// recently used entry discarded when a new one is needed. The cache is shared
+/// among all threads (with access synchronized by a mutex) and among the
+/// copies of the returned function. The cached entries are searched linearly,
+/// which permits tolerance-aware comparison of arguments, so keep the
+/// capacity small.
 template<typename Ret, typename... Args>
-auto memoize(Fn<Ret(Args...)> f) -> Fn<Ret(Args...)>
+auto memoize(Fn<Ret(Args...)> f, MemoizationOptions const& options = {}) -> Fn<Ret(Args...)>
 {
-    auto cache = std::make_shared<Map<Tuple<Args...>, Ret>>();
-    return [=](Args... args) mutable -> Ret
+    using Entry = Tuple<Tuple<detail::CacheType<Args>...>, Ret>;
+
+    struct Cache
+    {
+        std::list<Entry> entries; // the cached entries ordered from the most to the least recently used
+        std::mutex mutex;
+    };
+
+    auto cache = std::make_shared<Cache>();
+    const auto reltol = options.reltol;
+    const auto capacity = std::max<Index>(options.capacity, 1);
+    const auto stats = options.stats;
+
+    return [=](Args... args) -> Ret
     {
         if(Memoization::isDisabled())
             return f(args...);
-        Tuple<Args...> t(args...);
-        if(cache->find(t) == cache->end())
-            (*cache)[t] = f(args...);
-        return (*cache)[t];
+        {
+            std::lock_guard<std::mutex> lock(cache->mutex);
+            auto& entries = cache->entries;
+            for(auto it = entries.begin(); it != entries.end(); ++it)
+            {
+                if(detail::sameValues(std::get<0>(*it), std::tie(args...), reltol))
+                {
+                    entries.splice(entries.begin(), entries, it); // move the entry to the front of the list
+                    if(stats) stats->registerHit();
+                    return std::get<1>(entries.front());
+                }
+            }
+        }
+        if(stats) stats->registerMiss();
+        Entry entry;
+        std::get<1>(entry) = f(args...); // evaluate f without holding the lock
+        detail::assignValues(std::get<0>(entry), std::tie(args...));
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        auto& entries = cache->entries;
+        entries.push_front(std::move(entry));
+        if(entries.size() > capacity)
+            entries.pop_back();
+        return std::get<1>(entries.front());
     };
 }
 
-/// Return a memoized version of given function `f`.
+/// Return a memoized version of given function `f` that caches the arguments and results of its most recent calls.
 template<typename Fun, Requires<!isFunction<Fun>> = true>
-auto memoize(Fun f)
+auto memoize(Fun f, MemoizationOptions const& options = {})
 {
-    return memoize(asFunction(f));
+    return memoize(asFunction(f), options);
 }
 
 /// Return a memoized version of given function `f` that caches only the arguments used in the last call.
+/// Each thread has its own cache with the last call made in that thread, so
+/// the returned function (and its copies, which share these caches) can be
+/// used concurrently from multiple threads.
 template<typename Ret, typename... Args>
-auto memoizeLast(Fn<Ret(Args...)> f) -> Fn<Ret(Args...)>
+auto memoizeLast(Fn<Ret(Args...)> f, MemoizationOptions const& options = {}) -> Fn<Ret(Args...)>
 {
-    Tuple<detail::CacheType<Args>...> cache;
-    Ret result = Ret();
-    auto firsttime = true;
-    return [=](Args... args) mutable -> Ret
+    using Entry = detail::MemoizationLastEntry<Ret, Args...>;
+    SharedPtr<const void> owner = std::make_shared<char>(); // the identity of this memoized function used to find its cache in each thread
+    const auto reltol = options.reltol;
+    const auto stats = options.stats;
+    return [=](Args... args) -> Ret
     {
         if(Memoization::isDisabled())
             return f(args...);
-        if(detail::sameValues(cache, std::tie(args...)) && !firsttime)
-            return Ret(result);
-        detail::assignValues(cache, std::tie(args...));
-        firsttime = false;
-        return result = f(args...);
+        auto& entry = detail::threadLocalEntry<Entry>(owner);
+        if(!entry.empty && detail::sameValues(entry.args, std::tie(args...), reltol))
+        {
+            if(stats) stats->registerHit();
+            return Ret(entry.result);
+        }
+        if(stats) stats->registerMiss();
+        entry.empty = true; // in case f throws below
+        entry.result = f(args...);
+        detail::assignValues(entry.args, std::tie(args...));
+        entry.empty = false;
+        return Ret(entry.result);
     };
 }
 
 /// Return a memoized version of given function `f` that caches only the arguments used in the last call.
 template<typename Fun, Requires<!isFunction<Fun>> = true>
-auto memoizeLast(Fun f)
+auto memoizeLast(Fun f, MemoizationOptions const& options = {})
 {
-    return memoizeLast(asFunction(f));
+    return memoizeLast(asFunction(f), options);
 }
 
 /// Return a memoized version of given function `f` that caches only the arguments used in the last call.
+/// Each thread has its own cache with the last call made in that thread (see @ref memoizeLast).
 template<typename Ret, typename RetRef, typename... Args>
-auto memoizeLastUsingRef(Fn<void(RetRef, Args...)> f) -> Fn<void(RetRef, Args...)>
+auto memoizeLastUsingRef(Fn<void(RetRef, Args...)> f, MemoizationOptions const& options = {}) -> Fn<void(RetRef, Args...)>
 {
-    Tuple<detail::CacheType<Args>...> cache;
-    Ret result = Ret();
-    auto firsttime = true;
-    return [=](RetRef res, Args... args) mutable -> void
+    using Entry = detail::MemoizationLastEntry<Ret, Args...>;
+    SharedPtr<const void> owner = std::make_shared<char>(); // the identity of this memoized function used to find its cache in each thread
+    const auto reltol = options.reltol;
+    const auto stats = options.stats;
+    return [=](RetRef res, Args... args) -> void
     {
         if(Memoization::isDisabled())
-            f(res, args...);
-        else if(detail::sameValues(cache, std::tie(args...)) && !firsttime)
-            res = result;
-        else
+            return f(res, args...);
+        auto& entry = detail::threadLocalEntry<Entry>(owner);
+        if(!entry.empty && detail::sameValues(entry.args, std::tie(args...), reltol))
         {
-            f(res, args...);
-            result = res;
-            detail::assignValues(cache, std::tie(args...));
+            if(stats) stats->registerHit();
+            res = entry.result;
+            return;
         }
-        firsttime = false;
+        if(stats) stats->registerMiss();
+        entry.empty = true; // in case f throws below
+        f(res, args...);
+        entry.result = res;
+        detail::assignValues(entry.args, std::tie(args...));
+        entry.empty = false;
     };
 }
 
-/// Return a memoized version of given function `f` that caches only the arguments used in the last call./// Return a memoized version of given function `f` that caches only the arguments used in the last call.
+/// Return a memoized version of given function `f` that caches only the arguments used in the last call.
 /// This overload is used when `f` is a lambda function or free function.
 /// Use `memoizeLastUsingRef<Ret>(f)` to explicitly specify the `Ret` type.
 template<typename Ret, typename Fun, Requires<!isFunction<Fun>> = true>
-auto memoizeLastUsingRef(Fun f)
+auto memoizeLastUsingRef(Fun f, MemoizationOptions const& options = {})
 {
-    return memoizeLastUsingRef<Ret>(asFunction(f));
+    return memoizeLastUsingRef<Ret>(asFunction(f), options);
 }
 
 /// Return a memoized version of given function `f` that caches only the arguments used in the last call.
 /// This overload assumes that `RetRef = Ret&`.
 template<typename Ret, typename... Args>
-auto memoizeLastUsingRef(Fn<void(Ret&, Args...)> f) -> Fn<void(Ret&, Args...)>
+auto memoizeLastUsingRef(Fn<void(Ret&, Args...)> f, MemoizationOptions const& options = {}) -> Fn<void(Ret&, Args...)>
 {
-    return memoizeLastUsingRef<Ret, Ret&>(f);
+    return memoizeLastUsingRef<Ret, Ret&>(f, options);
 }
 
 /// Return a memoized version of given function `f` that caches only the arguments used in the last call.
 /// This overload is used when `f` is a lambda function or free function.
 /// Use `memoizeLastUsingRef(f)` to implicitly specify that `RetRef` is `Ret&`.
 template<typename Fun, Requires<!isFunction<Fun>> = true>
-auto memoizeLastUsingRef(Fun f)
+auto memoizeLastUsingRef(Fun f, MemoizationOptions const& options = {})
 {
-    return memoizeLastUsingRef(asFunction(f));
+    return memoizeLastUsingRef(asFunction(f), options);
 }
 
 } // namespace Reaktoro
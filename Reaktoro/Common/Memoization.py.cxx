@@ -30,4 +30,20 @@ void exportMemoization(py::module& m)
         .def_static("enable" , &Memoization::enable , "Enable memoization optimization.")
         .def_static("disable", &Memoization::disable, "Disable memoization optimization.")
         ;
+
+    py::class_<MemoizationStats>(m, "MemoizationStats")
+        .def(py::init<>())
+        .def("hits", &MemoizationStats::hits, "Return the number of calls in which a cached result was returned.")
+        .def("misses", &MemoizationStats::misses, "Return the number of calls in which the memoized function had to be evaluated.")
+        .def("calls", &MemoizationStats::calls, "Return the number of calls to the memoized function while memoization was enabled.")
+        .def("hitRate", &MemoizationStats::hitRate, "Return the fraction of calls in which a cached result was returned.")
+        .def("reset", &MemoizationStats::reset, "Reset the counters to zero.")
+        ;
+
+    py::class_<MemoizationOptions>(m, "MemoizationOptions")
+        .def(py::init<>())
+        .def_readwrite("reltol", &MemoizationOptions::reltol, "The relative tolerance used to compare arguments with the cached ones (zero for exact comparison).")
+        .def_readwrite("capacity", &MemoizationOptions::capacity, "The maximum number of cached entries in functions memoized with memoize.")
+        .def_readwrite("stats", &MemoizationOptions::stats, "The counters of cache hits and misses of the memoized function (none by default, in which case no counting is done).")
+        ;
 }
@@ -15,6 +15,10 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with this library. If not, see <http://www.gnu.org/licenses/>.
 
+// C++ includes
+#include <atomic>
+#include <thread>
+
 // Catch includes
 #include <catch2/catch.hpp>
 
@@ -126,3 +130,137 @@ TEST_CASE("Testing Memoization - memoizeLast without return", "[Memoization]")
 
     CHECK( counter == 5 ); // two increments above, in f1 and f2, because of different arguments
 }
+
+TEST_CASE("Testing Memoization - memoizeLast with statistics and tolerance", "[Memoization]")
+{
+    int counter = 0; // a counter for how many times f1 below has been fully evaluated
+
+    auto f1 = [&](double x, real y)
+    {
+        ++counter;
+        return x * y;
+    };
+
+    SECTION("Using exact comparison of arguments")
+    {
+        MemoizationOptions options;
+        options.stats = MemoizationStats();
+
+        auto f2 = memoizeLast(f1, options);
+
+        f2(2.0, 3.0);
+        f2(2.0, 3.0);
+        f2(2.0, 3.0 + 1e-12);
+
+        CHECK( counter == 2 );
+        CHECK( options.stats->hits() == 1 );
+        CHECK( options.stats->misses() == 2 );
+        CHECK( options.stats->calls() == 3 );
+        CHECK( options.stats->hitRate() == Approx(1.0/3.0) );
+
+        options.stats->reset();
+
+        CHECK( options.stats->calls() == 0 );
+        CHECK( options.stats->hitRate() == 0.0 );
+    }
+
+    SECTION("Using tolerance-aware comparison of arguments")
+    {
+        MemoizationOptions options;
+        options.reltol = 1e-8;
+        options.stats = MemoizationStats();
+
+        auto f2 = memoizeLast(f1, options);
+
+        f2(2.0, 3.0);
+        f2(2.0, 3.0 + 1e-12); // within tolerance - cached result is returned
+        f2(2.0, 3.1);
+
+        CHECK( counter == 2 );
+        CHECK( options.stats->hits() == 1 );
+        CHECK( options.stats->misses() == 2 );
+    }
+
+    SECTION("Using tolerance-aware comparison of arguments with different derivative seeds")
+    {
+        MemoizationOptions options;
+        options.reltol = 1e-8;
+
+        auto f2 = memoizeLast(f1, options);
+
+        real y = 3.0;
+
+        CHECK( f2(2.0, y)[1] == 0.0 );
+
+        y[1] = 1.0; // seed y - the cached result, with zero derivative, cannot be returned
+
+        CHECK( f2(2.0, y)[1] == 2.0 );
+        CHECK( counter == 2 );
+        CHECK( !options.stats ); // no counting of hits and misses unless requested
+    }
+}
+
+TEST_CASE("Testing Memoization - memoizeLast with multiple threads", "[Memoization]")
+{
+    std::atomic<int> counter = 0; // a counter for how many times f1 below has been fully evaluated
+
+    auto f1 = [&](double x)
+    {
+        ++counter;
+        return x * x;
+    };
+
+    MemoizationOptions options;
+    options.stats = MemoizationStats();
+
+    auto f2 = memoizeLast(f1, options);
+
+    const auto numthreads = 4;
+    const auto numcalls = 100;
+
+    std::atomic<int> failures = 0;
+
+    Vec<std::thread> threads;
+    for(auto i = 0; i < numthreads; ++i)
+        threads.emplace_back([&, i]() {
+            for(auto j = 0; j < numcalls; ++j)
+                if(f2(i) != i*i)
+                    ++failures;
+        });
+
+    for(auto& thread : threads)
+        thread.join();
+
+    CHECK( failures == 0 );
+    CHECK( counter == numthreads ); // each thread has its own cache of the last call
+    CHECK( options.stats->misses() == numthreads );
+    CHECK( options.stats->hits() == numthreads * (numcalls - 1) );
+}
+
+TEST_CASE("Testing Memoization - memoize with bounded cache", "[Memoization]")
+{
+    int counter = 0; // a counter for how many times f1 below has been fully evaluated
+
+    auto f1 = [&](int x)
+    {
+        ++counter;
+        return 2 * x;
+    };
+
+    MemoizationOptions options;
+    options.capacity = 2;
+    options.stats = MemoizationStats();
+
+    auto f2 = memoize(f1, options);
+
+    CHECK( f2(1) == 2 ); // miss, cache: 1
+    CHECK( f2(2) == 4 ); // miss, cache: 2 1
+    CHECK( f2(1) == 2 ); // hit,  cache: 1 2
+    CHECK( f2(3) == 6 ); // miss, cache: 3 1 (2 is discarded as the least recently used)
+    CHECK( f2(1) == 2 ); // hit,  cache: 1 3
+    CHECK( f2(2) == 4 ); // miss, cache: 2 1
+
+    CHECK( counter == 4 );
+    CHECK( options.stats->hits() == 2 );
+    CHECK( options.stats->misses() == 4 );
+}
@@ -18,6 +18,7 @@
 #include "Table.hpp"
 
 // C++ includes
+#include <cstdint>
 #include <sstream>
 #include <fstream>
 #include <iomanip>
@@ -144,6 +145,127 @@ auto outputTable(Stream& stream, Table const& table, Table::OutputOptions const&
     }
 }
 
+/// The identifier at the beginning of binary files of Table objects.
+const String binaryTableIdentifier = "RKTTABLE";
+
+/// The version of the format of binary files of Table objects.
+const std::uint64_t binaryTableVersion = 1;
+
+/// Write an unsigned 64-bit integer to a binary stream.
+auto writeUInt64(std::ostream& out, std::uint64_t value) -> void
+{
+    out.write(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+/// Read an unsigned 64-bit integer from a binary stream.
+auto readUInt64(std::istream& in) -> std::uint64_t
+{
+    std::uint64_t value = 0;
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+}
+
+/// Write zero bytes to a binary stream so that a block with given size becomes a multiple of 8 bytes.
+auto writePadding(std::ostream& out, Index size) -> void
+{
+    const char zeros[8] = {};
+    out.write(zeros, (8 - size % 8) % 8);
+}
+
+/// Skip the padding bytes in a binary stream after a block with given size.
+auto readPadding(std::istream& in, Index size) -> void
+{
+    in.ignore((8 - size % 8) % 8);
+}
+
+/// Write a string prefixed by its length to a binary stream (without padding).
+auto writeString(std::ostream& out, String const& str) -> Index
+{
+    writeUInt64(out, str.size());
+    out.write(str.data(), str.size());
+    return sizeof(std::uint64_t) + str.size();
+}
+
+/// Read a string prefixed by its length from a binary stream (without padding).
+auto readString(std::istream& in) -> String
+{
+    String str(readUInt64(in), '\0');
+    in.read(str.data(), str.size());
+    return str;
+}
+
+/// Write the values of a table column in a given range of rows to a binary stream as values of type `Binary`.
+template<typename Binary, typename T>
+auto writeValues(std::ostream& out, Deque<T> const& values, Index begin, Index end) -> void
+{
+    const Vec<Binary> buffer(values.begin() + begin, values.begin() + end);
+    const auto size = buffer.size() * sizeof(Binary);
+    out.write(reinterpret_cast<char const*>(buffer.data()), size);
+    writePadding(out, size);
+}
+
+/// Read a number of values of type `Binary` from a binary stream.
+template<typename Binary>
+auto readValues(std::istream& in, Index count) -> Vec<Binary>
+{
+    Vec<Binary> buffer(count);
+    const auto size = buffer.size() * sizeof(Binary);
+    in.read(reinterpret_cast<char*>(buffer.data()), size);
+    readPadding(in, size);
+    return buffer;
+}
+
+/// Write the values of a table column in a given range of rows to a binary stream.
+auto writeTableColumnBlock(std::ostream& out, TableColumn const& column, Index begin, Index end) -> void
+{
+    writeUInt64(out, static_cast<std::uint64_t>(column.dataType()));
+    writeUInt64(out, end - begin);
+
+    switch(column.dataType())
+    {
+        case DataType::Float:   writeValues<double>(out, column.floats(), begin, end); break;
+        case DataType::Integer: writeValues<std::int64_t>(out, column.integers(), begin, end); break;
+        case DataType::Boolean: writeValues<std::uint8_t>(out, column.booleans(), begin, end); break;
+        case DataType::String:
+        {
+            Index size = 0;
+            for(auto i = begin; i < end; ++i)
+                size += writeString(out, column.strings()[i]);
+            writePadding(out, size);
+            break;
+        }
+        default: break;
+    }
+}
+
+/// Read the values of a table column from a binary stream and append them to the column.
+auto readTableColumnBlock(std::istream& in, TableColumn& column) -> void
+{
+    const auto datatype = static_cast<DataType>(readUInt64(in));
+    const auto count = readUInt64(in);
+
+    switch(datatype)
+    {
+        case DataType::Float:   for(auto value : readValues<double>(in, count)) column.appendFloat(value); break;
+        case DataType::Integer: for(auto value : readValues<std::int64_t>(in, count)) column.appendInteger(value); break;
+        case DataType::Boolean: for(auto value : readValues<std::uint8_t>(in, count)) column.appendBoolean(value); break;
+        case DataType::String:
+        {
+            Index size = 0;
+            for(auto i = 0; i < count; ++i)
+            {
+                const auto str = readString(in);
+                column.appendString(str);
+                size += sizeof(std::uint64_t) + str.size();
+            }
+            readPadding(in, size);
+            break;
+        }
+        case DataType::Undefined: break;
+        default: errorif(true, "The binary file of the Table object is corrupted: a column has an unknown data type.");
+    }
+}
+
 } // anonymous namespace
 
 TableColumn::TableColumn()
@@ -307,6 +429,94 @@ auto Table::save(String const& filepath, OutputOptions const& outputopts) const
     outputTable(file, *this, outputopts);
 }
 
+auto Table::saveBinary(String const& filepath) const -> void
+{
+    TableWriter writer(filepath);
+    writer.write(*this);
+}
+
+auto Table::loadBinary(String const& filepath) -> Table
+{
+    std::ifstream file(filepath, std::ios::binary);
+    errorif(!file, "Could not open the binary file `", filepath, "` of a Table object.");
+
+    String identifier(binaryTableIdentifier.size(), '\0');
+    file.read(identifier.data(), identifier.size());
+    errorif(identifier != binaryTableIdentifier, "The file `", filepath, "` is not a binary file of a Table object.");
+
+    const auto version = readUInt64(file);
+    errorif(version != binaryTableVersion, "The binary file `", filepath, "` of a Table object has version ", version, ", but only version ", binaryTableVersion, " is supported.");
+
+    const auto numcols = readUInt64(file);
+
+    Strings colnames(numcols);
+    for(auto& colname : colnames)
+    {
+        colname = readString(file);
+        readPadding(file, sizeof(std::uint64_t) + colname.size());
+    }
+
+    Table table;
+
+    for(auto const& colname : colnames)
+        table.column(colname); // ensure the columns are created in the same order they were written, even if they are empty
+
+    // Read the chunks until the end of the file is reached
+    while(file.peek() != std::ifstream::traits_type::eof())
+    {
+        for(auto const& colname : colnames)
+            readTableColumnBlock(file, table.column(colname));
+        errorif(!file, "The binary file `", filepath, "` of a Table object is corrupted or truncated.");
+    }
+
+    return table;
+}
+
+TableWriter::TableWriter(String const& filepath)
+: mfile(new std::ofstream(filepath, std::ios::binary))
+{
+    errorif(!*mfile, "Could not create the binary file `", filepath, "` for a Table object.");
+}
+
+TableWriter::~TableWriter()
+{}
+
+auto TableWriter::write(Table const& table) -> void
+{
+    auto& file = *mfile;
+
+    // Write the header of the binary file in the first call
+    if(mcolnames.empty())
+    {
+        mcolnames = vectorize(table.columns(), RKT_LAMBDA(pair, pair.first));
+        mrows.resize(mcolnames.size(), 0);
+
+        file.write(binaryTableIdentifier.data(), binaryTableIdentifier.size());
+        writeUInt64(file, binaryTableVersion);
+        writeUInt64(file, mcolnames.size());
+        for(auto const& colname : mcolnames)
+            writePadding(file, writeString(file, colname));
+    }
+
+    errorif(table.cols() != mcolnames.size(), "The columns of a Table object written with TableWriter cannot change after its first write.");
+
+    // Write a new chunk with the rows added to each column since the last write
+    for(auto i = 0; i < mcolnames.size(); ++i)
+    {
+        auto const& column = table.column(mcolnames[i]);
+        errorif(column.rows() < mrows[i], "The rows of a Table object written with TableWriter cannot be removed after they are written.");
+        writeTableColumnBlock(file, column, mrows[i], column.rows());
+        mrows[i] = column.rows();
+    }
+
+    file.flush();
+}
+
+auto TableWriter::rows() const -> Vec<Index> const&
+{
+    return mrows;
+}
+
 Table::OutputOptions::OutputOptions()
 : delimiter(" | "), precision(6), scientific(false), fixed(false)
 {}
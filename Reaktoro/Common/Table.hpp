@@ -17,6 +17,11 @@
 
 #pragma once
 
+// C++ includes
+#include <iosfwd>
+#include <memory>
+#include <utility>
+
 // Reaktoro includes
 #include <Reaktoro/Common/Exception.hpp>
 #include <Reaktoro/Common/TraitsUtils.hpp>
@@ -230,9 +235,65 @@ public:
     /// @warning Ensure that the path given exists; no directories are created in this method call.
     auto save(String const& filepath, OutputOptions const& outputopts = {}) const -> void;
 
+    /// Save the Table object to a binary file.
+    /// Writing and reading a binary file is much faster than its text
+    /// counterpart, since no conversion of values to strings is needed. See
+    /// @ref TableWriter for the layout of the binary file.
+    /// @param filepath The path to the file that will be created, including its file name (e.g., `table.rkt`).
+    auto saveBinary(String const& filepath) const -> void;
+
+    /// Load a Table object from a binary file created with @ref saveBinary or @ref TableWriter.
+    /// @param filepath The path to the binary file.
+    static auto loadBinary(String const& filepath) -> Table;
+
 private:
     /// The named columns and their stored values in the table.
     Dict<String, TableColumn> mcolumns;
 };
 
+/// Used to write Table objects to a binary file in a streaming, append-only fashion.
+/// Each call to @ref write appends to the file the rows added to the table
+/// since the previous call, so that a table being filled during a long
+/// simulation can be flushed to disk periodically at very low cost.
+///
+/// The binary file starts with a header containing the identifier
+/// `RKTTABLE`, the format version, the number of columns and their names.
+/// This is followed by one chunk per call to @ref write, in which each
+/// column is stored as its data type, its number of values in the chunk and
+/// the values themselves (64-bit floats, 64-bit integers, 8-bit booleans, or
+/// strings prefixed by their 64-bit lengths). All integers are unsigned 64-bit
+/// values in the byte order of the machine that wrote the file, and every
+/// block is padded to a multiple of 8 bytes, so that the values of each
+/// column in a chunk are aligned and can be used directly from a
+/// memory-mapped file.
+class TableWriter
+{
+public:
+    /// Construct a TableWriter object that creates a binary file with given path.
+    /// @param filepath The path to the binary file that will be created, including its file name (e.g., `table.rkt`).
+    /// @warning Ensure that the path given exists; no directories are created in this method call.
+    explicit TableWriter(String const& filepath);
+
+    /// Destroy this TableWriter object, closing its binary file.
+    ~TableWriter();
+
+    /// Write to the binary file the rows added to a table since the last call to this method.
+    /// The columns of the table are fixed in the first call to this method.
+    /// @param table The table being written, always the same one in every call.
+    auto write(Table const& table) -> void;
+
+    /// Return the number of rows written so far in each column.
+    auto rows() const -> Vec<Index> const&;
+
+private:
+    /// The binary file stream in which the table is written.
+    std::unique_ptr<std::ofstream> mfile;
+
+    /// The names of the columns written to the binary file.
+    Strings mcolnames;
+
+    /// The number of rows written so far in each column.
+    Vec<Index> mrows;
+};
+
 } // namespace Reaktoro
@@ -92,6 +92,14 @@ void exportTable(py::module& m)
         .def("cols", &Table::cols, "Get the number of columns in the table.")
         .def("dump", &Table::dump, "Assemble a string representation of the Table object.", "outputopts"_a = Table::OutputOptions())
         .def("save", &Table::save, "Save the Table object to a file.", "filepath"_a, "outputopts"_a = Table::OutputOptions())
+        .def("saveBinary", &Table::saveBinary, "Save the Table object to a binary file.", "filepath"_a)
+        .def_static("loadBinary", &Table::loadBinary, "Load a Table object from a binary file created with saveBinary or TableWriter.", "filepath"_a)
         .def("__str__", [](Table const& self) { return self.dump(); })
         ;
+
+    py::class_<TableWriter>(m, "TableWriter")
+        .def(py::init<String const&>(), "filepath"_a)
+        .def("write", &TableWriter::write, "Write to the binary file the rows added to a table since the last call to this method.")
+        .def("rows", &TableWriter::rows, "Return the number of rows written so far in each column.")
+        ;
 }
@@ -15,6 +15,9 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with this library. If not, see <http://www.gnu.org/licenses/>.
 
+// C++ includes
+#include <filesystem>
+
 // Catch includes
 #include <catch2/catch.hpp>
 
@@ -233,4 +236,63 @@ TEST_CASE("Testing class Table", "[Table]")
             "70.0000 |          |         |         ");
 #endif
     }
+
+    SECTION("Testing binary output of Table using Table::saveBinary, Table::loadBinary and TableWriter")
+    {
+        const auto filepath = (std::filesystem::temp_directory_path() / "reaktoro-table-test.rkt").string();
+
+        Table table;
+
+        table.column("Floats") << 10.0 << 20.0 << 30.0;
+        table.column("Integers") << 1 << -2;
+        table.column("Strings") << "Hello" << "World";
+        table.column("Booleans") << true;
+        table.column("Empty");
+
+        //----------------------------------------------------------------------------------------------------
+        // Checking methods Table::saveBinary and Table::loadBinary
+        //----------------------------------------------------------------------------------------------------
+
+        table.saveBinary(filepath);
+
+        Table loaded = Table::loadBinary(filepath);
+
+        CHECK( loaded.rows() == 3 );
+        CHECK( loaded.cols() == 5 );
+
+        CHECK( loaded.column("Floats").floats()     == Deque<double>{10.0, 20.0, 30.0} );
+        CHECK( loaded.column("Integers").integers() == Deque<long>{1, -2} );
+        CHECK( loaded.column("Strings").strings()   == Deque<String>{"Hello", "World"} );
+        CHECK( loaded.column("Booleans").booleans() == Deque<bool>{true} );
+        CHECK( loaded.column("Empty").rows()        == 0 );
+
+        //----------------------------------------------------------------------------------------------------
+        // Checking class TableWriter, which appends to the file only the rows added since its last write
+        //----------------------------------------------------------------------------------------------------
+
+        {
+            TableWriter writer(filepath);
+
+            writer.write(table);
+
+            table.column("Floats") << 40.0;
+            table.column("Strings") << "!";
+            table.column("Booleans") << false << true;
+
+            writer.write(table);
+
+            CHECK( writer.rows() == Vec<Index>{4, 2, 3, 3, 0} );
+        }
+
+        loaded = Table::loadBinary(filepath);
+
+        CHECK( loaded.rows() == 4 );
+        CHECK( loaded.dump() == table.dump() );
+
+        CHECK( loaded.column("Floats").floats()     == Deque<double>{10.0, 20.0, 30.0, 40.0} );
+        CHECK( loaded.column("Strings").strings()   == Deque<String>{"Hello", "World", "!"} );
+        CHECK( loaded.column("Booleans").booleans() == Deque<bool>{true, false, true} );
+
+        std::filesystem::remove(filepath);
+    }
 }
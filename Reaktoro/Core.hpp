@@ -21,8 +21,11 @@
 #include <Reaktoro/Core/ActivityProps.hpp>
 #include <Reaktoro/Core/AggregateState.hpp>
 #include <Reaktoro/Core/ChemicalFormula.hpp>
+#include <Reaktoro/Core/ChemicalOutput.hpp>
 #include <Reaktoro/Core/ChemicalProps.hpp>
+#include <Reaktoro/Core/ChemicalPropsD.hpp>
 #include <Reaktoro/Core/ChemicalPropsPhase.hpp>
+#include <Reaktoro/Core/ChemicalQuantity.hpp>
 #include <Reaktoro/Core/ChemicalState.hpp>
 #include <Reaktoro/Core/ChemicalSystem.hpp>
 #include <Reaktoro/Core/Data.hpp>
@@ -32,8 +35,10 @@
 #include <Reaktoro/Core/ElementList.hpp>
 #include <Reaktoro/Core/Embedded.hpp>
 #include <Reaktoro/Core/FormationReaction.hpp>
+#include <Reaktoro/Core/FormationReactionGraph.hpp>
 #include <Reaktoro/Core/Model.hpp>
 #include <Reaktoro/Core/Param.hpp>
+#include <Reaktoro/Core/ParamOverlay.hpp>
 #include <Reaktoro/Core/Params.hpp>
 #include <Reaktoro/Core/Phase.hpp>
 #include <Reaktoro/Core/PhaseList.hpp>
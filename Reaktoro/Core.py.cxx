@@ -22,8 +22,11 @@ void exportActivityModel(py::module& m);
 void exportActivityProps(py::module& m);
 void exportAggregateState(py::module& m);
 void exportChemicalFormula(py::module& m);
+void exportChemicalOutput(py::module& m);
 void exportChemicalProps(py::module& m);
+void exportChemicalPropsD(py::module& m);
 void exportChemicalPropsPhase(py::module& m);
+void exportChemicalQuantity(py::module& m);
 void exportChemicalState(py::module& m);
 void exportChemicalSystem(py::module& m);
 void exportData(py::module& m);
@@ -33,10 +36,12 @@ void exportElementalComposition(py::module& m);
 void exportElementList(py::module& m);
 void exportEmbedded(py::module& m);
 void exportFormationReaction(py::module& m);
+void exportFormationReactionGraph(py::module& m);
 void exportPhase(py::module& m);
 void exportPhaseList(py::module& m);
 void exportPhases(py::module& m);
 void exportParam(py::module& m);
+void exportParamOverlay(py::module& m);
 void exportParams(py::module& m);
 void exportReaction(py::module& m);
 void exportReactions(py::module& m);
@@ -67,6 +72,7 @@ void exportCore(py::module& m)
     // properly and to avoid C++ types in docstrings when producing stubs via pybind11-stubgen.
     // https://pybind11.readthedocs.io/en/latest/advanced/misc.html#avoiding-c-types-in-docstrings
     exportParam(m);
+    exportParamOverlay(m);
     exportData(m);
     exportChemicalFormula(m);
     exportElement(m);
@@ -74,6 +80,7 @@ void exportCore(py::module& m)
     exportAggregateState(m);
     exportElementalComposition(m);
     exportFormationReaction(m);
+    exportFormationReactionGraph(m);
     exportSpecies(m);
     exportSpeciesList(m);
     exportPhase(m);
@@ -108,4 +115,7 @@ void exportCore(py::module& m)
     exportChemicalState(m);
     exportChemicalPropsPhase(m);
     exportChemicalProps(m);
+    exportChemicalPropsD(m);
+    exportChemicalQuantity(m);
+    exportChemicalOutput(m);
 }
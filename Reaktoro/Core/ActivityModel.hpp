@@ -99,6 +99,17 @@ struct MemoizationTraits<ActivityModelArgs>
         P = b.P;
         x = b.x;
     }
+
+    static auto approx(Tuple<real, real, ArrayXr> const& a, ActivityModelArgs const& b, double reltol) -> bool
+    {
+        auto const& [T, P, x] = a;
+        if(!MemoizationTraits<real>::approx(T, b.T, reltol) || !MemoizationTraits<real>::approx(P, b.P, reltol) || x.size() != b.x.size())
+            return false;
+        for(auto i = 0; i < x.size(); ++i)
+            if(!MemoizationTraits<real>::approx(x[i], b.x[i], reltol))
+                return false;
+        return true;
+    }
 };
 
 } // namespace Reaktoro
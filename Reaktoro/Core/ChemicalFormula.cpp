@@ -17,6 +17,10 @@
 
 #include "ChemicalFormula.hpp"
 
+// C++ includes
+#include <functional>
+#include <mutex>
+
 // Reaktoro includes
 #include <Reaktoro/Common/Algorithms.hpp>
 #include <Reaktoro/Common/Constants.hpp>
@@ -25,6 +29,37 @@
 #include <Reaktoro/Singletons/Elements.hpp>
 
 namespace Reaktoro {
+namespace {
+
+/// Return the interned identifier of an element symbol, which is unique for each distinct symbol.
+/// Element symbols not in the periodic table (e.g., those of custom elements in a database) are
+/// also interned, so that chemical formulas containing them can still be compared with integers.
+auto internSymbol(String const& symbol) -> Index
+{
+    static std::mutex mutex;
+    static Map<String, Index> symbols;
+    std::lock_guard<std::mutex> lock(mutex);
+    return symbols.emplace(symbol, symbols.size()).first->second;
+}
+
+/// Return the chemical formula parsed from a formula string, reusing the one parsed before for the same string.
+template<typename Impl>
+auto internFormula(String const& formula) -> SharedPtr<Impl>
+{
+    static std::mutex mutex;
+    static Map<String, SharedPtr<Impl>> formulas;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = formulas.find(formula);
+        if(it != formulas.end())
+            return it->second;
+    }
+    auto impl = std::make_shared<Impl>(formula); // parse the formula outside the lock
+    std::lock_guard<std::mutex> lock(mutex);
+    return formulas.emplace(formula, impl).first->second;
+}
+
+} // namespace
 
 struct ChemicalFormula::Impl
 {
@@ -37,19 +72,43 @@ struct ChemicalFormula::Impl
     /// The electric charge in the chemical formula (e.g., `-1` for `HCO3-`).
     double charge = {};
 
+    /// The interned identifiers of the element symbols and their coefficients, sorted by identifier.
+    Vec<Pair<Index, double>> interned;
+
+    /// The hash of the interned element symbols, their coefficients, and the electric charge.
+    std::size_t hash = {};
+
     /// Construct an object of type Impl.
     Impl()
-    {}
+    { intern(); }
 
     /// Construct an object of type Impl with given formula.
     Impl(String formula)
     : formula(formula), elements(parseChemicalFormula(formula)), charge(parseElectricCharge(formula))
-    {}
+    { intern(); }
 
     /// Construct an object of type Impl with given data.
     Impl(String formula, Pairs<String, double> elements, double charge)
     : formula(formula), elements(elements), charge(charge)
-    {}
+    { intern(); }
+
+    /// Initialize the interned representation of the chemical formula, used to compare chemical formulas without comparing strings.
+    auto intern() -> void
+    {
+        interned.clear();
+        for(auto const& [symbol, coeff] : elements)
+        {
+            const auto id = internSymbol(symbol);
+            const auto i = indexfn(interned, RKT_LAMBDA(x, x.first == id));
+            if(i < interned.size()) interned[i].second += coeff;
+            else interned.emplace_back(id, coeff);
+        }
+        std::sort(interned.begin(), interned.end());
+
+        hash = std::hash<double>{}(charge);
+        for(auto const& [id, coeff] : interned)
+            hash = hash * 31 + (std::hash<Index>{}(id) ^ (std::hash<double>{}(coeff) << 1));
+    }
 
     /// Return the symbols of the elements.
     auto symbols() const -> Strings
@@ -96,7 +155,7 @@ ChemicalFormula::ChemicalFormula(const char* formula)
 {}
 
 ChemicalFormula::ChemicalFormula(String formula)
-: pimpl(new Impl(formula))
+: pimpl(internFormula<Impl>(formula))
 {}
 
 ChemicalFormula::ChemicalFormula(String formula, Pairs<String, double> symbols, double charge)
@@ -140,9 +199,10 @@ auto ChemicalFormula::molarMass() const -> double
 
 auto ChemicalFormula::equivalent(const ChemicalFormula& other) const -> bool
 {
-    return elements().size() == other.elements().size() &&
-        contained(elements(), other.elements()) &&
-        charge() == other.charge();
+    return pimpl == other.pimpl || (
+        pimpl->hash == other.pimpl->hash &&
+        pimpl->interned == other.pimpl->interned &&
+        charge() == other.charge());
 }
 
 auto ChemicalFormula::equivalent(const ChemicalFormula& f1, const ChemicalFormula& f2) -> bool
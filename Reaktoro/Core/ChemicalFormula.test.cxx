@@ -284,4 +284,24 @@ TEST_CASE("Testing ChemicalFormula class", "[ChemicalFormula]")
 
     CHECK(ChemicalFormula::equivalent("CO2", "CO2(g)"));
     CHECK(ChemicalFormula::equivalent("CO2", "COO"));
+
+    CHECK_FALSE(ChemicalFormula::equivalent("CO2", "CO"));
+    CHECK_FALSE(ChemicalFormula::equivalent("CO2", "CO2-"));
+    CHECK_FALSE(ChemicalFormula::equivalent("CaCO3", "MgCO3"));
+    CHECK_FALSE(ChemicalFormula::equivalent("HCO3-", "CO3--"));
+
+    // Check equivalence of chemical formulas with elements not in the periodic table
+    CHECK(ChemicalFormula::equivalent("Xx2Yy", "YyXx2"));
+    CHECK(ChemicalFormula::equivalent("Xx2Yy", "XxYyXx"));
+    CHECK_FALSE(ChemicalFormula::equivalent("Xx2Yy", "XxYy2"));
+
+    // Check equivalence of chemical formulas constructed with explicit elements and those parsed from strings
+    CHECK(ChemicalFormula::equivalent("CaCO3", ChemicalFormula("CaCO3", {{"Ca", 1}, {"C", 1}, {"O", 3}}, 0)));
+    CHECK(ChemicalFormula::equivalent("CaCO3", ChemicalFormula("Calcite", {{"O", 3}, {"C", 1}, {"Ca", 1}}, 0)));
+    CHECK_FALSE(ChemicalFormula::equivalent("CaCO3", ChemicalFormula("CaCO3", {{"Ca", 1}, {"C", 1}, {"O", 3}}, 1)));
+
+    // Check chemical formulas parsed from the same string are consistent
+    CHECK(ChemicalFormula("Fe+++").str() == ChemicalFormula("Fe+++").str());
+    CHECK(ChemicalFormula("Fe+++").charge() == 3);
+    CHECK(ChemicalFormula("Fe+++").elements() == ChemicalFormula("Fe+++").elements());
 }
@@ -1,325 +1,329 @@
-// // Reaktoro is a unified framework for modeling chemically reactive systems.
-// //
-// // Copyright © 2014-2022 Allan Leal
-// //
-// // This library is free software; you can redistribute it and/or
-// // modify it under the terms of the GNU Lesser General Public
-// // License as published by the Free Software Foundation; either
-// // version 2.1 of the License, or (at your option) any later version.
-// //
-// // This library is distributed in the hope that it will be useful,
-// // but WITHOUT ANY WARRANTY; without even the implied warranty of
-// // MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
-// // Lesser General Public License for more details.
-// //
-// // You should have received a copy of the GNU Lesser General Public License
-// // along with this library. If not, see <http://www.gnu.org/licenses/>.
-
-// #include "ChemicalOutput.hpp"
-
-// // C++ includes
-// #include <fstream>
-// #include <iomanip>
-// #include <iostream>
-// #include <cmath>
-
-// // Reaktoro includes
-// #include <Reaktoro/Common/Exception.hpp>
-// #include <Reaktoro/Common/StringList.hpp>
-// #include <Reaktoro/Common/StringUtils.hpp>
-// #include <Reaktoro/Common/Units.hpp>
-// #include <Reaktoro/Core/ChemicalQuantity.hpp>
-// #include <Reaktoro/Core/ChemicalState.hpp>
-// #include <Reaktoro/Core/ChemicalSystem.hpp>
-// #include <Reaktoro/Core/ReactionSystem.hpp>
-
-// namespace Reaktoro {
-
-// struct ChemicalOutput::Impl
-// {
-//     /// The chemical system instance
-//     ChemicalSystem system;
-
-//     /// The reaction system instance
-//     ReactionSystem reactions;
-
-//     /// The chemical quantity instance
-//     ChemicalQuantity quantity;
-
-//     /// The flag that indicates if output should be done at the terminal.
-//     bool terminal = false;
-
-//     /// The name of the output file.
-//     std::string filename;
-
-//     /// The base name of the output file.
-//     std::string basename;
-
-//     /// The extension name of the output file.
-//     std::string extension;
-
-//     /// The suffix word of the output file name.
-//     std::string suffix;
-
-//     /// The names of the quantities to be output.
-//     std::vector<std::string> data;
-
-//     /// The names of the quantities to appear as column header in the output.
-//     std::vector<std::string> headings;
-
-//     /// The floating-point precision in the output.
-//     int precision = 6;
-
-//     /// The flag that indicates if scientific format should be used.
-//     bool scientific = false;
-
-//     /// The output stream of the data file.
-//     std::ofstream datafile;
-
-//     /// The iteration number for every update call
-//     Index iteration = 0;
-
-//     /// The extra attachments to the output file.
-//     std::vector<std::string> attachments;
-
-//     /// The index of the active column
-//     Index icolumn = 0;
-
-//     /// The spacings between the columns
-//     std::vector<int> spacings;
-
-//     Impl()
-//     : quantity(system)
-//     {}
-
-//     Impl(const ChemicalSystem& system)
-//     : system(system), quantity(system)
-//     {}
-
-//     Impl(const ReactionSystem& reactions)
-//     : system(reactions.system()), reactions(reactions), quantity(reactions)
-//     {}
-
-//     ~Impl()
-//     {
-//         close();
-//     }
-
-//     auto spacing(std::string word) const -> std::size_t
-//     {
-//         return word.size() + std::max(5, 25 - static_cast<int>(word.size()));
-//     }
-
-//     auto open() -> void
-//     {
-//         // Ensure the output file is closed
-//         close();
-
-//         // Ensure output is done either to a file and/or terminal
-//         Assert(!filename.empty() || terminal,
-//             "Cannot open the ChemicalOutput instance for output.",
-//             "The instance has not been configured to output to the terminal or file.");
-
-//         // Make sure header is not empty
-//         if(headings.empty())
-//             headings = data;
-
-//         // Open the data file
-//         if(!filename.empty())
-//             datafile.open(filename, std::ofstream::out | std::ofstream::trunc);
-
-//         // Check if scientific format should be used
-//         if(scientific)
-//             datafile << std::scientific;
-
-//         // Set the floating-point precision in the output.
-//         datafile << std::setprecision(precision);
-
-//         // Determine the spacings between the columns
-//         spacings.clear();
-//         for(auto word : headings)
-//             spacings.push_back(spacing(word));
-
-//         // Output the header of the data file
-//         icolumn = 0;
-//         for(auto word : headings)
-//         {
-//             auto space = spacings[icolumn];
-//             if(datafile.is_open()) datafile << std::left << std::setw(space) << word;
-//             if(terminal)
-//             {
-//                 std::ios::fmtflags flags(std::cout.flags());
-//                 if(scientific) std::cout << std::scientific;
-//                 std::cout << std::setprecision(precision);
-//                 std::cout << std::left << std::setw(space) << word;
-//                 std::cout.flags(flags);
-//             }
-//             ++icolumn;
-//         }
-//     }
-
-//     auto close() -> void
-//     {
-//         datafile.close();
-//     }
-
-//     auto update(const ChemicalState& state, double t) -> void
-//     {
-//         // Output values on a new line
-//         if(datafile.is_open()) datafile << std::endl;
-//         if(terminal) std::cout << std::endl;
-
-//         // Output the current chemical state to the data file.
-//         quantity.update(state, t);
-
-//         // For each quantity, ouput its value on each column
-//         icolumn = 0;
-//         for(auto word : data)
-//         {
-//             auto space = spacings[icolumn];
-//             auto val = (word == "i") ? iteration : quantity.value(word);
-//             if(datafile.is_open()) datafile << std::left << std::setw(space) << val;
-//             if(terminal) std::cout << std::left << std::setw(space) << val;
-//             ++icolumn;
-//         }
-
-//         // Update the iteration number
-//         ++iteration;
-//     }
-
-//     template<typename ValueType>
-//     auto attach(ValueType value) -> void
-//     {
-//         auto space = spacings[icolumn];
-//         if(datafile.is_open()) datafile << std::left << std::setw(space) << value;
-//         if(terminal) std::cout << std::left << std::setw(space) << value;
-//         ++icolumn;
-//     }
-// };
-
-// ChemicalOutput::ChemicalOutput()
-// : pimpl(new Impl())
-// {}
-
-// ChemicalOutput::ChemicalOutput(const ChemicalSystem& system)
-// : pimpl(new Impl(system))
-// {}
-
-// ChemicalOutput::ChemicalOutput(const ReactionSystem& reactions)
-// : pimpl(new Impl(reactions))
-// {}
-
-// ChemicalOutput::~ChemicalOutput()
-// {}
-
-// auto ChemicalOutput::filename(std::string filename) -> void
-// {
-//     pimpl->filename = filename;
-//     pimpl->basename = filename.substr(0, filename.rfind('.'));
-//     pimpl->extension = filename.substr(filename.rfind('.'));
-// }
-
-// auto ChemicalOutput::filename() const -> std::string
-// {
-//     return pimpl->filename;
-// }
-
-// auto ChemicalOutput::suffix(std::string word) -> void
-// {
-//     pimpl->suffix = word;
-//     pimpl->filename = pimpl->basename + pimpl->suffix + pimpl->extension;
-// }
-
-// auto ChemicalOutput::suffix() const -> std::string
-// {
-//     return pimpl->suffix;
-// }
-
-// auto ChemicalOutput::basename() const -> std::string
-// {
-//     return pimpl->basename;
-// }
-
-// auto ChemicalOutput::extension() const -> std::string
-// {
-//     return pimpl->extension;
-// }
-
-// auto ChemicalOutput::add(std::string quantity) -> void
-// {
-//     add(quantity, quantity);
-// }
-
-// auto ChemicalOutput::add(std::string quantity, std::string label) -> void
-// {
-//     pimpl->headings.insert(pimpl->headings.end() - pimpl->attachments.size(), label);
-//     pimpl->data.push_back(quantity);
-// }
-
-// auto ChemicalOutput::attachments(std::vector<std::string> titles) -> void
-// {
-//     pimpl->headings.insert(pimpl->headings.end(), titles.begin(), titles.end());
-//     pimpl->attachments.insert(pimpl->attachments.end(), titles.begin(), titles.end());
-// }
-
-// auto ChemicalOutput::attach(int value) -> void
-// {
-//     pimpl->attach(value);
-// }
-
-// auto ChemicalOutput::attach(double value) -> void
-// {
-//     pimpl->attach(value);
-// }
-
-// auto ChemicalOutput::attach(std::string value) -> void
-// {
-//     pimpl->attach(value);
-// }
-
-// auto ChemicalOutput::precision(int val) -> void
-// {
-//     pimpl->precision = std::abs(val);
-// }
-
-// auto ChemicalOutput::scientific(bool enable) -> void
-// {
-//     pimpl->scientific = enable;
-// }
-
-// auto ChemicalOutput::terminal(bool enabled) -> void
-// {
-//     pimpl->terminal = enabled;
-// }
-
-// auto ChemicalOutput::quantities() const -> std::vector<std::string>
-// {
-//     return pimpl->data;
-// }
-
-// auto ChemicalOutput::headings() const -> std::vector<std::string>
-// {
-//     return pimpl->headings;
-// }
-
-// auto ChemicalOutput::open() -> void
-// {
-//     pimpl->open();
-// }
-
-// auto ChemicalOutput::update(const ChemicalState& state, double t) -> void
-// {
-//     pimpl->update(state, t);
-// }
-
-// auto ChemicalOutput::close() -> void
-// {
-//     pimpl->close();
-// }
-
-// ChemicalOutput::operator bool() const
-// {
-//     return pimpl->terminal || pimpl->filename.size();
-// }
-
-// } // namespace Reaktoro
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "ChemicalOutput.hpp"
+
+// C++ includes
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Core/ChemicalQuantity.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+
+namespace Reaktoro {
+
+struct ChemicalOutput::Impl
+{
+    /// The chemical quantity object used to evaluate the output quantities.
+    ChemicalQuantity quantity;
+
+    /// The flag that indicates if output should be done at the terminal.
+    bool terminal = false;
+
+    /// The name of the output file.
+    String filename;
+
+    /// The formatted strings of the quantities to be output.
+    Strings data;
+
+    /// The names of the quantities to appear as column header in the output.
+    Strings headings;
+
+    /// The floating-point precision in the output.
+    int precision = 6;
+
+    /// The flag that indicates if scientific format should be used.
+    bool scientific = false;
+
+    /// The number of rows in each buffer.
+    Index buffersize = 1000;
+
+    /// The compiled functions of the quantities to be output (an empty function denotes the iteration number `i`).
+    Vec<ChemicalQuantity::Function> functions;
+
+    /// The iteration number for every update call.
+    Index iteration = 0;
+
+    /// The buffer with the rows of values being filled in the update calls.
+    Vec<double> front;
+
+    /// The buffer with the rows of values being written by the writer thread.
+    Vec<double> back;
+
+    /// The output stream of the data file.
+    std::ofstream datafile;
+
+    /// The spacings between the columns.
+    Vec<int> spacings;
+
+    /// The background thread that formats and writes the rows in the back buffer.
+    std::thread writer;
+
+    /// The mutex protecting the communication with the writer thread.
+    std::mutex mutex;
+
+    /// The condition variable used to signal the writer thread and wait for it.
+    std::condition_variable cv;
+
+    /// The flag that indicates the back buffer has rows still to be written.
+    bool pending = false;
+
+    /// The flag that indicates the writer thread should stop once no rows are pending.
+    bool stop = false;
+
+    Impl(ChemicalSystem const& system)
+    : quantity(system)
+    {}
+
+    ~Impl()
+    {
+        close();
+    }
+
+    auto spacing(String const& word) const -> int
+    {
+        return word.size() + std::max(5, 25 - static_cast<int>(word.size()));
+    }
+
+    auto open() -> void
+    {
+        // Ensure the output is closed
+        close();
+
+        // Ensure output is done either to a file and/or terminal
+        errorif(filename.empty() && !terminal,
+            "Cannot open the ChemicalOutput object for output. "
+            "The object has not been configured to output to the terminal or file.");
+
+        // Compile the quantities once, so that no string is parsed in the update calls
+        functions.clear();
+        for(auto const& word : data)
+            functions.push_back(word == "i" ? ChemicalQuantity::Function() : quantity.function(word));
+
+        // Open the data file
+        if(!filename.empty())
+        {
+            datafile.open(filename, std::ofstream::out | std::ofstream::trunc);
+            errorif(!datafile.is_open(), "Could not open the output file `", filename, "` of the ChemicalOutput object.");
+        }
+
+        // Determine the spacings between the columns
+        spacings.clear();
+        for(auto const& word : headings)
+            spacings.push_back(spacing(word));
+
+        // Output the header of the data file
+        std::ostringstream ss;
+        for(auto i = 0; i < headings.size(); ++i)
+            ss << std::left << std::setw(spacings[i]) << headings[i];
+        if(datafile.is_open()) datafile << ss.str();
+        if(terminal) std::cout << ss.str();
+
+        // Start the writer thread
+        iteration = 0;
+        front.clear();
+        back.clear();
+        pending = false;
+        stop = false;
+        writer = std::thread([this] { write(); });
+    }
+
+    auto close() -> void
+    {
+        if(!writer.joinable())
+            return;
+
+        // Hand the remaining rows to the writer thread and ask it to stop after writing them
+        flush();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        cv.notify_all();
+        writer.join();
+
+        datafile.close();
+    }
+
+    auto update(ChemicalState const& state, double t) -> void
+    {
+        errorif(!writer.joinable(), "Cannot update the ChemicalOutput object before it is opened.");
+
+        // Evaluate the compiled quantities at the current chemical state and store them in the front buffer
+        quantity.update(state, t);
+
+        for(auto const& fn : functions)
+            front.push_back(fn ? fn() : iteration);
+
+        // Update the iteration number
+        ++iteration;
+
+        // Hand the front buffer to the writer thread if it is full
+        if(front.size() >= buffersize * functions.size())
+            flush();
+    }
+
+    /// Swap the front and back buffers once the writer thread has finished writing the back buffer.
+    auto flush() -> void
+    {
+        if(front.empty())
+            return;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return !pending; });
+            std::swap(front, back);
+            pending = true;
+        }
+        cv.notify_all();
+        front.clear();
+    }
+
+    /// Execute the loop of the writer thread, formatting and writing the back buffer whenever it has pending rows.
+    auto write() -> void
+    {
+        std::ostringstream ss;
+        if(scientific) ss << std::scientific;
+        ss << std::setprecision(precision);
+
+        const auto numcols = functions.size();
+
+        while(true)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return pending || stop; });
+
+            if(!pending)
+                break;
+
+            lock.unlock();
+
+            // Format the rows in the back buffer (no other thread accesses it while pending is true)
+            ss.str("");
+            for(auto i = 0; i < back.size(); i += numcols)
+            {
+                ss << "\n";
+                for(auto j = 0; j < numcols; ++j)
+                    ss << std::left << std::setw(spacings[j]) << back[i + j];
+            }
+
+            if(datafile.is_open()) datafile << ss.str();
+            if(terminal) std::cout << ss.str();
+
+            lock.lock();
+            pending = false;
+            lock.unlock();
+            cv.notify_all();
+        }
+
+        if(datafile.is_open()) datafile << std::flush;
+        if(terminal) std::cout << std::flush;
+    }
+};
+
+ChemicalOutput::ChemicalOutput(ChemicalSystem const& system)
+: pimpl(new Impl(system))
+{}
+
+ChemicalOutput::~ChemicalOutput()
+{}
+
+auto ChemicalOutput::filename(String const& filename) -> void
+{
+    pimpl->filename = filename;
+}
+
+auto ChemicalOutput::filename() const -> String
+{
+    return pimpl->filename;
+}
+
+auto ChemicalOutput::add(String const& quantity) -> void
+{
+    add(quantity, quantity);
+}
+
+auto ChemicalOutput::add(String const& quantity, String const& label) -> void
+{
+    pimpl->data.push_back(quantity);
+    pimpl->headings.push_back(label);
+}
+
+auto ChemicalOutput::precision(int val) -> void
+{
+    pimpl->precision = std::abs(val);
+}
+
+auto ChemicalOutput::scientific(bool enable) -> void
+{
+    pimpl->scientific = enable;
+}
+
+auto ChemicalOutput::terminal(bool enabled) -> void
+{
+    pimpl->terminal = enabled;
+}
+
+auto ChemicalOutput::bufferSize(Index rows) -> void
+{
+    pimpl->buffersize = std::max<Index>(rows, 1);
+}
+
+auto ChemicalOutput::quantities() const -> Strings
+{
+    return pimpl->data;
+}
+
+auto ChemicalOutput::headings() const -> Strings
+{
+    return pimpl->headings;
+}
+
+auto ChemicalOutput::open() -> void
+{
+    pimpl->open();
+}
+
+auto ChemicalOutput::update(ChemicalState const& state, double t) -> void
+{
+    pimpl->update(state, t);
+}
+
+auto ChemicalOutput::update(Vec<ChemicalState> const& states, double t) -> void
+{
+    for(auto const& state : states)
+        pimpl->update(state, t);
+}
+
+auto ChemicalOutput::close() -> void
+{
+    pimpl->close();
+}
+
+ChemicalOutput::operator bool() const
+{
+    return pimpl->terminal || pimpl->filename.size();
+}
+
+} // namespace Reaktoro
@@ -0,0 +1,47 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include <Reaktoro/pybind11.hxx>
+
+// Reaktoro includes
+#include <Reaktoro/Core/ChemicalOutput.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+using namespace Reaktoro;
+
+void exportChemicalOutput(py::module& m)
+{
+    py::class_<ChemicalOutput>(m, "ChemicalOutput")
+        .def(py::init<ChemicalSystem const&>())
+        .def("filename", py::overload_cast<String const&>(&ChemicalOutput::filename), "Set the name of the output file.")
+        .def("filename", py::overload_cast<>(&ChemicalOutput::filename, py::const_), "Return the name of the output file.")
+        .def("add", py::overload_cast<String const&>(&ChemicalOutput::add), "Add a quantity to be output.")
+        .def("add", py::overload_cast<String const&, String const&>(&ChemicalOutput::add), "Add a quantity to be output with given label.")
+        .def("precision", &ChemicalOutput::precision, "Set the floating-point precision in the output.")
+        .def("scientific", &ChemicalOutput::scientific, "Enable or disable output in scientific format.")
+        .def("terminal", &ChemicalOutput::terminal, "Enable or disable the output to the terminal.")
+        .def("bufferSize", &ChemicalOutput::bufferSize, "Set the number of rows in each of the two buffers of the output (defaults to 1000).")
+        .def("quantities", &ChemicalOutput::quantities, "Return the formatted strings of the quantities in the output.")
+        .def("headings", &ChemicalOutput::headings, "Return the headings of the output.")
+        .def("open", &ChemicalOutput::open, "Open the output, compiling its quantities and starting its writer thread.")
+        .def("update", py::overload_cast<ChemicalState const&, double>(&ChemicalOutput::update), "Update the output with a new chemical state and its tag (e.g., time).")
+        .def("update", py::overload_cast<Vec<ChemicalState> const&, double>(&ChemicalOutput::update), "Update the output with new chemical states sharing the same tag.")
+        .def("close", &ChemicalOutput::close, "Close the output, waiting for all updates to be written.")
+        .def("__bool__", [](ChemicalOutput const& self) { return bool(self); })
+        ;
+}
@@ -0,0 +1,91 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+// C++ includes
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+// Catch includes
+#include <catch2/catch.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Core/ChemicalOutput.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+using namespace Reaktoro;
+
+namespace test {
+
+/// Return a mock ChemicalSystem object for test reasons.
+auto createChemicalSystem() -> ChemicalSystem;
+
+} // namespace test
+
+TEST_CASE("Testing ChemicalOutput class", "[ChemicalOutput]")
+{
+    ChemicalSystem system = test::createChemicalSystem();
+
+    ChemicalState state(system);
+    state.setSpeciesAmounts(1.0);
+
+    const auto filepath = (std::filesystem::temp_directory_path() / "reaktoro-chemical-output-test.txt").string();
+
+    ChemicalOutput output(system);
+    output.filename(filepath);
+    output.add("i");
+    output.add("t");
+    output.add("speciesAmount(Ca++(aq))", "Calcium");
+    output.bufferSize(3); // ensure the writer thread processes several buffers
+
+    CHECK( output );
+    CHECK( output.quantities() == Strings{"i", "t", "speciesAmount(Ca++(aq))"} );
+    CHECK( output.headings() == Strings{"i", "t", "Calcium"} );
+
+    output.open();
+
+    for(auto i = 0; i < 10; ++i)
+    {
+        state.set("Ca++(aq)", i, "mol");
+        output.update(state, 10.0 * i);
+    }
+
+    output.update(Vec<ChemicalState>{state, state}, 100.0);
+
+    output.close();
+
+    std::ifstream file(filepath);
+
+    String line;
+    Strings lines;
+    while(std::getline(file, line))
+        lines.push_back(line);
+
+    file.close();
+
+    REQUIRE( lines.size() == 13 ); // header and 12 rows
+
+    std::istringstream row(lines[4]);
+
+    double i, t, nCa;
+    row >> i >> t >> nCa;
+
+    CHECK( i == 3 );
+    CHECK( t == 30.0 );
+    CHECK( nCa == 3.0 );
+
+    std::filesystem::remove(filepath);
+}
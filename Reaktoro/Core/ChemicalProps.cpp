@@ -27,6 +27,7 @@ using namespace tabulate;
 // Reaktoro includes
 #include <Reaktoro/Common/Algorithms.hpp>
 #include <Reaktoro/Common/Enumerate.hpp>
+#include <Reaktoro/Core/ChemicalPropsD.hpp>
 #include <Reaktoro/Core/ChemicalPropsPhase.hpp>
 #include <Reaktoro/Core/ChemicalState.hpp>
 #include <Reaktoro/Core/Utils.hpp>
@@ -92,12 +93,15 @@ auto ChemicalProps::update(real const& T0, real const& P0, ArrayXrConstRef n0) -
     T = T0;
     P = P0;
 
+    // Compute the standard thermodynamic properties of all species at once using the graph of their formation reactions
+    msystem.formationReactionGraph().evaluate(T, P, G0, H0, V0, VT0, VP0, Cp0);
+
     auto offset = 0;
     for(auto const& [i, phase] : enumerate(msystem.phases()))
     {
         const auto size = phase.species().size();
         const auto np = n0.segment(offset, size);
-        phasePropsRef(i).update(T, P, np, m_extra);
+        phasePropsRef(i).updateExceptStandardProps(T, P, np, m_extra);
         offset += size;
     }
 }
@@ -133,12 +137,15 @@ auto ChemicalProps::updateIdeal(real const& T0, real const& P0, ArrayXrConstRef
     T = T0;
     P = P0;
 
+    // Compute the standard thermodynamic properties of all species at once using the graph of their formation reactions
+    msystem.formationReactionGraph().evaluate(T, P, G0, H0, V0, VT0, VP0, Cp0);
+
     auto offset = 0;
     for(auto const& [i, phase] : enumerate(msystem.phases()))
     {
         const auto size = phase.species().size();
         const auto np = n0.segment(offset, size);
-        phasePropsRef(i).updateIdeal(T, P, np, m_extra);
+        phasePropsRef(i).updateIdealExceptStandardProps(T, P, np, m_extra);
         offset += size;
     }
 }
@@ -886,40 +893,43 @@ auto operator<<(std::ostream& out, ChemicalProps const& props) -> std::ostream&
     if(props.system().species().empty())
         return out;
 
+    // No derivatives are needed here, so compute all properties in double precision
+    const ChemicalPropsD values(props);
+
     const auto species = props.system().species();
     const auto elements = props.system().elements();
-    const auto b   = props.elementAmounts();
-    const auto n   = props.speciesAmounts();
-    const auto x   = props.speciesMoleFractions();
-    const auto lng = props.speciesActivityCoefficientsLn();
-    const auto lna = props.speciesActivitiesLn();
-    const auto mu  = props.speciesChemicalPotentials();
-    const auto G0  = props.speciesStandardGibbsEnergies();
-    const auto H0  = props.speciesStandardEnthalpies();
-    const auto V0  = props.speciesStandardVolumes();
-    const auto S0  = props.speciesStandardEntropies();
-    const auto U0  = props.speciesStandardInternalEnergies();
-    const auto A0  = props.speciesStandardHelmholtzEnergies();
-    const auto Cp0 = props.speciesStandardHeatCapacitiesConstP();
-    const auto Cv0 = props.speciesStandardHeatCapacitiesConstV();
+    const auto b   = values.elementAmounts();
+    const auto n   = values.speciesAmounts();
+    const auto x   = values.speciesMoleFractions();
+    const auto lng = values.speciesActivityCoefficientsLn();
+    const auto lna = values.speciesActivitiesLn();
+    const auto mu  = values.speciesChemicalPotentials();
+    const auto G0  = values.speciesStandardGibbsEnergies();
+    const auto H0  = values.speciesStandardEnthalpies();
+    const auto V0  = values.speciesStandardVolumes();
+    const auto S0  = values.speciesStandardEntropies();
+    const auto U0  = values.speciesStandardInternalEnergies();
+    const auto A0  = values.speciesStandardHelmholtzEnergies();
+    const auto Cp0 = values.speciesStandardHeatCapacitiesConstP();
+    const auto Cv0 = values.speciesStandardHeatCapacitiesConstV();
 
     Table table;
     table.add_row({ "Property", "Value", "Unit" });
-    table.add_row({ "Temperature", strfix(props.temperature()), "K" });
-    table.add_row({ "Pressure", strfix(props.pressure()*1e-5), "bar" });
-    table.add_row({ "Volume", strsci(props.volume()), "m3" });
-    table.add_row({ "Gibbs Energy", strfix(props.gibbsEnergy()), "J" });
-    table.add_row({ "Enthalpy", strfix(props.enthalpy()), "J" });
-    table.add_row({ "Entropy", strfix(props.entropy()), "J/K" });
-    table.add_row({ "Internal Energy", strfix(props.internalEnergy()), "J" });
-    table.add_row({ "Helmholtz Energy", strfix(props.helmholtzEnergy()), "J" });
-    table.add_row({ "Charge", strsci(props.charge()), "mol" });
+    table.add_row({ "Temperature", strfix(values.temperature()), "K" });
+    table.add_row({ "Pressure", strfix(values.pressure()*1e-5), "bar" });
+    table.add_row({ "Volume", strsci(values.volume()), "m3" });
+    table.add_row({ "Gibbs Energy", strfix(values.gibbsEnergy()), "J" });
+    table.add_row({ "Enthalpy", strfix(values.enthalpy()), "J" });
+    table.add_row({ "Entropy", strfix(values.entropy()), "J/K" });
+    table.add_row({ "Internal Energy", strfix(values.internalEnergy()), "J" });
+    table.add_row({ "Helmholtz Energy", strfix(values.helmholtzEnergy()), "J" });
+    table.add_row({ "Charge", strsci(values.charge()), "mol" });
 
     table.add_row({ "Element Amount:" }); for(auto i = 0; i < b.size(); ++i) table.add_row({ ":: " + elements[i].symbol(), strsci(b[i]), "mol" });
     table.add_row({ "Species Amount:" }); for(auto i = 0; i < n.size(); ++i) table.add_row({ ":: " + species[i].repr(), strsci(n[i]), "mol" });
     table.add_row({ "Mole Fraction:", "", "" }); for(auto i = 0; i < n.size(); ++i) table.add_row({ ":: " + species[i].repr(), strsci(x[i]), "mol/mol" });
-    table.add_row({ "Activity Coefficient:", "", "" }); for(auto i = 0; i < n.size(); ++i) table.add_row({ ":: " + species[i].repr(), strfix(exp(lng[i])), "-" });
-    table.add_row({ "Activity:", "", "" }); for(auto i = 0; i < n.size(); ++i) table.add_row({ ":: " + species[i].repr(), strsci(exp(lna[i])), "-" });
+    table.add_row({ "Activity Coefficient:", "", "" }); for(auto i = 0; i < n.size(); ++i) table.add_row({ ":: " + species[i].repr(), strfix(std::exp(lng[i])), "-" });
+    table.add_row({ "Activity:", "", "" }); for(auto i = 0; i < n.size(); ++i) table.add_row({ ":: " + species[i].repr(), strsci(std::exp(lna[i])), "-" });
     table.add_row({ "lg(Activity):", "", "" }); for(auto i = 0; i < n.size(); ++i) table.add_row({ ":: " + species[i].repr(), strfix(lna[i]/ln10), "-" });
     table.add_row({ "ln(Activity):", "", "" }); for(auto i = 0; i < n.size(); ++i) table.add_row({ ":: " + species[i].repr(), strfix(lna[i]), "-" });
     table.add_row({ "Chemical Potential:", "", "" }); for(auto i = 0; i < n.size(); ++i) table.add_row({ ":: " + species[i].repr(), strsci(mu[i]), "J/mol" });
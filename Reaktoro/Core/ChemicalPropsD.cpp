@@ -0,0 +1,343 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "ChemicalPropsD.hpp"
+
+// Reaktoro includes
+#include <Reaktoro/Common/ArraySerialization.hpp>
+#include <Reaktoro/Core/ChemicalProps.hpp>
+
+namespace Reaktoro {
+
+ChemicalPropsD::ChemicalPropsD()
+{}
+
+ChemicalPropsD::ChemicalPropsD(ChemicalSystem const& system)
+: msystem(system)
+{
+    const auto N = system.species().size();
+    const auto K = system.phases().size();
+
+    mm = ArrayXd::Zero(N);
+    for(auto i = 0; i < N; ++i)
+        mm[i] = system.species(i).molarMass();
+
+    Ts   = ArrayXd::Zero(K);
+    Ps   = ArrayXd::Zero(K);
+    n    = ArrayXd::Zero(N);
+    nsum = ArrayXd::Zero(K);
+    msum = ArrayXd::Zero(K);
+    x    = ArrayXd::Zero(N);
+    G0   = ArrayXd::Zero(N);
+    H0   = ArrayXd::Zero(N);
+    V0   = ArrayXd::Zero(N);
+    VT0  = ArrayXd::Zero(N);
+    VP0  = ArrayXd::Zero(N);
+    Cp0  = ArrayXd::Zero(N);
+    Vx   = ArrayXd::Zero(K);
+    VxT  = ArrayXd::Zero(K);
+    VxP  = ArrayXd::Zero(K);
+    Vxi  = ArrayXd::Zero(N);
+    Gx   = ArrayXd::Zero(K);
+    Hx   = ArrayXd::Zero(K);
+    Cpx  = ArrayXd::Zero(K);
+    ln_g = ArrayXd::Zero(N);
+    ln_a = ArrayXd::Zero(N);
+    u    = ArrayXd::Zero(N);
+}
+
+ChemicalPropsD::ChemicalPropsD(ChemicalProps const& props)
+: ChemicalPropsD(props.system())
+{
+    update(props);
+}
+
+auto ChemicalPropsD::update(ChemicalProps const& props) -> void
+{
+    props.serialize(stream);
+    update(stream.data());
+}
+
+auto ChemicalPropsD::update(ArrayXdConstRef data) -> void
+{
+    ArraySerialization::deserialize(data, T, P, n, Ts, Ps, nsum, msum, x, G0, H0, V0, VT0, VP0, Cp0, Vx, VxT, VxP, Vxi, Gx, Hx, Cpx, ln_g, ln_a, u);
+}
+
+auto ChemicalPropsD::system() const -> ChemicalSystem const&
+{
+    return msystem;
+}
+
+auto ChemicalPropsD::temperature() const -> double
+{
+    return T;
+}
+
+auto ChemicalPropsD::pressure() const -> double
+{
+    return P;
+}
+
+auto ChemicalPropsD::charge() const -> double
+{
+    const auto Acharge = msystem.formulaMatrixCharge();
+    return (Acharge * n.matrix()).sum();
+}
+
+auto ChemicalPropsD::elementAmount(Index ielement) const -> double
+{
+    const auto A = msystem.formulaMatrixElements();
+    return A.row(ielement) * n.matrix();
+}
+
+auto ChemicalPropsD::elementAmountInPhase(Index ielement, Index iphase) const -> double
+{
+    const auto offset = msystem.phases().numSpeciesUntilPhase(iphase);
+    const auto length = msystem.phase(iphase).species().size();
+    const auto A = msystem.formulaMatrixElements();
+    return A.row(ielement).segment(offset, length) * n.matrix().segment(offset, length);
+}
+
+auto ChemicalPropsD::elementMass(Index ielement) const -> double
+{
+    return elementAmount(ielement) * msystem.element(ielement).molarMass();
+}
+
+auto ChemicalPropsD::elementMassInPhase(Index ielement, Index iphase) const -> double
+{
+    return elementAmountInPhase(ielement, iphase) * msystem.element(ielement).molarMass();
+}
+
+auto ChemicalPropsD::elementAmounts() const -> ArrayXd
+{
+    const auto A = msystem.formulaMatrixElements();
+    return (A * n.matrix()).array();
+}
+
+auto ChemicalPropsD::componentAmounts() const -> ArrayXd
+{
+    const auto A = msystem.formulaMatrix();
+    return (A * n.matrix()).array();
+}
+
+auto ChemicalPropsD::speciesAmounts() const -> ArrayXdConstRef
+{
+    return n;
+}
+
+auto ChemicalPropsD::speciesMasses() const -> ArrayXd
+{
+    return n * mm;
+}
+
+auto ChemicalPropsD::speciesMoleFractions() const -> ArrayXdConstRef
+{
+    return x;
+}
+
+auto ChemicalPropsD::speciesConcentrationsLn() const -> ArrayXd
+{
+    return ln_a - ln_g;
+}
+
+auto ChemicalPropsD::speciesActivityCoefficientsLn() const -> ArrayXdConstRef
+{
+    return ln_g;
+}
+
+auto ChemicalPropsD::speciesActivitiesLn() const -> ArrayXdConstRef
+{
+    return ln_a;
+}
+
+auto ChemicalPropsD::speciesChemicalPotentials() const -> ArrayXdConstRef
+{
+    return u;
+}
+
+auto ChemicalPropsD::speciesPartialMolarVolumes() const -> ArrayXd
+{
+    return V0 + Vxi;
+}
+
+auto ChemicalPropsD::speciesStandardVolumes() const -> ArrayXdConstRef
+{
+    return V0;
+}
+
+auto ChemicalPropsD::speciesStandardVolumesT() const -> ArrayXdConstRef
+{
+    return VT0;
+}
+
+auto ChemicalPropsD::speciesStandardVolumesP() const -> ArrayXdConstRef
+{
+    return VP0;
+}
+
+auto ChemicalPropsD::speciesStandardGibbsEnergies() const -> ArrayXdConstRef
+{
+    return G0;
+}
+
+auto ChemicalPropsD::speciesStandardEnthalpies() const -> ArrayXdConstRef
+{
+    return H0;
+}
+
+auto ChemicalPropsD::speciesStandardEntropies() const -> ArrayXd
+{
+    return (H0 - G0)/T; // from G0 = H0 - T*S0
+}
+
+auto ChemicalPropsD::speciesStandardInternalEnergies() const -> ArrayXd
+{
+    return H0 - P*V0; // from H0 = U0 + P*V0
+}
+
+auto ChemicalPropsD::speciesStandardHelmholtzEnergies() const -> ArrayXd
+{
+    return G0 - P*V0; // from A0 = U0 - T*S0 = (H0 - P*V0) + (G0 - H0) = G0 - P*V0
+}
+
+auto ChemicalPropsD::speciesStandardHeatCapacitiesConstP() const -> ArrayXdConstRef
+{
+    return Cp0;
+}
+
+auto ChemicalPropsD::speciesStandardHeatCapacitiesConstV() const -> ArrayXd
+{
+    return (VP0 == 0.0).select(Cp0, Cp0 + T*VT0*VT0/VP0); // from Cv0 = Cp0 + T*VT0*VT0/VP0
+}
+
+auto ChemicalPropsD::phaseAmounts() const -> ArrayXdConstRef
+{
+    return nsum;
+}
+
+auto ChemicalPropsD::phaseMasses() const -> ArrayXdConstRef
+{
+    return msum;
+}
+
+auto ChemicalPropsD::phaseVolume(Index iphase) const -> double
+{
+    const auto offset = msystem.phases().numSpeciesUntilPhase(iphase);
+    const auto size = msystem.phase(iphase).species().size();
+    return (n.segment(offset, size) * V0.segment(offset, size)).sum() + nsum[iphase] * Vx[iphase]; // from V = n*(sum(x*V0) + Vx)
+}
+
+auto ChemicalPropsD::phaseVolumes() const -> ArrayXd
+{
+    const auto K = msystem.phases().size();
+    ArrayXd V(K);
+    auto offset = 0;
+    for(auto i = 0; i < K; ++i)
+    {
+        const auto size = msystem.phase(i).species().size();
+        V[i] = (n.segment(offset, size) * V0.segment(offset, size)).sum() + nsum[i] * Vx[i]; // from V = n*(sum(x*V0) + Vx)
+        offset += size;
+    }
+    return V;
+}
+
+auto ChemicalPropsD::molarVolume() const -> double
+{
+    return volume() / amount();
+}
+
+auto ChemicalPropsD::molarGibbsEnergy() const -> double
+{
+    return gibbsEnergy() / amount();
+}
+
+auto ChemicalPropsD::molarEnthalpy() const -> double
+{
+    return enthalpy() / amount();
+}
+
+auto ChemicalPropsD::molarEntropy() const -> double
+{
+    return entropy() / amount();
+}
+
+auto ChemicalPropsD::molarInternalEnergy() const -> double
+{
+    return internalEnergy() / amount();
+}
+
+auto ChemicalPropsD::molarHelmholtzEnergy() const -> double
+{
+    return helmholtzEnergy() / amount();
+}
+
+auto ChemicalPropsD::molarHeatCapacityConstP() const -> double
+{
+    return heatCapacityConstP() / amount();
+}
+
+auto ChemicalPropsD::density() const -> double
+{
+    return mass() / volume();
+}
+
+auto ChemicalPropsD::amount() const -> double
+{
+    return nsum.sum();
+}
+
+auto ChemicalPropsD::mass() const -> double
+{
+    return msum.sum();
+}
+
+auto ChemicalPropsD::volume() const -> double
+{
+    return phaseVolumes().sum();
+}
+
+auto ChemicalPropsD::gibbsEnergy() const -> double
+{
+    return (n * G0).sum() + (nsum * Gx).sum();
+}
+
+auto ChemicalPropsD::enthalpy() const -> double
+{
+    return (n * H0).sum() + (nsum * Hx).sum();
+}
+
+auto ChemicalPropsD::entropy() const -> double
+{
+    return (n * (H0 - G0)).sum()/T + (nsum * (Hx - Gx)/Ts).sum(); // from G = H - T*S
+}
+
+auto ChemicalPropsD::internalEnergy() const -> double
+{
+    return (n * (H0 - P*V0)).sum() + (nsum * (Hx - Ps*Vx)).sum(); // from H = U + P*V
+}
+
+auto ChemicalPropsD::helmholtzEnergy() const -> double
+{
+    return (n * (G0 - P*V0)).sum() + (nsum * (Gx - Ps*Vx)).sum(); // from A = U - T*S = G - P*V
+}
+
+auto ChemicalPropsD::heatCapacityConstP() const -> double
+{
+    return (n * Cp0).sum() + (nsum * Cpx).sum();
+}
+
+} // namespace Reaktoro
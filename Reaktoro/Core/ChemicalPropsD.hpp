@@ -0,0 +1,297 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Reaktoro includes
+#include <Reaktoro/Common/ArrayStream.hpp>
+#include <Reaktoro/Common/Matrix.hpp>
+#include <Reaktoro/Common/Types.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+
+namespace Reaktoro {
+
+// Forward declarations
+class ChemicalProps;
+
+/// The class that computes chemical properties of a chemical system in double precision.
+/// This is the counterpart of ChemicalProps for calculations in which no
+/// derivatives are needed (e.g., post-processing, output, and predictions of
+/// smart equilibrium solvers). The primary chemical property data is stored
+/// as arrays of double numbers, and all secondary properties are computed
+/// from these arrays without propagating automatic differentiation
+/// derivatives. A ChemicalPropsD object can be updated from a ChemicalProps
+/// object or directly from the array of double numbers produced by
+/// ChemicalProps::serialize (e.g., the predicted properties in
+/// EquilibriumPredictor), in which case the chemical models are not evaluated.
+class ChemicalPropsD
+{
+public:
+    /// Construct a default uninitialized ChemicalPropsD object.
+    ChemicalPropsD();
+
+    /// Construct an uninitialized ChemicalPropsD object with given chemical system.
+    explicit ChemicalPropsD(ChemicalSystem const& system);
+
+    /// Construct a ChemicalPropsD object with the values of given chemical properties.
+    explicit ChemicalPropsD(ChemicalProps const& props);
+
+    /// Update the chemical properties of the system with the values of given chemical properties.
+    auto update(ChemicalProps const& props) -> void;
+
+    /// Update the chemical properties of the system with serialized data.
+    /// @param u The chemical properties serialized in the same layout of ChemicalProps::serialize.
+    auto update(ArrayXdConstRef u) -> void;
+
+    /// Return the chemical system associated with these chemical properties.
+    auto system() const -> ChemicalSystem const&;
+
+    /// Return the temperature of the system (in K).
+    auto temperature() const -> double;
+
+    /// Return the pressure of the system (in Pa).
+    auto pressure() const -> double;
+
+    /// Return the amount of electric charge in the system (in mol).
+    auto charge() const -> double;
+
+    /// Return the amount of an element in the system (in mol).
+    /// @param ielement The index of the element in the system.
+    auto elementAmount(Index ielement) const -> double;
+
+    /// Return the amount of an element in a phase of the system (in mol).
+    /// @param ielement The index of the element in the system.
+    /// @param iphase The index of the phase in the system.
+    auto elementAmountInPhase(Index ielement, Index iphase) const -> double;
+
+    /// Return the mass of an element in the system (in kg).
+    /// @param ielement The index of the element in the system.
+    auto elementMass(Index ielement) const -> double;
+
+    /// Return the mass of an element in a phase of the system (in kg).
+    /// @param ielement The index of the element in the system.
+    /// @param iphase The index of the phase in the system.
+    auto elementMassInPhase(Index ielement, Index iphase) const -> double;
+
+    /// Return the amounts of the elements in the system (in mol).
+    auto elementAmounts() const -> ArrayXd;
+
+    /// Return the amounts of the conservative components (elements and charge) in the system (in mol).
+    auto componentAmounts() const -> ArrayXd;
+
+    /// Return the amounts of the species in the system (in mol).
+    auto speciesAmounts() const -> ArrayXdConstRef;
+
+    /// Return the masses of the species in the system (in kg).
+    auto speciesMasses() const -> ArrayXd;
+
+    /// Return the mole fractions of the species in the system.
+    auto speciesMoleFractions() const -> ArrayXdConstRef;
+
+    /// Return the ln concentrations of the species in the system.
+    auto speciesConcentrationsLn() const -> ArrayXd;
+
+    /// Return the ln activity coefficients of the species in the system.
+    auto speciesActivityCoefficientsLn() const -> ArrayXdConstRef;
+
+    /// Return the ln activities of the species in the system.
+    auto speciesActivitiesLn() const -> ArrayXdConstRef;
+
+    /// Return the chemical potentials of the species in the system (in J/mol).
+    auto speciesChemicalPotentials() const -> ArrayXdConstRef;
+
+    /// Return the partial molar volumes of the species in the system (in m³/mol).
+    auto speciesPartialMolarVolumes() const-> ArrayXd;
+
+    /// Return the standard partial molar volumes of the species in the system (in m³/mol).
+    auto speciesStandardVolumes() const -> ArrayXdConstRef;
+
+    /// Return the temperature derivative of the standard partial molar volumes of the species in the system (in m³/(mol·K)).
+    auto speciesStandardVolumesT() const -> ArrayXdConstRef;
+
+    /// Return the pressure derivative of the standard partial molar volumes of the species in the system (in m³/(mol·Pa)).
+    auto speciesStandardVolumesP() const -> ArrayXdConstRef;
+
+    /// Return the standard partial molar Gibbs energies of formation of the species in the system (in J/mol).
+    auto speciesStandardGibbsEnergies() const -> ArrayXdConstRef;
+
+    /// Return the standard partial molar enthalpies of formation of the species in the system (in J/mol).
+    auto speciesStandardEnthalpies() const -> ArrayXdConstRef;
+
+    /// Return the standard partial molar entropies of formation of the species in the system (in J/(mol·K)).
+    auto speciesStandardEntropies() const -> ArrayXd;
+
+    /// Return the standard partial molar internal energies of formation of the species in the system (in J/mol).
+    auto speciesStandardInternalEnergies() const -> ArrayXd;
+
+    /// Return the standard partial molar Helmholtz energies of formation of the species in the system (in J/mol).
+    auto speciesStandardHelmholtzEnergies() const -> ArrayXd;
+
+    /// Return the standard partial molar isobaric heat capacities of the species in the system (in J/(mol·K)).
+    auto speciesStandardHeatCapacitiesConstP() const -> ArrayXdConstRef;
+
+    /// Return the standard partial molar isochoric heat capacities of the species in the system (in J/(mol·K)).
+    auto speciesStandardHeatCapacitiesConstV() const -> ArrayXd;
+
+    /// Return the sums of species amounts in each phase of the system (in mol).
+    auto phaseAmounts() const -> ArrayXdConstRef;
+
+    /// Return the sums of species masses in each phase of the system (in kg).
+    auto phaseMasses() const -> ArrayXdConstRef;
+
+    /// Return the volume of a phase of the system (in m³).
+    /// @param iphase The index of the phase in the system.
+    auto phaseVolume(Index iphase) const -> double;
+
+    /// Return the volumes of each phase of the system (in m³).
+    auto phaseVolumes() const -> ArrayXd;
+
+    /// Return the molar volume of the system (in m³/mol).
+    auto molarVolume() const -> double;
+
+    /// Return the molar Gibbs energy of formation of the system (in J/mol).
+    auto molarGibbsEnergy() const -> double;
+
+    /// Return the molar enthalpy of formation of the system (in J/mol).
+    auto molarEnthalpy() const -> double;
+
+    /// Return the molar entropy of formation of the system (in J/(mol·K)).
+    auto molarEntropy() const -> double;
+
+    /// Return the molar internal energy of formation of the system (in J/mol).
+    auto molarInternalEnergy() const -> double;
+
+    /// Return the molar Helmholtz energy of formation of the system (in J/mol).
+    auto molarHelmholtzEnergy() const -> double;
+
+    /// Return the molar isobaric heat capacity of the system (in J/(mol·K)).
+    auto molarHeatCapacityConstP() const -> double;
+
+    /// Return the density of the system (in kg/m³).
+    auto density() const -> double;
+
+    /// Return the sum of species amounts in the system (in mol).
+    auto amount() const -> double;
+
+    /// Return the sum of species masses in the system (in kg).
+    auto mass() const -> double;
+
+    /// Return the volume of the system (in m³).
+    auto volume() const -> double;
+
+    /// Return the Gibbs energy of the system (in J).
+    auto gibbsEnergy() const -> double;
+
+    /// Return the enthalpy of the system (in J).
+    auto enthalpy() const -> double;
+
+    /// Return the entropy of the system (in J/K).
+    auto entropy() const -> double;
+
+    /// Return the internal energy of the system (in J).
+    auto internalEnergy() const -> double;
+
+    /// Return the Helmholtz energy of the system (in J).
+    auto helmholtzEnergy() const -> double;
+
+    /// Return the isobaric heat capacity of the system (in J/K).
+    auto heatCapacityConstP() const -> double;
+
+private:
+    /// The ChemicalSystem object associated with this ChemicalPropsD object.
+    ChemicalSystem msystem;
+
+    /// The molar masses of the species in the system (in kg/mol).
+    ArrayXd mm;
+
+    /// The auxiliary stream used to serialize the chemical properties in a ChemicalProps object.
+    ArrayStream<double> stream;
+
+    /// The temperature of the system (in K).
+    double T = 0.0;
+
+    /// The pressure of the system (in Pa).
+    double P = 0.0;
+
+    /// The amounts of each species in the system (in mol).
+    ArrayXd n;
+
+    /// The temperatures of each phase (in K).
+    ArrayXd Ts;
+
+    /// The pressures of each phase (in Pa).
+    ArrayXd Ps;
+
+    /// The sum of species amounts in each phase of the system (in mol).
+    ArrayXd nsum;
+
+    /// The sum of species masses in each phase of the system (in kg).
+    ArrayXd msum;
+
+    /// The mole fractions of the species in the system (in mol/mol).
+    ArrayXd x;
+
+    /// The standard molar Gibbs energies of formation of the species in the system (in J/mol).
+    ArrayXd G0;
+
+    /// The standard molar enthalpies of formation of the species in the system (in J/mol).
+    ArrayXd H0;
+
+    /// The standard molar volumes of the species in the system (in m³/mol).
+    ArrayXd V0;
+
+    /// The temperature derivative of the standard molar volumes of the species in the system (in m³/(mol·K)).
+    ArrayXd VT0;
+
+    /// The pressure derivative of the standard molar volumes of the species in the system (in m³/(mol·Pa)).
+    ArrayXd VP0;
+
+    /// The standard molar isobaric heat capacities of the species in the system (in J/(mol·K)).
+    ArrayXd Cp0;
+
+    /// The corrective molar volume of each phase in the system (in m³/mol).
+    ArrayXd Vx;
+
+    /// The derivative of the corrective molar volume of each phase in the system with respect to temperature (in m³/(mol⋅K)).
+    ArrayXd VxT;
+
+    /// The derivative of the corrective molar volume of each phase in the system with respect to pressure (in m³/(mol⋅Pa)).
+    ArrayXd VxP;
+
+    /// The derivatives of the corrective molar volume of each phase in the system with respect to species mole fractions (in m³/mol).
+    ArrayXd Vxi;
+
+    /// The corrective molar Gibbs energy of each phase in the system (in J/mol).
+    ArrayXd Gx;
+
+    /// The corrective molar enthalpy of each phase in the system (in J/mol).
+    ArrayXd Hx;
+
+    /// The corrective molar isobaric heat capacity of each phase in the system (in J/(mol·K)).
+    ArrayXd Cpx;
+
+    /// The activity coefficients (natural log) of the species in the system.
+    ArrayXd ln_g;
+
+    /// The activities (natural log) of the species in the system.
+    ArrayXd ln_a;
+
+    /// The chemical potentials of the species in the system.
+    ArrayXd u;
+};
+
+} // namespace Reaktoro
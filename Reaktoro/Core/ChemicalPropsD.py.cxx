@@ -0,0 +1,84 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include <Reaktoro/pybind11.hxx>
+
+// Reaktoro includes
+#include <Reaktoro/Core/ChemicalProps.hpp>
+#include <Reaktoro/Core/ChemicalPropsD.hpp>
+using namespace Reaktoro;
+
+void exportChemicalPropsD(py::module& m)
+{
+    py::class_<ChemicalPropsD>(m, "ChemicalPropsD")
+        .def(py::init<>())
+        .def(py::init<ChemicalSystem const&>())
+        .def(py::init<ChemicalProps const&>())
+        .def("update", py::overload_cast<ChemicalProps const&>(&ChemicalPropsD::update), "Update the chemical properties of the system with the values of given chemical properties.")
+        .def("update", py::overload_cast<ArrayXdConstRef>(&ChemicalPropsD::update), "Update the chemical properties of the system with serialized data.")
+        .def("system", &ChemicalPropsD::system, return_internal_ref, "Return the chemical system associated with these chemical properties.")
+        .def("temperature", &ChemicalPropsD::temperature, "Return the temperature of the system (in K).")
+        .def("pressure", &ChemicalPropsD::pressure, "Return the pressure of the system (in Pa).")
+        .def("charge", &ChemicalPropsD::charge, "Return the amount of electric charge in the system (in mol).")
+        .def("elementAmount", &ChemicalPropsD::elementAmount, "Return the amount of an element in the system (in mol).")
+        .def("elementAmountInPhase", &ChemicalPropsD::elementAmountInPhase, "Return the amount of an element in a phase of the system (in mol).")
+        .def("elementMass", &ChemicalPropsD::elementMass, "Return the mass of an element in the system (in kg).")
+        .def("elementMassInPhase", &ChemicalPropsD::elementMassInPhase, "Return the mass of an element in a phase of the system (in kg).")
+        .def("elementAmounts", &ChemicalPropsD::elementAmounts, "Return the amounts of the elements in the system (in mol).")
+        .def("componentAmounts", &ChemicalPropsD::componentAmounts, "Return the amounts of the conservative components (elements and charge) in the system (in mol).")
+        .def("speciesAmounts", &ChemicalPropsD::speciesAmounts, "Return the amounts of the species in the system (in mol).")
+        .def("speciesMasses", &ChemicalPropsD::speciesMasses, "Return the masses of the species in the system (in kg).")
+        .def("speciesMoleFractions", &ChemicalPropsD::speciesMoleFractions, "Return the mole fractions of the species in the system.")
+        .def("speciesConcentrationsLn", &ChemicalPropsD::speciesConcentrationsLn, "Return the ln concentrations of the species in the system.")
+        .def("speciesActivityCoefficientsLn", &ChemicalPropsD::speciesActivityCoefficientsLn, "Return the ln activity coefficients of the species in the system.")
+        .def("speciesActivitiesLn", &ChemicalPropsD::speciesActivitiesLn, "Return the ln activities of the species in the system.")
+        .def("speciesChemicalPotentials", &ChemicalPropsD::speciesChemicalPotentials, "Return the chemical potentials of the species in the system (in J/mol).")
+        .def("speciesPartialMolarVolumes", &ChemicalPropsD::speciesPartialMolarVolumes, "Return the partial molar volumes of the species in the system (in m³/mol).")
+        .def("speciesStandardVolumes", &ChemicalPropsD::speciesStandardVolumes, "Return the standard partial molar volumes of the species in the system (in m³/mol).")
+        .def("speciesStandardVolumesT", &ChemicalPropsD::speciesStandardVolumesT, "Return the temperature derivative of the standard partial molar volumes of the species in the system (in m³/(mol·K)).")
+        .def("speciesStandardVolumesP", &ChemicalPropsD::speciesStandardVolumesP, "Return the pressure derivative of the standard partial molar volumes of the species in the system (in m³/(mol·Pa)).")
+        .def("speciesStandardGibbsEnergies", &ChemicalPropsD::speciesStandardGibbsEnergies, "Return the standard partial molar Gibbs energies of formation of the species in the system (in J/mol).")
+        .def("speciesStandardEnthalpies", &ChemicalPropsD::speciesStandardEnthalpies, "Return the standard partial molar enthalpies of formation of the species in the system (in J/mol).")
+        .def("speciesStandardEntropies", &ChemicalPropsD::speciesStandardEntropies, "Return the standard partial molar entropies of formation of the species in the system (in J/(mol·K)).")
+        .def("speciesStandardInternalEnergies", &ChemicalPropsD::speciesStandardInternalEnergies, "Return the standard partial molar internal energies of formation of the species in the system (in J/mol).")
+        .def("speciesStandardHelmholtzEnergies", &ChemicalPropsD::speciesStandardHelmholtzEnergies, "Return the standard partial molar Helmholtz energies of formation of the species in the system (in J/mol).")
+        .def("speciesStandardHeatCapacitiesConstP", &ChemicalPropsD::speciesStandardHeatCapacitiesConstP, "Return the standard partial molar isobaric heat capacities of the species in the system (in J/(mol·K)).")
+        .def("speciesStandardHeatCapacitiesConstV", &ChemicalPropsD::speciesStandardHeatCapacitiesConstV, "Return the standard partial molar isochoric heat capacities of the species in the system (in J/(mol·K)).")
+        .def("phaseAmounts", &ChemicalPropsD::phaseAmounts, "Return the sums of species amounts in each phase of the system (in mol).")
+        .def("phaseMasses", &ChemicalPropsD::phaseMasses, "Return the sums of species masses in each phase of the system (in kg).")
+        .def("phaseVolume", &ChemicalPropsD::phaseVolume, "Return the volume of a phase of the system (in m³).")
+        .def("phaseVolumes", &ChemicalPropsD::phaseVolumes, "Return the volumes of each phase of the system (in m³).")
+        .def("molarVolume", &ChemicalPropsD::molarVolume, "Return the molar volume of the system (in m³/mol).")
+        .def("molarGibbsEnergy", &ChemicalPropsD::molarGibbsEnergy, "Return the molar Gibbs energy of formation of the system (in J/mol).")
+        .def("molarEnthalpy", &ChemicalPropsD::molarEnthalpy, "Return the molar enthalpy of formation of the system (in J/mol).")
+        .def("molarEntropy", &ChemicalPropsD::molarEntropy, "Return the molar entropy of formation of the system (in J/(mol·K)).")
+        .def("molarInternalEnergy", &ChemicalPropsD::molarInternalEnergy, "Return the molar internal energy of formation of the system (in J/mol).")
+        .def("molarHelmholtzEnergy", &ChemicalPropsD::molarHelmholtzEnergy, "Return the molar Helmholtz energy of formation of the system (in J/mol).")
+        .def("molarHeatCapacityConstP", &ChemicalPropsD::molarHeatCapacityConstP, "Return the molar isobaric heat capacity of the system (in J/(mol·K)).")
+        .def("density", &ChemicalPropsD::density, "Return the density of the system (in kg/m³).")
+        .def("amount", &ChemicalPropsD::amount, "Return the sum of species amounts in the system (in mol).")
+        .def("mass", &ChemicalPropsD::mass, "Return the sum of species masses in the system (in kg).")
+        .def("volume", &ChemicalPropsD::volume, "Return the volume of the system (in m³).")
+        .def("gibbsEnergy", &ChemicalPropsD::gibbsEnergy, "Return the Gibbs energy of the system (in J).")
+        .def("enthalpy", &ChemicalPropsD::enthalpy, "Return the enthalpy of the system (in J).")
+        .def("entropy", &ChemicalPropsD::entropy, "Return the entropy of the system (in J/K).")
+        .def("internalEnergy", &ChemicalPropsD::internalEnergy, "Return the internal energy of the system (in J).")
+        .def("helmholtzEnergy", &ChemicalPropsD::helmholtzEnergy, "Return the Helmholtz energy of the system (in J).")
+        .def("heatCapacityConstP", &ChemicalPropsD::heatCapacityConstP, "Return the isobaric heat capacity of the system (in J/K).")
+        ;
+}
@@ -0,0 +1,185 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+// Catch includes
+#include <catch2/catch.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Core/ChemicalProps.hpp>
+#include <Reaktoro/Core/ChemicalPropsD.hpp>
+using namespace Reaktoro;
+
+TEST_CASE("Testing ChemicalPropsD class", "[ChemicalPropsD]")
+{
+    StandardThermoModel standard_thermo_model_gas = [](real T, real P)
+    {
+        StandardThermoProps props;
+        props.G0  = 0.1 * (T*P)*(T*P);
+        props.H0  = 0.2 * (T*P)*(T*P);
+        props.V0  = 0.3 * (T*P)*(T*P);
+        props.VT0 = 0.4 * (T*P)*(T*P);
+        props.VP0 = 0.5 * (T*P)*(T*P);
+        props.Cp0 = 0.6 * (T*P)*(T*P);
+        return props;
+    };
+
+    StandardThermoModel standard_thermo_model_solid = [](real T, real P)
+    {
+        StandardThermoProps props;
+        props.G0  = 1.1 * (T*P)*(T*P);
+        props.H0  = 1.2 * (T*P)*(T*P);
+        props.V0  = 1.3 * (T*P)*(T*P);
+        props.VT0 = 1.4 * (T*P)*(T*P);
+        props.VP0 = 1.5 * (T*P)*(T*P);
+        props.Cp0 = 1.6 * (T*P)*(T*P);
+        return props;
+    };
+
+    ActivityModel activity_model_gas = [](ActivityPropsRef props, ActivityModelArgs args)
+    {
+        const auto [T, P, x] = args;
+        props.Vx  = 1.0 * (T*P)*(T*P);
+        props.VxT = 2.0 * (T*P)*(T*P);
+        props.VxP = 3.0 * (T*P)*(T*P);
+        props.Gx  = 4.0 * (T*P)*(T*P);
+        props.Hx  = 5.0 * (T*P)*(T*P);
+        props.Cpx = 6.0 * (T*P)*(T*P);
+        props.ln_g = 8.0 * x;
+        props.ln_a = 9.0 * x;
+        props.som = StateOfMatter::Gas;
+    };
+
+    ActivityModel activity_model_solid = [](ActivityPropsRef props, ActivityModelArgs args)
+    {
+        const auto [T, P, x] = args;
+        props.Vx  = 1.1 * (T*P)*(T*P);
+        props.VxT = 2.1 * (T*P)*(T*P);
+        props.VxP = 3.1 * (T*P)*(T*P);
+        props.Gx  = 4.1 * (T*P)*(T*P);
+        props.Hx  = 5.1 * (T*P)*(T*P);
+        props.Cpx = 6.1 * (T*P)*(T*P);
+        props.ln_g = 8.1 * x;
+        props.ln_a = 9.1 * x;
+        props.som = StateOfMatter::Solid;
+    };
+
+    Database db;
+
+    db.addSpecies( Species("H2O(g)").withStandardThermoModel(standard_thermo_model_gas) );
+    db.addSpecies( Species("CO2(g)").withStandardThermoModel(standard_thermo_model_gas) );
+    db.addSpecies( Species("CaCO3(s)").withStandardThermoModel(standard_thermo_model_solid) );
+
+    Vec<Phase> phases
+    {
+        Phase()
+            .withName("SomeGas")
+            .withActivityModel(activity_model_gas)
+            .withIdealActivityModel(activity_model_gas)
+            .withStateOfMatter(StateOfMatter::Gas)
+            .withSpecies({
+                db.species().get("H2O(g)"),
+                db.species().get("CO2(g)")}),
+
+        Phase()
+            .withName("SomeSolid")
+            .withActivityModel(activity_model_solid)
+            .withIdealActivityModel(activity_model_solid)
+            .withStateOfMatter(StateOfMatter::Solid)
+            .withSpecies({
+                db.species().get("CaCO3(s)") })
+    };
+
+    ChemicalSystem system(db, phases);
+
+    ChemicalProps props(system);
+
+    real T = 3.0;
+    real P = 5.0;
+    ArrayXr n = ArrayXr{{ 4.0, 6.0, 5.0 }};
+
+    props.update(T, P, n);
+
+    auto checkValues = [&](ChemicalPropsD const& values)
+    {
+        CHECK( values.temperature() == props.temperature().val() );
+        CHECK( values.pressure()    == props.pressure().val()    );
+
+        CHECK( values.speciesAmounts()                     .isApprox(props.speciesAmounts().cast<double>())                      );
+        CHECK( values.speciesMasses()                      .isApprox(props.speciesMasses().cast<double>())                       );
+        CHECK( values.speciesMoleFractions()               .isApprox(props.speciesMoleFractions().cast<double>())                );
+        CHECK( values.speciesActivityCoefficientsLn()      .isApprox(props.speciesActivityCoefficientsLn().cast<double>())       );
+        CHECK( values.speciesActivitiesLn()                .isApprox(props.speciesActivitiesLn().cast<double>())                 );
+        CHECK( values.speciesChemicalPotentials()          .isApprox(props.speciesChemicalPotentials().cast<double>())           );
+        CHECK( values.speciesStandardVolumes()             .isApprox(props.speciesStandardVolumes().cast<double>())              );
+        CHECK( values.speciesStandardGibbsEnergies()       .isApprox(props.speciesStandardGibbsEnergies().cast<double>())        );
+        CHECK( values.speciesStandardEnthalpies()          .isApprox(props.speciesStandardEnthalpies().cast<double>())           );
+        CHECK( values.speciesStandardEntropies()           .isApprox(props.speciesStandardEntropies().cast<double>())            );
+        CHECK( values.speciesStandardInternalEnergies()    .isApprox(props.speciesStandardInternalEnergies().cast<double>())     );
+        CHECK( values.speciesStandardHelmholtzEnergies()   .isApprox(props.speciesStandardHelmholtzEnergies().cast<double>())    );
+        CHECK( values.speciesStandardHeatCapacitiesConstP().isApprox(props.speciesStandardHeatCapacitiesConstP().cast<double>()) );
+        CHECK( values.speciesStandardHeatCapacitiesConstV().isApprox(props.speciesStandardHeatCapacitiesConstV().cast<double>()) );
+        CHECK( values.elementAmounts()                     .isApprox(props.elementAmounts().cast<double>())                      );
+
+        CHECK( values.phaseAmounts()[0] == Approx(props.phaseProps(0).amount()) );
+        CHECK( values.phaseAmounts()[1] == Approx(props.phaseProps(1).amount()) );
+        CHECK( values.phaseVolumes()[0] == Approx(props.phaseProps(0).volume()) );
+        CHECK( values.phaseVolumes()[1] == Approx(props.phaseProps(1).volume()) );
+        CHECK( values.phaseVolume(0)    == Approx(props.phaseProps(0).volume()) );
+        CHECK( values.phaseVolume(1)    == Approx(props.phaseProps(1).volume()) );
+
+        for(auto i = 0; i < system.elements().size(); ++i)
+        {
+            CHECK( values.elementAmount(i) == Approx(props.elementAmount(i)) );
+            CHECK( values.elementMass(i)   == Approx(props.elementMass(i))   );
+            for(auto j = 0; j < system.phases().size(); ++j)
+            {
+                CHECK( values.elementAmountInPhase(i, j) == Approx(props.elementAmountInPhase(i, j)) );
+                CHECK( values.elementMassInPhase(i, j)   == Approx(props.elementMassInPhase(i, j))   );
+            }
+        }
+
+        CHECK( values.molarVolume()             == Approx(props.molarVolume())             );
+        CHECK( values.molarGibbsEnergy()        == Approx(props.molarGibbsEnergy())        );
+        CHECK( values.molarEnthalpy()           == Approx(props.molarEnthalpy())           );
+        CHECK( values.molarEntropy()            == Approx(props.molarEntropy())            );
+        CHECK( values.molarInternalEnergy()     == Approx(props.molarInternalEnergy())     );
+        CHECK( values.molarHelmholtzEnergy()    == Approx(props.molarHelmholtzEnergy())    );
+        CHECK( values.molarHeatCapacityConstP() == Approx(props.molarHeatCapacityConstP()) );
+        CHECK( values.density()                 == Approx(props.density())                 );
+        CHECK( values.amount()                  == Approx(props.amount())                  );
+        CHECK( values.mass()                    == Approx(props.mass())                    );
+        CHECK( values.volume()                  == Approx(props.volume())                  );
+        CHECK( values.gibbsEnergy()             == Approx(props.gibbsEnergy())             );
+        CHECK( values.enthalpy()                == Approx(props.enthalpy())                );
+        CHECK( values.entropy()                 == Approx(props.entropy())                 );
+        CHECK( values.internalEnergy()          == Approx(props.internalEnergy())          );
+        CHECK( values.helmholtzEnergy()         == Approx(props.helmholtzEnergy())         );
+        CHECK( values.heatCapacityConstP()      == Approx(props.heatCapacityConstP())      );
+    };
+
+    SECTION("Testing construction from a ChemicalProps object")
+    {
+        checkValues(ChemicalPropsD(props));
+    }
+
+    SECTION("Testing update with serialized data of a ChemicalProps object")
+    {
+        ChemicalPropsD values(system);
+        values.update(VectorXd(props));
+        checkValues(values);
+    }
+}
@@ -231,6 +231,30 @@ public:
         _update<true>(T, P, n, extra);
     }
 
+    /// Update the chemical properties of the phase, except the standard thermodynamic properties of its species.
+    /// This method assumes the standard thermodynamic properties of the
+    /// species in the phase have already been computed at given temperature
+    /// and pressure (e.g., in ChemicalProps::update for all species in the
+    /// system with FormationReactionGraph::evaluate).
+    /// @param T The temperature condition (in K)
+    /// @param P The pressure condition (in Pa)
+    /// @param n The amounts of the species in the phase (in mol)
+    /// @param extra The extra properties evaluated in the activity models
+    auto updateExceptStandardProps(const real& T, const real& P, ArrayXrConstRef n, Map<String, Any>& extra)
+    {
+        _update<false, false>(T, P, n, extra);
+    }
+
+    /// Update the chemical properties of the phase using ideal activity models, except the standard thermodynamic properties of its species.
+    /// @param T The temperature condition (in K)
+    /// @param P The pressure condition (in Pa)
+    /// @param n The amounts of the species in the phase (in mol)
+    /// @param extra The extra properties evaluated in the activity models
+    auto updateIdealExceptStandardProps(const real& T, const real& P, ArrayXrConstRef n, Map<String, Any>& extra)
+    {
+        _update<true, false>(T, P, n, extra);
+    }
+
     /// Update the chemical properties of the phase with given data.
     auto updateWithData(const ChemicalPropsPhaseBaseData<TypeOp>& data)
     {
@@ -623,7 +647,7 @@ private:
     /// @param P The pressure condition (in Pa)
     /// @param n The amounts of the species in the phase (in mol)
     /// @param extra The extra data mapped to activity mode
-    template<bool use_ideal_activity_model>
+    template<bool use_ideal_activity_model, bool update_standard_props = true>
     auto _update(const real& T, const real& P, ArrayXrConstRef n, Map<String, Any>& extra)
     {
         mdata.T = T;
@@ -668,17 +692,20 @@ private:
         assert(    u.size() == N );
         assert(   Vxi.size() == N );
 
-        // Compute the standard thermodynamic properties of the species in the phase.
-        StandardThermoProps aux;
-        for(auto i = 0; i < N; ++i)
+        // Compute the standard thermodynamic properties of the species in the phase (unless already computed).
+        if constexpr(update_standard_props)
         {
-            aux = species[i].standardThermoProps(T, P);
-            G0[i]  = aux.G0;
-            H0[i]  = aux.H0;
-            V0[i]  = aux.V0;
-            VT0[i] = aux.VT0;
-            VP0[i] = aux.VP0;
-            Cp0[i] = aux.Cp0;
+            StandardThermoProps aux;
+            for(auto i = 0; i < N; ++i)
+            {
+                aux = species[i].standardThermoProps(T, P);
+                G0[i]  = aux.G0;
+                H0[i]  = aux.H0;
+                V0[i]  = aux.V0;
+                VT0[i] = aux.VT0;
+                VP0[i] = aux.VP0;
+                Cp0[i] = aux.Cp0;
+            }
         }
 
         // Compute the amount of the phase
@@ -1,160 +1,146 @@
-// // Reaktoro is a unified framework for modeling chemically reactive systems.
-// //
-// // Copyright © 2014-2022 Allan Leal
-// //
-// // This library is free software; you can redistribute it and/or
-// // modify it under the terms of the GNU Lesser General Public
-// // License as published by the Free Software Foundation; either
-// // version 2.1 of the License, or (at your option) any later version.
-// //
-// // This library is distributed in the hope that it will be useful,
-// // but WITHOUT ANY WARRANTY; without even the implied warranty of
-// // MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
-// // Lesser General Public License for more details.
-// //
-// // You should have received a copy of the GNU Lesser General Public License
-// // along with this library. If not, see <http://www.gnu.org/licenses/>.
-
-// #pragma once
-
-// // C++ includes
-// #include <memory>
-// #include <string>
-
-// // Reaktoro includes
-// #include <Reaktoro/Common/Index.hpp>
-// #include <Reaktoro/Common/Matrix.hpp>
-// #include <Reaktoro/Common/Real.hpp>
-
-// namespace Reaktoro {
-
-// // Forward declarations
-// class ChemicalProps;
-// class ChemicalState;
-// class ChemicalSystem;
-// class ReactionSystem;
-
-// /// A class that provides a convenient way to retrieve chemical quantities.
-// /// Here the term chemical quantity is used in a broad sense. It means any
-// /// quantity for an element, species, or phase in a chemical system that
-// /// can be calculated at a chemical state whose temperature, pressure, and
-// /// mole amounts of all species are known.
-// ///
-// /// In the example below, the volume of a phase named Gaseous and the pH
-// /// of the aqueous phase (assuming both phases were defined in the chemical
-// /// system) are retrieved:
-// ///
-// /// ~~~
-// /// ChemicalQuantity q(state);
-// ///
-// /// const double vol = q["phaseVolume(Gaseous)"];
-// /// const double pH = q["pH"];
-// /// ~~~
-// ///
-// /// The table below shows all possible quantities that can be retrieved from
-// /// a ChemicalQuantity instance. The first column, **Quantity**, lists the
-// /// names of the quantities; the second column, **Units**, lists the default
-// /// units of the quantity; and the third column, **Example**, lists the
-// /// formatted strings needed to retrieve a quantity.
-// ///
-// /// | Quantity                 | Units  | Example                                    |
-// /// | --------                 | -----  | -------                                    |
-// /// | temperature              | kelvin | `"temperature(units=celsius)"`             |
-// /// | pressure                 | pascal | `"pressure(units=bar)"`                    |
-// /// | volume                   | m3     | `"volume(units=cm3)"`                      |
-// /// | activity                 | ---    | `"activity(CO2(aq))"`                      |
-// /// | activityCoefficient      | ---    | `"activityCoefficient(Na+)"`               |
-// /// | fugacity                 | bar    | `"fugacity(CO2(g))"`                       |
-// /// | chemicalPotential        | J/mol  | `"chemicalPotential(Cl-)"`                 |
-// /// | elementAmount            | mol    | `"elementAmount(Ca)"`                      |
-// /// | elementAmountInPhase     | mol    | `"elementAmountInPhase(Mg Aqueous)"`       |
-// /// | elementMass              | kg     | `"elementMass(Fe units=g)"`                |
-// /// | elementMassInPhase       | kg     | `"elementMassInPhase(C Gaseous)"`          |
-// /// | elementMolality          | molal  | `"elementMolality(Cl units=mmolal)"`       |
-// /// | elementMolarity          | molar  | `"elementMolarity(K units=mmolar)"`        |
-// /// | speciesAmount            | mol    | `"speciesAmount(H2O(l))"`                  |
-// /// | speciesMass              | kg     | `"speciesMass(Calcite units=g)"`           |
-// /// | speciesMoleFraction      | ---    | `"speciesMoleFraction(HCO3-)"`             |
-// /// | speciesMolality          | molal  | `"speciesMolality(Ca++)"`                  |
-// /// | speciesMolarity          | molar  | `"speciesMolarity(Mg++)"`                  |
-// /// | phaseAmount              | mol    | `"phaseAmount(Aqueous)"`                   |
-// /// | phaseMass                | kg     | `"phaseMass(Dolomite)"`                    |
-// /// | phaseVolume              | m3     | `"phaseVolume(Gaseous)"`                   |
-// /// | pH                       | ---    | `"pH"`                                     |
-// /// | pE                       | ---    | `"pE"`                                     |
-// /// | Eh                       | volt   | `"Eh"`                                     |
-// /// | ionicStrength            | molal  | `"ionicStrength"`                          |
-// /// | fluidVolume              | m3     | `"fluidVolume(units=liter)"`               |
-// /// | fluidVolumeFraction      | ---    | `"fluidVolumeFraction"`                    |
-// /// | solidVolume              | m3     | `"solidVolume(units=mm3)"`                 |
-// /// | solidVolumeFraction      | ---    | `"solidVolumeFraction"`                    |
-// /// | reactionRate             | mol/s  | `"reactionRate(Dolomite units=mmol/hour)"` |
-// /// | reactionEquilibriumIndex | ---    | `"reactionEquilibriumIndex(Quartz)"`       |
-// /// | tag                      | ---    | `"tag"`                                    |
-// /// | t                        | s      | `"t(units=minute)"`                        |
-// /// | time                     | s      | `"time(units=year)"`                       |
-// /// | progress                 | ---    | `"progress"`                               |
-// ///
-// class ChemicalQuantity
-// {
-// public:
-//     /// A type to describe a chemical quantity function.
-//     using Function = std::function<double()>;
-
-//     /// Disable the default ChemicalQuantity constructor.
-//     /// This is to enforce the initialization of ChemicalQuantity
-//     /// instance with a ChemicalSystem instance.
-//     ChemicalQuantity() = delete;
-
-//     /// Construct a ChemicalQuantity instance from a ChemicalSystem object.
-//     explicit ChemicalQuantity(const ChemicalSystem& system);
-
-//     /// Construct a ChemicalQuantity instance from a ReactionSystem object.
-//     explicit ChemicalQuantity(const ReactionSystem& reactions);
-
-//     /// Construct a ChemicalQuantity instance from a ChemicalState object.
-//     explicit ChemicalQuantity(const ChemicalState& state);
-
-//     /// Destroy this ChemicalQuantity instance.
-//     virtual ~ChemicalQuantity() = default;
-
-//     /// Return the chemical system of the ChemicalQuantity instance.
-//     auto system() const -> const ChemicalSystem&;
-
-//     /// Return the chemical reactions of the ChemicalQuantity instance.
-//     auto reactions() const -> const ReactionSystem&;
-
-//     /// Return the chemical state of the ChemicalQuantity instance.
-//     auto state() const -> const ChemicalState&;
-
-//     /// Return the chemical properties of the ChemicalQuantity instance.
-//     auto props() const -> const ChemicalProps&;
-
-//     /// Return the reaction rates of the ChemicalQuantity instance.
-//     auto rates() const -> const VectorXr&;
-
-//     /// Return the tag variable of the ChemicalQuantity instance.
-//     auto tag() const -> double;
-
-//     /// Update the state of this ChemicalQuantity instance.
-//     auto update(const ChemicalState& state) -> ChemicalQuantity&;
-
-//     /// Update the state of this ChemicalQuantity instance.
-//     auto update(const ChemicalState& state, double t) -> ChemicalQuantity&;
-
-//     /// Return the value of the quantity given as a formatted string.
-//     auto value(std::string str) const -> double;
-
-//     /// Return a created function that calculates the chemical quantity from a formatted string.
-//     auto function(std::string str) const -> Function;
-
-//     /// Return the value of the quantity given as a formatted string.
-//     auto operator()(std::string str) const -> double;
-
-// private:
-//     struct Impl;
-
-//     std::shared_ptr<Impl> pimpl;
-// };
-
-// } // namespace Reaktoro
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Reaktoro includes
+#include <Reaktoro/Common/Types.hpp>
+
+namespace Reaktoro {
+
+// Forward declarations
+class ChemicalProps;
+class ChemicalPropsD;
+class ChemicalState;
+class ChemicalSystem;
+
+/// A class that provides a convenient way to retrieve chemical quantities.
+/// Here the term chemical quantity is used in a broad sense. It means any
+/// quantity for an element, species, or phase in a chemical system that
+/// can be calculated at a chemical state whose temperature, pressure, and
+/// amounts of all species are known.
+///
+/// Quantities are given as formatted strings (e.g., `"pH"`,
+/// `"speciesAmount(Calcite)"`, `"elementMolality(Ca units=mmolal)"`).
+/// These strings are parsed only once by method @ref function, which returns
+/// a compiled function in which the names of species, elements and phases
+/// have been resolved to indices and the unit conversion has been reduced to
+/// a linear transformation. This function can then be evaluated very
+/// efficiently after every call to @ref update.
+///
+/// ~~~
+/// ChemicalQuantity quantity(system);
+///
+/// auto pH = quantity.function("pH");
+/// auto nCalcite = quantity.function("speciesAmount(Calcite units=mmol)");
+///
+/// quantity.update(state);
+///
+/// const double pHval = pH();
+/// const double nCalciteVal = nCalcite();
+/// ~~~
+///
+/// The table below shows all possible quantities that can be retrieved from
+/// a ChemicalQuantity object. The first column, **Quantity**, lists the
+/// names of the quantities; the second column, **Units**, lists the default
+/// units of the quantity; and the third column, **Example**, lists the
+/// formatted strings needed to retrieve a quantity.
+///
+/// | Quantity                 | Units  | Example                                    |
+/// | --------                 | -----  | -------                                    |
+/// | temperature              | K      | `"temperature(units=celsius)"`             |
+/// | pressure                 | Pa     | `"pressure(units=bar)"`                    |
+/// | volume                   | m3     | `"volume(units=cm3)"`                      |
+/// | amount                   | mol    | `"amount"`                                 |
+/// | mass                     | kg     | `"mass(units=g)"`                          |
+/// | activity                 | ---    | `"activity(CO2(aq))"`                      |
+/// | activityCoefficient      | ---    | `"activityCoefficient(Na+)"`               |
+/// | fugacity                 | bar    | `"fugacity(CO2(g))"`                       |
+/// | chemicalPotential        | J/mol  | `"chemicalPotential(Cl-)"`                 |
+/// | elementAmount            | mol    | `"elementAmount(Ca)"`                      |
+/// | elementAmountInPhase     | mol    | `"elementAmountInPhase(Mg AqueousPhase)"`  |
+/// | elementMass              | kg     | `"elementMass(Fe units=g)"`                |
+/// | elementMassInPhase       | kg     | `"elementMassInPhase(C GaseousPhase)"`     |
+/// | elementMolality          | molal  | `"elementMolality(Cl units=mmolal)"`       |
+/// | speciesAmount            | mol    | `"speciesAmount(H2O(aq))"`                 |
+/// | speciesMass              | kg     | `"speciesMass(Calcite units=g)"`           |
+/// | speciesMoleFraction      | ---    | `"speciesMoleFraction(HCO3-)"`             |
+/// | speciesMolality          | molal  | `"speciesMolality(Ca+2)"`                  |
+/// | phaseAmount              | mol    | `"phaseAmount(AqueousPhase)"`              |
+/// | phaseMass                | kg     | `"phaseMass(Calcite)"`                     |
+/// | phaseVolume              | m3     | `"phaseVolume(GaseousPhase)"`              |
+/// | pH                       | ---    | `"pH"`                                     |
+/// | ionicStrength            | molal  | `"ionicStrength"`                          |
+/// | t                        | s      | `"t(units=minute)"`                        |
+/// | time                     | s      | `"time(units=year)"`                       |
+/// | tag                      | ---    | `"tag"`                                    |
+/// | progress                 | ---    | `"progress"`                               |
+///
+/// The names of the quantities are case insensitive, and the prefix
+/// `species` can be omitted in `activity`, `activityCoefficient`,
+/// `chemicalPotential` and `moleFraction`. The quantities `t`, `time`,
+/// `tag` and `progress` all return the tag value given in method @ref
+/// update (e.g., the time in a kinetic or transport simulation).
+class ChemicalQuantity
+{
+public:
+    /// A type to describe a compiled chemical quantity function.
+    using Function = Fn<double()>;
+
+    /// Construct a ChemicalQuantity object with given chemical system.
+    explicit ChemicalQuantity(ChemicalSystem const& system);
+
+    /// Construct a ChemicalQuantity object with given chemical state.
+    explicit ChemicalQuantity(ChemicalState const& state);
+
+    /// Return the chemical system of the ChemicalQuantity object.
+    auto system() const -> ChemicalSystem const&;
+
+    /// Return the chemical properties of the ChemicalQuantity object (in double precision).
+    auto props() const -> ChemicalPropsD const&;
+
+    /// Return the tag variable of the ChemicalQuantity object.
+    auto tag() const -> double;
+
+    /// Update the state of this ChemicalQuantity object.
+    auto update(ChemicalState const& state) -> ChemicalQuantity&;
+
+    /// Update the state of this ChemicalQuantity object with given tag value (e.g., time).
+    auto update(ChemicalState const& state, double t) -> ChemicalQuantity&;
+
+    /// Update the state of this ChemicalQuantity object with given chemical properties and tag value (e.g., time).
+    auto update(ChemicalProps const& props, double t) -> ChemicalQuantity&;
+
+    /// Return the value of the quantity given as a formatted string.
+    auto value(String const& str) const -> double;
+
+    /// Return a compiled function that calculates the chemical quantity from a formatted string.
+    /// The returned function evaluates the quantity at the chemical state
+    /// given in the last call to @ref update. It remains valid as long as
+    /// this ChemicalQuantity object (or a copy of it) exists.
+    auto function(String const& str) const -> Function;
+
+    /// Return the value of the quantity given as a formatted string.
+    auto operator()(String const& str) const -> double;
+
+private:
+    struct Impl;
+
+    SharedPtr<Impl> pimpl;
+};
+
+} // namespace Reaktoro
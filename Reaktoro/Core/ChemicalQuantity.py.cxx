@@ -0,0 +1,44 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include <Reaktoro/pybind11.hxx>
+
+// Reaktoro includes
+#include <Reaktoro/Core/ChemicalProps.hpp>
+#include <Reaktoro/Core/ChemicalPropsD.hpp>
+#include <Reaktoro/Core/ChemicalQuantity.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+using namespace Reaktoro;
+
+void exportChemicalQuantity(py::module& m)
+{
+    py::class_<ChemicalQuantity>(m, "ChemicalQuantity")
+        .def(py::init<ChemicalSystem const&>())
+        .def(py::init<ChemicalState const&>())
+        .def("system", &ChemicalQuantity::system, return_internal_ref, "Return the chemical system of the ChemicalQuantity object.")
+        .def("props", &ChemicalQuantity::props, return_internal_ref, "Return the chemical properties of the ChemicalQuantity object.")
+        .def("tag", &ChemicalQuantity::tag, "Return the tag variable of the ChemicalQuantity object.")
+        .def("update", py::overload_cast<ChemicalState const&>(&ChemicalQuantity::update), return_internal_ref, "Update the state of this ChemicalQuantity object.")
+        .def("update", py::overload_cast<ChemicalState const&, double>(&ChemicalQuantity::update), return_internal_ref, "Update the state of this ChemicalQuantity object with given tag value (e.g., time).")
+        .def("update", py::overload_cast<ChemicalProps const&, double>(&ChemicalQuantity::update), return_internal_ref, "Update the state of this ChemicalQuantity object with given chemical properties and tag value (e.g., time).")
+        .def("value", &ChemicalQuantity::value, "Return the value of the quantity given as a formatted string.")
+        .def("function", &ChemicalQuantity::function, "Return a compiled function that calculates the chemical quantity from a formatted string.")
+        .def("__call__", &ChemicalQuantity::operator(), "Return the value of the quantity given as a formatted string.")
+        ;
+}
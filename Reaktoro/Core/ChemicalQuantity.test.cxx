@@ -0,0 +1,85 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+// Catch includes
+#include <catch2/catch.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Core/ChemicalProps.hpp>
+#include <Reaktoro/Core/ChemicalQuantity.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+using namespace Reaktoro;
+
+namespace test {
+
+/// Return a mock ChemicalSystem object for test reasons.
+auto createChemicalSystem() -> ChemicalSystem;
+
+} // namespace test
+
+TEST_CASE("Testing ChemicalQuantity class", "[ChemicalQuantity]")
+{
+    ChemicalSystem system = test::createChemicalSystem();
+
+    ChemicalState state(system);
+    state.temperature(60.0, "celsius");
+    state.pressure(10.0, "bar");
+    state.setSpeciesAmounts(1.0);
+    state.set("H2O(aq)", 55.0, "mol");
+    state.set("Ca++(aq)", 0.2, "mol");
+
+    ChemicalProps const& props = state.props();
+
+    ChemicalQuantity quantity(system);
+    quantity.update(state, 120.0);
+
+    const auto iH2O = system.species().index("H2O(aq)");
+    const auto kgH2O = props.speciesMass(iH2O);
+
+    CHECK( quantity("temperature") == Approx(333.15) );
+    CHECK( quantity("temperature(units=celsius)") == Approx(60.0) );
+    CHECK( quantity("pressure(units=bar)") == Approx(10.0) );
+    CHECK( quantity("volume") == Approx(props.volume()) );
+    CHECK( quantity("speciesAmount(Ca++(aq))") == Approx(0.2) );
+    CHECK( quantity("speciesAmount(Ca++(aq) units=mmol)") == Approx(200.0) );
+    CHECK( quantity("speciesMass(CaCO3(s))") == Approx(props.speciesMass("CaCO3(s)")) );
+    CHECK( quantity("speciesMolality(Ca++(aq))") == Approx(0.2 / kgH2O) );
+    CHECK( quantity("chemicalPotential(CO2(aq))") == Approx(props.speciesChemicalPotential("CO2(aq)")) );
+    CHECK( quantity("activity(CO2(aq))") == Approx(props.speciesActivity("CO2(aq)")) );
+    CHECK( quantity("elementAmount(Ca)") == Approx(props.elementAmount("Ca")) );
+    CHECK( quantity("elementAmountInPhase(C AqueousPhase)") == Approx(props.elementAmountInPhase("C", "AqueousPhase")) );
+    CHECK( quantity("elementMolality(Ca units=mmolal)") == Approx(1e3 * props.elementAmountInPhase("Ca", "AqueousPhase") / kgH2O) );
+    CHECK( quantity("phaseAmount(Calcite)") == Approx(1.0) );
+    CHECK( quantity("phaseVolume(GaseousPhase)") == Approx(props.phaseProps("GaseousPhase").volume()) );
+    CHECK( quantity("pH") == Approx(-props.speciesActivityLg("H+(aq)")) );
+    CHECK( quantity("t(units=minute)") == Approx(2.0) );
+    CHECK( quantity("progress") == Approx(120.0) );
+
+    // Check compiled functions are evaluated at the chemical state of the last update
+    auto nCa = quantity.function("speciesAmount(Ca++(aq))");
+
+    state.set("Ca++(aq)", 0.5, "mol");
+    quantity.update(state);
+
+    CHECK( nCa() == Approx(0.5) );
+
+    CHECK_THROWS( quantity("speciesAmount(Ca++(aq) Mg++(aq))") );
+    CHECK_THROWS( quantity("speciesAmount(Unknown)") );
+    CHECK_THROWS( quantity("unknownQuantity") );
+    CHECK_THROWS( quantity("pH(units=mol)") );
+}
@@ -75,6 +75,9 @@ struct ChemicalSystem::Impl
     /// The stoichiometric matrix of the reactions in the system with respect to its species.
     MatrixXd stoichiometric_matrix;
 
+    /// The dependency graph of the formation reactions of the species in the system.
+    FormationReactionGraph formation_reaction_graph;
+
     /// Construct a default ChemicalSystem::Impl object.
     Impl()
     {}
@@ -113,6 +116,8 @@ struct ChemicalSystem::Impl
         detail::fixDuplicateNames(species);
         detail::fixDuplicateNames(reactions);
         detail::fixDuplicateNames(surfaces);
+
+        formation_reaction_graph = FormationReactionGraph(species);
     }
 
     /// Construct a ChemicalSystem::Impl object with given database, phases, reactions, and surfaces.
@@ -256,6 +261,11 @@ auto ChemicalSystem::stoichiometricMatrix() const -> MatrixXdConstRef
     return pimpl->stoichiometric_matrix;
 }
 
+auto ChemicalSystem::formationReactionGraph() const -> FormationReactionGraph const&
+{
+    return pimpl->formation_reaction_graph;
+}
+
 auto operator<<(std::ostream& out, ChemicalSystem const& system) -> std::ostream&
 {
     // auto const& phases = system.phases();
@@ -25,6 +25,7 @@
 #include <Reaktoro/Core/Database.hpp>
 #include <Reaktoro/Core/Element.hpp>
 #include <Reaktoro/Core/ElementList.hpp>
+#include <Reaktoro/Core/FormationReactionGraph.hpp>
 #include <Reaktoro/Core/Phase.hpp>
 #include <Reaktoro/Core/PhaseList.hpp>
 #include <Reaktoro/Core/Phases.hpp>
@@ -155,6 +156,12 @@ public:
     /// is given by the coefficient of the *i*th species in the *j*th reaction.
     auto stoichiometricMatrix() const -> MatrixXdConstRef;
 
+    /// Return the dependency graph of the formation reactions of the species in the system.
+    /// This graph is used to evaluate the standard thermodynamic properties
+    /// of all species in the system at once, so that the properties of
+    /// species shared as reactants in formation reactions are computed only once.
+    auto formationReactionGraph() const -> FormationReactionGraph const&;
+
 private:
     struct Impl;
 
@@ -96,5 +96,6 @@ void exportChemicalSystem(py::module& m)
         .def("formulaMatrixElements", &ChemicalSystem::formulaMatrixElements, return_internal_ref)
         .def("formulaMatrixCharge", &ChemicalSystem::formulaMatrixCharge, return_internal_ref)
         .def("stoichiometricMatrix", &ChemicalSystem::stoichiometricMatrix, return_internal_ref)
+        .def("formationReactionGraph", &ChemicalSystem::formationReactionGraph, return_internal_ref)
         ;
 }
@@ -0,0 +1,332 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "FormationReactionGraph.hpp"
+
+// Reaktoro includes
+#include <Reaktoro/Common/Algorithms.hpp>
+#include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Common/Memoization.hpp>
+#include <Reaktoro/Core/FormationReaction.hpp>
+
+namespace Reaktoro {
+namespace detail {
+
+/// Return the key used to identify a species in the graph with a reactant species in a formation reaction.
+/// The key combines the name of the species (without the suffixes `!` appended
+/// to duplicate names in a chemical system), its chemical formula and its
+/// aggregate state. This way, a reactant species such as `CO2` in gaseous state
+/// is identified with the species renamed to `CO2!` in the system, and not
+/// with the aqueous species `CO2` that happens to keep the original name.
+auto formationReactionGraphNodeKey(Species const& species) -> String
+{
+    auto name = species.name();
+    name.erase(name.find_last_not_of('!') + 1);
+    return name + "\n" + species.formula().str() + "\n" + std::to_string(static_cast<int>(species.aggregateState()));
+}
+
+/// The cached standard thermodynamic properties of all nodes evaluated in the last call in a thread.
+struct FormationReactionGraphEntry
+{
+    real T;         ///< The temperature used in the last evaluation.
+    real P;         ///< The pressure used in the last evaluation.
+    ArrayXr w;      ///< The values of the parameters used in the last evaluation.
+    ArrayXr G0;     ///< The standard molar Gibbs energies of all nodes.
+    ArrayXr H0;     ///< The standard molar enthalpies of all nodes.
+    ArrayXr V0;     ///< The standard molar volumes of all nodes.
+    ArrayXr VT0;    ///< The temperature derivative of the standard molar volumes of all nodes.
+    ArrayXr VP0;    ///< The pressure derivative of the standard molar volumes of all nodes.
+    ArrayXr Cp0;    ///< The standard molar isobaric heat capacities of all nodes.
+    bool empty = true; ///< True if no evaluation has been cached yet.
+};
+
+} // namespace detail
+
+struct FormationReactionGraph::Impl
+{
+    /// The number of species in the chemical system.
+    Index numspecies = 0;
+
+    /// The species in the nodes of the graph (the species in the system followed by the reactant species not in the system).
+    Vec<Species> nodes;
+
+    /// The indices of the nodes in the order they are evaluated.
+    Indices order;
+
+    /// The flags indicating whether each node is evaluated with its formation reaction.
+    Vec<bool> isproduct;
+
+    /// The row offsets of each node in the compressed sparse rows of reactant coefficients.
+    Indices rowptr;
+
+    /// The reactant nodes in the compressed sparse rows of reactant coefficients.
+    Indices colidx;
+
+    /// The stoichiometric coefficients in the compressed sparse rows of reactant coefficients.
+    Vec<double> coeffs;
+
+    /// The Param objects in the standard thermodynamic models of all nodes.
+    Vec<Param> params;
+
+    /// Construct a default FormationReactionGraph::Impl object.
+    Impl()
+    {}
+
+    /// Construct a FormationReactionGraph::Impl object with given species.
+    Impl(SpeciesList const& species)
+    {
+        numspecies = species.size();
+
+        nodes = Vec<Species>(species.begin(), species.end());
+
+        Map<String, Index> nodeidx; // the first node with a given key is used if several species in the system share it
+        for(auto i = 0; i < numspecies; ++i)
+            nodeidx.emplace(detail::formationReactionGraphNodeKey(nodes[i]), i);
+
+        // Collect the reactant species not in the system (along with their reactants, recursively).
+        for(auto i = 0; i < nodes.size(); ++i)
+        {
+            if(!nodes[i].usesFormationReaction())
+                continue;
+            const auto reactants = nodes[i].reaction().reactants(); // copy because nodes may be resized below
+            for(auto const& [reactant, coeff] : reactants)
+            {
+                const auto key = detail::formationReactionGraphNodeKey(reactant);
+                if(nodeidx.find(key) != nodeidx.end())
+                    continue;
+                nodeidx.emplace(key, nodes.size());
+                nodes.push_back(reactant);
+            }
+        }
+
+        const auto numnodes = nodes.size();
+
+        isproduct.resize(numnodes);
+        rowptr.resize(numnodes + 1);
+        rowptr[0] = 0;
+
+        for(auto i = 0; i < numnodes; ++i)
+        {
+            isproduct[i] = nodes[i].usesFormationReaction();
+            if(isproduct[i])
+            {
+                for(auto const& [reactant, coeff] : nodes[i].reaction().reactants())
+                {
+                    colidx.push_back(nodeidx.at(detail::formationReactionGraphNodeKey(reactant)));
+                    coeffs.push_back(coeff);
+                }
+            }
+            rowptr[i + 1] = colidx.size();
+        }
+
+        // Determine the topological order of the nodes using depth-first search.
+        enum class Mark { None, Visiting, Done };
+        Vec<Mark> marks(numnodes, Mark::None);
+
+        Fn<void(Index)> visit = [&](Index i)
+        {
+            if(marks[i] == Mark::Done)
+                return;
+            errorif(marks[i] == Mark::Visiting, "Could not construct the graph of formation reactions of the species. "
+                "The formation reaction of species ", nodes[i].name(), " depends on itself, directly or through other species.");
+            marks[i] = Mark::Visiting;
+            for(auto k = rowptr[i]; k < rowptr[i + 1]; ++k)
+                visit(colidx[k]);
+            marks[i] = Mark::Done;
+            order.push_back(i);
+        };
+
+        for(auto i = 0; i < numnodes; ++i)
+            visit(i);
+
+        // Collect the Param objects in the models used to evaluate each node.
+        for(auto i = 0; i < numnodes; ++i)
+        {
+            auto const& reaction = nodes[i].reaction();
+            auto const& nodeparams = isproduct[i] ?
+                concatenate(reaction.reactionThermoModel().params(), reaction.productStandardVolumeModel().params()) :
+                nodes[i].standardThermoModel().params();
+            params.insert(params.end(), nodeparams.begin(), nodeparams.end());
+        }
+    }
+
+    /// Compute the standard thermodynamic properties of all nodes in the graph.
+    auto compute(detail::FormationReactionGraphEntry& entry, real const& T, real const& P) const -> void
+    {
+        const auto numnodes = nodes.size();
+
+        auto& G0  = entry.G0;
+        auto& H0  = entry.H0;
+        auto& V0  = entry.V0;
+        auto& VT0 = entry.VT0;
+        auto& VP0 = entry.VP0;
+        auto& Cp0 = entry.Cp0;
+
+        G0.resize(numnodes);
+        H0.resize(numnodes);
+        V0.resize(numnodes);
+        VT0.resize(numnodes);
+        VP0.resize(numnodes);
+        Cp0.resize(numnodes);
+
+        StandardThermoProps props;
+        ReactionStandardThermoProps rxnprops;
+
+        for(auto i : order)
+        {
+            if(!isproduct[i])
+            {
+                props = nodes[i].standardThermoProps(T, P);
+                G0[i]  = props.G0;
+                H0[i]  = props.H0;
+                V0[i]  = props.V0;
+                VT0[i] = props.VT0;
+                VP0[i] = props.VP0;
+                Cp0[i] = props.Cp0;
+                continue;
+            }
+
+            auto const& reaction = nodes[i].reaction();
+            auto const& std_volume_model = reaction.productStandardVolumeModel();
+
+            // Compute the standard molar volume of the product species and the standard molar volume change of the reaction
+            const auto V0p = std_volume_model ? std_volume_model(T, P) : real{0.0};
+            auto dV0 = V0p;
+            for(auto k = rowptr[i]; k < rowptr[i + 1]; ++k)
+                dV0 -= coeffs[k] * V0[colidx[k]]; // coeff is positve for left-hand side reactant, negative for right-hand side
+
+            // Compute the rest of the standard thermodynamic properties of the reaction
+            reaction.reactionThermoModel().apply(rxnprops, {T, P, dV0});
+
+            // Compute the standard thermodynamic properties of the product species from those of its reactants (already computed)
+            G0[i]  = rxnprops.dG0;  // G0  = ΔG0  + sum(vr * G0r)
+            H0[i]  = rxnprops.dH0;  // H0  = ΔH0  + sum(vr * H0r)
+            V0[i]  = V0p;
+            VT0[i] = 0.0;
+            VP0[i] = 0.0;
+            Cp0[i] = rxnprops.dCp0; // Cp0 = ΔCp0 + sum(vr * Cp0r)
+            for(auto k = rowptr[i]; k < rowptr[i + 1]; ++k)
+            {
+                const auto j = colidx[k];
+                G0[i]  += coeffs[k] * G0[j];
+                H0[i]  += coeffs[k] * H0[j];
+                Cp0[i] += coeffs[k] * Cp0[j];
+            }
+        }
+    }
+
+    /// Evaluate the standard thermodynamic properties of the species in the system.
+    auto evaluate(SharedPtr<const void> const& owner, real const& T, real const& P, ArrayXrRef G0, ArrayXrRef H0, ArrayXrRef V0, ArrayXrRef VT0, ArrayXrRef VP0, ArrayXrRef Cp0) const -> void
+    {
+        const auto N = numspecies;
+
+        assert(  G0.size() == N );
+        assert(  H0.size() == N );
+        assert(  V0.size() == N );
+        assert( VT0.size() == N );
+        assert( VP0.size() == N );
+        assert( Cp0.size() == N );
+
+        auto assign = [&](detail::FormationReactionGraphEntry const& entry)
+        {
+            G0  = entry.G0.head(N);
+            H0  = entry.H0.head(N);
+            V0  = entry.V0.head(N);
+            VT0 = entry.VT0.head(N);
+            VP0 = entry.VP0.head(N);
+            Cp0 = entry.Cp0.head(N);
+        };
+
+        if(Memoization::isDisabled())
+        {
+            detail::FormationReactionGraphEntry entry;
+            compute(entry, T, P);
+            assign(entry);
+            return;
+        }
+
+        auto& entry = detail::threadLocalEntry<detail::FormationReactionGraphEntry>(owner);
+
+        const auto numparams = params.size();
+
+        auto sameparams = entry.w.size() == numparams;
+        for(auto i = 0; sameparams && i < numparams; ++i)
+            sameparams = entry.w[i] == params[i].value();
+
+        if(!entry.empty && entry.T == T && entry.P == P && sameparams)
+            return assign(entry);
+
+        entry.empty = true; // in case compute throws below
+        compute(entry, T, P);
+        entry.T = T;
+        entry.P = P;
+        entry.w.resize(numparams);
+        for(auto i = 0; i < numparams; ++i)
+            entry.w[i] = params[i].value();
+        entry.empty = false;
+
+        assign(entry);
+    }
+};
+
+FormationReactionGraph::FormationReactionGraph()
+: pimpl(new Impl())
+{}
+
+FormationReactionGraph::FormationReactionGraph(SpeciesList const& species)
+: pimpl(new Impl(species))
+{}
+
+auto FormationReactionGraph::numSpecies() const -> Index
+{
+    return pimpl->numspecies;
+}
+
+auto FormationReactionGraph::numNodes() const -> Index
+{
+    return pimpl->nodes.size();
+}
+
+auto FormationReactionGraph::nodes() const -> Vec<Species> const&
+{
+    return pimpl->nodes;
+}
+
+auto FormationReactionGraph::order() const -> Indices const&
+{
+    return pimpl->order;
+}
+
+auto FormationReactionGraph::reactants(Index inode) const -> Indices
+{
+    assert(inode < numNodes());
+    const auto begin = pimpl->colidx.begin() + pimpl->rowptr[inode];
+    const auto end = pimpl->colidx.begin() + pimpl->rowptr[inode + 1];
+    return Indices(begin, end);
+}
+
+auto FormationReactionGraph::params() const -> Vec<Param> const&
+{
+    return pimpl->params;
+}
+
+auto FormationReactionGraph::evaluate(real const& T, real const& P, ArrayXrRef G0, ArrayXrRef H0, ArrayXrRef V0, ArrayXrRef VT0, ArrayXrRef VP0, ArrayXrRef Cp0) const -> void
+{
+    pimpl->evaluate(pimpl, T, P, G0, H0, V0, VT0, VP0, Cp0);
+}
+
+} // namespace Reaktoro
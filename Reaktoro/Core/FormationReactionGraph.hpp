@@ -0,0 +1,90 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Reaktoro includes
+#include <Reaktoro/Common/Matrix.hpp>
+#include <Reaktoro/Common/Types.hpp>
+#include <Reaktoro/Core/Param.hpp>
+#include <Reaktoro/Core/Species.hpp>
+#include <Reaktoro/Core/SpeciesList.hpp>
+
+namespace Reaktoro {
+
+/// The dependency graph of the formation reactions of the species in a chemical system.
+/// The standard thermodynamic properties of a species defined with a
+/// formation reaction depend on those of its reactant species, which may also
+/// be defined with formation reactions. Evaluating each species with its own
+/// standard thermodynamic model repeats the evaluation of the reactant
+/// species for every product species. This class arranges instead all species
+/// (and the reactant species not in the system) in a directed acyclic graph
+/// and evaluates them once each, in topological order, so that the standard
+/// properties of every product species are obtained from the already
+/// computed properties of its reactants with a sparse matrix-vector product.
+/// The reactant species in formation reactions are identified with the
+/// species in the system by name, chemical formula and aggregate state, where
+/// the suffixes `!` given to duplicate names in a chemical system are ignored.
+/// @ingroup Core
+class FormationReactionGraph
+{
+public:
+    /// Construct a default FormationReactionGraph object.
+    FormationReactionGraph();
+
+    /// Construct a FormationReactionGraph object with given species.
+    /// @param species The species in the chemical system
+    explicit FormationReactionGraph(SpeciesList const& species);
+
+    /// Return the number of species in the chemical system.
+    auto numSpecies() const -> Index;
+
+    /// Return the number of nodes in the graph (the species in the system followed by the reactant species not in the system).
+    auto numNodes() const -> Index;
+
+    /// Return the species in the nodes of the graph.
+    auto nodes() const -> Vec<Species> const&;
+
+    /// Return the indices of the nodes in the graph in the order they are evaluated (reactant species before product species).
+    auto order() const -> Indices const&;
+
+    /// Return the indices of the reactant nodes of a node in the graph (empty if the node is not evaluated with a formation reaction).
+    auto reactants(Index inode) const -> Indices;
+
+    /// Return the Param objects in the standard thermodynamic models of all nodes in the graph.
+    auto params() const -> Vec<Param> const&;
+
+    /// Evaluate the standard thermodynamic properties of the species in the chemical system.
+    /// The last evaluation in each thread is cached, so that no model is evaluated again
+    /// if temperature, pressure and the values of the parameters have not changed.
+    /// @param T The temperature for the calculation (in K)
+    /// @param P The pressure for the calculation (in Pa)
+    /// @param[out] G0 The standard molar Gibbs energies of formation of the species (in J/mol)
+    /// @param[out] H0 The standard molar enthalpies of formation of the species (in J/mol)
+    /// @param[out] V0 The standard molar volumes of the species (in m³/mol)
+    /// @param[out] VT0 The temperature derivative of the standard molar volumes of the species (in m³/(mol·K))
+    /// @param[out] VP0 The pressure derivative of the standard molar volumes of the species (in m³/(mol·Pa))
+    /// @param[out] Cp0 The standard molar isobaric heat capacities of the species (in J/(mol·K))
+    auto evaluate(real const& T, real const& P, ArrayXrRef G0, ArrayXrRef H0, ArrayXrRef V0, ArrayXrRef VT0, ArrayXrRef VP0, ArrayXrRef Cp0) const -> void;
+
+private:
+    struct Impl;
+
+    SharedPtr<Impl> pimpl;
+};
+
+} // namespace Reaktoro
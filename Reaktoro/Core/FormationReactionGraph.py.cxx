@@ -0,0 +1,46 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include <Reaktoro/pybind11.hxx>
+
+// Reaktoro includes
+#include <Reaktoro/Core/FormationReactionGraph.hpp>
+using namespace Reaktoro;
+
+void exportFormationReactionGraph(py::module& m)
+{
+    auto evaluate = [](FormationReactionGraph const& self, real const& T, real const& P)
+    {
+        const auto N = self.numSpecies();
+        ArrayXr G0(N), H0(N), V0(N), VT0(N), VP0(N), Cp0(N);
+        self.evaluate(T, P, G0, H0, V0, VT0, VP0, Cp0);
+        return std::make_tuple(G0, H0, V0, VT0, VP0, Cp0);
+    };
+
+    py::class_<FormationReactionGraph>(m, "FormationReactionGraph")
+        .def(py::init<>())
+        .def(py::init<SpeciesList const&>())
+        .def("numSpecies", &FormationReactionGraph::numSpecies)
+        .def("numNodes", &FormationReactionGraph::numNodes)
+        .def("nodes", &FormationReactionGraph::nodes, return_internal_ref)
+        .def("order", &FormationReactionGraph::order, return_internal_ref)
+        .def("reactants", &FormationReactionGraph::reactants)
+        .def("params", &FormationReactionGraph::params, return_internal_ref)
+        .def("evaluate", evaluate)
+        ;
+}
@@ -0,0 +1,223 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+// Catch includes
+#include <catch2/catch.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Constants.hpp>
+#include <Reaktoro/Core/FormationReaction.hpp>
+#include <Reaktoro/Core/FormationReactionGraph.hpp>
+using namespace Reaktoro;
+
+TEST_CASE("Testing FormationReactionGraph class", "[FormationReactionGraph]")
+{
+    // FORMATION REACTIONS CONSIDERED IN THE TESTS BELOW
+    //    A + 2B = C
+    //    B + 3C = D
+    //    C - 2D = E
+
+    const auto R = universalGasConstant;
+
+    const auto V0_A = 1.234;
+    const auto V0_B = 2.345;
+    const auto V0_C = 16.324;
+    const auto V0_D = 17.435;
+    const auto V0_E = 18.546;
+
+    const auto A = Species()
+        .withName("A")
+        .withStandardThermoModel([=](real T, real P) { StandardThermoProps props; props.G0 = 1.0*T; props.H0 = 2.0*T; props.V0 = V0_A; props.Cp0 = 3.0; return props; });
+
+    const auto B = Species()
+        .withName("B")
+        .withStandardThermoModel([=](real T, real P) { StandardThermoProps props; props.G0 = 4.0*T; props.H0 = 5.0*T; props.V0 = V0_B; props.Cp0 = 6.0; return props; });
+
+    auto reactionThermoModel = [=](double lgK, double dH0, double dCp0)
+    {
+        return ReactionStandardThermoModel([=](ReactionStandardThermoProps& res, ReactionStandardThermoModelArgs args) {
+            const auto& [T, P, dV0] = args;
+            res.dG0  = -R*T*ln10*lgK + P*dV0;
+            res.dH0  = dH0;
+            res.dCp0 = dCp0;
+        });
+    };
+
+    const auto C = Species()
+        .withName("C")
+        .withFormationReaction(
+            FormationReaction()
+                .withReactants({{A, 1}, {B, 2}})
+                .withProductStandardVolumeModel([=](real T, real P) { return real(V0_C); })
+                .withReactionStandardThermoModel(reactionThermoModel(1.234, 123.4, 12.34))
+            );
+
+    const auto D = Species()
+        .withName("D")
+        .withFormationReaction(
+            FormationReaction()
+                .withReactants({{B, 1}, {C, 3}})
+                .withProductStandardVolumeModel([=](real T, real P) { return real(V0_D); })
+                .withReactionStandardThermoModel(reactionThermoModel(2.345, 234.5, 23.45))
+            );
+
+    const auto E = Species()
+        .withName("E")
+        .withFormationReaction(
+            FormationReaction()
+                .withReactants({{C, 1}, {D, -2}})
+                .withProductStandardVolumeModel([=](real T, real P) { return real(V0_E); })
+                .withReactionStandardThermoModel(reactionThermoModel(3.456, 345.6, 34.56))
+            );
+
+    const auto T = 345.0;
+    const auto P = 2.0e5;
+
+    SECTION("Testing graph with reactant species not in the system")
+    {
+        FormationReactionGraph graph(SpeciesList{ E, D, C });
+
+        CHECK( graph.numSpecies() == 3 );
+        CHECK( graph.numNodes() == 5 ); // E, D, C, B, A
+
+        CHECK( graph.nodes()[0].name() == "E" );
+        CHECK( graph.nodes()[1].name() == "D" );
+        CHECK( graph.nodes()[2].name() == "C" );
+        CHECK( graph.nodes()[3].name() == "B" );
+        CHECK( graph.nodes()[4].name() == "A" );
+
+        CHECK( graph.reactants(0) == Indices{2, 1} );
+        CHECK( graph.reactants(1) == Indices{3, 2} );
+        CHECK( graph.reactants(2) == Indices{4, 3} );
+        CHECK( graph.reactants(3).empty() );
+        CHECK( graph.reactants(4).empty() );
+
+        // Every node must come after its reactants in the evaluation order
+        const auto order = graph.order();
+        REQUIRE( order.size() == 5 );
+        auto position = [&](Index inode) { return std::find(order.begin(), order.end(), inode) - order.begin(); };
+        for(auto i = 0; i < 5; ++i)
+            for(auto j : graph.reactants(i))
+                CHECK( position(j) < position(i) );
+
+        ArrayXr G0(3), H0(3), V0(3), VT0(3), VP0(3), Cp0(3);
+        graph.evaluate(T, P, G0, H0, V0, VT0, VP0, Cp0);
+
+        // The properties must match those computed with the standard thermodynamic model of each species
+        for(auto [i, species] : std::vector<std::pair<Index, Species>>{{0, E}, {1, D}, {2, C}})
+        {
+            const auto props = species.standardThermoProps(T, P);
+            CHECK( G0[i]  == Approx(props.G0)  );
+            CHECK( H0[i]  == Approx(props.H0)  );
+            CHECK( V0[i]  == Approx(props.V0)  );
+            CHECK( VT0[i] == Approx(props.VT0) );
+            CHECK( VP0[i] == Approx(props.VP0) );
+            CHECK( Cp0[i] == Approx(props.Cp0) );
+        }
+    }
+
+    SECTION("Testing graph in which all species are in the system")
+    {
+        FormationReactionGraph graph(SpeciesList{ A, B, C, D, E });
+
+        CHECK( graph.numSpecies() == 5 );
+        CHECK( graph.numNodes() == 5 );
+
+        ArrayXr G0(5), H0(5), V0(5), VT0(5), VP0(5), Cp0(5);
+        graph.evaluate(T, P, G0, H0, V0, VT0, VP0, Cp0);
+
+        for(auto [i, species] : std::vector<std::pair<Index, Species>>{{0, A}, {1, B}, {2, C}, {3, D}, {4, E}})
+        {
+            const auto props = species.standardThermoProps(T, P);
+            CHECK( G0[i]  == Approx(props.G0)  );
+            CHECK( H0[i]  == Approx(props.H0)  );
+            CHECK( V0[i]  == Approx(props.V0)  );
+            CHECK( Cp0[i] == Approx(props.Cp0) );
+        }
+    }
+
+    SECTION("Testing graph with species whose standard thermodynamic model overrides its formation reaction")
+    {
+        const auto Cx = C.withStandardGibbsEnergy(123.0);
+
+        CHECK( C.usesFormationReaction() );
+        CHECK_FALSE( Cx.usesFormationReaction() );
+
+        FormationReactionGraph graph(SpeciesList{ Cx, D });
+
+        CHECK( graph.reactants(0).empty() );
+
+        ArrayXr G0(2), H0(2), V0(2), VT0(2), VP0(2), Cp0(2);
+        graph.evaluate(T, P, G0, H0, V0, VT0, VP0, Cp0);
+
+        CHECK( G0[0] == Approx(123.0) );
+    }
+
+    SECTION("Testing graph with reactant species renamed in the system because of duplicate names")
+    {
+        const auto Bgas = B.withAggregateState(AggregateState::Gas);
+
+        const auto Baq = Species()
+            .withName("B")
+            .withAggregateState(AggregateState::Aqueous)
+            .withStandardThermoModel([=](real T, real P) { StandardThermoProps props; props.G0 = 7.0*T; props.H0 = 8.0*T; props.V0 = 9.0; props.Cp0 = 10.0; return props; });
+
+        const auto F = Species()
+            .withName("F")
+            .withFormationReaction(
+                FormationReaction()
+                    .withReactants({{Bgas, 1}})
+                    .withProductStandardVolumeModel([=](real T, real P) { return real(V0_B); })
+                    .withReactionStandardThermoModel(reactionThermoModel(4.567, 456.7, 45.67))
+                );
+
+        // The gaseous species B is renamed to B! in a chemical system because the aqueous species B comes first
+        FormationReactionGraph graph(SpeciesList{ F, Baq, Bgas.withName("B!") });
+
+        CHECK( graph.numNodes() == 3 );
+        CHECK( graph.reactants(0) == Indices{2} );
+
+        ArrayXr G0(3), H0(3), V0(3), VT0(3), VP0(3), Cp0(3);
+        graph.evaluate(T, P, G0, H0, V0, VT0, VP0, Cp0);
+
+        const auto props = F.standardThermoProps(T, P);
+        CHECK( G0[0]  == Approx(props.G0)  );
+        CHECK( H0[0]  == Approx(props.H0)  );
+        CHECK( Cp0[0] == Approx(props.Cp0) );
+    }
+
+    SECTION("Testing graph with cyclic formation reactions")
+    {
+        const auto X = Species()
+            .withName("X")
+            .withFormationReaction(
+                FormationReaction()
+                    .withReactants({{A, 1}})
+                    .withEquilibriumConstant(1.0)
+                );
+
+        const auto Y = Species()
+            .withName("A") // the formation reaction of X has a reactant named A, which is now formed from X
+            .withFormationReaction(
+                FormationReaction()
+                    .withReactants({{X, 1}})
+                    .withEquilibriumConstant(1.0)
+                );
+
+        CHECK_THROWS( FormationReactionGraph(SpeciesList{ X, Y }) );
+    }
+}
@@ -113,14 +113,27 @@ public:
     {}
 
     /// Return a new Model function object with memoization for the model calculator.
-    auto withMemoization() const -> Model
+    /// The last evaluation of the model is cached per thread, so the memoized
+    /// model can be used concurrently from multiple threads. If a
+    /// MemoizationStats object is given in @p options, the cache hits and
+    /// misses are counted in it, and it can be retrieved later with @ref
+    /// memoizationStats.
+    /// @param options The options for the memoization of the model.
+    auto withMemoization(MemoizationOptions const& options = {}) const -> Model
     {
         Model copy = *this;
-        copy.m_evalfn = memoizeLastUsingRef<Result>(copy.m_evalfn); // Here, if `m_evalfn` did not consider `const Vec<Param>&` as argument, memoization would not know when the parameters have been changed externally!
-        copy.m_calcfn = memoizeLast(copy.m_calcfn); // Here, if `m_calcfn` did not consider `const Vec<Param>&` as argument, memoization would not know when the parameters have been changed externally!
+        copy.m_evalfn = memoizeLastUsingRef<Result>(copy.m_evalfn, options); // Here, if `m_evalfn` did not consider `const Vec<Param>&` as argument, memoization would not know when the parameters have been changed externally!
+        copy.m_calcfn = memoizeLast(copy.m_calcfn, options); // Here, if `m_calcfn` did not consider `const Vec<Param>&` as argument, memoization would not know when the parameters have been changed externally!
+        copy.m_memostats = options.stats;
         return copy;
     }
 
+    /// Return the counters of cache hits and misses of this Model function object if memoized.
+    auto memoizationStats() const -> Optional<MemoizationStats> const&
+    {
+        return m_memostats;
+    }
+
     /// Evaluate the model with given arguments.
     auto apply(ResultRef res, const Args&... args) const -> void
     {
@@ -219,6 +232,9 @@ private:
     /// This is needed for proper memoization optimization!
     ModelCalculator<Result, Args..., const Vec<Param>&> m_calcfn;
 
+    /// The counters of cache hits and misses of the model if memoized (see @ref withMemoization).
+    Optional<MemoizationStats> m_memostats;
+
     /// The function that serializes the underlying model function to a Data object.
     /// This has to be a function because if we stored the serialization of the
     /// model at construction and the Param objects associated to it changed at
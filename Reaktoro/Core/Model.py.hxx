@@ -32,6 +32,7 @@ auto exportModelMethodsOnly(py::module& m, const char* modelname)
 
     return py::class_<ModelType>(m, modelname)
         .def("params", &ModelType::params, return_internal_ref)
+        .def("memoizationStats", &ModelType::memoizationStats)
         .def("apply", &ModelType::apply)
         .def("__call__", py::overload_cast<const Args&...>(&ModelType::operator(), py::const_))
         .def("__call__", py::overload_cast<ResultRef, const Args&...>(&ModelType::operator(), py::const_))
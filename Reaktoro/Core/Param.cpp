@@ -17,6 +17,9 @@
 
 #include "Param.hpp"
 
+// Reaktoro includes
+#include <Reaktoro/Core/ParamOverlay.hpp>
+
 namespace Reaktoro {
 namespace {
 
@@ -84,17 +87,21 @@ auto Param::assign(const Param& other) -> Param&
 auto Param::value(const real& val) -> Param&
 {
     warningIfOutOfBounds(*this, val);
-    pimpl->value = val;
+    value() = val;
     return *this;
 }
 
 auto Param::value() const -> const real&
 {
+    if(auto* val = ParamOverlay::lookup(pimpl.get()))
+        return *val;
     return pimpl->value;
 }
 
 auto Param::value() -> real&
 {
+    if(auto* val = ParamOverlay::lookup(pimpl.get()))
+        return *val;
     return pimpl->value;
 }
 
@@ -154,17 +161,17 @@ auto Param::operator=(const real& val) -> Param&
 
 Param::operator const real&() const
 {
-    return pimpl->value;
+    return value();
 }
 
 Param::operator real&()
 {
-    return pimpl->value;
+    return value();
 }
 
 Param::operator double() const
 {
-    return pimpl->value;
+    return value();
 }
 
 auto Param::Constant(const real& val) -> Param
@@ -53,6 +53,8 @@ public:
     auto value(const real& val) -> Param&;
 
     /// Return the value of the parameter.
+    /// If the parameter is in the ParamOverlay object active in the calling
+    /// thread, the value in the overlay is returned instead (see ParamOverlay).
     auto value() const -> const real&;
 
     /// Return the value of the parameter.
@@ -104,6 +106,8 @@ private:
     struct Impl;
 
     SharedPtr<Impl> pimpl;
+
+    friend class ParamOverlay;
 };
 
 } // namespace Reaktoro
@@ -0,0 +1,173 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "ParamOverlay.hpp"
+
+// Reaktoro includes
+#include <Reaktoro/Common/Exception.hpp>
+
+namespace Reaktoro {
+namespace {
+
+/// The overlay active in each thread.
+thread_local ParamOverlay* activeoverlay = nullptr;
+
+/// The number of parameters in an overlay above which they are found with a hash table instead of a linear search.
+const auto maxlinearsearch = 8;
+
+/// Return the value of a parameter outside any overlay.
+auto sharedValue(Param const& param) -> real
+{
+    auto* overlay = activeoverlay;
+    activeoverlay = nullptr;
+    const real value = param.value();
+    activeoverlay = overlay;
+    return value;
+}
+
+} // namespace
+
+ParamOverlay::ParamOverlay()
+{}
+
+ParamOverlay::ParamOverlay(Vec<Param> const& params)
+{
+    for(auto const& param : params)
+        add(param);
+}
+
+auto ParamOverlay::add(Param const& param) -> Index
+{
+    const auto idx = find(param);
+    if(idx < size())
+        return idx;
+
+    m_params.push_back(param);
+    m_values.push_back(sharedValue(param));
+    m_keys.push_back(param.pimpl.get());
+
+    if(m_keys.size() > maxlinearsearch)
+    {
+        if(m_indices.empty())
+            for(auto i = 0; i < m_keys.size(); ++i)
+                m_indices.emplace(m_keys[i], i);
+        else m_indices.emplace(m_keys.back(), m_keys.size() - 1);
+    }
+
+    return m_keys.size() - 1;
+}
+
+auto ParamOverlay::size() const -> Index
+{
+    return m_keys.size();
+}
+
+auto ParamOverlay::params() const -> Vec<Param> const&
+{
+    return m_params;
+}
+
+auto ParamOverlay::find(Param const& param) const -> Index
+{
+    void const* key = param.pimpl.get();
+    if(m_indices.empty())
+    {
+        for(auto i = 0; i < m_keys.size(); ++i)
+            if(m_keys[i] == key)
+                return i;
+        return m_keys.size();
+    }
+    const auto it = m_indices.find(key);
+    return it != m_indices.end() ? it->second : m_keys.size();
+}
+
+auto ParamOverlay::value(Index i) const -> real const&
+{
+    assert(i < size());
+    return m_values[i];
+}
+
+auto ParamOverlay::value(Index i) -> real&
+{
+    assert(i < size());
+    return m_values[i];
+}
+
+auto ParamOverlay::values(ArrayXrConstRef const& vals) -> void
+{
+    errorif(vals.size() != size(), "Expecting ", size(), " values for the parameters in the ParamOverlay object, but ", vals.size(), " were given.");
+    for(auto i = 0; i < vals.size(); ++i)
+        m_values[i] = vals[i];
+}
+
+auto ParamOverlay::values(ArrayXdConstRef const& vals) -> void
+{
+    errorif(vals.size() != size(), "Expecting ", size(), " values for the parameters in the ParamOverlay object, but ", vals.size(), " were given.");
+    for(auto i = 0; i < vals.size(); ++i)
+        m_values[i] = vals[i];
+}
+
+auto ParamOverlay::values() const -> ArrayXr
+{
+    ArrayXr vals(size());
+    for(auto i = 0; i < vals.size(); ++i)
+        vals[i] = m_values[i];
+    return vals;
+}
+
+auto ParamOverlay::reset() -> void
+{
+    for(auto i = 0; i < size(); ++i)
+        m_values[i] = sharedValue(m_params[i]);
+}
+
+auto ParamOverlay::active() -> ParamOverlay*
+{
+    return activeoverlay;
+}
+
+auto ParamOverlay::lookup(void const* key) -> real*
+{
+    auto* overlay = activeoverlay;
+    if(overlay == nullptr)
+        return nullptr;
+    auto const& keys = overlay->m_keys;
+    auto const& indices = overlay->m_indices;
+    if(indices.empty())
+    {
+        for(auto i = 0; i < keys.size(); ++i)
+            if(keys[i] == key)
+                return &overlay->m_values[i];
+        return nullptr;
+    }
+    const auto it = indices.find(key);
+    return it != indices.end() ? &overlay->m_values[it->second] : nullptr;
+}
+
+ParamOverlayGuard::ParamOverlayGuard(ParamOverlay& overlay)
+: m_previous(activeoverlay)
+{
+    activeoverlay = &overlay;
+}
+
+ParamOverlayGuard::~ParamOverlayGuard()
+{
+    activeoverlay = m_previous;
+}
+
+} // namespace Reaktoro
@@ -0,0 +1,132 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+// Reaktoro includes
+#include <Reaktoro/Common/Matrix.hpp>
+#include <Reaktoro/Common/Types.hpp>
+#include <Reaktoro/Core/Param.hpp>
+
+namespace Reaktoro {
+
+/// Used to override the values of model parameters in a single thread.
+/// Param objects are shared by every copy of the species, phases and models
+/// that use them, so changing the value of a parameter affects all copies of a
+/// chemical system. A ParamOverlay object stores its own values for a
+/// selection of parameters. While it is active in a thread (see
+/// ParamOverlayGuard), every read and write of these parameters in that
+/// thread, including those performed by the models of a chemical system, uses
+/// the values in the overlay instead. Other threads, and parameters not in the
+/// overlay, are not affected. This permits many calculations with different
+/// parameter values (e.g., the members of a Monte Carlo ensemble) to run
+/// concurrently with a single chemical system, each thread with its own
+/// overlay. An example is shown below.
+/// ~~~{.cpp}
+/// ParamOverlay overlay({ G0calcite, G0dolomite });
+/// ParamOverlayGuard guard(overlay); // activate overlay in this thread until guard is destroyed
+/// overlay.value(0) = -1129000.0;    // the value of G0calcite seen by this thread only
+/// solver.solve(state);              // the models of the chemical system read G0calcite from the overlay
+/// ~~~
+/// @ingroup Core
+class ParamOverlay
+{
+public:
+    /// Construct a default ParamOverlay object.
+    ParamOverlay();
+
+    /// Construct a ParamOverlay object for given parameters, initialized with their current values.
+    explicit ParamOverlay(Vec<Param> const& params);
+
+    /// Add a parameter to the overlay, initialized with its current value, and return its index in the overlay.
+    /// If the parameter is already in the overlay, its index is returned.
+    auto add(Param const& param) -> Index;
+
+    /// Return the number of parameters in the overlay.
+    auto size() const -> Index;
+
+    /// Return the parameters in the overlay.
+    auto params() const -> Vec<Param> const&;
+
+    /// Return the index of a parameter in the overlay, or the number of parameters if not found.
+    auto find(Param const& param) const -> Index;
+
+    /// Return the value of the parameter with given index in the overlay.
+    auto value(Index i) const -> real const&;
+
+    /// Return the value of the parameter with given index in the overlay.
+    auto value(Index i) -> real&;
+
+    /// Set the values of all parameters in the overlay.
+    auto values(ArrayXrConstRef const& vals) -> void;
+
+    /// Set the values of all parameters in the overlay.
+    auto values(ArrayXdConstRef const& vals) -> void;
+
+    /// Return the values of all parameters in the overlay.
+    auto values() const -> ArrayXr;
+
+    /// Reset the values in the overlay to the current values of the parameters outside any overlay.
+    auto reset() -> void;
+
+    /// Return the overlay active in the calling thread, or a null pointer if none.
+    static auto active() -> ParamOverlay*;
+
+    /// Return the value in the overlay active in the calling thread for a parameter, or a null pointer if the parameter is not in it.
+    /// This is used by Param to read and write its value through the active overlay.
+    static auto lookup(void const* key) -> real*;
+
+private:
+    /// The parameters in the overlay.
+    Vec<Param> m_params;
+
+    /// The values of the parameters in the overlay.
+    Vec<real> m_values;
+
+    /// The identities of the shared data of the parameters in the overlay, used to find them.
+    Vec<void const*> m_keys;
+
+    /// The indices of the parameters in the overlay, used to find them when there are many.
+    Map<void const*, Index> m_indices;
+
+    friend class ParamOverlayGuard;
+};
+
+/// Used to activate a ParamOverlay object in the calling thread during its lifetime.
+/// The overlay that was active before (if any) is restored on destruction,
+/// so that guards can be nested. The overlay must outlive the guard.
+/// @ingroup Core
+class ParamOverlayGuard
+{
+public:
+    /// Activate the given overlay in the calling thread.
+    explicit ParamOverlayGuard(ParamOverlay& overlay);
+
+    /// Restore the overlay that was active in the calling thread before this guard was constructed.
+    ~ParamOverlayGuard();
+
+    ParamOverlayGuard(ParamOverlayGuard const&) = delete;
+
+    auto operator=(ParamOverlayGuard const&) -> ParamOverlayGuard& = delete;
+
+private:
+    /// The overlay active in the calling thread before this guard was constructed.
+    ParamOverlay* m_previous;
+};
+
+} // namespace Reaktoro
@@ -0,0 +1,54 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// pybind11 includes
+#include <Reaktoro/pybind11.hxx>
+
+// Reaktoro includes
+#include <Reaktoro/Core/ParamOverlay.hpp>
+using namespace Reaktoro;
+
+namespace {
+
+/// The guards of the overlays activated with Python `with` statements in each thread.
+thread_local Vec<Ptr<ParamOverlayGuard>> guards;
+
+} // namespace
+
+void exportParamOverlay(py::module& m)
+{
+    auto value = [](ParamOverlay& self, Index i, real const& val) { self.value(i) = val; };
+
+    py::class_<ParamOverlay>(m, "ParamOverlay")
+        .def(py::init<>())
+        .def(py::init<Vec<Param> const&>())
+        .def("add", &ParamOverlay::add, "Add a parameter to the overlay and return its index in the overlay.")
+        .def("size", &ParamOverlay::size, "Return the number of parameters in the overlay.")
+        .def("params", &ParamOverlay::params, return_internal_ref, "Return the parameters in the overlay.")
+        .def("find", &ParamOverlay::find, "Return the index of a parameter in the overlay, or the number of parameters if not found.")
+        .def("value", py::overload_cast<Index>(&ParamOverlay::value, py::const_), return_internal_ref, "Return the value of the parameter with given index in the overlay.")
+        .def("value", value, "Set the value of the parameter with given index in the overlay.")
+        .def("values", py::overload_cast<ArrayXrConstRef const&>(&ParamOverlay::values), "Set the values of all parameters in the overlay.")
+        .def("values", py::overload_cast<ArrayXdConstRef const&>(&ParamOverlay::values), "Set the values of all parameters in the overlay.")
+        .def("values", py::overload_cast<>(&ParamOverlay::values, py::const_), "Return the values of all parameters in the overlay.")
+        .def("reset", &ParamOverlay::reset, "Reset the values in the overlay to the current values of the parameters outside any overlay.")
+        .def("__enter__", [](ParamOverlay& self) -> ParamOverlay& { guards.push_back(std::make_unique<ParamOverlayGuard>(self)); return self; }, return_internal_ref)
+        .def("__exit__", [](ParamOverlay& self, py::args) { guards.pop_back(); })
+        .def_static("active", &ParamOverlay::active, py::return_value_policy::reference, "Return the overlay active in the calling thread, or None if none.")
+        ;
+}
@@ -0,0 +1,160 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// Catch includes
+#include <catch2/catch.hpp>
+
+// C++ includes
+#include <thread>
+
+// Reaktoro includes
+#include <Reaktoro/Core/ParamOverlay.hpp>
+using namespace Reaktoro;
+
+TEST_CASE("Testing ParamOverlay class", "[ParamOverlay]")
+{
+    Param a("a", 1.0);
+    Param b("b", 2.0);
+    Param c("c", 3.0);
+
+    Param acopy = a; // acopy shares the same underlying data as a
+
+    ParamOverlay overlay({ a, b });
+
+    CHECK( overlay.size() == 2 );
+    CHECK( overlay.find(a) == 0 );
+    CHECK( overlay.find(acopy) == 0 );
+    CHECK( overlay.find(b) == 1 );
+    CHECK( overlay.find(c) == 2 );
+    CHECK( overlay.add(b) == 1 );
+    CHECK( overlay.value(0) == 1.0 );
+    CHECK( overlay.value(1) == 2.0 );
+
+    overlay.value(0) = 10.0;
+    overlay.value(1) = 20.0;
+
+    CHECK( ParamOverlay::active() == nullptr );
+
+    SECTION("Checking the overlay is only seen while active")
+    {
+        CHECK( a.value() == 1.0 );
+        CHECK( b.value() == 2.0 );
+
+        {
+            ParamOverlayGuard guard(overlay);
+
+            CHECK( ParamOverlay::active() == &overlay );
+            CHECK( a.value() == 10.0 );
+            CHECK( acopy.value() == 10.0 );
+            CHECK( b.value() == 20.0 );
+            CHECK( c.value() == 3.0 );
+            CHECK( double(a) == 10.0 );
+            CHECK( a + b == 30.0 );
+
+            a = 11.0;      // writes to the overlay
+            b.value(21.0); // writes to the overlay
+            c = 4.0;       // c is not in the overlay
+
+            CHECK( overlay.value(0) == 11.0 );
+            CHECK( overlay.value(1) == 21.0 );
+        }
+
+        CHECK( ParamOverlay::active() == nullptr );
+        CHECK( a.value() == 1.0 );
+        CHECK( b.value() == 2.0 );
+        CHECK( c.value() == 4.0 );
+    }
+
+    SECTION("Checking nested overlays")
+    {
+        ParamOverlay inner({ b });
+        inner.value(0) = 200.0;
+
+        ParamOverlayGuard guard(overlay);
+        {
+            ParamOverlayGuard guard(inner);
+            CHECK( a.value() == 1.0 ); // only the innermost overlay is active
+            CHECK( b.value() == 200.0 );
+        }
+        CHECK( a.value() == 10.0 );
+        CHECK( b.value() == 20.0 );
+    }
+
+    SECTION("Checking the values and reset methods")
+    {
+        overlay.values(ArrayXd{{ 5.0, 6.0 }});
+        CHECK( overlay.values().isApprox(ArrayXr{{ 5.0, 6.0 }}) );
+
+        a = 7.0;
+        overlay.reset();
+        CHECK( overlay.value(0) == 7.0 );
+        CHECK( overlay.value(1) == 2.0 );
+    }
+
+    SECTION("Checking overlays with many parameters")
+    {
+        Vec<Param> params;
+        for(auto i = 0; i < 20; ++i)
+            params.push_back(Param(double(i)));
+
+        ParamOverlay many(params);
+
+        CHECK( many.size() == 20 );
+        CHECK( many.find(params[15]) == 15 );
+        CHECK( many.find(a) == 20 );
+
+        for(auto i = 0; i < 20; ++i)
+            many.value(i) = 100.0 + i;
+
+        ParamOverlayGuard guard(many);
+        for(auto i = 0; i < 20; ++i)
+            CHECK( params[i].value() == 100.0 + i );
+        CHECK( a.value() == 1.0 );
+    }
+
+    SECTION("Checking overlays in concurrent threads")
+    {
+        const auto numthreads = 4;
+        Vec<double> sums(numthreads);
+        Vec<std::thread> threads;
+        for(auto t = 0; t < numthreads; ++t)
+        {
+            threads.emplace_back([&, t]
+            {
+                ParamOverlay local({ a, b });
+                ParamOverlayGuard guard(local);
+                double sum = 0.0;
+                for(auto i = 0; i < 1000; ++i)
+                {
+                    a = double(t);
+                    b = double(i);
+                    sum += double(a) * 1000.0 + double(b) - double(t) * 1000.0 - double(i); // zero unless another thread interferes
+                }
+                sums[t] = sum;
+            });
+        }
+        for(auto& thread : threads)
+            thread.join();
+
+        for(auto sum : sums)
+            CHECK( sum == 0.0 );
+
+        CHECK( a.value() == 1.0 );
+        CHECK( b.value() == 2.0 );
+    }
+}
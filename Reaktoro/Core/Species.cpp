@@ -84,6 +84,9 @@ struct Species::Impl
     /// The standard thermodynamic model function of the species (if any).
     StandardThermoModel propsfn = detail::defaultStandardThermoModel();
 
+    /// True if the standard thermodynamic model function of the species was created from its formation reaction.
+    bool propsfn_from_reaction = false;
+
     /// The tags of the species such as `organic`, `mineral`.
     Strings tags;
 
@@ -142,6 +145,7 @@ struct Species::Impl
             reaction = attribs.formation_reaction;
             propsfn = reaction.createStandardThermoModel();
             propsfn = propsfn.withMemoization();
+            propsfn_from_reaction = true;
         }
     }
 };
@@ -214,6 +218,7 @@ auto Species::withFormationReaction(const FormationReaction& reaction) const ->
     Species copy = clone();
     copy.pimpl->reaction = reaction;
     copy = copy.withStandardThermoModel(reaction.createStandardThermoModel());
+    copy.pimpl->propsfn_from_reaction = true;
     return copy;
 }
 
@@ -226,6 +231,7 @@ auto Species::withStandardThermoModel(const StandardThermoModel& model) const ->
 {
     Species copy = clone();
     copy.pimpl->propsfn = model.withMemoization();
+    copy.pimpl->propsfn_from_reaction = false;
     return copy;
 }
 
@@ -289,6 +295,11 @@ auto Species::reaction() const -> const FormationReaction&
     return pimpl->reaction;
 }
 
+auto Species::usesFormationReaction() const -> bool
+{
+    return pimpl->propsfn_from_reaction;
+}
+
 auto Species::standardThermoModel() const -> const StandardThermoModel&
 {
     return pimpl->propsfn;
@@ -164,6 +164,12 @@ public:
     /// Return the formation reaction of the species.
     auto reaction() const -> const FormationReaction&;
 
+    /// Return true if the standard thermodynamic model of the species is the one created from its formation reaction.
+    /// This is false if the species has no formation reaction or if its
+    /// standard thermodynamic model has been replaced afterwards with
+    /// @ref withStandardThermoModel or @ref withStandardGibbsEnergy.
+    auto usesFormationReaction() const -> bool;
+
     /// Return the function that computes the standard thermodynamic properties of the species.
     auto standardThermoModel() const -> const StandardThermoModel&;
 
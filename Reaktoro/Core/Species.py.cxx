@@ -47,6 +47,7 @@ void exportSpecies(py::module& m)
         .def("charge", &Species::charge)
         .def("aggregateState", &Species::aggregateState)
         .def("reaction", &Species::reaction, return_internal_ref)
+        .def("usesFormationReaction", &Species::usesFormationReaction)
         .def("standardThermoModel", &Species::standardThermoModel, return_internal_ref)
         .def("tags", &Species::tags, return_internal_ref)
         .def("attachedData", &Species::attachedData)
@@ -20,6 +20,7 @@
 
 void exportEquilibriumConditions(py::module& m);
 void exportEquilibriumDims(py::module& m);
+void exportEquilibriumFitting(py::module& m);
 void exportEquilibriumOptions(py::module& m);
 void exportEquilibriumProblem(py::module& m);
 void exportEquilibriumRestrictions(py::module& m);
@@ -27,6 +28,8 @@ void exportEquilibriumResult(py::module& m);
 void exportEquilibriumSensitivity(py::module& m);
 void exportEquilibriumSolver(py::module& m);
 void exportEquilibriumSpecs(py::module& m);
+void exportEquilibriumSurrogate(py::module& m);
+void exportEquilibriumSweep(py::module& m);
 void exportEquilibriumUtils(py::module& m);
 void exportSmartEquilibriumOptions(py::module& m);
 void exportSmartEquilibriumResult(py::module& m);
@@ -36,6 +39,7 @@ void exportEquilibrium(py::module& m)
 {
     exportEquilibriumConditions(m);
     exportEquilibriumDims(m);
+    exportEquilibriumFitting(m);
     exportEquilibriumOptions(m);
     exportEquilibriumRestrictions(m);
     exportEquilibriumProblem(m); // Ensure exportEquilibriumProblem is executed after exportEquilibriumConditions and exportEquilibriumRestrictions!
@@ -43,6 +47,8 @@ void exportEquilibrium(py::module& m)
     exportEquilibriumSensitivity(m);
     exportEquilibriumSolver(m);
     exportEquilibriumSpecs(m);
+    exportEquilibriumSurrogate(m);
+    exportEquilibriumSweep(m);
     exportEquilibriumUtils(m);
     exportSmartEquilibriumOptions(m);
     exportSmartEquilibriumResult(m);
@@ -0,0 +1,536 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "EquilibriumFitting.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Algorithms.hpp>
+#include <Reaktoro/Common/AutoDiff.hpp>
+#include <Reaktoro/Common/Enumerate.hpp>
+#include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Common/TimeUtils.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ParamOverlay.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumConditions.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumResult.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSensitivity.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSolver.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSpecs.hpp>
+
+namespace Reaktoro {
+namespace {
+
+/// Return the specifications of the equilibrium problems of the experiments, with the model parameters as input variables.
+auto createEquilibriumSpecs(EquilibriumFittingModel const& model) -> EquilibriumSpecs
+{
+    EquilibriumSpecs specs(model.system);
+    specs.temperature();
+    specs.pressure();
+    for(auto const& param : model.params)
+        specs.addInput(param);
+    return specs;
+}
+
+/// Check the model parameters to be fitted have unique, non-empty identifiers.
+auto checkModelParams(Vec<Param> const& params) -> void
+{
+    errorif(params.empty(), "Expecting at least one model parameter to be fitted in EquilibriumFitting.");
+    for(auto i = 0; i < params.size(); ++i)
+    {
+        errorif(params[i].id().empty(), "Expecting model parameters with non-empty identifiers in EquilibriumFitting (see method Param::id).");
+        for(auto j = 0; j < i; ++j)
+            errorif(params[i].id() == params[j].id(), "Expecting model parameters with unique identifiers in EquilibriumFitting, but `", params[i].id(), "` is used more than once.");
+    }
+}
+
+} // namespace
+
+struct EquilibriumFitting::Impl
+{
+    /// The objects used by a thread to evaluate experiments.
+    struct Replica
+    {
+        /// The chemical system and model parameters used by this thread.
+        EquilibriumFittingModel model;
+
+        /// The values of the model parameters seen by this thread, so that threads sharing a chemical system do not interfere.
+        ParamOverlay overlay;
+
+        /// The specifications of the equilibrium problems with the model parameters as input variables.
+        EquilibriumSpecs specs;
+
+        /// The equilibrium solver used by this thread.
+        EquilibriumSolver solver;
+
+        /// The sensitivity derivatives of the last equilibrium calculation.
+        EquilibriumSensitivity sensitivity;
+
+        /// The conditions of the equilibrium problems.
+        EquilibriumConditions conditions;
+
+        /// The chemical state used in the equilibrium calculations.
+        ChemicalState state;
+
+        /// Construct a Replica object.
+        Replica(EquilibriumFittingModel const& model, EquilibriumOptions const& options)
+        : model(model), overlay(model.params), specs(createEquilibriumSpecs(model)), solver(specs), sensitivity(specs), conditions(specs), state(model.system)
+        {
+            Strings ids;
+            for(auto const& param : model.params)
+                ids.push_back(param.id());
+
+            solver.setOptions(options);
+            sensitivity.requestInputs(ids);
+            sensitivity.requestComponents(false);
+            sensitivity.requestProperties(false);
+        }
+    };
+
+    /// The function that creates a copy of the model to be fitted for each thread (empty if all threads share the same model).
+    EquilibriumFittingModelFn modelfn;
+
+    /// The options of the fitting.
+    EquilibriumFittingOptions options;
+
+    /// The experiments in the fitting.
+    Vec<EquilibriumFittingExperiment> experiments;
+
+    /// The species amounts at the last equilibrium state of each experiment, used as initial guess in the next evaluation.
+    Vec<ArrayXd> nlast;
+
+    /// The index of the first observation of each experiment in the vector of residuals.
+    Indices offsets;
+
+    /// The number of observations in all experiments.
+    Index numobservations = 0;
+
+    /// The objects used by each thread to evaluate the experiments (the first one is also the model exposed in the public interface).
+    Vec<Ptr<Replica>> replicas;
+
+    /// The number of equilibrium calculations performed so far.
+    std::atomic<Index> numequilibriums = 0;
+
+    /// Construct an EquilibriumFitting::Impl object with a model shared by all threads.
+    Impl(EquilibriumFittingModel const& model)
+    {
+        checkModelParams(model.params);
+        replicas.push_back(std::make_unique<Replica>(model, options.equilibrium));
+    }
+
+    /// Construct an EquilibriumFitting::Impl object with a function that creates a copy of the model for each thread.
+    Impl(EquilibriumFittingModelFn const& modelfn)
+    : modelfn(modelfn)
+    {
+        errorif(!modelfn, "Expecting a non-empty function that creates the model to be fitted in EquilibriumFitting.");
+        replicas.push_back(createReplica());
+    }
+
+    /// Construct a copy of an EquilibriumFitting::Impl object.
+    Impl(Impl const& other)
+    : modelfn(other.modelfn)
+    {
+        replicas.push_back(modelfn ? createReplica() : std::make_unique<Replica>(other.replicas[0]->model, other.options.equilibrium));
+        options = other.options;
+        experiments = other.experiments;
+        nlast = other.nlast;
+        offsets = other.offsets;
+        numobservations = other.numobservations;
+        replicas[0]->solver.setOptions(options.equilibrium);
+    }
+
+    /// Return a new Replica object, with either a new copy of the model or the model shared with the first replica.
+    auto createReplica() const -> Ptr<Replica>
+    {
+        if(!modelfn)
+            return std::make_unique<Replica>(replicas[0]->model, options.equilibrium);
+
+        auto model = modelfn();
+        checkModelParams(model.params);
+        if(!replicas.empty())
+        {
+            errorif(model.params.size() != replicas[0]->model.params.size(), "Expecting the function that creates the model in EquilibriumFitting to always return the same number of model parameters.");
+            errorif(model.system.species().size() != replicas[0]->model.system.species().size(), "Expecting the function that creates the model in EquilibriumFitting to always return the same chemical system.");
+        }
+        return std::make_unique<Replica>(model, options.equilibrium);
+    }
+
+    /// Set the options of the fitting.
+    auto setOptions(EquilibriumFittingOptions const& opts) -> void
+    {
+        options = opts;
+        for(auto& replica : replicas)
+            if(replica)
+                replica->solver.setOptions(options.equilibrium);
+    }
+
+    /// Add an experiment to the fitting.
+    auto addExperiment(EquilibriumFittingExperiment const& experiment) -> void
+    {
+        const auto Nn = replicas[0]->model.system.species().size();
+        errorif(experiment.n.size() != Nn, "Expecting an experiment in EquilibriumFitting with ", Nn, " initial species amounts, but ", experiment.n.size(), " were given.");
+        errorif(experiment.observations.empty(), "Expecting an experiment in EquilibriumFitting with at least one observation.");
+        for(auto const& observation : experiment.observations)
+        {
+            errorif(!observation.fn, "Expecting observations in EquilibriumFitting with non-empty functions.");
+            errorif(observation.stddev <= 0.0, "Expecting observations in EquilibriumFitting with positive standard deviations.");
+        }
+        experiments.push_back(experiment);
+        nlast.push_back(experiment.n);
+        offsets.push_back(numobservations);
+        numobservations += experiment.observations.size();
+    }
+
+    /// Compute the chemical equilibrium state of an experiment with given values of the model parameters, starting from species amounts @p n (updated on exit).
+    auto solve(Replica& replica, EquilibriumFittingExperiment const& experiment, VectorXdConstRef x, ArrayXd& n, bool sensitivities) -> bool
+    {
+        auto& [model, overlay, specs, solver, sensitivity, conditions, state] = replica;
+
+        for(auto j = 0; j < x.size(); ++j)
+        {
+            model.params[j].value() = x[j];
+            conditions.set(model.params[j].id(), x[j]);
+        }
+
+        conditions.temperature(experiment.T);
+        conditions.pressure(experiment.P);
+        conditions.setInitialComponentAmountsFromSpeciesAmounts(experiment.n.matrix());
+
+        state.setTemperature(experiment.T);
+        state.setPressure(experiment.P);
+        state.setSpeciesAmounts(n);
+
+        auto result = sensitivities ?
+            solver.solve(state, sensitivity, conditions) :
+            solver.solve(state, conditions);
+        ++numequilibriums;
+
+        // Start again from the initial species amounts of the experiment if the calculation failed from the previous equilibrium state
+        if(result.failed() && !(n == experiment.n).all())
+        {
+            state.setSpeciesAmounts(experiment.n);
+            result = sensitivities ?
+                solver.solve(state, sensitivity, conditions) :
+                solver.solve(state, conditions);
+            ++numequilibriums;
+        }
+
+        if(result.failed())
+            return false;
+
+        n = state.speciesAmounts().cast<double>();
+        return true;
+    }
+
+    /// Compute the weighted residuals of the observations of an experiment with given species amounts.
+    auto observe(EquilibriumFittingExperiment const& experiment, ArrayXdConstRef const& n, VectorXdRef r) const -> void
+    {
+        const ArrayXr nr = n.cast<real>();
+        for(auto const& [i, observation] : enumerate(experiment.observations))
+            r[i] = (double(observation.fn(nr)) - observation.value) / observation.stddev;
+    }
+
+    /// Evaluate the weighted residuals of the observations of an experiment and their Jacobian matrix.
+    auto evaluate(Replica& replica, Index k, VectorXdConstRef x, VectorXdRef r, MatrixXdRef J) -> bool
+    {
+        auto const& experiment = experiments[k];
+        auto& n = nlast[k];
+
+        const auto Np = x.size();
+
+        if(!solve(replica, experiment, x, n, !options.finitedifferences))
+            return false;
+
+        observe(experiment, n, r);
+
+        if(!options.finitedifferences)
+        {
+            // The Jacobian matrix is assembled with the directional derivatives
+            // of the observable functions along the sensitivity derivatives
+            // dn/dx, computed with one forward automatic differentiation pass
+            // per model parameter.
+            ArrayXr nr = n.cast<real>();
+            for(auto j = 0; j < Np; ++j)
+            {
+                const auto dndx = replica.sensitivity.dndw(replica.model.params[j]);
+                for(auto i = 0; i < nr.size(); ++i)
+                    autodiff::detail::seed<1>(nr[i], dndx[i]);
+                for(auto const& [i, observation] : enumerate(experiment.observations))
+                    J(i, j) = grad(observation.fn(nr)) / observation.stddev;
+            }
+        }
+        else
+        {
+            VectorXd xh = x;
+            VectorXd rplus(r.size());
+            VectorXd rminus(r.size());
+            for(auto j = 0; j < Np; ++j)
+            {
+                const auto h = options.finitedifferencestep * std::max(1.0, std::abs(x[j]));
+
+                ArrayXd nplus = n;
+                xh[j] = x[j] + h;
+                if(!solve(replica, experiment, xh, nplus, false))
+                    return false;
+                observe(experiment, nplus, rplus);
+
+                ArrayXd nminus = n;
+                xh[j] = x[j] - h;
+                if(!solve(replica, experiment, xh, nminus, false))
+                    return false;
+                observe(experiment, nminus, rminus);
+
+                xh[j] = x[j];
+
+                J.col(j) = (rplus - rminus) / (2.0 * h);
+            }
+        }
+
+        return true;
+    }
+
+    /// Evaluate the weighted residuals of the observations and their Jacobian matrix across a pool of threads.
+    auto evaluate(VectorXdConstRef x, VectorXdRef r, MatrixXdRef J) -> bool
+    {
+        const auto Np = replicas[0]->model.params.size();
+        const auto Ne = experiments.size();
+        const auto Nr = numobservations;
+
+        errorif(Ne == 0, "Expecting at least one experiment in EquilibriumFitting before evaluating residuals.");
+        errorif(x.size() != Np, "Expecting ", Np, " values of model parameters in EquilibriumFitting, but ", x.size(), " were given.");
+        errorif(r.size() != Nr, "Expecting a vector of residuals with size ", Nr, " in EquilibriumFitting, but its size is ", r.size(), ".");
+        errorif(J.rows() != Nr || J.cols() != Np, "Expecting a Jacobian matrix with dimensions ", Nr, "x", Np, " in EquilibriumFitting, but its dimensions are ", J.rows(), "x", J.cols(), ".");
+
+        Index numthreads = options.threads;
+        if(numthreads == 0)
+            numthreads = std::max<Index>(std::thread::hardware_concurrency(), 1);
+        numthreads = std::max<Index>(std::min(numthreads, Ne), 1);
+
+        if(replicas.size() < numthreads)
+            replicas.resize(numthreads); // the new replicas are created by their threads below
+
+        Vec<char> succeeded(Ne, false);
+
+        std::atomic<Index> next = 0;
+        std::exception_ptr error;
+        std::mutex errormutex;
+
+        auto worker = [&](Index t)
+        {
+            try
+            {
+                if(!replicas[t])
+                    replicas[t] = createReplica();
+
+                auto& replica = *replicas[t];
+
+                ParamOverlayGuard guard(replica.overlay); // the model parameters are read and written through the overlay of this thread
+
+                for(auto k = next++; k < Ne; k = next++)
+                {
+                    const auto offset = offsets[k];
+                    const auto size = experiments[k].observations.size();
+                    succeeded[k] = evaluate(replica, k, x, r.segment(offset, size), J.middleRows(offset, size));
+                }
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(errormutex);
+                if(!error)
+                    error = std::current_exception();
+                next = Ne; // stop the other threads as soon as they finish their current experiment
+            }
+        };
+
+        Vec<std::thread> threads;
+        for(auto t = 1; t < numthreads; ++t)
+            threads.emplace_back(worker, t);
+        worker(0); // the calling thread is also part of the pool
+        for(auto& thread : threads)
+            thread.join();
+
+        if(error)
+            std::rethrow_exception(error);
+
+        return std::all_of(succeeded.begin(), succeeded.end(), RKT_LAMBDA(x, x));
+    }
+
+    /// Fit the model parameters with the Levenberg-Marquardt algorithm starting from given values.
+    auto fit(VectorXdConstRef x0) -> EquilibriumFittingResult
+    {
+        const auto tbegin = time();
+        const auto numequilibriums0 = numequilibriums.load();
+
+        auto& params = replicas[0]->model.params;
+
+        const auto Np = params.size();
+        const auto Nr = numobservations;
+
+        VectorXd lower(Np), upper(Np);
+        for(auto j = 0; j < Np; ++j)
+        {
+            lower[j] = params[j].lowerbound();
+            upper[j] = params[j].upperbound();
+        }
+
+        EquilibriumFittingResult result;
+
+        VectorXd x = x0.cwiseMax(lower).cwiseMin(upper);
+        VectorXd r(Nr), rnew(Nr);
+        MatrixXd J(Nr, Np), Jnew(Nr, Np);
+
+        const auto succeeded = evaluate(x, r, J);
+        ++result.evaluations;
+
+        errorif(!succeeded, "Could not compute the chemical equilibrium states of all experiments in EquilibriumFitting with the initial values of the model parameters.");
+
+        auto f = 0.5 * r.squaredNorm();
+        auto lambda = options.lambda;
+
+        for(auto i = 0; i < options.maxiters; ++i)
+        {
+            const VectorXd g = J.transpose() * r;
+
+            if(g.lpNorm<Eigen::Infinity>() <= options.tolerance)
+            {
+                result.succeeded = true;
+                break;
+            }
+
+            ++result.iterations;
+
+            // Solve (JᵀJ + λ diag(JᵀJ)) dx = -Jᵀr for the step dx in the model parameters
+            MatrixXd A = J.transpose() * J;
+            A.diagonal() += lambda * A.diagonal().cwiseMax(std::numeric_limits<double>::epsilon());
+            const VectorXd dx = A.ldlt().solve(-g);
+
+            const VectorXd xnew = (x + dx).cwiseMax(lower).cwiseMin(upper);
+
+            const auto accepted = evaluate(xnew, rnew, Jnew) && 0.5 * rnew.squaredNorm() < f;
+            ++result.evaluations;
+
+            if(!accepted)
+            {
+                lambda = lambda > 0.0 ? 10.0 * lambda : 1.0e-3;
+                continue;
+            }
+
+            const auto stepnorm = (xnew - x).norm();
+
+            x = xnew;
+            r.swap(rnew);
+            J.swap(Jnew);
+            f = 0.5 * r.squaredNorm();
+            lambda = 0.1 * lambda;
+
+            if(stepnorm <= options.steptolerance * (1.0 + x.norm()))
+            {
+                result.succeeded = true;
+                break;
+            }
+        }
+
+        for(auto j = 0; j < Np; ++j)
+            params[j].value() = x[j];
+
+        result.params = x;
+        result.residuals = r;
+        result.jacobian = J;
+        result.objective = f;
+        result.equilibriums = numequilibriums.load() - numequilibriums0;
+        result.time = elapsed(tbegin);
+
+        return result;
+    }
+};
+
+EquilibriumFitting::EquilibriumFitting(EquilibriumFittingModel const& model)
+: pimpl(new Impl(model))
+{}
+
+EquilibriumFitting::EquilibriumFitting(EquilibriumFittingModelFn const& modelfn)
+: pimpl(new Impl(modelfn))
+{}
+
+EquilibriumFitting::EquilibriumFitting(EquilibriumFitting const& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+EquilibriumFitting::~EquilibriumFitting()
+{}
+
+auto EquilibriumFitting::operator=(EquilibriumFitting other) -> EquilibriumFitting&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto EquilibriumFitting::setOptions(EquilibriumFittingOptions const& options) -> void
+{
+    pimpl->setOptions(options);
+}
+
+auto EquilibriumFitting::addExperiment(EquilibriumFittingExperiment const& experiment) -> void
+{
+    pimpl->addExperiment(experiment);
+}
+
+auto EquilibriumFitting::system() const -> ChemicalSystem const&
+{
+    return pimpl->replicas[0]->model.system;
+}
+
+auto EquilibriumFitting::params() const -> Vec<Param> const&
+{
+    return pimpl->replicas[0]->model.params;
+}
+
+auto EquilibriumFitting::experiments() const -> Vec<EquilibriumFittingExperiment> const&
+{
+    return pimpl->experiments;
+}
+
+auto EquilibriumFitting::numObservations() const -> Index
+{
+    return pimpl->numobservations;
+}
+
+auto EquilibriumFitting::evaluate(VectorXdConstRef x, VectorXdRef r, MatrixXdRef J) -> bool
+{
+    return pimpl->evaluate(x, r, J);
+}
+
+auto EquilibriumFitting::fit() -> EquilibriumFittingResult
+{
+    VectorXd x0(params().size());
+    for(auto const& [j, param] : enumerate(params()))
+        x0[j] = param.value().val();
+    return pimpl->fit(x0);
+}
+
+auto EquilibriumFitting::fit(VectorXdConstRef x0) -> EquilibriumFittingResult
+{
+    return pimpl->fit(x0);
+}
+
+} // namespace Reaktoro
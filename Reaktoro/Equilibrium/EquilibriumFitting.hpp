@@ -0,0 +1,209 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+// Reaktoro includes
+#include <Reaktoro/Common/Matrix.hpp>
+#include <Reaktoro/Common/Types.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+#include <Reaktoro/Core/Param.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumOptions.hpp>
+
+namespace Reaktoro {
+
+/// The chemical system and its model parameters to be fitted to experimental data.
+/// @see EquilibriumFitting
+struct EquilibriumFittingModel
+{
+    /// The chemical system whose model parameters are fitted.
+    ChemicalSystem system;
+
+    /// The model parameters in the chemical system to be fitted, each with a unique identifier.
+    Vec<Param> params;
+};
+
+/// The function type that creates the chemical system and its model parameters to be fitted.
+/// This function is called once per thread of an EquilibriumFitting object
+/// constructed with it, so that each thread works with its own copy of the
+/// chemical system (e.g., by creating the Database object inside the
+/// function). The function may be called concurrently from different threads.
+using EquilibriumFittingModelFn = Fn<EquilibriumFittingModel()>;
+
+/// The function type that computes a measured quantity in terms of the amounts of the species (in mol).
+using EquilibriumFittingObservableFn = Fn<real(ArrayXrConstRef const& n)>;
+
+/// A measured quantity in an experiment and its value.
+struct EquilibriumFittingObservation
+{
+    /// The function that computes the measured quantity at the equilibrium state of the experiment.
+    EquilibriumFittingObservableFn fn;
+
+    /// The measured value of the quantity.
+    double value = 0.0;
+
+    /// The standard deviation of the measured value, used to scale its residual.
+    double stddev = 1.0;
+};
+
+/// An experiment with the conditions of a chemical equilibrium calculation and the quantities measured at equilibrium.
+struct EquilibriumFittingExperiment
+{
+    /// The temperature of the experiment (in K).
+    double T = 298.15;
+
+    /// The pressure of the experiment (in Pa).
+    double P = 1.0e+5;
+
+    /// The initial amounts of the species in the experiment (in mol), which determine the amounts of the elements.
+    ArrayXd n;
+
+    /// The quantities measured at the equilibrium state of the experiment.
+    Vec<EquilibriumFittingObservation> observations;
+};
+
+/// The options for the fitting of model parameters with EquilibriumFitting.
+struct EquilibriumFittingOptions
+{
+    /// The number of threads used to evaluate the experiments (zero means the number of hardware threads).
+    Index threads = 0;
+
+    /// The maximum number of iterations of the Levenberg-Marquardt algorithm.
+    Index maxiters = 100;
+
+    /// The tolerance for the infinity norm of the gradient of the objective function.
+    double tolerance = 1.0e-8;
+
+    /// The relative tolerance for the norm of the step in the model parameters.
+    double steptolerance = 1.0e-10;
+
+    /// The initial damping factor of the Levenberg-Marquardt algorithm (zero gives the Gauss-Newton algorithm while steps are accepted).
+    double lambda = 1.0e-3;
+
+    /// The flag that indicates if the Jacobian matrix of the residuals is computed with central finite differences instead of equilibrium sensitivities.
+    /// Finite differences require two additional equilibrium calculations per
+    /// experiment and model parameter. This option exists mainly to verify and
+    /// benchmark the Jacobian matrix computed with equilibrium sensitivities.
+    bool finitedifferences = false;
+
+    /// The relative step used in the finite difference approximation of the Jacobian matrix.
+    double finitedifferencestep = 1.0e-6;
+
+    /// The options for the equilibrium calculations of the experiments.
+    EquilibriumOptions equilibrium;
+};
+
+/// The result of the fitting of model parameters with EquilibriumFitting.
+struct EquilibriumFittingResult
+{
+    /// The flag that indicates if the fitting converged.
+    bool succeeded = false;
+
+    /// The fitted values of the model parameters.
+    VectorXd params;
+
+    /// The weighted residuals of the observations at the fitted model parameters.
+    VectorXd residuals;
+
+    /// The Jacobian matrix of the weighted residuals with respect to the model parameters.
+    MatrixXd jacobian;
+
+    /// The value of the objective function at the fitted model parameters (half the squared norm of the residuals).
+    double objective = 0.0;
+
+    /// The number of iterations of the Levenberg-Marquardt algorithm.
+    Index iterations = 0;
+
+    /// The number of evaluations of the residuals and their Jacobian matrix.
+    Index evaluations = 0;
+
+    /// The number of equilibrium calculations performed.
+    Index equilibriums = 0;
+
+    /// The time spent in the fitting (in s).
+    double time = 0.0;
+};
+
+/// Used to fit model parameters to experimental data of chemical equilibrium states.
+/// The weighted residuals of all observations are minimized in the least
+/// squares sense with a Levenberg-Marquardt algorithm. The Jacobian matrix of
+/// the residuals is assembled from the sensitivity derivatives of the species
+/// amounts with respect to the model parameters (see
+/// EquilibriumSensitivity::dndw), so that each evaluation requires one
+/// equilibrium calculation per experiment. The experiments are evaluated in
+/// parallel, and every experiment starts its calculation from its equilibrium
+/// state in the previous evaluation. All threads share a single chemical
+/// system, each reading the model parameters through its own ParamOverlay
+/// object, unless the fitting is constructed with a function that creates a
+/// copy of the model for each thread (see EquilibriumFittingModelFn).
+class EquilibriumFitting
+{
+public:
+    /// Construct an EquilibriumFitting object with given model to be fitted, shared by all threads.
+    explicit EquilibriumFitting(EquilibriumFittingModel const& model);
+
+    /// Construct an EquilibriumFitting object with given function that creates a copy of the model to be fitted for each thread.
+    explicit EquilibriumFitting(EquilibriumFittingModelFn const& modelfn);
+
+    /// Construct a copy of an EquilibriumFitting object.
+    EquilibriumFitting(EquilibriumFitting const& other);
+
+    /// Destroy this EquilibriumFitting object.
+    ~EquilibriumFitting();
+
+    /// Assign a copy of an EquilibriumFitting object to this.
+    auto operator=(EquilibriumFitting other) -> EquilibriumFitting&;
+
+    /// Set the options of the fitting.
+    auto setOptions(EquilibriumFittingOptions const& options) -> void;
+
+    /// Add an experiment to the fitting.
+    auto addExperiment(EquilibriumFittingExperiment const& experiment) -> void;
+
+    /// Return the chemical system of the model, which can be used to create the experiments.
+    auto system() const -> ChemicalSystem const&;
+
+    /// Return the model parameters to be fitted.
+    auto params() const -> Vec<Param> const&;
+
+    /// Return the experiments in the fitting.
+    auto experiments() const -> Vec<EquilibriumFittingExperiment> const&;
+
+    /// Return the number of observations in all experiments.
+    auto numObservations() const -> Index;
+
+    /// Evaluate the weighted residuals of the observations and their Jacobian matrix with given values of the model parameters.
+    /// @param x The values of the model parameters.
+    /// @param[out] r The weighted residuals of the observations.
+    /// @param[out] J The Jacobian matrix of the weighted residuals with respect to the model parameters.
+    /// @return True if the equilibrium calculations of all experiments succeeded.
+    auto evaluate(VectorXdConstRef x, VectorXdRef r, MatrixXdRef J) -> bool;
+
+    /// Fit the model parameters starting from their current values.
+    auto fit() -> EquilibriumFittingResult;
+
+    /// Fit the model parameters starting from given values.
+    auto fit(VectorXdConstRef x0) -> EquilibriumFittingResult;
+
+private:
+    struct Impl;
+
+    Ptr<Impl> pimpl;
+};
+
+} // namespace Reaktoro
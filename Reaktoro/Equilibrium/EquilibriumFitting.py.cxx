@@ -0,0 +1,89 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// pybind11 includes
+#include <Reaktoro/pybind11.hxx>
+
+// Reaktoro includes
+#include <Reaktoro/Equilibrium/EquilibriumFitting.hpp>
+using namespace Reaktoro;
+
+void exportEquilibriumFitting(py::module& m)
+{
+    py::class_<EquilibriumFittingModel>(m, "EquilibriumFittingModel")
+        .def(py::init<>())
+        .def(py::init<ChemicalSystem const&, Vec<Param> const&>())
+        .def_readwrite("system", &EquilibriumFittingModel::system, "The chemical system whose model parameters are fitted.")
+        .def_readwrite("params", &EquilibriumFittingModel::params, "The model parameters in the chemical system to be fitted, each with a unique identifier.")
+        ;
+
+    py::class_<EquilibriumFittingObservation>(m, "EquilibriumFittingObservation")
+        .def(py::init<>())
+        .def_readwrite("fn", &EquilibriumFittingObservation::fn, "The function that computes the measured quantity at the equilibrium state of the experiment.")
+        .def_readwrite("value", &EquilibriumFittingObservation::value, "The measured value of the quantity.")
+        .def_readwrite("stddev", &EquilibriumFittingObservation::stddev, "The standard deviation of the measured value, used to scale its residual.")
+        ;
+
+    py::class_<EquilibriumFittingExperiment>(m, "EquilibriumFittingExperiment")
+        .def(py::init<>())
+        .def_readwrite("T", &EquilibriumFittingExperiment::T, "The temperature of the experiment (in K).")
+        .def_readwrite("P", &EquilibriumFittingExperiment::P, "The pressure of the experiment (in Pa).")
+        .def_readwrite("n", &EquilibriumFittingExperiment::n, "The initial amounts of the species in the experiment (in mol).")
+        .def_readwrite("observations", &EquilibriumFittingExperiment::observations, "The quantities measured at the equilibrium state of the experiment.")
+        ;
+
+    py::class_<EquilibriumFittingOptions>(m, "EquilibriumFittingOptions")
+        .def(py::init<>())
+        .def_readwrite("threads", &EquilibriumFittingOptions::threads, "The number of threads used to evaluate the experiments (zero means the number of hardware threads).")
+        .def_readwrite("maxiters", &EquilibriumFittingOptions::maxiters, "The maximum number of iterations of the Levenberg-Marquardt algorithm.")
+        .def_readwrite("tolerance", &EquilibriumFittingOptions::tolerance, "The tolerance for the infinity norm of the gradient of the objective function.")
+        .def_readwrite("steptolerance", &EquilibriumFittingOptions::steptolerance, "The relative tolerance for the norm of the step in the model parameters.")
+        .def_readwrite("lambda_", &EquilibriumFittingOptions::lambda, "The initial damping factor of the Levenberg-Marquardt algorithm.")
+        .def_readwrite("finitedifferences", &EquilibriumFittingOptions::finitedifferences, "The flag that indicates if the Jacobian matrix of the residuals is computed with central finite differences.")
+        .def_readwrite("finitedifferencestep", &EquilibriumFittingOptions::finitedifferencestep, "The relative step used in the finite difference approximation of the Jacobian matrix.")
+        .def_readwrite("equilibrium", &EquilibriumFittingOptions::equilibrium, "The options for the equilibrium calculations of the experiments.")
+        ;
+
+    py::class_<EquilibriumFittingResult>(m, "EquilibriumFittingResult")
+        .def(py::init<>())
+        .def_readwrite("succeeded", &EquilibriumFittingResult::succeeded, "The flag that indicates if the fitting converged.")
+        .def_readwrite("params", &EquilibriumFittingResult::params, "The fitted values of the model parameters.")
+        .def_readwrite("residuals", &EquilibriumFittingResult::residuals, "The weighted residuals of the observations at the fitted model parameters.")
+        .def_readwrite("jacobian", &EquilibriumFittingResult::jacobian, "The Jacobian matrix of the weighted residuals with respect to the model parameters.")
+        .def_readwrite("objective", &EquilibriumFittingResult::objective, "The value of the objective function at the fitted model parameters.")
+        .def_readwrite("iterations", &EquilibriumFittingResult::iterations, "The number of iterations of the Levenberg-Marquardt algorithm.")
+        .def_readwrite("evaluations", &EquilibriumFittingResult::evaluations, "The number of evaluations of the residuals and their Jacobian matrix.")
+        .def_readwrite("equilibriums", &EquilibriumFittingResult::equilibriums, "The number of equilibrium calculations performed.")
+        .def_readwrite("time", &EquilibriumFittingResult::time, "The time spent in the fitting (in s).")
+        ;
+
+    // The Python functions given to EquilibriumFitting are called from the threads evaluating the experiments, so the GIL is released below
+    py::class_<EquilibriumFitting>(m, "EquilibriumFitting")
+        .def(py::init<EquilibriumFittingModel const&>())
+        .def(py::init<EquilibriumFittingModelFn const&>())
+        .def("setOptions", &EquilibriumFitting::setOptions, "Set the options of the fitting.")
+        .def("addExperiment", &EquilibriumFitting::addExperiment, "Add an experiment to the fitting.")
+        .def("system", &EquilibriumFitting::system, return_internal_ref, "Return the chemical system of the model, which can be used to create the experiments.")
+        .def("params", &EquilibriumFitting::params, return_internal_ref, "Return the model parameters to be fitted.")
+        .def("experiments", &EquilibriumFitting::experiments, return_internal_ref, "Return the experiments in the fitting.")
+        .def("numObservations", &EquilibriumFitting::numObservations, "Return the number of observations in all experiments.")
+        .def("evaluate", &EquilibriumFitting::evaluate, py::call_guard<py::gil_scoped_release>(), "Evaluate the weighted residuals of the observations and their Jacobian matrix with given values of the model parameters.")
+        .def("fit", py::overload_cast<>(&EquilibriumFitting::fit), py::call_guard<py::gil_scoped_release>(), "Fit the model parameters starting from their current values.")
+        .def("fit", py::overload_cast<VectorXdConstRef>(&EquilibriumFitting::fit), py::call_guard<py::gil_scoped_release>(), "Fit the model parameters starting from given values.")
+        ;
+}
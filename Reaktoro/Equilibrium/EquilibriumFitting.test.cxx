@@ -0,0 +1,176 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// Catch includes
+#include <catch2/catch.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Enumerate.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/Database.hpp>
+#include <Reaktoro/Core/Phases.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumFitting.hpp>
+using namespace Reaktoro;
+
+namespace test {
+
+/// Return a chemical system for calcite solubility with new Param objects for the standard Gibbs energies of the species.
+auto createCalciteSolubilityModel() -> EquilibriumFittingModel
+{
+    Map<String, Param> G0;
+    G0["H2O"]      = Param("G0[H2O]"     ,  -237181.72);
+    G0["H+"]       = Param("G0[H+]"      ,        0.00);
+    G0["OH-"]      = Param("G0[OH-]"     ,  -157297.48);
+    G0["Ca++"]     = Param("G0[Ca++]"    ,  -552790.08);
+    G0["CO2"]      = Param("G0[CO2]"     ,  -385974.00);
+    G0["HCO3-"]    = Param("G0[HCO3-]"   ,  -586939.89);
+    G0["CO3--"]    = Param("G0[CO3--]"   ,  -527983.14);
+    G0["CaCO3(s)"] = Param("G0[CaCO3(s)]", -1129177.92);
+
+    Database db;
+    for(auto [key, value] : G0)
+        db.addSpecies( Species(key).withStandardGibbsEnergy(value) );
+
+    Phases phases(db);
+    phases.add( AqueousPhase("H2O H+ OH- Ca++ CO2 HCO3- CO3--") );
+    phases.add( MineralPhase("CaCO3(s)") );
+
+    return { ChemicalSystem(phases), { G0["CaCO3(s)"] } };
+}
+
+} // namespace test
+
+TEST_CASE("Testing EquilibriumFitting", "[EquilibriumFitting]")
+{
+    EquilibriumFitting fitting(test::createCalciteSolubilityModel);
+
+    const auto& system = fitting.system();
+
+    const auto iH2O = system.species().index("H2O");
+    const auto iCa = system.species().index("Ca++");
+
+    // The molality of calcium in the aqueous solution
+    auto molalityCa = [=](ArrayXrConstRef const& n) -> real
+    {
+        return n[iCa] / (n[iH2O] * 0.018015268);
+    };
+
+    const auto G0true = -1129177.92;
+
+    CHECK( fitting.params().size() == 1 );
+    CHECK( fitting.params()[0].id() == "G0[CaCO3(s)]" );
+
+    EquilibriumFittingOptions options;
+    options.threads = 2;
+    fitting.setOptions(options);
+
+    // Create experiments at different temperatures and amounts of CO2, with observations to be computed below
+    for(auto T : { 25.0, 50.0, 75.0 })
+    {
+        for(auto nCO2 : { 1e-3, 1e-2, 1e-1 })
+        {
+            ChemicalState state(system);
+            state.setSpeciesAmounts(1e-16);
+            state.setSpeciesAmount("H2O", 55.508, "mol");
+            state.setSpeciesAmount("CO2", nCO2, "mol");
+            state.setSpeciesAmount("CaCO3(s)", 1.0, "mol");
+
+            EquilibriumFittingExperiment experiment;
+            experiment.T = T + 273.15;
+            experiment.P = 1.0e+5;
+            experiment.n = state.speciesAmounts().cast<double>();
+            experiment.observations = { { molalityCa, 0.0, 1.0e-5 } };
+
+            fitting.addExperiment(experiment);
+        }
+    }
+
+    const auto Nr = fitting.numObservations();
+
+    CHECK( Nr == 9 );
+
+    VectorXd r(Nr);
+    MatrixXd J(Nr, 1);
+
+    // Compute the synthetic measurements of calcium molality with the true value of the parameter
+    REQUIRE( fitting.evaluate(VectorXd{{G0true}}, r, J) );
+
+    EquilibriumFitting synthetic(test::createCalciteSolubilityModel);
+    synthetic.setOptions(options);
+    for(auto const& [k, experiment] : enumerate(fitting.experiments()))
+    {
+        auto copy = experiment;
+        copy.observations[0].value = r[k] * copy.observations[0].stddev;
+        synthetic.addExperiment(copy);
+    }
+
+    const VectorXd x0{{G0true + 2000.0}};
+
+    SECTION("Checking the Jacobian matrix computed with equilibrium sensitivities against finite differences")
+    {
+        VectorXd rsens(Nr), rfd(Nr);
+        MatrixXd Jsens(Nr, 1), Jfd(Nr, 1);
+
+        REQUIRE( synthetic.evaluate(x0, rsens, Jsens) );
+
+        options.finitedifferences = true;
+        synthetic.setOptions(options);
+
+        REQUIRE( synthetic.evaluate(x0, rfd, Jfd) );
+
+        CHECK( rsens.isApprox(rfd) );
+        CHECK( Jsens.isApprox(Jfd, 1e-4) );
+    }
+
+    SECTION("Checking the fitting recovers the true value of the parameter")
+    {
+        const auto result = synthetic.fit(x0);
+
+        CHECK( result.succeeded );
+        CHECK( result.params[0] == Approx(G0true) );
+        CHECK( result.objective == Approx(0.0).margin(1e-8) );
+        CHECK( result.equilibriums >= result.evaluations * Nr );
+        CHECK( double(synthetic.params()[0]) == Approx(G0true) );
+    }
+
+    SECTION("Checking the fitting with a chemical system shared by all threads")
+    {
+        EquilibriumFitting shared(test::createCalciteSolubilityModel());
+        shared.setOptions(options);
+        for(auto const& experiment : synthetic.experiments())
+            shared.addExperiment(experiment);
+
+        const auto param = shared.params()[0];
+
+        VectorXd rshared(Nr), rsynthetic(Nr);
+        MatrixXd Jshared(Nr, 1), Jsynthetic(Nr, 1);
+
+        REQUIRE( shared.evaluate(x0, rshared, Jshared) );
+        REQUIRE( synthetic.evaluate(x0, rsynthetic, Jsynthetic) );
+
+        CHECK( rshared.isApprox(rsynthetic) );
+        CHECK( Jshared.isApprox(Jsynthetic) );
+        CHECK( double(param) == Approx(G0true) ); // the evaluation above does not change the parameter outside the overlays of the threads
+
+        const auto result = shared.fit(x0);
+
+        CHECK( result.succeeded );
+        CHECK( result.params[0] == Approx(G0true) );
+        CHECK( double(param) == Approx(G0true) );
+    }
+}
@@ -17,7 +17,11 @@
 
 #include "EquilibriumHessian.hpp"
 
+// C++ includes
+#include <numeric>
+
 // Reaktoro includes
+#include <Reaktoro/Common/Algorithms.hpp>
 #include <Reaktoro/Common/MolalityUtils.hpp>
 #include <Reaktoro/Common/MoleFractionUtils.hpp>
 #include <Reaktoro/Core/ChemicalProps.hpp>
@@ -25,9 +29,7 @@
 
 namespace Reaktoro {
 
-using autodiff::jacobian;
-using autodiff::wrt;
-using autodiff::at;
+using autodiff::grad;
 
 struct EquilibriumHessian::Impl
 {
@@ -46,6 +48,21 @@ struct EquilibriumHessian::Impl
     /// The auxiliary vector of species amounts.
     VectorXr n;
 
+    /// The auxiliary vector of species chemical potentials.
+    VectorXr mu;
+
+    /// The index of the phase containing each species in the system.
+    Indices iphaseofspecies;
+
+    /// The index of the first species of each phase in the system.
+    Indices phaseoffsets;
+
+    /// The number of species in each phase of the system.
+    Indices phasesizes;
+
+    /// The indices of the phases whose activity models export data to other phases via ChemicalProps::extra (i.e., the aqueous phase when the system has ion exchange phases).
+    Indices iphasesexporting;
+
     /// The functions for each phase that assemble the block of approximate derivatives in ∂(µ/RT)/∂n.
     Vec<Fn<void(VectorXrConstRef, MatrixXdRef)>> approxfuncs;
 
@@ -65,6 +82,20 @@ struct EquilibriumHessian::Impl
         approxfuncs.resize(numphases);
         approxfuncsdiag.resize(numphases);
 
+        const auto hasionexchange = containsfn(system.phases(), RKT_LAMBDA(phase, phase.aggregateState() == AggregateState::IonExchange));
+
+        auto offset = 0;
+        for(auto const& phase : system.phases())
+        {
+            const auto size = phase.species().size();
+            phaseoffsets.push_back(offset);
+            phasesizes.push_back(size);
+            iphaseofspecies.insert(iphaseofspecies.end(), size, phaseoffsets.size() - 1);
+            if(hasionexchange && phase.aggregateState() == AggregateState::Aqueous)
+                iphasesexporting.push_back(phaseoffsets.size() - 1); // the aqueous state is used by the activity models of ion exchange phases
+            offset += size;
+        }
+
         auto iphase = 0;
 
         for(auto iphase = 0; iphase < numphases; ++iphase)
@@ -110,30 +141,83 @@ struct EquilibriumHessian::Impl
     auto exact(real const& T, real const& P, VectorXrConstRef const& nconst) -> MatrixXdConstRef
     {
         n = nconst;
-        auto fn = [&](VectorXrConstRef const& n) -> VectorXr
-        {
-            props.update(T, P, n);
-            return props.speciesChemicalPotentials();
-        };
-        const double RT = universalGasConstant * T;
-        dudn.noalias() = jacobian(fn, wrt(n), at(n))/RT;
+        dudn.fill(0.0); // clear previous state of dudn
+        Indices icols(n.size());
+        std::iota(icols.begin(), icols.end(), 0);
+        exactColumns(T, P, icols);
         return dudn;
     }
 
     auto partiallyExact(real const& T, real const& P, VectorXrConstRef const& nconst, VectorXlConstRef const& idxs) -> MatrixXdConstRef
     {
         n = nconst;
-        auto fn = [&](VectorXrConstRef const& n) -> VectorXr
-        {
-            props.update(T, P, n);
-            return props.speciesChemicalPotentials();
-        };
-        const double RT = universalGasConstant * T;
         dudn = approximate(n);
-        dudn(Eigen::all, idxs) = jacobian(fn, wrt(n(idxs)), at(n))/RT;
+        exactColumns(T, P, Indices(idxs.begin(), idxs.end()));
         return dudn;
     }
 
+    /// Evaluate the columns of ∂(µ/RT)/∂n corresponding to given species with exact derivatives.
+    /// Since the chemical potentials of the species in a phase depend only on
+    /// the amounts of the species in that phase, ∂(µ/RT)/∂n is block-diagonal
+    /// by phase, and the columns of species in different phases are computed
+    /// simultaneously in one forward automatic differentiation pass. The
+    /// columns of pure phase species are zero and need no pass. The columns
+    /// of species in phases that export data to other phases (i.e., the
+    /// aqueous phase when the system has ion exchange phases) are computed
+    /// one at a time and in full. The number of passes is thus the number of
+    /// requested species in exporting phases plus the largest number of
+    /// requested species in any other multi-species phase.
+    auto exactColumns(real const& T, real const& P, Indices const& icols) -> void
+    {
+        const auto numphases = system.phases().size();
+        const double RT = universalGasConstant * T;
+
+        Vec<Indices> icolsphases(numphases);
+        Index numpasses = 0;
+        for(auto i : icols)
+        {
+            const auto iphase = iphaseofspecies[i];
+            dudn.col(i).fill(0.0);
+            if(contains(iphasesexporting, iphase))
+            {
+                autodiff::seed(n[i]);
+                props.update(T, P, n);
+                mu = props.speciesChemicalPotentials();
+                dudn.col(i) = grad(mu)/RT;
+                autodiff::unseed(n[i]);
+                continue;
+            }
+            if(phasesizes[iphase] == 1)
+                continue; // the chemical potential of a pure phase species does not depend on n
+            icolsphases[iphase].push_back(i);
+            numpasses = std::max<Index>(numpasses, icolsphases[iphase].size());
+        }
+
+        Indices iseeded;
+        for(auto k = 0; k < numpasses; ++k)
+        {
+            iseeded.clear();
+            for(auto const& icolsphase : icolsphases)
+                if(k < icolsphase.size())
+                    iseeded.push_back(icolsphase[k]);
+
+            for(auto i : iseeded)
+                autodiff::seed(n[i]);
+
+            props.update(T, P, n);
+            mu = props.speciesChemicalPotentials();
+
+            for(auto i : iseeded)
+            {
+                const auto iphase = iphaseofspecies[i];
+                const auto offset = phaseoffsets[iphase];
+                const auto size = phasesizes[iphase];
+                dudn.col(i).segment(offset, size) = grad(mu.segment(offset, size))/RT;
+                autodiff::unseed(n[i]);
+            }
+        }
+    }
+
     auto approximate(VectorXrConstRef const& n) -> MatrixXdConstRef
     {
         dudn.fill(0.0); // clear previous state of dudn
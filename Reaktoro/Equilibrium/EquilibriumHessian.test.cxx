@@ -112,3 +112,42 @@ TEST_CASE("Testing EquilibriumHessian", "[EquilibriumHessian]")
         CHECK( dudn_partially_exact.isApprox(dudn_partially_exact_expected) );
     }
 }
+
+TEST_CASE("Testing EquilibriumHessian number of passes", "[EquilibriumHessian]")
+{
+    const ChemicalSystem basesystem = test::createChemicalSystem();
+
+    // Count the evaluations of the activity model of the aqueous phase (one per automatic differentiation pass)
+    Index numpasses = 0;
+
+    Vec<Phase> phases = basesystem.phases().data();
+    const ActivityModel aqueousmodel = phases[0].activityModel();
+    phases[0] = phases[0].withActivityModel([=, &numpasses](ActivityPropsRef props, ActivityModelArgs args)
+    {
+        ++numpasses;
+        aqueousmodel(props, args);
+    });
+
+    ChemicalSystem system(basesystem.database(), phases);
+
+    const auto Nn = system.species().size();
+
+    ChemicalState state(system);
+    for(auto i = 0; i < Nn; ++i)
+        state.setSpeciesAmount(i, 0.1 * (i + 1), "mol");
+    state.set("H2O(aq)", 1.0, "kg");
+
+    EquilibriumHessian hessian(system);
+
+    numpasses = 0;
+    hessian.exact(state.temperature(), state.pressure(), state.speciesAmounts());
+
+    // The system has an aqueous phase with 19 species, a gaseous phase with 6
+    // species and 4 pure mineral phases, and no ion exchange phase. Thus, the
+    // columns of the aqueous and gaseous species are computed together and
+    // the columns of the pure mineral species need no pass.
+    CHECK( system.phase(0).species().size() == 19 );
+    CHECK( system.phase(1).species().size() == 6 );
+    CHECK( Nn == 29 );
+    CHECK( numpasses == 19 );
+}
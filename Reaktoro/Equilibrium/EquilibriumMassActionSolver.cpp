@@ -0,0 +1,273 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "EquilibriumMassActionSolver.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <limits>
+
+// Eigen includes
+#include <Eigen/LU>
+#include <Eigen/QR>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Constants.hpp>
+#include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Core/ChemicalProps.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumOptions.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumReactions.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumResult.hpp>
+#include <Reaktoro/Water/WaterConstants.hpp>
+
+namespace Reaktoro {
+
+namespace {
+
+/// The maximum change allowed in the logarithm of the amount of a master species in one Newton step.
+const auto MAX_LN_STEP = 4.0;
+
+/// The maximum value allowed for the logarithm of the amount of a species (to avoid overflow in early iterations).
+const auto MAX_LN_AMOUNT = 300.0;
+
+} // namespace
+
+struct EquilibriumMassActionSolver::Impl
+{
+    /// The chemical system associated with this equilibrium solver.
+    const ChemicalSystem system;
+
+    /// The equilibrium reactions forming the secondary species from the master species.
+    EquilibriumReactions reactions;
+
+    /// The options of the equilibrium solver.
+    EquilibriumOptions options;
+
+    /// The chemical properties of the system used to evaluate activity coefficients during the calculation.
+    ChemicalProps props;
+
+    /// The index of the water species in the system.
+    Index iH2O;
+
+    /// Construct an EquilibriumMassActionSolver::Impl object.
+    Impl(ChemicalSystem const& system)
+    : system(system), reactions(system), props(system)
+    {
+        errorif(system.phases().size() != 1 || system.phase(0).aggregateState() != AggregateState::Aqueous,
+            "EquilibriumMassActionSolver (i.e., EquilibriumMethod::LawOfMassAction) "
+            "can only be used with chemical systems containing a single aqueous phase.");
+
+        iH2O = system.phase(0).species().findWithFormula("H2O");
+
+        errorif(iH2O >= system.species().size(),
+            "EquilibriumMassActionSolver (i.e., EquilibriumMethod::LawOfMassAction) "
+            "requires the aqueous phase to contain the species H2O.");
+    }
+
+    /// Equilibrate a chemical state at its current temperature and pressure.
+    auto solve(ChemicalState& state, ArrayXdConstRef b) -> EquilibriumResult
+    {
+        EquilibriumResult result;
+
+        const auto Nn = system.species().size();
+
+        const real T = state.temperature();
+        const real P = state.pressure();
+        const auto RT = universalGasConstant * T.val();
+
+        ArrayXd n = state.speciesAmounts().cast<double>();
+
+        // Choose as master species the most abundant species in the initial state (water always first)
+        ArrayXd weights = n;
+        weights[iH2O] = std::numeric_limits<double>::max();
+        reactions.setMasterSpeciesPriorityWeights(weights);
+
+        // Ensure no species has zero amount when evaluating activity coefficients
+        n = n.max(options.epsilon);
+
+        auto const& imaster = reactions.indicesMasterSpecies();
+        auto const& isecondary = reactions.indicesSecondarySpecies();
+        auto const& S = reactions.masterStoichiometricMatrix();
+
+        const auto Nm = imaster.size();
+        const auto Ns = isecondary.size();
+
+        const Index iw = std::find(imaster.begin(), imaster.end(), iH2O) - imaster.begin(); // the position of water among the master species
+
+        errorif(iw >= Nm, "Expecting H2O to be a master species in EquilibriumMassActionSolver.");
+
+        // The amounts of the master species b̃ satisfying Am b̃ = b, so that mass balance is written as nm + S ns = b̃
+        const MatrixXd Am = system.formulaMatrix()(Eigen::all, imaster);
+        const VectorXd bm = Am.colPivHouseholderQr().solve(b.matrix());
+
+        // The standard Gibbs energies of the species (constant at fixed temperature and pressure)
+        props.update(T, P, n.cast<real>());
+        const ArrayXd G0 = props.speciesStandardGibbsEnergies().cast<double>() / RT;
+
+        // The stoichiometric coefficients of the secondary species with respect to the solute master species
+        // and the coefficient D of water in the derivatives of ln(ns) with respect to ln(nw)
+        ArrayXd D = ArrayXd::Ones(Ns);
+        for(auto k = 0; k < Nm; ++k)
+            if(k != iw)
+                D -= S.row(k).transpose().array();
+
+        // The lower bound for the logarithm of the amounts of the master species
+        const auto ymin = std::log(options.epsilon);
+
+        // The initial guess for the logarithm of the amounts of the master species
+        VectorXd y(Nm);
+        for(auto k = 0; k < Nm; ++k)
+        {
+            const auto i = imaster[k];
+            y[k] = std::log(n[i] > options.epsilon ? n[i] : bm[k] > 0.0 ? bm[k] : 1e-10);
+        }
+
+        VectorXd q(Nm);     // the normalized chemical potentials of the master species
+        VectorXd ns(Ns);    // the amounts of the secondary species
+        VectorXd F(Nm);     // the residuals of the mass balance equations
+        VectorXd scale(Nm); // the scaling factors of the residuals
+        MatrixXd J(Nm, Nm); // the Jacobian of the residuals with respect to y
+        ArrayXd lng = ArrayXd::Zero(Nn); // the ln activity coefficients of the species
+        ArrayXd lngprev = lng;
+
+        const auto& tol = options.mass_action_tolerance;
+
+        auto& iters = result.optima.iterations;
+        auto& succeeded = result.optima.succeeded;
+
+        succeeded = false;
+
+        for(iters = 1; iters <= options.mass_action_maxiters; ++iters)
+        {
+            // Update the activity coefficients of the species and the activity of water at the current species amounts
+            n(imaster) = y.array().exp();
+            props.update(T, P, n.cast<real>());
+            lngprev = lng;
+            lng = props.speciesActivityCoefficientsLn().cast<double>();
+            const double lnaw = props.speciesActivityLn(iH2O).val();
+
+            // The logarithm of the mass of water (in kg) used to convert molalities of solutes into amounts
+            const auto lnkgw = y[iw] + std::log(waterMolarMass);
+
+            // Compute the chemical potentials of the master species (divided by RT)
+            for(auto k = 0; k < Nm; ++k)
+            {
+                const auto i = imaster[k];
+                q[k] = (k == iw) ? G0[i] + lnaw : G0[i] + lng[i] + y[k] - lnkgw;
+            }
+
+            // Compute the amounts of the secondary species using their mass-action equations
+            for(auto j = 0; j < Ns; ++j)
+            {
+                const auto i = isecondary[j];
+                const auto lnns = S.col(j).dot(q) - G0[i] - lng[i] + lnkgw;
+                ns[j] = std::exp(std::min(lnns, MAX_LN_AMOUNT));
+            }
+
+            n(isecondary) = ns.array();
+
+            // Compute the residuals of the mass balance equations and their scaling factors
+            F = y.array().exp().matrix() + S * ns - bm;
+            scale = y.array().exp().matrix() + S.cwiseAbs() * ns;
+            scale = scale.cwiseMax(bm.cwiseAbs());
+
+            // Compute the Jacobian of the residuals with respect to y = ln(nm)
+            J.noalias() = S * ns.asDiagonal() * S.transpose();
+            J.col(iw) = S * (ns.array() * D).matrix();
+            J.diagonal() += y.array().exp().matrix();
+
+            // Fix master species whose amounts cannot decrease further and are in excess
+            for(auto k = 0; k < Nm; ++k)
+            {
+                if(y[k] <= ymin && F[k] > 0.0)
+                {
+                    J.row(k).setZero();
+                    J(k, k) = 1.0;
+                    F[k] = 0.0;
+                }
+            }
+
+            // Check for convergence (the activity coefficients should also no longer change)
+            const auto converged_residuals = (F.cwiseAbs().array() <= tol * scale.array()).all();
+            const auto converged_activities = (lng - lngprev).abs().maxCoeff() <= std::sqrt(tol);
+
+            if(converged_residuals && converged_activities)
+            {
+                succeeded = true;
+                break;
+            }
+
+            // Compute the Newton step and limit its length
+            VectorXd dy = J.partialPivLu().solve(-F);
+            const auto dymax = dy.cwiseAbs().maxCoeff();
+            if(dymax > MAX_LN_STEP)
+                dy *= MAX_LN_STEP / dymax;
+
+            if(!dy.allFinite())
+                break;
+
+            y = (y + dy).cwiseMax(ymin).cwiseMin(MAX_LN_AMOUNT);
+        }
+
+        iters = std::min<Index>(iters, options.mass_action_maxiters);
+
+        // Update the chemical properties in the state at the computed species amounts
+        n(imaster) = y.array().exp();
+        props.update(T, P, n.cast<real>());
+
+        state.setSpeciesAmounts(n);
+        state.props() = props;
+
+        return result;
+    }
+};
+
+EquilibriumMassActionSolver::EquilibriumMassActionSolver(ChemicalSystem const& system)
+: pimpl(new Impl(system))
+{}
+
+EquilibriumMassActionSolver::EquilibriumMassActionSolver(EquilibriumMassActionSolver const& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+EquilibriumMassActionSolver::~EquilibriumMassActionSolver()
+{}
+
+auto EquilibriumMassActionSolver::operator=(EquilibriumMassActionSolver other) -> EquilibriumMassActionSolver&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto EquilibriumMassActionSolver::setOptions(EquilibriumOptions const& options) -> void
+{
+    pimpl->options = options;
+}
+
+auto EquilibriumMassActionSolver::solve(ChemicalState& state, ArrayXdConstRef b) -> EquilibriumResult
+{
+    return pimpl->solve(state, b);
+}
+
+auto EquilibriumMassActionSolver::reactions() const -> EquilibriumReactions const&
+{
+    return pimpl->reactions;
+}
+
+} // namespace Reaktoro
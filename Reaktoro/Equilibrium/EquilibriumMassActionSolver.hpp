@@ -0,0 +1,77 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Reaktoro includes
+#include <Reaktoro/Common/Matrix.hpp>
+#include <Reaktoro/Common/Types.hpp>
+
+namespace Reaktoro {
+
+// Forward declarations
+class ChemicalState;
+class ChemicalSystem;
+class EquilibriumReactions;
+struct EquilibriumOptions;
+struct EquilibriumResult;
+
+/// Used for calculating chemical equilibrium states of aqueous systems using law-of-mass-action equations.
+/// This solver computes the speciation of a chemical system containing a
+/// single aqueous phase at given temperature, pressure, and amounts of
+/// conservative components (elements and electric charge). Only the amounts
+/// of the master species are unknowns (see EquilibriumReactions). The amounts
+/// of the secondary species are eliminated using the mass-action equations of
+/// the reactions that form them from the master species, and the resulting
+/// mass balance equations are solved with a Newton method on the logarithms of
+/// the amounts of the master species. The activity coefficients of the
+/// species and the activity of water are updated at every iteration.
+/// @note This class is used by EquilibriumSolver when
+/// EquilibriumOptions::method is EquilibriumMethod::LawOfMassAction.
+class EquilibriumMassActionSolver
+{
+public:
+    /// Construct an EquilibriumMassActionSolver object with given chemical system.
+    explicit EquilibriumMassActionSolver(ChemicalSystem const& system);
+
+    /// Construct a copy of an EquilibriumMassActionSolver object.
+    EquilibriumMassActionSolver(EquilibriumMassActionSolver const& other);
+
+    /// Destroy this EquilibriumMassActionSolver object.
+    ~EquilibriumMassActionSolver();
+
+    /// Assign a copy of an EquilibriumMassActionSolver object to this.
+    auto operator=(EquilibriumMassActionSolver other) -> EquilibriumMassActionSolver&;
+
+    /// Set the options of the equilibrium solver.
+    auto setOptions(EquilibriumOptions const& options) -> void;
+
+    /// Equilibrate a chemical state at its current temperature and pressure.
+    /// @param[in,out] state The initial guess for the calculation (in) and the computed equilibrium state (out)
+    /// @param b The amounts of the conservative components (elements and electric charge) in the system.
+    auto solve(ChemicalState& state, ArrayXdConstRef b) -> EquilibriumResult;
+
+    /// Return the equilibrium reactions used in the last calculation.
+    auto reactions() const -> EquilibriumReactions const&;
+
+private:
+    struct Impl;
+
+    Ptr<Impl> pimpl;
+};
+
+} // namespace Reaktoro
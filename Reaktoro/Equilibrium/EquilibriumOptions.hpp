@@ -20,6 +20,9 @@
 // Optima includes
 #include <Optima/Options.hpp>
 
+// Reaktoro includes
+#include <Reaktoro/Common/Index.hpp>
+
 namespace Reaktoro {
 
 /// The options for the description of the Hessian of the Gibbs energy function
@@ -38,6 +41,22 @@ enum class GibbsHessian
     ApproxDiagonal,
 };
 
+/// The methods available for the solution of chemical equilibrium problems
+enum class EquilibriumMethod
+{
+    /// The chemical equilibrium state is computed by minimizing the Gibbs energy of the system with all species amounts as unknowns.
+    GibbsEnergyMinimization,
+
+    /// The chemical equilibrium state is computed by solving law-of-mass-action equations for the amounts of master species only.
+    /// In this method, the secondary species are eliminated from the problem
+    /// using the mass-action equations of the reactions that form them from
+    /// the master species (see EquilibriumReactions), and only the mass
+    /// balance equations for the master species are solved. This method is
+    /// currently restricted to systems with a single aqueous phase and
+    /// equilibrium specifications with given temperature and pressure.
+    LawOfMassAction,
+};
+
 /// The options for the equilibrium calculations
 struct EquilibriumOptions
 {
@@ -66,6 +85,58 @@ struct EquilibriumOptions
 
     /// The calculation mode of the Hessian of the Gibbs energy function
     GibbsHessian hessian = GibbsHessian::PartiallyExact;
+
+    /// The method used to solve the chemical equilibrium problem.
+    EquilibriumMethod method = EquilibriumMethod::GibbsEnergyMinimization;
+
+    /// The relative tolerance for the residuals of the mass balance equations when using EquilibriumMethod::LawOfMassAction.
+    double mass_action_tolerance = 1e-10;
+
+    /// The maximum number of iterations when using EquilibriumMethod::LawOfMassAction.
+    Index mass_action_maxiters = 100;
+
+    /// The flag indicating if the Hessian of the Gibbs energy function should be reused when possible.
+    /// Setting this flag to true causes the Hessian matrix computed in one
+    /// iteration to be kept frozen in the next ones (a modified Newton
+    /// approach), including across consecutive warm-started calculations
+    /// performed with the same solver (e.g., successive time steps in
+    /// chemical kinetics and reactive transport simulations). The Hessian
+    /// matrix is only refreshed when the convergence rate degrades (see @ref
+    /// hessian_reuse_contraction), when the set of basic variables changes,
+    /// or when it has been reused too many times (see @ref
+    /// hessian_reuse_max_age). The Hessian matrix is never reused when
+    /// computing sensitivity derivatives.
+    bool hessian_reuse = false;
+
+    /// The maximum ratio between the lengths of two consecutive steps for which a frozen Hessian is still considered adequate.
+    /// A frozen Hessian is refreshed once the length of the current step
+    /// relative to the length of the previous one exceeds this value,
+    /// indicating that the convergence rate has degraded.
+    double hessian_reuse_contraction = 0.5;
+
+    /// The maximum number of consecutive iterations in which a frozen Hessian can be reused before it is refreshed.
+    Index hessian_reuse_max_age = 10;
+
+    /// The flag indicating if clearly unstable phases should be removed from the equilibrium problem before it is solved.
+    /// Setting this flag to true causes the phases that are absent in the
+    /// initial chemical state (i.e., with all species amounts near their
+    /// lower bounds) to be tested for stability before a warm-started
+    /// equilibrium calculation. The test uses the chemical potentials of the
+    /// species in the initial state to compute the tangent-plane distance of
+    /// each phase (normalized by *RT*), which for a pure mineral phase is its
+    /// saturation index times @eq{-\ln 10}. The amounts of the species in
+    /// phases with a tangent-plane distance greater than @ref
+    /// phase_prescreening_threshold are then kept fixed at their lower bounds
+    /// during the calculation, reducing the number of variables in the
+    /// optimization problem. Once the calculation converges, the pruned phases
+    /// are tested again, and those that have become supersaturated are
+    /// re-admitted and the calculation is resumed. This pre-screening is not
+    /// performed when computing sensitivity derivatives or when the initial
+    /// state does not result from a previous equilibrium calculation.
+    bool phase_prescreening = false;
+
+    /// The minimum tangent-plane distance (normalized by *RT*) of an absent phase for it to be removed from the equilibrium problem (see @ref phase_prescreening).
+    double phase_prescreening_threshold = 5.0;
 };
 
 } // namespace Reaktoro
@@ -24,10 +24,23 @@ using namespace Reaktoro;
 
 void exportEquilibriumOptions(py::module& m)
 {
+    py::enum_<EquilibriumMethod>(m, "EquilibriumMethod")
+        .value("GibbsEnergyMinimization", EquilibriumMethod::GibbsEnergyMinimization)
+        .value("LawOfMassAction", EquilibriumMethod::LawOfMassAction)
+        ;
+
     py::class_<EquilibriumOptions>(m, "EquilibriumOptions")
         .def(py::init<>())
         .def_readwrite("optima", &EquilibriumOptions::optima)
         .def_readwrite("epsilon", &EquilibriumOptions::epsilon)
         .def_readwrite("use_ideal_activity_models", &EquilibriumOptions::use_ideal_activity_models)
+        .def_readwrite("method", &EquilibriumOptions::method)
+        .def_readwrite("mass_action_tolerance", &EquilibriumOptions::mass_action_tolerance)
+        .def_readwrite("mass_action_maxiters", &EquilibriumOptions::mass_action_maxiters)
+        .def_readwrite("hessian_reuse", &EquilibriumOptions::hessian_reuse)
+        .def_readwrite("hessian_reuse_contraction", &EquilibriumOptions::hessian_reuse_contraction)
+        .def_readwrite("hessian_reuse_max_age", &EquilibriumOptions::hessian_reuse_max_age)
+        .def_readwrite("phase_prescreening", &EquilibriumOptions::phase_prescreening)
+        .def_readwrite("phase_prescreening_threshold", &EquilibriumOptions::phase_prescreening_threshold)
         ;
 }
@@ -85,6 +85,11 @@ struct EquilibriumPredictor::Impl
         errorif(state0.equilibrium().w().size() == 0,
             "EquilibriumPredictor expects a ChemicalState object that "
             "has been used in a call to EquilibriumSolver::solve.");
+        errorif(sensitivity0.dudw().size() == 0 || sensitivity0.dudc().size() == 0,
+            "EquilibriumPredictor expects an EquilibriumSensitivity object "
+            "with the derivatives of the chemical properties *u*, but these "
+            "were not computed. Do not use requestProperties(false) in the "
+            "EquilibriumSensitivity object given to EquilibriumSolver::solve.");
     }
 
     auto predict(ChemicalState& state, EquilibriumConditions const& conditions) const -> void
@@ -153,6 +158,31 @@ struct EquilibriumPredictor::Impl
         return mui0 + dmuidw0.dot(dw) + dmuidc0.dot(dc);
     }
 
+    /// Perform a first-order Taylor prediction of the chemical potentials of selected species at many given conditions at once.
+    auto speciesChemicalPotentialsPredicted(Indices const& ispecies, MatrixXdConstRef const& dw, MatrixXdConstRef const& dc) const -> MatrixXd
+    {
+        assert(dw.cols() == dc.cols());
+
+        const auto dudw0 = sensitivity0.dudw(); // The derivatives *du/dw* of the chemical properties of the chemical system wrt *w*.
+        const auto dudc0 = sensitivity0.dudc(); // The derivatives *du/dc* of the chemical properties of the chemical system wrt *c*.
+
+        // The indices of the chemical potentials of the selected species in *u*
+        Indices irows(ispecies.size());
+        for(auto k = 0; k < ispecies.size(); ++k)
+            irows[k] = Nu - Nn + ispecies[k];
+
+        // Pack the rows of the selected species so that the predictions below are computed with matrix-matrix products
+        const MatrixXd dmudw0 = dudw0(irows, Eigen::all);
+        const MatrixXd dmudc0 = dudc0(irows, Eigen::all);
+
+        MatrixXd mu(irows.size(), dw.cols());
+        mu.noalias() = dmudw0 * dw;
+        mu.noalias() += dmudc0 * dc;
+        mu.colwise() += u0(irows);
+
+        return mu;
+    }
+
     /// Return the chemical potential of a species at given reference conditions.
     auto speciesChemicalPotentialReference(Index i) const -> double
     {
@@ -193,6 +223,11 @@ auto EquilibriumPredictor::speciesChemicalPotentialPredicted(Index ispecies, Vec
     return pimpl->speciesChemicalPotentialPredicted(ispecies, dw, dc);
 }
 
+auto EquilibriumPredictor::speciesChemicalPotentialsPredicted(Indices const& ispecies, MatrixXdConstRef const& dw, MatrixXdConstRef const& dc) const -> MatrixXd
+{
+    return pimpl->speciesChemicalPotentialsPredicted(ispecies, dw, dc);
+}
+
 auto EquilibriumPredictor::speciesChemicalPotentialReference(Index ispecies) const -> double
 {
     return pimpl->speciesChemicalPotentialReference(ispecies);
@@ -34,7 +34,7 @@ class EquilibriumPredictor
 public:
     /// Construct a EquilibriumPredictor object.
     /// @param state0 The reference chemical equilibrium state from which first-order Taylor predictions are made.
-    /// @param sensitivity0 The sensitivity derivatives of the chemical equilibrium state at the reference point.
+    /// @param sensitivity0 The sensitivity derivatives of the chemical equilibrium state at the reference point (including those of the chemical properties, see EquilibriumSensitivity::requestProperties).
     EquilibriumPredictor(ChemicalState const& state0, EquilibriumSensitivity const& sensitivity0);
 
     /// Construct a copy of a EquilibriumPredictor object.
@@ -60,6 +60,16 @@ public:
     /// Perform a first-order Taylor prediction of the chemical potential of a species at given conditions.
     auto speciesChemicalPotentialPredicted(Index ispecies, VectorXdConstRef const& dw, VectorXdConstRef const& dc) const -> double;
 
+    /// Perform a first-order Taylor prediction of the chemical potentials of selected species at many given conditions at once.
+    /// The predictions are computed with matrix-matrix products, which is
+    /// considerably faster than calling @ref speciesChemicalPotentialPredicted
+    /// for each species and each condition.
+    /// @param ispecies The indices of the species whose chemical potentials are predicted.
+    /// @param dw The changes in the values of the input variables *w* (one column per condition).
+    /// @param dc The changes in the values of the initial amounts of conservative components *c* (one column per condition).
+    /// @return The predicted chemical potentials (one row per selected species, one column per condition).
+    auto speciesChemicalPotentialsPredicted(Indices const& ispecies, MatrixXdConstRef const& dw, MatrixXdConstRef const& dc) const -> MatrixXd;
+
     /// Return the chemical potential of a species at given reference conditions.
     auto speciesChemicalPotentialReference(Index ispecies) const -> double;
 
@@ -32,6 +32,7 @@ void exportEquilibriumProjector(py::module& m)
         .def("predict", py::overload_cast<ChemicalState&, EquilibriumConditions const&>(&EquilibriumPredictor::predict, py::const_), "Perform a first-order Taylor prediction of the chemical state at given conditions.")
         .def("predict", py::overload_cast<ChemicalState&, VectorXdConstRef const&, VectorXdConstRef const&>(&EquilibriumPredictor::predict, py::const_), "Perform a first-order Taylor prediction of the chemical state at given conditions.")
         .def("speciesChemicalPotentialPredicted", &EquilibriumPredictor::speciesChemicalPotentialPredicted, "Perform a first-order Taylor prediction of the chemical potential of a species at given conditions.")
+        .def("speciesChemicalPotentialsPredicted", &EquilibriumPredictor::speciesChemicalPotentialsPredicted, "Perform a first-order Taylor prediction of the chemical potentials of selected species at many given conditions at once.")
         .def("speciesChemicalPotentialReference", &EquilibriumPredictor::speciesChemicalPotentialReference, "Return the chemical potential of a species at given reference conditions.")
         ;
 }
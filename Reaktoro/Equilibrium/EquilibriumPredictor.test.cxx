@@ -19,6 +19,7 @@
 #include <catch2/catch.hpp>
 
 // Reaktoro includes
+#include <Reaktoro/Common/Algorithms.hpp>
 #include <Reaktoro/Core/ChemicalState.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumConditions.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumDims.hpp>
@@ -158,6 +159,24 @@ TEST_CASE("Testing EquilibriumPredictor", "[EquilibriumPredictor]")
             CHECK( predictor.speciesChemicalPotentialReference(i) == Approx(props0.speciesChemicalPotential(i)) );
             CHECK( predictor.speciesChemicalPotentialPredicted(i, dw, dc) == Approx(props.speciesChemicalPotential(i)) );
         }
+
+        // Check EquilibriumPredictor::speciesChemicalPotentialsPredicted with many conditions at once
+        const Indices ispecies = range<Index>(n.size());
+        MatrixXd dW(dw.size(), 3);
+        MatrixXd dC(dc.size(), 3);
+        dW << 0.0*dw, 0.5*dw, dw;
+        dC << 0.0*dc, 0.5*dc, dc;
+        const MatrixXd mu = predictor.speciesChemicalPotentialsPredicted(ispecies, dW, dC);
+
+        CHECK( mu.rows() == n.size() );
+        CHECK( mu.cols() == 3 );
+
+        for(auto i = 0; i < n.size(); ++i)
+        {
+            CHECK( mu(i, 0) == Approx(predictor.speciesChemicalPotentialReference(i)) );
+            CHECK( mu(i, 1) == Approx(predictor.speciesChemicalPotentialPredicted(i, 0.5*dw, 0.5*dc)) );
+            CHECK( mu(i, 2) == Approx(props.speciesChemicalPotential(i)) );
+        }
     }
 
     SECTION("when the system is closed, temperature and pressure given, O2 is a meta-stable basic species - sensitivity derivatives should be zero")
@@ -322,4 +341,28 @@ TEST_CASE("Testing EquilibriumPredictor", "[EquilibriumPredictor]")
             CHECK( predictor.speciesChemicalPotentialPredicted(i, dw, dc) == Approx(props.speciesChemicalPotential(i)) );
         }
     }
+
+    SECTION("when the sensitivity derivatives of the chemical properties were not requested")
+    {
+        EquilibriumSpecs specs(system);
+        specs.temperature();
+        specs.pressure();
+
+        EquilibriumConditions conditions0(specs);
+        conditions0.temperature(300.0);
+        conditions0.pressure(1.0e5);
+
+        ChemicalState state0(system);
+        state0.set("H2O" , 55.00, "mol");
+        state0.set("NaCl", 0.100, "mol");
+        state0.set("O2"  , 0.001, "mol");
+
+        EquilibriumSensitivity sensitivity0(specs);
+        sensitivity0.requestProperties(false);
+
+        EquilibriumSolver solver(specs);
+        solver.solve(state0, sensitivity0, conditions0);
+
+        CHECK_THROWS( EquilibriumPredictor(state0, sensitivity0) );
+    }
 }
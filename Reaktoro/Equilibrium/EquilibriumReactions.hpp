@@ -1,93 +1,101 @@
-// // Reaktoro is a unified framework for modeling chemically reactive systems.
-// //
-// // Copyright © 2014-2022 Allan Leal
-// //
-// // This library is free software; you can redistribute it and/or
-// // modify it under the terms of the GNU Lesser General Public
-// // License as published by the Free Software Foundation; either
-// // version 2.1 of the License, or (at your option) any later version.
-// //
-// // This library is distributed in the hope that it will be useful,
-// // but WITHOUT ANY WARRANTY; without even the implied warranty of
-// // MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
-// // Lesser General Public License for more details.
-// //
-// // You should have received a copy of the GNU Lesser General Public License
-// // along with this library. If not, see <http://www.gnu.org/licenses/>.
-
-// #pragma once
-
-// // C++ includes
-// #include <memory>
-// #include <string>
-// #include <vector>
-
-// // Reaktoro includes
-// #include <Reaktoro/Common/Index.hpp>
-// #include <Reaktoro/Common/Matrix.hpp>
-// #include <Reaktoro/Math/LU.hpp>
-
-// namespace Reaktoro {
-
-// // Forward declarations
-// class ChemicalSystem;
-// class Partition;
-// class ReactionEquation;
-
-// /// A class that generates a system of equilibrium reactions written in terms of master and secondary species.
-// class EquilibriumReactions
-// {
-// public:
-//     /// Construct an EquilibriumReactions instance.
-//     EquilibriumReactions(const ChemicalSystem& system);
-
-//     /// Construct an EquilibriumReactions instance
-//     EquilibriumReactions(const ChemicalSystem& system, const Partition& partition);
-
-//     /// Construct a copy of an EquilibriumReactions instance
-//     EquilibriumReactions(const EquilibriumReactions& other);
-
-//     /// Destroy this EquilibriumReactions instance.
-//     virtual ~EquilibriumReactions();
-
-//     /// Assign other EquilibriumReactions instance to this.
-//     auto operator=(EquilibriumReactions other) -> EquilibriumReactions&;
-
-//     /// Return the chemical system for which the equilibrium reactions were defined.
-//     auto system() const -> const ChemicalSystem&;
-
-//     /// Return the partition of the chemical system for which the equilibrium reactions were defined.
-//     auto partition() const -> const Partition&;
-
-//     /// Set the master species manually.
-//     /// @param ispecies The global indices of the master species.
-//     auto setMasterSpecies(Indices ispecies) -> void;
-
-//     /// Set the master species manually.
-//     /// @param species The names of the master species.
-//     auto setMasterSpecies(std::vector<std::string> species) -> void;
-
-//     /// Return the indices of the master species.
-//     /// The master species are those that serve as building blocks for the secondary species.
-//     auto indicesMasterSpecies() const -> Indices;
-
-//     /// Return the indices of the secondary species.
-//     /// The secondary species are those that are constructed from master species.
-//     auto indicesSecondarySpecies() const -> Indices;
-
-//     /// Return the equations of the equilibrium reactions.
-//     auto equations() const -> std::vector<ReactionEquation>;
-
-//     /// Return the stoichiometric matrix of the reactions.
-//     auto stoichiometricMatrix() const -> MatrixXd;
-
-//     /// Return the LU decomposition of the formula matrix `A`.
-//     auto lu() const -> const LU&;
-
-// private:
-//     struct Impl;
-
-//     std::unique_ptr<Impl> pimpl;
-// };
-
-// } // namespace Reaktoro
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Reaktoro includes
+#include <Reaktoro/Common/Matrix.hpp>
+#include <Reaktoro/Common/Types.hpp>
+
+namespace Reaktoro {
+
+// Forward declarations
+class ChemicalSystem;
+class ReactionEquation;
+
+/// Used to generate a system of equilibrium reactions written in terms of master and secondary species.
+/// The master species are a subset of the species in the chemical system
+/// whose formulas are linearly independent and span the formulas of all
+/// other species (i.e., the elements and electric charge). The secondary
+/// species are all remaining species, each of which can be formed from the
+/// master species via a single equilibrium reaction. The master species are
+/// chosen so that those with higher priority are preferred (e.g., the most
+/// abundant species in the system, as done in PHREEQC for its master species).
+class EquilibriumReactions
+{
+public:
+    /// Construct an EquilibriumReactions object.
+    explicit EquilibriumReactions(ChemicalSystem const& system);
+
+    /// Construct a copy of an EquilibriumReactions object.
+    EquilibriumReactions(EquilibriumReactions const& other);
+
+    /// Destroy this EquilibriumReactions object.
+    ~EquilibriumReactions();
+
+    /// Assign a copy of an EquilibriumReactions object to this.
+    auto operator=(EquilibriumReactions other) -> EquilibriumReactions&;
+
+    /// Return the chemical system for which the equilibrium reactions were defined.
+    auto system() const -> ChemicalSystem const&;
+
+    /// Set the master species with given priority.
+    /// The first species in the list has the highest priority to be a master species.
+    /// @param ispecies The indices of the preferred master species.
+    auto setMasterSpecies(Indices const& ispecies) -> void;
+
+    /// Set the master species with given priority.
+    /// The first species in the list has the highest priority to be a master species.
+    /// @param species The names of the preferred master species.
+    auto setMasterSpecies(Strings const& species) -> void;
+
+    /// Set the master species using priority weights for every species in the system.
+    /// Species with higher weights are preferred as master species (e.g., use
+    /// the amounts of the species to select the most abundant ones).
+    /// @param weights The priority weights of the species in the system.
+    auto setMasterSpeciesPriorityWeights(ArrayXdConstRef weights) -> void;
+
+    /// Return the indices of the master species.
+    /// The master species are those that serve as building blocks for the secondary species.
+    auto indicesMasterSpecies() const -> Indices const&;
+
+    /// Return the indices of the secondary species.
+    /// The secondary species are those that are constructed from master species.
+    auto indicesSecondarySpecies() const -> Indices const&;
+
+    /// Return the equations of the equilibrium reactions forming each secondary species from the master species.
+    auto equations() const -> Vec<ReactionEquation>;
+
+    /// Return the stoichiometric matrix of the reactions.
+    /// The matrix has one row per secondary species and one column per
+    /// species in the system. The coefficient of a secondary species in its own
+    /// formation reaction is -1 (as a product), and the coefficients of the
+    /// master species are positive if they are reactants.
+    auto stoichiometricMatrix() const -> MatrixXdConstRef;
+
+    /// Return the matrix *S* expressing the formulas of the secondary species in terms of the master species.
+    /// The matrix *S* satisfies *As = Am S*, where *Am* and *As* are the
+    /// formula matrices of the master and secondary species respectively.
+    auto masterStoichiometricMatrix() const -> MatrixXdConstRef;
+
+private:
+    struct Impl;
+
+    Ptr<Impl> pimpl;
+};
+
+} // namespace Reaktoro
@@ -0,0 +1,98 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+// Catch includes
+#include <catch2/catch.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Algorithms.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+#include <Reaktoro/Core/ReactionEquation.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumReactions.hpp>
+using namespace Reaktoro;
+
+namespace test { extern auto createChemicalSystem() -> ChemicalSystem; }
+
+TEST_CASE("Testing EquilibriumReactions", "[EquilibriumReactions]")
+{
+    ChemicalSystem system = test::createChemicalSystem();
+
+    const auto Nn = system.species().size();
+    const auto A = system.formulaMatrix();
+
+    EquilibriumReactions reactions(system);
+
+    auto checkReactions = [&]()
+    {
+        auto const& imaster = reactions.indicesMasterSpecies();
+        auto const& isecondary = reactions.indicesSecondarySpecies();
+
+        CHECK( imaster.size() + isecondary.size() == Nn );
+
+        const MatrixXd Am = A(Eigen::all, imaster);
+        const MatrixXd As = A(Eigen::all, isecondary);
+
+        // Check the master species have linearly independent formulas spanning all other formulas
+        CHECK( Am.fullPivLu().rank() == imaster.size() );
+        CHECK( Am.fullPivLu().rank() == A.fullPivLu().rank() );
+
+        // Check the secondary species are formed from the master species
+        const auto S = reactions.masterStoichiometricMatrix();
+        CHECK( (Am * S - As).norm() == Approx(0.0).margin(1e-12) );
+
+        // Check the reactions conserve elements and electric charge
+        const auto N = reactions.stoichiometricMatrix();
+        CHECK( N.rows() == isecondary.size() );
+        CHECK( N.cols() == Nn );
+        CHECK( (A * N.transpose()).norm() == Approx(0.0).margin(1e-12) );
+
+        CHECK( reactions.equations().size() == isecondary.size() );
+    };
+
+    SECTION("When master species are chosen automatically")
+    {
+        checkReactions();
+    }
+
+    SECTION("When master species are chosen by the user")
+    {
+        reactions.setMasterSpecies(Strings{ "H2O(aq)", "CO2(aq)" });
+
+        checkReactions();
+
+        auto const& imaster = reactions.indicesMasterSpecies();
+
+        CHECK( contains(imaster, system.species().index("H2O(aq)")) );
+        CHECK( contains(imaster, system.species().index("CO2(aq)")) );
+    }
+
+    SECTION("When master species are chosen with priority weights")
+    {
+        ArrayXd weights = ArrayXd::Zero(Nn);
+        weights[system.species().index("H2O(aq)")] = 2.0;
+        weights[system.species().index("HCO3-(aq)")] = 1.0;
+
+        reactions.setMasterSpeciesPriorityWeights(weights);
+
+        checkReactions();
+
+        auto const& imaster = reactions.indicesMasterSpecies();
+
+        CHECK( contains(imaster, system.species().index("H2O(aq)")) );
+        CHECK( contains(imaster, system.species().index("HCO3-(aq)")) );
+    }
+}
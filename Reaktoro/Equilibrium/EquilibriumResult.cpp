@@ -22,6 +22,11 @@ namespace Reaktoro {
 auto EquilibriumResult::operator+=(const EquilibriumResult& other) -> EquilibriumResult&
 {
     optima += other.optima;
+    hessian_refreshes += other.hessian_refreshes;
+    hessian_reuses += other.hessian_reuses;
+    pruned_phases += other.pruned_phases;
+    pruned_species += other.pruned_species;
+    readmitted_phases += other.readmitted_phases;
     return *this;
 }
 
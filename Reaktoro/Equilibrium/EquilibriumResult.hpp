@@ -20,6 +20,9 @@
 // Optima includes
 #include <Optima/Result.hpp>
 
+// Reaktoro includes
+#include <Reaktoro/Common/Index.hpp>
+
 namespace Reaktoro {
 
 /// A type used to describe the result of an equilibrium calculation
@@ -38,6 +41,21 @@ struct EquilibriumResult
     /// The result of the optimisation calculation using Optima.
     Optima::Result optima;
 
+    /// The number of iterations in which the Hessian of the Gibbs energy function was computed from scratch.
+    Index hessian_refreshes = 0;
+
+    /// The number of iterations in which a previously computed Hessian of the Gibbs energy function was reused (see EquilibriumOptions::hessian_reuse).
+    Index hessian_reuses = 0;
+
+    /// The number of phases removed from the equilibrium problem because they were clearly unstable (see EquilibriumOptions::phase_prescreening).
+    Index pruned_phases = 0;
+
+    /// The number of species amounts removed from the variables of the equilibrium problem along with the pruned phases.
+    Index pruned_species = 0;
+
+    /// The number of pruned phases that were re-admitted into the equilibrium problem because they were found supersaturated.
+    Index readmitted_phases = 0;
+
     /// Apply an addition assignment to this instance
     auto operator+=(const EquilibriumResult& other) -> EquilibriumResult&;
 };
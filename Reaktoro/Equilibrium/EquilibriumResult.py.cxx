@@ -30,5 +30,10 @@ void exportEquilibriumResult(py::module& m)
         .def("failed", &EquilibriumResult::failed, "Return true if the calculation failed.")
         .def("iterations", &EquilibriumResult::iterations, "Return the number of iterations in the calculation.")
         .def_readwrite("optima", &EquilibriumResult::optima)
+        .def_readwrite("hessian_refreshes", &EquilibriumResult::hessian_refreshes)
+        .def_readwrite("hessian_reuses", &EquilibriumResult::hessian_reuses)
+        .def_readwrite("pruned_phases", &EquilibriumResult::pruned_phases)
+        .def_readwrite("pruned_species", &EquilibriumResult::pruned_species)
+        .def_readwrite("readmitted_phases", &EquilibriumResult::readmitted_phases)
         ;
 }
@@ -18,6 +18,9 @@
 #include "EquilibriumSensitivity.hpp"
 
 // Reaktoro includes
+#include <Reaktoro/Common/Algorithms.hpp>
+#include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Common/StringUtils.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumDims.hpp>
 
 namespace Reaktoro {
@@ -51,6 +54,53 @@ auto EquilibriumSensitivity::initialize(EquilibriumSpecs const& specs) -> void
     mdqdc.resize(Nq, Nc);
 }
 
+auto EquilibriumSensitivity::requestInputs(Strings const& wids) -> void
+{
+    mrequested_inputs = wids;
+}
+
+auto EquilibriumSensitivity::requestAllInputs() -> void
+{
+    mrequested_inputs.reset();
+}
+
+auto EquilibriumSensitivity::requestComponents(bool value) -> void
+{
+    mrequested_components = value;
+}
+
+auto EquilibriumSensitivity::requestProperties(bool value) -> void
+{
+    mrequested_properties = value;
+}
+
+auto EquilibriumSensitivity::requestedInputs() const -> Indices
+{
+    if(!mrequested_inputs)
+        return range<Index>(minputs.size());
+
+    Indices iw;
+    for(auto const& wid : mrequested_inputs.value())
+    {
+        const auto idx = index(minputs, wid);
+        errorif(idx >= minputs.size(), "Could not request sensitivity derivatives with respect to `", wid, "` "
+            "because it is not an input variable in the chemical equilibrium problem specifications. "
+            "The input variables are: ", join(minputs, ", "), ".");
+        iw.push_back(idx);
+    }
+    return iw;
+}
+
+auto EquilibriumSensitivity::requestedComponents() const -> bool
+{
+    return mrequested_components;
+}
+
+auto EquilibriumSensitivity::requestedProperties() const -> bool
+{
+    return mrequested_properties;
+}
+
 auto EquilibriumSensitivity::dndw(String const& wid) const -> VectorXdConstRef
 {
     const auto idx = index(minputs, wid);
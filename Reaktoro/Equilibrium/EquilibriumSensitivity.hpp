@@ -44,8 +44,47 @@ public:
     explicit EquilibriumSensitivity(EquilibriumSpecs const& specs);
 
     /// Initialize this EquilibriumSensitivity object with given equilibrium problem specifications.
+    /// The requested sensitivity derivatives (see methods `requestInputs`,
+    /// `requestComponents` and `requestProperties`) are preserved.
     auto initialize(EquilibriumSpecs const& specs) -> void;
 
+    //======================================================================
+    // SELECTION OF THE SENSITIVITY DERIVATIVES TO BE COMPUTED
+    //======================================================================
+
+    /// Request derivatives with respect to the given input variables in *w* only.
+    /// By default, derivatives with respect to all input variables in *w* are
+    /// computed. The columns of the derivative matrices corresponding to input
+    /// variables that have not been requested are set to zero. Use this method
+    /// when only a few input variables are of interest, so that the
+    /// derivatives of the Gibbs energy function with respect to the remaining
+    /// input variables are not computed in the equilibrium calculation.
+    /// @param wids The identifiers of the input variables in *w* (e.g., "T", "P", "pH", it depends on what is input).
+    auto requestInputs(Strings const& wids) -> void;
+
+    /// Request derivatives with respect to all input variables in *w* (the default).
+    auto requestAllInputs() -> void;
+
+    /// Request derivatives with respect to component amounts *c* (requested by default).
+    /// If not requested, the derivatives with respect to *c* are set to zero.
+    auto requestComponents(bool value) -> void;
+
+    /// Request total derivatives of the chemical properties *u* (requested by default).
+    /// If not requested, the matrices *du/dw* and *du/dc* are empty and the
+    /// full Jacobian matrix of the chemical properties is not assembled during
+    /// the equilibrium calculation, which is the most expensive part of
+    /// computing sensitivity derivatives.
+    auto requestProperties(bool value) -> void;
+
+    /// Return the indices of the requested input variables in *w*.
+    auto requestedInputs() const -> Indices;
+
+    /// Return true if derivatives with respect to component amounts *c* are requested.
+    auto requestedComponents() const -> bool;
+
+    /// Return true if total derivatives of the chemical properties *u* are requested.
+    auto requestedProperties() const -> bool;
+
     //======================================================================
     // DERIVATIVES OF SPECIES AMOUNTS WITH RESPECT TO INPUT PARAMETERS
     //======================================================================
@@ -153,6 +192,15 @@ private:
     /// The input variables *w* in the chemical equilibrium problem specifications.
     Strings minputs;
 
+    /// The input variables in *w* for which derivatives are requested (all if not set).
+    Optional<Strings> mrequested_inputs;
+
+    /// The flag indicating whether derivatives with respect to component amounts *c* are requested.
+    bool mrequested_components = true;
+
+    /// The flag indicating whether total derivatives of the chemical properties *u* are requested.
+    bool mrequested_properties = true;
+
     /// The derivatives of the species amounts *n* with respect to input variables *w*.
     MatrixXd mdndw;
 
@@ -32,6 +32,13 @@ void exportEquilibriumSensitivity(py::module& m)
         .def(py::init<>())
         .def(py::init<EquilibriumSpecs const&>())
         .def("initialize", &EquilibriumSensitivity::initialize, "Initialize this EquilibriumSensitivity object with given equilibrium problem specifications.")
+        .def("requestInputs", &EquilibriumSensitivity::requestInputs, "Request derivatives with respect to the given input variables in w only.")
+        .def("requestAllInputs", &EquilibriumSensitivity::requestAllInputs, "Request derivatives with respect to all input variables in w (the default).")
+        .def("requestComponents", &EquilibriumSensitivity::requestComponents, "Request derivatives with respect to component amounts c (requested by default).")
+        .def("requestProperties", &EquilibriumSensitivity::requestProperties, "Request total derivatives of the chemical properties u (requested by default).")
+        .def("requestedInputs", &EquilibriumSensitivity::requestedInputs, "Return the indices of the requested input variables in w.")
+        .def("requestedComponents", &EquilibriumSensitivity::requestedComponents, "Return true if derivatives with respect to component amounts c are requested.")
+        .def("requestedProperties", &EquilibriumSensitivity::requestedProperties, "Return true if total derivatives of the chemical properties u are requested.")
         .def("dndw", py::overload_cast<String const&>(&EquilibriumSensitivity::dndw, py::const_), return_internal_ref, "Return the derivatives of the species amounts n with respect to an input variable in w.")
         .def("dndw", py::overload_cast<Param const&>(&EquilibriumSensitivity::dndw, py::const_), return_internal_ref, "Return the derivatives of the species amounts n with respect to an input variable in w.")
         .def("dndw", py::overload_cast<>(&EquilibriumSensitivity::dndw, py::const_), return_internal_ref, "Return the derivatives of the species amounts n with respect to the input variables w.")
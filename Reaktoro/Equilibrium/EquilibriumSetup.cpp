@@ -17,7 +17,11 @@
 
 #include "EquilibriumSetup.hpp"
 
+// C++ includes
+#include <numeric>
+
 // Reaktoro includes
+#include <Reaktoro/Common/Algorithms.hpp>
 #include <Reaktoro/Common/Constants.hpp>
 #include <Reaktoro/Common/Enumerate.hpp>
 #include <Reaktoro/Common/Exception.hpp>
@@ -83,6 +87,23 @@ struct EquilibriumSetup::Impl
     ArrayXr mu;                               ///< The auxiliary vector of chemical potentials of the species.
     VectorXl isbasicvar;                      ///< The bitmap that indicates which variables in x = (n, q) are currently basic variables.
     Indices ipps;                             ///< The indices of the pure phase species (i.e., species composing single-phase species, whose chemical potentials do not depend on composition)
+    Indices iphaseofspecies;                  ///< The index of the phase containing each species in the system.
+    Indices phaseoffsets;                     ///< The index of the first species of each phase in the system.
+    Indices phasesizes;                       ///< The number of species in each phase of the system.
+    Indices iphasesexporting;                 ///< The indices of the phases whose activity models export data to other phases via ChemicalProps::extra (i.e., the aqueous phase when the system has ion exchange phases).
+
+    // -------------------------------------------- //
+    // --------- HESSIAN REUSE VARIABLES ---------- //
+    // -------------------------------------------- //
+
+    bool recording = false;                   ///< The flag indicating that the full Jacobian of the chemical properties is being recorded (the Hessian matrix cannot be reused in this case).
+    bool hessian_available = false;           ///< The flag indicating that Hxx and Vpx contain a previously computed Hessian that can be reused.
+    Index hessian_age = 0;                    ///< The number of consecutive iterations in which the current Hessian matrix Hxx has been reused.
+    Index hessian_refreshes = 0;              ///< The number of times Hxx has been computed from scratch since the last reset.
+    Index hessian_reuses = 0;                 ///< The number of times Hxx has been reused since the last reset.
+    VectorXd xprev;                           ///< The values of x = (n, q) at the previous iteration in which Hxx was requested.
+    double dxprev = -1.0;                     ///< The relative length of the previous step in x = (n, q) (negative if not yet available).
+    VectorXl isbasicvarprev;                  ///< The bitmap of basic variables at the last time Hxx was computed from scratch.
 
     // -------------------------------------------- //
     // ------ CONVENIENT AUXILIARY VARIABLES ------ //
@@ -136,14 +157,21 @@ struct EquilibriumSetup::Impl
         mu.resize(Nn);
 
         isbasicvar.resize(Nx);
+        isbasicvarprev.resize(Nx);
 
-        // Initialize the indices of the pure phase species
+        // Initialize the indices of the pure phase species and the phase block structure of Hnn
+        const auto hasionexchange = containsfn(system.phases(), RKT_LAMBDA(phase, phase.aggregateState() == AggregateState::IonExchange));
         auto offset = 0;
         for(auto const& phase : system.phases())
         {
             const auto size = phase.species().size();
             if(size == 1)
                 ipps.push_back(offset);
+            phaseoffsets.push_back(offset);
+            phasesizes.push_back(size);
+            iphaseofspecies.insert(iphaseofspecies.end(), size, phaseoffsets.size() - 1);
+            if(hasionexchange && phase.aggregateState() == AggregateState::Aqueous)
+                iphasesexporting.push_back(phaseoffsets.size() - 1); // the aqueous state is used by the activity models of ion exchange phases
             offset += size;
         }
     }
@@ -186,11 +214,66 @@ struct EquilibriumSetup::Impl
         vp = F.tail(Np);
     }
 
+    auto resetHessianReuse(bool keep) -> void
+    {
+        hessian_available = hessian_available && keep;
+        hessian_refreshes = 0;
+        hessian_reuses = 0;
+        dxprev = -1.0;
+        xprev.resize(0);
+    }
+
+    auto invalidateHessian() -> void
+    {
+        hessian_available = false;
+    }
+
+    /// Return true if the Hessian matrix computed in a previous iteration can be reused in the current one.
+    auto canReuseHessian() -> bool
+    {
+        if(!options.hessian_reuse)
+            return false;
+
+        // The relative length of the step from the previous iteration to the current one
+        const auto dx = xprev.size() == Nx ? (x.cast<double>() - xprev).norm() / std::max(x.cast<double>().norm(), options.epsilon) : -1.0;
+
+        // Update the history of iterates used to estimate the convergence rate
+        const auto dxlast = dxprev;
+        xprev = x.cast<double>();
+        dxprev = dx;
+
+        if(recording || !hessian_available)
+            return false;
+
+        if(hessian_age >= options.hessian_reuse_max_age)
+            return false;
+
+        if(options.hessian == GibbsHessian::PartiallyExact && isbasicvar != isbasicvarprev)
+            return false; // the exact columns of Hxx were computed for a different set of basic variables
+
+        if(dx > 0.0 && dxlast > 0.0 && dx > options.hessian_reuse_contraction * dxlast)
+            return false; // the steps are not contracting fast enough with the frozen Hessian
+
+        return true;
+    }
+
     auto updateGradX(VectorXlConstRef ibasicvars) -> void
     {
         isbasicvar.fill(false);
         isbasicvar(ibasicvars).fill(true);
 
+        if(canReuseHessian())
+        {
+            ++hessian_age;
+            ++hessian_reuses;
+            return;
+        }
+
+        hessian_available = true;
+        hessian_age = 0;
+        ++hessian_refreshes;
+        isbasicvarprev = isbasicvar;
+
         auto add_log_barrier_contrib = [&](MatrixXdRef Hnn)
         {
             // Add log-barrier contribution to Hnn
@@ -218,23 +301,21 @@ struct EquilibriumSetup::Impl
                 Hnn = hessian.approximate(n);
                 add_log_barrier_contrib(Hnn);
 
-                // Update columns of Hxx and Vpx corresponding to primary species
+                // Update columns of Hxx corresponding to primary species (skipping `q` variables, in case an implicit titrant is currently a primary species)
+                Indices icols;
                 for(auto i : ibasicvars)
-                {
-                    if(i >= Nn) continue; // i corresponds to a `q` variable, and the implicit titrant is currently a primary species
-                    updateFx(i);
-                    Hxx.col(i) = grad(F.head(Nx));
-                }
+                    if(i < Nn)
+                        icols.push_back(i);
+
+                updateGradXColumnsN(icols);
             }
             else // case GibbsHessian::Exact
             {
-                // Update Hxx and Vpx columns for all species
-                for(auto i = 0; i < Nn; ++i)
-                {
-                    updateFx(i);
-                    Hxx.col(i) = grad(F.head(Nx));
-                    Vpx.col(i) = grad(F.tail(Np));
-                }
+                // Update Hxx columns for all species
+                Indices icols(Nn);
+                std::iota(icols.begin(), icols.end(), 0);
+
+                updateGradXColumnsN(icols);
             }
         }
         else // when there are p variables, some problems (e.g., those in NasaDatabase), need Vpx to be calculated; Vpx = 0  causes convergence failure
@@ -256,6 +337,98 @@ struct EquilibriumSetup::Impl
         Vpx.rightCols(Nq).fill(0.0);  // these are derivatives w.r.t. amounts of implicit titrants q
     }
 
+    /// Update the columns of Hxx corresponding to given species when there are no *p* control variables.
+    /// The block-diagonal structure of Hnn by phase is exploited: the
+    /// chemical potentials of the species in a phase depend only on the
+    /// amounts of the species in that phase. Thus, a single forward automatic
+    /// differentiation pass can compute columns of Hnn for species in
+    /// different phases simultaneously. The columns of pure phase species
+    /// are computed analytically, as their chemical potentials do not depend
+    /// on *n*, and need no pass. The exception are the species in phases that
+    /// export data to other phases (i.e., the aqueous phase when the system
+    /// has ion exchange phases, whose activity models use the aqueous state).
+    /// Their columns are computed one at a time and in full. The number of
+    /// passes is thus the number of requested species in exporting phases
+    /// plus the largest number of requested species in any other
+    /// multi-species phase (e.g., for an aqueous phase with 19 species, a
+    /// gaseous phase with 6 species and 4 pure minerals, 19 passes instead
+    /// of 29).
+    auto updateGradXColumnsN(Indices const& icols) -> void
+    {
+        // The full Jacobian of the chemical properties is being recorded (one pass per species is needed in this case)
+        if(recording)
+        {
+            for(auto i : icols)
+            {
+                updateFx(i);
+                Hxx.col(i) = grad(F.head(Nx));
+                Vpx.col(i) = grad(F.tail(Np));
+            }
+            return;
+        }
+
+        const auto tau = options.epsilon * options.logarithm_barrier_factor;
+        const auto numphases = phasesizes.size();
+
+        // The requested species in each phase (for each choice of activity models) whose columns in Hnn are evaluated with autodiff
+        Vec<Indices> icolsideal(numphases);
+        Vec<Indices> icolsnonideal(numphases);
+
+        for(auto i : icols)
+        {
+            const auto iphase = iphaseofspecies[i];
+            if(contains(iphasesexporting, iphase))
+            {
+                updateFx(i);
+                Hxx.col(i) = grad(F.head(Nx));
+            }
+            else if(phasesizes[iphase] == 1)
+            {
+                Hxx.col(i).fill(0.0);
+                Hxx(i, i) = tau/(n[i].val() * n[i].val()); // only the log-barrier term depends on the amount of a pure phase species
+            }
+            else if(useIdealModelForGradWrtVariableN(i))
+                icolsideal[iphase].push_back(i);
+            else icolsnonideal[iphase].push_back(i);
+        }
+
+        auto evalcolumns = [&](Vec<Indices> const& icolsphases, bool useIdealModel)
+        {
+            Index numpasses = 0;
+            for(auto const& icolsphase : icolsphases)
+                numpasses = std::max<Index>(numpasses, icolsphase.size());
+
+            Indices iseeded;
+            for(auto k = 0; k < numpasses; ++k)
+            {
+                // Seed the k-th requested species of every phase at once
+                iseeded.clear();
+                for(auto const& icolsphase : icolsphases)
+                    if(k < icolsphase.size())
+                        iseeded.push_back(icolsphase[k]);
+
+                for(auto i : iseeded)
+                    autodiff::seed(n[i]);
+
+                props.update(n, p, w, useIdealModel, -1);
+                updateF();
+
+                for(auto i : iseeded)
+                {
+                    const auto iphase = iphaseofspecies[i];
+                    const auto offset = phaseoffsets[iphase];
+                    const auto size = phasesizes[iphase];
+                    Hxx.col(i).fill(0.0);
+                    Hxx.col(i).segment(offset, size) = grad(F.segment(offset, size));
+                    autodiff::unseed(n[i]);
+                }
+            }
+        };
+
+        evalcolumns(icolsnonideal, false);
+        evalcolumns(icolsideal, true);
+    }
+
     auto updateGradP() -> void
     {
         // Update Hxp and Vpp
@@ -280,6 +453,19 @@ struct EquilibriumSetup::Impl
         Vpc.rightCols(Nc).fill(0.0); // these are derivatives w.r.t. amounts of conservative components
     }
 
+    auto updateGradW(Indices const& iws) -> void
+    {
+        // Update Hxc and Vpc only for the selected input variables (one automatic differentiation pass for each)
+        Hxc.fill(0.0);
+        Vpc.fill(0.0);
+        for(auto i : iws)
+        {
+            updateFw(i);
+            Hxc.col(i) = grad(F.head(Nx));
+            Vpc.col(i) = grad(F.tail(Np));
+        }
+    }
+
     auto updateF() -> void
     {
         auto const& qvars = specs.controlVariablesQ();
@@ -551,6 +737,11 @@ auto EquilibriumSetup::updateGradW() -> void
     pimpl->updateGradW();
 }
 
+auto EquilibriumSetup::updateGradW(Indices const& iws) -> void
+{
+    pimpl->updateGradW(iws);
+}
+
 auto EquilibriumSetup::getGibbsEnergy() -> real
 {
     return pimpl->getGibbsEnergy();
@@ -606,13 +797,35 @@ auto EquilibriumSetup::usingDiagonalApproxDerivatives() -> bool
     return pimpl->usingDiagonalApproxDerivatives();
 }
 
+auto EquilibriumSetup::resetHessianReuse(bool keep) -> void
+{
+    pimpl->resetHessianReuse(keep);
+}
+
+auto EquilibriumSetup::invalidateHessian() -> void
+{
+    pimpl->invalidateHessian();
+}
+
+auto EquilibriumSetup::numHessianRefreshes() const -> Index
+{
+    return pimpl->hessian_refreshes;
+}
+
+auto EquilibriumSetup::numHessianReuses() const -> Index
+{
+    return pimpl->hessian_reuses;
+}
+
 auto EquilibriumSetup::assembleChemicalPropsJacobianBegin() -> void
 {
+    pimpl->recording = true;
     pimpl->props.assembleFullJacobianBegin();
 }
 
 auto EquilibriumSetup::assembleChemicalPropsJacobianEnd() -> void
 {
+    pimpl->recording = false;
     pimpl->props.assembleFullJacobianEnd();
 }
 
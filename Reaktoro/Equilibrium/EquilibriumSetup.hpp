@@ -88,6 +88,8 @@ public:
     auto update(VectorXrConstRef x, VectorXrConstRef p, VectorXrConstRef w) -> void;
 
     /// Update the derivatives of the chemical potentials and residuals of the equilibrium constraints with respect to *x*.
+    /// If EquilibriumOptions::hessian_reuse is enabled, the previously
+    /// computed derivatives are kept unchanged whenever they can be reused.
     /// @param ibasicvars The indices of the current basic variables in *x*.
     auto updateGradX(VectorXlConstRef ibasicvars) -> void;
 
@@ -97,6 +99,11 @@ public:
     /// Update the derivatives of the chemical potentials and residuals of the equilibrium constraints with respect to *w*.
     auto updateGradW() -> void;
 
+    /// Update the derivatives of the chemical potentials and residuals of the equilibrium constraints with respect to selected input variables in *w*.
+    /// The derivatives with respect to the remaining input variables are set to zero.
+    /// @param iws The indices of the input variables in *w* for which derivatives are computed.
+    auto updateGradW(Indices const& iws) -> void;
+
     /// Get the updated Gibbs energy value.
     auto getGibbsEnergy() -> real;
 
@@ -130,6 +137,24 @@ public:
     /// Return true if a diagonal structure is adopted for the Hessian matrix *Hxx*.
     auto usingDiagonalApproxDerivatives() -> bool;
 
+    /// Reset the iteration history used to decide whether the Hessian matrix *Hxx* can be reused.
+    /// This method should be called at the start of every equilibrium
+    /// calculation. It also resets the counters returned by @ref
+    /// numHessianRefreshes and @ref numHessianReuses.
+    /// @param keep Whether the last computed Hessian matrix can still be reused in the next iterations.
+    auto resetHessianReuse(bool keep) -> void;
+
+    /// Prevent the last computed Hessian matrix *Hxx* from being reused in the next evaluation.
+    /// Unlike @ref resetHessianReuse, the iteration history and the counters
+    /// returned by @ref numHessianRefreshes and @ref numHessianReuses are kept.
+    auto invalidateHessian() -> void;
+
+    /// Return the number of times *Hxx* was computed from scratch since the last call to @ref resetHessianReuse.
+    auto numHessianRefreshes() const -> Index;
+
+    /// Return the number of times *Hxx* was reused since the last call to @ref resetHessianReuse.
+    auto numHessianReuses() const -> Index;
+
     /// Enable recording of derivatives of the chemical properties with respect
     /// to *(n, p, w)* to construct its full Jacobian matrix.
     /// Consider a series of forward automatic differentiation passes to
@@ -17,6 +17,9 @@
 
 #include "EquilibriumSolver.hpp"
 
+// Eigen includes
+#include <Eigen/QR>
+
 // Optima includes
 #include <Optima/Options.hpp>
 #include <Optima/Problem.hpp>
@@ -34,6 +37,7 @@
 #include <Reaktoro/Core/ChemicalSystem.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumConditions.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumDims.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumMassActionSolver.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumOptions.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumProps.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumRestrictions.hpp>
@@ -92,12 +96,30 @@ struct EquilibriumSolver::Impl
     /// The solver for the optimization calculations.
     Optima::Solver optsolver;
 
+    /// The solver for the law-of-mass-action calculations (initialized only if EquilibriumMethod::LawOfMassAction is used).
+    Optional<EquilibriumMassActionSolver> lmasolver;
+
     /// The result of the equilibrium calculation
     EquilibriumResult result;
 
     /// The array stream used to clean up autodiff seed values from the last ChemicalProps update step.
     ArrayStream<double> stream;
 
+    /// The indices of the phases currently removed from the equilibrium problem by the phase pre-screening.
+    Indices pruned_phases;
+
+    /// The upper bounds of the variables in the optimization problem before the phase pre-screening.
+    VectorXd xupper_unpruned;
+
+    /// The indices of the input variables in *w* for which sensitivity derivatives are requested.
+    Indices sensitivity_iws;
+
+    /// The flag indicating whether sensitivity derivatives with respect to all input variables in *w* are requested.
+    bool sensitivity_allinputs = true;
+
+    /// The flag indicating whether total derivatives of the chemical properties are requested in the sensitivity calculation.
+    bool sensitivity_properties = true;
+
     /// Construct a Impl instance with given EquilibriumConditions object.
     Impl(EquilibriumSpecs const& specs)
     : system(specs.system()), specs(specs), dims(specs), xconditions(specs), xrestrictions(system), setup(specs)
@@ -118,6 +140,14 @@ struct EquilibriumSolver::Impl
         // Ensure some options have proper values
         error(options.epsilon <= 0, "EquilibriumOptions::epsilon cannot be zero or negative.");
 
+        // Initialize the law-of-mass-action solver if this method has been chosen
+        if(options.method == EquilibriumMethod::LawOfMassAction)
+        {
+            if(!lmasolver)
+                lmasolver = EquilibriumMassActionSolver(system);
+            lmasolver->setOptions(options);
+        }
+
         // Initialize the names of the primal and dual variables
         if(options.optima.output.active)
         {
@@ -168,17 +198,21 @@ struct EquilibriumSolver::Impl
         {
             setup.update(x, p, w);
 
-            if(fopts.eval.fxc || vopts.eval.ddc)
+            const auto recording = (fopts.eval.fxc || vopts.eval.ddc) && sensitivity_properties; // the full Jacobian of the chemical properties is only needed for total derivatives of the chemical properties
+
+            if(recording)
                 setup.assembleChemicalPropsJacobianBegin();
+            else if(fopts.eval.fxc || vopts.eval.ddc)
+                setup.invalidateHessian(); // ensure the sensitivity derivatives are computed with an up-to-date Hessian matrix (without resetting the reuse counters of the current calculation)
 
             if(fopts.eval.fxx || vopts.eval.ddx)
                 setup.updateGradX(fopts.ibasicvars);
             if(fopts.eval.fxp || vopts.eval.ddp)
                 setup.updateGradP();
             if(fopts.eval.fxc || vopts.eval.ddc)
-                setup.updateGradW();
+                sensitivity_allinputs ? setup.updateGradW() : setup.updateGradW(sensitivity_iws);
 
-            if(fopts.eval.fxc || vopts.eval.ddc)
+            if(recording)
                 setup.assembleChemicalPropsJacobianEnd();
         };
 
@@ -307,6 +341,150 @@ struct EquilibriumSolver::Impl
         state.equilibrium().setOptimaState(optstate);
     }
 
+    /// Update the result with the statistics on Hessian reuse and discard the frozen Hessian if the calculation failed.
+    auto updateHessianReuseStats(EquilibriumResult& res)
+    {
+        res.hessian_refreshes = setup.numHessianRefreshes();
+        res.hessian_reuses = setup.numHessianReuses();
+
+        if(!res.optima.succeeded)
+            setup.resetHessianReuse(false);
+    }
+
+    /// Return the tangent-plane distances of the phases (normalized by *RT*) for given chemical properties.
+    /// The chemical potentials of the components are estimated from those of
+    /// the species with amounts away from their lower bounds. The reduced
+    /// driving force of each species, without its ideal mixing contribution,
+    /// is then combined over the species in each phase to give the minimum
+    /// tangent-plane distance of the phase at fixed activity coefficients.
+    /// A negative value indicates the phase is supersaturated.
+    auto computePhaseStabilities(ChemicalProps const& props) const -> ArrayXd
+    {
+        auto const& Nn = dims.Nn;
+
+        const auto RT = universalGasConstant * props.temperature().val();
+
+        const ArrayXd n  = props.speciesAmounts().cast<double>();
+        const ArrayXd x  = props.speciesMoleFractions().cast<double>();
+        const ArrayXd mu = props.speciesChemicalPotentials().cast<double>() / RT;
+
+        const auto Wn = setup.Aex().leftCols(Nn);
+
+        // The species with amounts away from their lower bounds, whose chemical potentials determine those of the components
+        Indices ibasic;
+        for(auto i = 0; i < Nn; ++i)
+            if(n[i] > 1e3 * options.epsilon)
+                ibasic.push_back(i);
+
+        const auto numphases = system.phases().size();
+
+        if(ibasic.empty())
+            return ArrayXd::Zero(numphases);
+
+        MatrixXd Wb(ibasic.size(), Wn.rows());
+        VectorXd ub(ibasic.size());
+        for(auto k = 0; k < ibasic.size(); ++k)
+        {
+            Wb.row(k) = Wn.col(ibasic[k]).transpose();
+            ub[k] = mu[ibasic[k]];
+        }
+
+        const VectorXd y = Wb.colPivHouseholderQr().solve(ub); // the chemical potentials of the components (normalized by RT)
+
+        const ArrayXd d = mu - (Wn.transpose() * y).array() - x.log(); // the reduced driving forces of the species, without ideal mixing contribution
+
+        ArrayXd tpd(numphases);
+        auto offset = 0;
+        for(auto k = 0; k < numphases; ++k)
+        {
+            const auto size = system.phase(k).species().size();
+            const auto dk = d.segment(offset, size);
+            const auto dmin = dk.minCoeff();
+            tpd[k] = dmin - std::log((dmin - dk).exp().sum()); // tpd = -ln(sum(exp(-d))) computed without overflow
+            offset += size;
+        }
+
+        return tpd;
+    }
+
+    /// Remove from the optimization problem the phases that are absent and clearly unstable in the initial chemical state.
+    auto prescreenPhases(ChemicalState const& state0) -> void
+    {
+        pruned_phases.clear();
+
+        result.pruned_phases = 0;
+        result.pruned_species = 0;
+        result.readmitted_phases = 0;
+
+        if(!options.phase_prescreening)
+            return;
+
+        // Only a chemical state computed in a previous equilibrium calculation has chemical properties suitable for the pre-screening
+        if(state0.equilibrium().optimaState().dims.x != dims.Nx)
+            return;
+
+        const auto tpd = computePhaseStabilities(state0.props());
+        const auto n0 = state0.speciesAmounts();
+
+        xupper_unpruned = optproblem.xupper;
+
+        auto offset = 0;
+        for(auto k = 0; k < tpd.size(); ++k)
+        {
+            const auto size = system.phase(k).species().size();
+            const auto absent = (n0.segment(offset, size) <= 100 * options.epsilon).all();
+
+            if(absent && tpd[k] > options.phase_prescreening_threshold)
+            {
+                // Keep the amounts of the species in the phase fixed at their lower bounds
+                optproblem.xupper.segment(offset, size) = optproblem.xlower.segment(offset, size);
+                optstate.x.segment(offset, size) = optproblem.xlower.segment(offset, size);
+                pruned_phases.push_back(k);
+                result.pruned_phases += 1;
+                result.pruned_species += size;
+            }
+
+            offset += size;
+        }
+    }
+
+    /// Re-admit into the optimization problem the pruned phases that are supersaturated in the computed equilibrium state (return true if any was re-admitted).
+    auto readmitPhases() -> bool
+    {
+        if(pruned_phases.empty())
+            return false;
+
+        const auto tpd = computePhaseStabilities(setup.chemicalProps());
+
+        Indices remaining;
+        for(auto k : pruned_phases)
+        {
+            if(tpd[k] < 0.0)
+            {
+                const auto offset = system.phases().numSpeciesUntilPhase(k);
+                const auto size = system.phase(k).species().size();
+                optproblem.xupper.segment(offset, size) = xupper_unpruned.segment(offset, size);
+                result.readmitted_phases += 1;
+            }
+            else remaining.push_back(k);
+        }
+
+        const auto readmitted = remaining.size() < pruned_phases.size();
+
+        pruned_phases = remaining;
+
+        return readmitted;
+    }
+
+    /// Prepare the equilibrium sensitivity object and the sensitivity calculation for the requested derivatives.
+    auto initEquilibriumSensitivity(EquilibriumSensitivity& sensitivity)
+    {
+        sensitivity.initialize(specs);
+        sensitivity_iws = sensitivity.requestedInputs();
+        sensitivity_allinputs = sensitivity_iws.size() == dims.Nw;
+        sensitivity_properties = sensitivity.requestedProperties();
+    }
+
     /// Update the equilibrium sensitivity object with computed optimization sensitivity.
     auto updateEquilibriumSensitivity(EquilibriumSensitivity& sensitivity)
     {
@@ -317,27 +495,50 @@ struct EquilibriumSolver::Impl
         auto const& xc = optsensitivity.xc;
         auto const& pc = optsensitivity.pc;
 
-        auto const& props = setup.equilibriumProps();
-
         const auto dndw = xc.topLeftCorner(Nn, Nw);
         const auto dqdw = xc.bottomLeftCorner(Nq, Nw);
         const auto dpdw = pc.leftCols(Nw);
         const auto dndc = xc.topRightCorner(Nn, Nc);
         const auto dqdc = xc.bottomRightCorner(Nq, Nc);
         const auto dpdc = pc.rightCols(Nc);
-        const auto dudn = props.dudn();
-        const auto dudp = props.dudp();
-        const auto dudw = props.dudw();
 
-        sensitivity.initialize(specs);
+        const auto components = sensitivity.requestedComponents();
+
         sensitivity.dndw(dndw);
         sensitivity.dqdw(dqdw);
         sensitivity.dpdw(dpdw);
-        sensitivity.dndc(dndc);
-        sensitivity.dqdc(dqdc);
-        sensitivity.dpdc(dpdc);
-        sensitivity.dudw(dudw + dudn*dndw + dudp*dpdw);
-        sensitivity.dudc(dudn*dndc + dudp*dpdc);
+        sensitivity.dndc(components ? MatrixXd(dndc) : MatrixXd::Zero(Nn, Nc));
+        sensitivity.dqdc(components ? MatrixXd(dqdc) : MatrixXd::Zero(Nq, Nc));
+        sensitivity.dpdc(components ? MatrixXd(dpdc) : MatrixXd::Zero(dpdc.rows(), Nc));
+
+        if(!sensitivity_properties)
+        {
+            sensitivity.dudw(MatrixXd());
+            sensitivity.dudc(MatrixXd());
+            return;
+        }
+
+        auto const& props = setup.equilibriumProps();
+
+        const auto dudn = props.dudn();
+        const auto dudp = props.dudp();
+        const auto dudw = props.dudw();
+
+        // Compute the total derivatives du/dw only for the requested input variables (the remaining columns are zero)
+        if(sensitivity_allinputs)
+            sensitivity.dudw(dudw + dudn*dndw + dudp*dpdw);
+        else
+        {
+            MatrixXd dudwtotal = MatrixXd::Zero(dudw.rows(), Nw);
+            for(auto i : sensitivity_iws)
+                dudwtotal.col(i) = dudw.col(i) + dudn*dndw.col(i) + dudp*dpdw.col(i);
+            sensitivity.dudw(dudwtotal);
+        }
+
+        // Compute the total derivatives du/dc only if requested (zero otherwise)
+        if(components)
+            sensitivity.dudc(dudn*dndc + dudp*dpdc);
+        else sensitivity.dudc(MatrixXd::Zero(dudw.rows(), Nc));
     }
 
     auto solve(ChemicalState& state) -> EquilibriumResult
@@ -355,15 +556,59 @@ struct EquilibriumSolver::Impl
         return solve(state, conditions, xrestrictions);
     }
 
+    /// Equilibrate a chemical state using the law-of-mass-action solver.
+    auto solveMassAction(ChemicalState& state, EquilibriumConditions const& conditions, EquilibriumRestrictions const& restrictions) -> EquilibriumResult
+    {
+        errorif(dims.Np != 0 || dims.Nq != 0 || dims.Nr != 0 || (specs.inputs() != Strings{"T", "P"}),
+            "EquilibriumMethod::LawOfMassAction can only be used with equilibrium specifications of given temperature and pressure.");
+
+        errorif(!restrictions.speciesCannotIncrease().empty() || !restrictions.speciesCannotDecrease().empty() ||
+            !restrictions.speciesCannotIncreaseAbove().empty() || !restrictions.speciesCannotDecreaseBelow().empty(),
+            "EquilibriumMethod::LawOfMassAction does not support reactivity restrictions on the species.");
+
+        const ArrayXr w = conditions.inputValuesGetOrCompute(state);
+        const ArrayXd b = conditions.initialComponentAmountsGetOrCompute(state);
+
+        state.setTemperature(w[0]);
+        state.setPressure(w[1]);
+
+        result = lmasolver->solve(state, b);
+
+        warningif(!result.optima.succeeded && Warnings::isEnabled(906), EQUILIBRIUM_FAILURE_MESSAGE);
+
+        state.equilibrium().setNamesInputVariables(specs.namesInputs());
+        state.equilibrium().setNamesControlVariablesP(specs.namesControlVariablesP());
+        state.equilibrium().setNamesControlVariablesQ(specs.namesControlVariablesQ());
+        state.equilibrium().setInputVariables(conditions.inputValues());
+        state.equilibrium().setInitialComponentAmounts(b);
+
+        return result;
+    }
+
     auto solve(ChemicalState& state, EquilibriumConditions const& conditions, EquilibriumRestrictions const& restrictions) -> EquilibriumResult
     {
+        if(options.method == EquilibriumMethod::LawOfMassAction)
+            return solveMassAction(state, conditions, restrictions);
+
         updateOptProblem(state, conditions, restrictions);
         updateOptState(state);
+        prescreenPhases(state);
+
+        setup.resetHessianReuse(true);
 
         result.optima = optsolver.solve(optproblem, optstate);
 
+        // Resume the calculation while pruned phases are found supersaturated in the computed state
+        while(result.optima.succeeded && readmitPhases())
+        {
+            const auto iterations = result.optima.iterations;
+            result.optima = optsolver.solve(optproblem, optstate);
+            result.optima.iterations += iterations;
+        }
+
         warningif(!result.optima.succeeded && Warnings::isEnabled(906), EQUILIBRIUM_FAILURE_MESSAGE);
 
+        updateHessianReuseStats(result);
         updateChemicalState(state, conditions);
 
         return result;
@@ -386,13 +631,20 @@ struct EquilibriumSolver::Impl
 
     auto solve(ChemicalState& state, EquilibriumSensitivity& sensitivity, EquilibriumConditions const& conditions, EquilibriumRestrictions const& restrictions) -> EquilibriumResult
     {
+        errorif(options.method == EquilibriumMethod::LawOfMassAction,
+            "EquilibriumMethod::LawOfMassAction does not support the computation of sensitivity derivatives.");
+
         EquilibriumResult result;
 
         updateOptProblem(state, conditions, restrictions);
         updateOptState(state);
+        initEquilibriumSensitivity(sensitivity);
+
+        setup.resetHessianReuse(true);
 
         result.optima = optsolver.solve(optproblem, optstate, optsensitivity);
 
+        updateHessianReuseStats(result);
         updateChemicalState(state, conditions);
         updateEquilibriumSensitivity(sensitivity);
 
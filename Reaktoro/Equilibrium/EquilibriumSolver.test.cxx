@@ -184,6 +184,34 @@ TEST_CASE("Testing EquilibriumSolver", "[EquilibriumSolver]")
                     { 6.1533476097769296e-09, -0.0000000000000000e+00, -5.0000000123066946e-01 },
                     { 0.0000000000000000e+00,  0.0000000000000000e+00,  0.0000000000000000e+00 },
                     { 0.0000000000000000e+00, -0.0000000000000000e+00,  0.0000000000000000e+00 }})));
+
+                // Check that only the requested sensitivity derivatives are computed
+                EquilibriumSensitivity selected;
+                selected.requestInputs({"T"});
+                selected.requestComponents(false);
+                selected.requestProperties(false);
+
+                result = solver.solve(state, selected);
+
+                CHECK( result.succeeded() );
+                CHECK( selected.dndw("T").isApprox(dndT) );
+                CHECK( selected.dndw("P").isZero() );
+                CHECK( selected.dndc().isZero() );
+                CHECK( selected.dudw().size() == 0 );
+                CHECK( selected.dudc().size() == 0 );
+
+                selected.requestProperties(true);
+
+                result = solver.solve(state, selected);
+
+                CHECK( result.succeeded() );
+                CHECK( selected.dudw().col(0).isApprox(sensitivity.dudw().col(0)) );
+                CHECK( selected.dudw().col(1).isZero() );
+                CHECK( selected.dudc().isZero() );
+
+                selected.requestInputs({"V"});
+
+                CHECK_THROWS( solver.solve(state, selected) );
             }
         }
     }
@@ -681,4 +709,274 @@ TEST_CASE("Testing EquilibriumSolver", "[EquilibriumSolver]")
         CHECK( result.succeeded() );
         CHECK( result.iterations() == 32 );
     }
+
+    SECTION("There is an aqueous solution and a gaseous solution and the Hessian is reused")
+    {
+        Phases phases(db);
+        phases.add( AqueousPhase(speciate("H O Na Cl C Ca Mg Si")) );
+        phases.add( GaseousPhase(speciate("H O C")) );
+
+        ChemicalSystem system(phases);
+
+        ChemicalState state(system);
+        state.setTemperature(T, "celsius");
+        state.setPressure(P, "bar");
+        state.setSpeciesAmount("H2O"   , 55.0 , "mol");
+        state.setSpeciesAmount("NaCl"  , 0.01 , "mol");
+        state.setSpeciesAmount("CO2"   , 10.0 , "mol");
+        state.setSpeciesAmount("CaCO3" , 0.01 , "mol");
+        state.setSpeciesAmount("MgCO3" , 0.02 , "mol");
+        state.setSpeciesAmount("SiO2"  , 0.01 , "mol");
+
+        ChemicalState expected(state);
+
+        EquilibriumSolver solver(system);
+
+        options.hessian_reuse = false;
+        solver.setOptions(options);
+
+        result = solver.solve(expected);
+
+        CHECK( result.succeeded() );
+        CHECK( result.hessian_reuses == 0 );
+        CHECK( result.hessian_refreshes > 0 );
+
+        options.hessian_reuse = true;
+        solver.setOptions(options);
+
+        result = solver.solve(state);
+
+        CHECK( result.succeeded() );
+        CHECK( result.hessian_refreshes > 0 );
+        checkChemicalEquilibriumStateHasZeroDerivativeValues(state);
+
+        ArrayXd nexpected = expected.speciesAmounts();
+        ArrayXd nactual = state.speciesAmounts();
+
+        PRINT_INFO_IF_FAILS(nexpected);
+        PRINT_INFO_IF_FAILS(nactual);
+
+        CHECK( nactual.isApprox(nexpected, 1e-6) );
+
+        // Check a warm-started calculation at slightly different conditions reuses the Hessian of the previous calculation
+        state.setTemperature(T + 1.0, "celsius");
+        expected.setTemperature(T + 1.0, "celsius");
+
+        result = solver.solve(state);
+
+        CHECK( result.succeeded() );
+        CHECK( result.hessian_reuses > 0 );
+        checkChemicalEquilibriumStateHasZeroDerivativeValues(state);
+
+        options.hessian_reuse = false;
+        solver.setOptions(options);
+
+        result = solver.solve(expected);
+
+        CHECK( result.succeeded() );
+        CHECK( result.hessian_reuses == 0 );
+
+        nexpected = expected.speciesAmounts();
+        nactual = state.speciesAmounts();
+
+        PRINT_INFO_IF_FAILS(nexpected);
+        PRINT_INFO_IF_FAILS(nactual);
+
+        CHECK( nactual.isApprox(nexpected, 1e-6) );
+
+        // Check the sensitivity derivatives use an up-to-date Hessian matrix without discarding the reuse counters of a warm-started calculation
+        state.setTemperature(T + 2.0, "celsius");
+        expected.setTemperature(T + 2.0, "celsius");
+
+        options.hessian_reuse = true;
+        solver.setOptions(options);
+
+        EquilibriumSensitivity sensitivity;
+        sensitivity.requestProperties(false);
+
+        result = solver.solve(state, sensitivity);
+
+        CHECK( result.succeeded() );
+        CHECK( result.hessian_reuses > 0 );
+        CHECK( result.hessian_refreshes > 0 ); // at least the Hessian refresh for the sensitivity derivatives
+
+        options.hessian_reuse = false;
+        solver.setOptions(options);
+
+        EquilibriumSensitivity sensitivity_expected;
+        sensitivity_expected.requestProperties(false);
+
+        result = solver.solve(expected, sensitivity_expected);
+
+        CHECK( result.succeeded() );
+
+        const MatrixXd dndc = sensitivity.dndc();
+        const MatrixXd dndc_expected = sensitivity_expected.dndc();
+
+        PRINT_INFO_IF_FAILS(dndc);
+        PRINT_INFO_IF_FAILS(dndc_expected);
+
+        CHECK( dndc.isApprox(dndc_expected, 1e-6) );
+    }
+
+    SECTION("There is an aqueous solution, gaseous solution, several minerals and clearly unstable phases are pre-screened")
+    {
+        Phases phases(db);
+        phases.add( AqueousPhase(speciate("H O Na Cl C Ca Mg Si")) );
+        phases.add( GaseousPhase(speciate("H O C")) );
+        phases.add( MineralPhases("Halite Calcite Magnesite Dolomite Quartz") );
+
+        ChemicalSystem system(phases);
+
+        ChemicalState state(system);
+        state.setTemperature(T, "celsius");
+        state.setPressure(P, "bar");
+        state.setSpeciesAmount("H2O"   , 55.0 , "mol");
+        state.setSpeciesAmount("NaCl"  , 0.01 , "mol");
+        state.setSpeciesAmount("CO2"   , 10.0 , "mol");
+        state.setSpeciesAmount("CaCO3" , 0.10 , "mol");
+        state.setSpeciesAmount("MgCO3" , 0.20 , "mol");
+        state.setSpeciesAmount("SiO2"  , 0.01 , "mol");
+        state.setSpeciesAmount("Halite", 0.03 , "mol");
+
+        EquilibriumSolver solver(system);
+
+        result = solver.solve(state); // Halite is completely dissolved in this first calculation
+
+        CHECK( result.succeeded() );
+        CHECK( result.pruned_phases == 0 ); // no pre-screening by default
+
+        ChemicalState expected(state);
+
+        // Check a warm-started calculation at slightly different conditions prunes Halite and gives the same result
+        state.setTemperature(T + 5.0, "celsius");
+        expected.setTemperature(T + 5.0, "celsius");
+
+        result = solver.solve(expected);
+
+        CHECK( result.succeeded() );
+
+        options.phase_prescreening = true;
+        solver.setOptions(options);
+
+        result = solver.solve(state);
+
+        CHECK( result.succeeded() );
+        CHECK( result.pruned_phases >= 1 );
+        CHECK( result.pruned_species >= result.pruned_phases );
+        CHECK( result.readmitted_phases == 0 );
+        CHECK( state.speciesAmount("Halite") == Approx(options.epsilon) );
+        checkChemicalEquilibriumStateHasZeroDerivativeValues(state);
+
+        ArrayXd nexpected = expected.speciesAmounts();
+        ArrayXd nactual = state.speciesAmounts();
+
+        PRINT_INFO_IF_FAILS(nexpected);
+        PRINT_INFO_IF_FAILS(nactual);
+
+        for(auto i = 0; i < nexpected.size(); ++i)
+            if(nexpected[i] > 1e-12)
+                CHECK( nactual[i] == Approx(nexpected[i]).epsilon(1e-6) );
+
+        // Check a pruned phase is re-admitted once it becomes supersaturated (the chemical properties in state are those before the addition of NaCl)
+        state.add("NaCl", 20.0, "mol");
+        expected.add("NaCl", 20.0, "mol");
+
+        options.phase_prescreening = false;
+        solver.setOptions(options);
+
+        result = solver.solve(expected);
+
+        CHECK( result.succeeded() );
+
+        options.phase_prescreening = true;
+        solver.setOptions(options);
+
+        result = solver.solve(state);
+
+        CHECK( result.succeeded() );
+        CHECK( result.pruned_phases >= 1 ); // Halite is pruned again, since the chemical properties in state still indicate it is unstable
+        CHECK( result.readmitted_phases >= 1 ); // Halite becomes supersaturated with the added NaCl and is re-admitted
+        CHECK( result.readmitted_phases <= result.pruned_phases );
+        CHECK( expected.speciesAmount("Halite") > 1e-6 );
+        CHECK( state.speciesAmount("Halite") > 1e-6 );
+
+        nexpected = expected.speciesAmounts();
+        nactual = state.speciesAmounts();
+
+        for(auto i = 0; i < nexpected.size(); ++i)
+            if(nexpected[i] > 1e-12)
+                CHECK( nactual[i] == Approx(nexpected[i]).epsilon(1e-6) );
+    }
+
+    SECTION("There is an aqueous solution and the law-of-mass-action method is used")
+    {
+        PhreeqcDatabase db("phreeqc.dat");
+
+        AqueousPhase aqueousphase(speciate("H O C Na Cl Ca"));
+        aqueousphase.set(ActivityModelPhreeqc(db));
+
+        ChemicalSystem system(db, aqueousphase);
+
+        ChemicalState state(system);
+        state.temperature(25.0, "°C");
+        state.pressure(1.0, "atm");
+        state.set("H2O" , 1.0  , "kg");
+        state.set("Na+" , 0.1  , "mol");
+        state.set("Cl-" , 0.1  , "mol");
+        state.set("Ca+2", 0.01 , "mol");
+        state.set("CO2" , 0.02 , "mol");
+        state.set("OH-" , 0.02 , "mol");
+
+        ChemicalState expected(state);
+
+        EquilibriumSolver solver(system);
+
+        result = solver.solve(expected);
+
+        CHECK( result.succeeded() );
+
+        options.method = EquilibriumMethod::LawOfMassAction;
+        solver.setOptions(options);
+
+        result = solver.solve(state);
+
+        CHECK( result.succeeded() );
+        checkChemicalEquilibriumStateHasZeroDerivativeValues(state);
+
+        ArrayXd nexpected = expected.speciesAmounts();
+        ArrayXd nactual = state.speciesAmounts();
+
+        PRINT_INFO_IF_FAILS(nexpected);
+        PRINT_INFO_IF_FAILS(nactual);
+
+        // Compare only species with non-negligible amounts (the lower bounds in the Gibbs energy minimization method affect trace species)
+        for(auto i = 0; i < nexpected.size(); ++i)
+            if(nexpected[i] > 1e-12)
+                CHECK( nactual[i] == Approx(nexpected[i]).epsilon(1e-6) );
+
+        // Check a warm-started calculation converges in a few iterations
+        state.temperature(30.0, "°C");
+
+        result = solver.solve(state);
+
+        CHECK( result.succeeded() );
+        CHECK( result.iterations() <= 10 );
+
+        // Check the law-of-mass-action method does not accept other equilibrium specifications
+        EquilibriumSpecs specs(system);
+        specs.temperature();
+        specs.pressure();
+        specs.pH();
+
+        EquilibriumSolver phsolver(specs);
+        phsolver.setOptions(options);
+
+        EquilibriumConditions conditions(specs);
+        conditions.temperature(25.0, "°C");
+        conditions.pressure(1.0, "atm");
+        conditions.pH(7.0);
+
+        CHECK_THROWS( phsolver.solve(state, conditions) );
+    }
 }
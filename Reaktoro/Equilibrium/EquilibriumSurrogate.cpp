@@ -0,0 +1,974 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "EquilibriumSurrogate.hpp"
+
+// C++ includes
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Algorithms.hpp>
+#include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Common/TimeUtils.hpp>
+#include <Reaktoro/Common/Units.hpp>
+#include <Reaktoro/Core/ChemicalProps.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumConditions.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumPredictor.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSensitivity.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSolver.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSpecs.hpp>
+
+namespace Reaktoro {
+namespace {
+
+/// The identifier at the beginning of binary files of equilibrium surrogates.
+const String surrogateIdentifier = "RKTSURRO";
+
+/// The version of the format of binary files of equilibrium surrogates.
+const std::uint64_t surrogateVersion = 1;
+
+/// The value used to indicate the absence of an index (e.g., a cell without a record).
+const Index npos = std::numeric_limits<Index>::max();
+
+/// Write an unsigned 64-bit integer to a binary stream.
+auto writeUInt64(std::ostream& out, std::uint64_t value) -> void
+{
+    out.write(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+/// Read an unsigned 64-bit integer from a binary stream.
+auto readUInt64(std::istream& in) -> std::uint64_t
+{
+    std::uint64_t value = 0;
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+}
+
+/// Write a double value to a binary stream.
+auto writeDouble(std::ostream& out, double value) -> void
+{
+    out.write(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+/// Read a double value from a binary stream.
+auto readDouble(std::istream& in) -> double
+{
+    double value = 0.0;
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+}
+
+/// Write a matrix prefixed by its numbers of rows and columns to a binary stream.
+auto writeMatrix(std::ostream& out, MatrixXdConstRef mat) -> void
+{
+    writeUInt64(out, mat.rows());
+    writeUInt64(out, mat.cols());
+    const MatrixXd tmp = mat; // ensure contiguous column-major storage
+    out.write(reinterpret_cast<char const*>(tmp.data()), tmp.size() * sizeof(double));
+}
+
+/// Read a matrix prefixed by its numbers of rows and columns from a binary stream.
+auto readMatrix(std::istream& in) -> MatrixXd
+{
+    const auto rows = readUInt64(in);
+    const auto cols = readUInt64(in);
+    MatrixXd mat(rows, cols);
+    in.read(reinterpret_cast<char*>(mat.data()), mat.size() * sizeof(double));
+    return mat;
+}
+
+/// Write strings prefixed by their number to a binary stream.
+auto writeStrings(std::ostream& out, Strings const& strs) -> void
+{
+    writeUInt64(out, strs.size());
+    for(auto const& str : strs)
+    {
+        writeUInt64(out, str.size());
+        out.write(str.data(), str.size());
+    }
+}
+
+/// Read strings prefixed by their number from a binary stream.
+auto readStrings(std::istream& in) -> Strings
+{
+    Strings strs(readUInt64(in));
+    for(auto& str : strs)
+    {
+        str.resize(readUInt64(in));
+        in.read(str.data(), str.size());
+    }
+    return strs;
+}
+
+} // namespace
+
+struct EquilibriumSurrogate::Impl
+{
+    /// A dimension of the box covered by the surrogate.
+    struct Dimension
+    {
+        /// The name of the input variable or conservative component along the dimension.
+        String name;
+
+        /// The index of the input variable in *w* (or the number of input variables if this is a dimension of a component amount).
+        Index iw = 0;
+
+        /// The index of the conservative component in *c* (or the number of components if this is a dimension of an input variable).
+        Index ic = 0;
+
+        /// The lower bound of the box along the dimension.
+        double lower = 0.0;
+
+        /// The upper bound of the box along the dimension.
+        double upper = 0.0;
+    };
+
+    /// A cell in the k-d tree of the surrogate.
+    struct Node
+    {
+        /// The dimension along which the cell is bisected (if not a leaf).
+        Index dim = 0;
+
+        /// The coordinate along dimension @ref dim at which the cell is bisected (if not a leaf).
+        double split = 0.0;
+
+        /// The index of the lower child cell, with the upper one right after it (zero if this is a leaf).
+        Index children = 0;
+
+        /// The index of the record of the cell (npos if the equilibrium calculation at its center failed, or once built, if the cell is not a converged leaf).
+        Index record = npos;
+
+        /// The indication whether the prediction errors in the cell are within the tolerances.
+        bool converged = false;
+    };
+
+    /// The chemical equilibrium state at the center of a cell and its sensitivity derivatives.
+    struct Record
+    {
+        VectorXd n0;     ///< The species amounts *n* at the center of the cell.
+        VectorXd p0;     ///< The control variables *p* at the center of the cell.
+        VectorXd q0;     ///< The control variables *q* at the center of the cell.
+        VectorXd w0;     ///< The input variables *w* at the center of the cell.
+        VectorXd c0;     ///< The component amounts *c* at the center of the cell.
+        VectorXd u0;     ///< The chemical properties *u* at the center of the cell.
+        MatrixXd dndwc;  ///< The derivatives of *n* with respect to *(w, c)* at the center of the cell.
+        MatrixXd dpdwc;  ///< The derivatives of *p* with respect to *(w, c)* at the center of the cell.
+        MatrixXd dqdwc;  ///< The derivatives of *q* with respect to *(w, c)* at the center of the cell.
+        MatrixXd dudwc;  ///< The derivatives of *u* with respect to *(w, c)* at the center of the cell.
+        Indices iprimary; ///< The indices of the primary species at the center of the cell.
+        VectorXd mu0;    ///< The chemical potentials of the primary species at the center of the cell.
+        MatrixXd dmudwc; ///< The derivatives of the chemical potentials of the primary species with respect to *(w, c)* at the center of the cell.
+
+        /// Return the number of doubles stored in the record.
+        auto size() const -> Index
+        {
+            return n0.size() + p0.size() + q0.size() + w0.size() + c0.size() + u0.size() +
+                dndwc.size() + dpdwc.size() + dqdwc.size() + dudwc.size() + mu0.size() + dmudwc.size();
+        }
+    };
+
+    /// A cell waiting to be evaluated while building the surrogate.
+    struct Cell
+    {
+        ArrayXd lower;        ///< The lower bounds of the cell along the dimensions of the box.
+        ArrayXd upper;        ///< The upper bounds of the cell along the dimensions of the box.
+        Index depth = 0;      ///< The number of bisections that produced the cell.
+        Index node = 0;       ///< The index of the node of the cell in the k-d tree.
+        Index parent = npos;  ///< The index of the record of the parent cell, whose prediction is the initial guess at the center of the cell.
+    };
+
+    /// The outcome of the evaluation of a cell while building the surrogate.
+    struct Evaluation
+    {
+        bool succeeded = false; ///< The indication whether the equilibrium calculation at the center of the cell succeeded.
+        Record record;          ///< The record with the equilibrium state at the center of the cell.
+        ArrayXd errors;         ///< The largest normalized prediction errors at the centers of the faces of the cell along each dimension.
+        Index equilibriums = 0; ///< The number of equilibrium calculations performed.
+    };
+
+    /// The chemical equilibrium specifications of the surrogate.
+    EquilibriumSpecs specs;
+
+    /// The options for building and evaluating the surrogate.
+    EquilibriumSurrogateOptions options;
+
+    /// The equilibrium solver used when the predictions are not accepted.
+    EquilibriumSolver solver;
+
+    /// The conditions used in the calculations without explicit conditions.
+    EquilibriumConditions conditions;
+
+    /// The dimensions of the box covered by the surrogate.
+    Vec<Dimension> dims;
+
+    /// The cells of the k-d tree of the surrogate (the root cell first).
+    Vec<Node> nodes;
+
+    /// The records of the converged leaf cells of the surrogate.
+    Vec<Record> records;
+
+    /// The statistics of the construction and usage of the surrogate.
+    EquilibriumSurrogateStatistics stats;
+
+    /// The number of input variables *w*.
+    const Index Nw;
+
+    /// The number of conservative components *c*.
+    const Index Nc;
+
+    /// The index of temperature in *w* (equal to the number of input variables if temperature is unknown and thus in *p*).
+    const Index iTw;
+
+    /// The index of pressure in *w* (equal to the number of input variables if pressure is unknown and thus in *p*).
+    const Index iPw;
+
+    /// Construct an EquilibriumSurrogate::Impl object with given chemical equilibrium specifications.
+    Impl(EquilibriumSpecs const& specs)
+    : specs(specs), solver(specs), conditions(specs),
+      Nw(specs.numInputs()),
+      Nc(specs.numConservativeComponents()),
+      iTw(index(specs.inputs(), "T")),
+      iPw(index(specs.inputs(), "P"))
+    {}
+
+    auto setOptions(EquilibriumSurrogateOptions const& opts) -> void
+    {
+        options = opts;
+        solver.setOptions(options.equilibrium);
+    }
+
+    auto addDimension(Dimension const& dim) -> void
+    {
+        errorif(!(dim.lower < dim.upper), "Expecting a lower bound smaller than the upper bound along the dimension `", dim.name, "` of EquilibriumSurrogate.");
+        for(auto const& other : dims)
+            errorif(other.name == dim.name && (other.iw < Nw) == (dim.iw < Nw), "There is already a dimension named `", dim.name, "` in EquilibriumSurrogate.");
+        dims.push_back(dim);
+    }
+
+    auto addInputDimension(String const& input, double lower, double upper) -> void
+    {
+        const auto iw = index(specs.inputs(), input);
+        errorif(iw >= Nw, "Cannot add a dimension along `", input, "` in EquilibriumSurrogate because this is not an input variable in your equilibrium specifications.");
+        addDimension({ input, iw, Nc, lower, upper });
+    }
+
+    auto addComponentDimension(String const& component, double lower, double upper) -> void
+    {
+        const auto ic = index(specs.namesConservativeComponents(), component);
+        errorif(ic >= Nc, "Cannot add a dimension along `", component, "` in EquilibriumSurrogate because this is not a conservative component in your equilibrium specifications.");
+        addDimension({ component, Nw, ic, lower, upper });
+    }
+
+    //=================================================================================================================
+    //
+    // METHODS TO BUILD THE SURROGATE
+    //
+    //=================================================================================================================
+
+    /// Set the coordinates of a point in the box in the input variables *w* and component amounts *c*.
+    auto setPoint(ArrayXdConstRef const& x, ArrayXdRef w, ArrayXdRef c) const -> void
+    {
+        for(auto k = 0; k < dims.size(); ++k)
+        {
+            if(dims[k].iw < Nw)
+                w[dims[k].iw] = x[k];
+            else c[dims[k].ic] = x[k];
+        }
+    }
+
+    /// Create the record of an equilibrium state and its sensitivity derivatives.
+    auto createRecord(ChemicalState const& state, EquilibriumSensitivity const& sensitivity) const -> Record
+    {
+        auto const& equilibrium = state.equilibrium();
+
+        Record record;
+        record.n0 = state.speciesAmounts().matrix().cast<double>();
+        record.p0 = equilibrium.p().matrix();
+        record.q0 = equilibrium.q().matrix();
+        record.w0 = equilibrium.w().matrix();
+        record.c0 = equilibrium.c().matrix();
+        record.u0 = state.props();
+
+        auto join = [](MatrixXdConstRef dxdw, MatrixXdConstRef dxdc) -> MatrixXd
+        {
+            MatrixXd dxdwc(dxdw.rows(), dxdw.cols() + dxdc.cols());
+            dxdwc << dxdw, dxdc;
+            return dxdwc;
+        };
+
+        record.dndwc = join(sensitivity.dndw(), sensitivity.dndc());
+        record.dpdwc = join(sensitivity.dpdw(), sensitivity.dpdc());
+        record.dqdwc = join(sensitivity.dqdw(), sensitivity.dqdc());
+        record.dudwc = join(sensitivity.dudw(), sensitivity.dudc());
+
+        const auto iprimary = equilibrium.indicesPrimarySpecies();
+        const auto Nn = record.n0.size();
+        const auto Nu = record.u0.size();
+
+        record.iprimary.resize(iprimary.size());
+        record.mu0.resize(iprimary.size());
+        record.dmudwc.resize(iprimary.size(), record.dndwc.cols());
+
+        for(auto j = 0; j < iprimary.size(); ++j)
+        {
+            const auto iu = Nu - Nn + iprimary[j]; // the index of the chemical potential of the primary species in *u*
+            record.iprimary[j] = iprimary[j];
+            record.mu0[j] = record.u0[iu];
+            record.dmudwc.row(j) = record.dudwc.row(iu);
+        }
+
+        return record;
+    }
+
+    /// Set the chemical state with the first-order Taylor prediction of a record at given input conditions *(w, c)*.
+    auto setPredictedState(ChemicalState& state, Record const& record, VectorXdConstRef n, VectorXdConstRef w, VectorXdConstRef c, VectorXdConstRef dwc) const -> void
+    {
+        const VectorXd p = record.p0 + record.dpdwc * dwc;
+        const VectorXd q = record.q0 + record.dqdwc * dwc;
+        const VectorXd u = record.u0 + record.dudwc * dwc;
+
+        auto& equilibrium = state.equilibrium();
+
+        if(equilibrium.namesInputVariables().empty())
+        {
+            equilibrium.setNamesInputVariables(specs.inputs());
+            equilibrium.setNamesControlVariablesP(specs.namesControlVariablesP());
+            equilibrium.setNamesControlVariablesQ(specs.namesControlVariablesQ());
+        }
+
+        state.setSpeciesAmounts(n.array());
+        state.props().update(u.array());
+        equilibrium.setControlVariablesP(p.array());
+        equilibrium.setControlVariablesQ(q.array());
+        equilibrium.setInputVariables(w.array());
+        equilibrium.setInitialComponentAmounts(c.array());
+
+        const auto T = iTw < Nw ? w[iTw] : p[0]; // get temperature from given *w* or predicted *p*
+        const auto P = iPw < Nw ? w[iPw] : iTw < Nw ? p[0] : p[1]; // get pressure from given *w* or predicted *p* (if T is also unknown, P is in p[1])
+
+        state.setTemperature(T);
+        state.setPressure(P);
+    }
+
+    /// Return the largest error in predicted species amounts relative to the tolerances in the options.
+    auto normalizedError(ArrayXrConstRef const& npredicted, ArrayXrConstRef const& nexact) const -> double
+    {
+        const double nsum = nexact.sum();
+        double error = 0.0;
+        for(auto i = 0; i < nexact.size(); ++i)
+        {
+            const double ni = nexact[i];
+            const double dni = npredicted[i] - nexact[i];
+            error = std::max(error, std::abs(dni) / (options.reltol * std::abs(ni) + options.abstol * nsum));
+        }
+        return error;
+    }
+
+    auto build(ChemicalState const& state0, EquilibriumConditions const& conditions0) -> void
+    {
+        errorif(dims.empty(), "Expecting at least one dimension in EquilibriumSurrogate before building it.");
+
+        const auto tbegin = time();
+
+        const auto D = dims.size();
+
+        //======================================================================
+        // Prepare the conditions shared by all points in the box
+        //======================================================================
+
+        EquilibriumConditions base(conditions0);
+
+        // The input variables along the dimensions of the box are set later for every point (set here so that the other input values can be checked)
+        for(auto const& dim : dims)
+            if(dim.iw < Nw)
+                base.setInputVariable(dim.iw, dim.lower);
+
+        // Temperature and pressure not given by the box nor by the conditions are taken from the initial state
+        if(iTw < Nw && std::isnan(base.inputValue("T").val()))
+            base.temperature(state0.temperature());
+        if(iPw < Nw && std::isnan(base.inputValue("P").val()))
+            base.pressure(state0.pressure());
+
+        const ArrayXd w0 = base.inputValuesGetOrCompute(state0).cast<double>();
+        const ArrayXd c0 = base.initialComponentAmountsGetOrCompute(state0);
+
+        //======================================================================
+        // The evaluation of a cell: the equilibrium state at its center and the prediction errors at the centers of its faces
+        //======================================================================
+
+        Vec<Record> allrecords; // the records of all cells, including those bisected later
+
+        auto evaluate = [&](Cell const& cell, EquilibriumSolver& solver, EquilibriumSensitivity& sensitivity, EquilibriumConditions& conditions) -> Evaluation
+        {
+            Evaluation eval;
+            eval.errors = ArrayXd::Zero(D);
+
+            ArrayXd w = w0;
+            ArrayXd c = c0;
+
+            // The initial state at a point, with the temperature and pressure of the point if these are dimensions of the box
+            auto initialState = [&]()
+            {
+                ChemicalState state(state0);
+                if(iTw < Nw) state.temperature(w[iTw]);
+                if(iPw < Nw) state.pressure(w[iPw]);
+                return state;
+            };
+
+            const ArrayXd x = 0.5 * (cell.lower + cell.upper);
+
+            setPoint(x, w, c);
+            conditions.setInputVariables(w.cast<real>());
+            conditions.setInitialComponentAmounts(c.matrix());
+
+            ChemicalState state = initialState();
+
+            // Start from the prediction of the parent cell, which is close to the equilibrium state at the center of this cell
+            if(cell.parent != npos)
+            {
+                auto const& parent = allrecords[cell.parent];
+                VectorXd dwc(Nw + Nc);
+                dwc << w.matrix() - parent.w0, c.matrix() - parent.c0;
+                const VectorXd n = (parent.n0 + parent.dndwc * dwc).cwiseMax(options.equilibrium.epsilon);
+                setPredictedState(state, parent, n, w.matrix(), c.matrix(), dwc);
+            }
+
+            auto result = solver.solve(state, sensitivity, conditions);
+            eval.equilibriums += 1;
+
+            if(!result.succeeded() && cell.parent != npos)
+            {
+                state = initialState();
+                result = solver.solve(state, sensitivity, conditions);
+                eval.equilibriums += 1;
+            }
+
+            if(!result.succeeded())
+                return eval;
+
+            eval.succeeded = true;
+            eval.record = createRecord(state, sensitivity);
+
+            EquilibriumPredictor predictor(state, sensitivity);
+
+            ChemicalState predicted(state);
+            ChemicalState exact(state);
+
+            for(auto k = 0; k < D; ++k)
+            {
+                for(auto bound : { cell.lower[k], cell.upper[k] })
+                {
+                    ArrayXd xk = x;
+                    xk[k] = bound;
+
+                    setPoint(xk, w, c);
+                    conditions.setInputVariables(w.cast<real>());
+                    conditions.setInitialComponentAmounts(c.matrix());
+
+                    predictor.predict(predicted, conditions);
+
+                    exact = state; // start from the equilibrium state at the center of the cell
+                    const auto succeeded = solver.solve(exact, conditions).succeeded();
+                    eval.equilibriums += 1;
+
+                    const auto error = succeeded ?
+                        normalizedError(predicted.speciesAmounts(), exact.speciesAmounts()) :
+                        std::numeric_limits<double>::infinity();
+
+                    eval.errors[k] = std::max(eval.errors[k], error);
+                }
+            }
+
+            return eval;
+        };
+
+        //======================================================================
+        // Refine the cells level by level, evaluating the cells of a level across a pool of threads
+        //======================================================================
+
+        nodes.assign(1, Node());
+        records.clear();
+        stats = {};
+
+        Vec<Cell> cells(1);
+        cells[0].lower.resize(D);
+        cells[0].upper.resize(D);
+        for(auto k = 0; k < D; ++k)
+        {
+            cells[0].lower[k] = dims[k].lower;
+            cells[0].upper[k] = dims[k].upper;
+        }
+
+        while(!cells.empty())
+        {
+            const auto N = cells.size();
+
+            Vec<Evaluation> evals(N);
+
+            Index numthreads = options.threads;
+            if(numthreads == 0)
+                numthreads = std::max<Index>(std::thread::hardware_concurrency(), 1);
+            numthreads = std::max<Index>(std::min(numthreads, N), 1);
+
+            std::atomic<Index> next = 0;
+            std::exception_ptr error;
+            std::mutex errormutex;
+
+            auto worker = [&]
+            {
+                try
+                {
+                    EquilibriumSolver solver(specs);
+                    EquilibriumSensitivity sensitivity(specs);
+                    EquilibriumConditions conditions(base);
+
+                    solver.setOptions(options.equilibrium);
+
+                    for(auto i = next++; i < N; i = next++)
+                        evals[i] = evaluate(cells[i], solver, sensitivity, conditions);
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> lock(errormutex);
+                    if(!error)
+                        error = std::current_exception();
+                    next = N; // stop the other threads as soon as they finish their current cell
+                }
+            };
+
+            Vec<std::thread> threads;
+            for(auto i = 1; i < numthreads; ++i)
+                threads.emplace_back(worker);
+            worker(); // the calling thread is also part of the pool
+            for(auto& thread : threads)
+                thread.join();
+
+            if(error)
+                std::rethrow_exception(error);
+
+            // Accept the cells whose errors are within the tolerances and bisect the others along the dimension with the largest errors
+            Vec<Cell> nextcells;
+
+            for(auto i = 0; i < N; ++i)
+            {
+                auto const& cell = cells[i];
+                auto& eval = evals[i];
+
+                stats.equilibriums += eval.equilibriums;
+                stats.depth = std::max(stats.depth, cell.depth);
+
+                if(!eval.succeeded)
+                    continue; // a leaf without record, for which the solver is always used
+
+                nodes[cell.node].record = allrecords.size();
+                allrecords.push_back(std::move(eval.record));
+
+                if(eval.errors.sum() <= 1.0)
+                {
+                    nodes[cell.node].converged = true;
+                    continue;
+                }
+
+                if(cell.depth >= options.max_depth || nodes.size() + 2 > options.max_cells)
+                    continue; // an unconverged leaf, for which the solver is always used
+
+                Index k = 0;
+                eval.errors.maxCoeff(&k);
+
+                const auto split = 0.5 * (cell.lower[k] + cell.upper[k]);
+
+                nodes[cell.node].dim = k;
+                nodes[cell.node].split = split;
+                nodes[cell.node].children = nodes.size();
+
+                Cell lowercell = cell, uppercell = cell;
+                lowercell.upper[k] = split;
+                uppercell.lower[k] = split;
+                lowercell.depth = uppercell.depth = cell.depth + 1;
+                lowercell.node = nodes.size();
+                uppercell.node = nodes.size() + 1;
+                lowercell.parent = uppercell.parent = nodes[cell.node].record;
+
+                nodes.push_back(Node());
+                nodes.push_back(Node());
+
+                nextcells.push_back(std::move(lowercell));
+                nextcells.push_back(std::move(uppercell));
+            }
+
+            cells = std::move(nextcells);
+        }
+
+        //======================================================================
+        // Keep only the records of the converged leaf cells
+        //======================================================================
+
+        for(auto& node : nodes)
+        {
+            if(node.children != 0 || node.record == npos || !node.converged)
+            {
+                node.record = npos;
+                continue;
+            }
+            records.push_back(std::move(allrecords[node.record]));
+            node.record = records.size() - 1;
+        }
+
+        updateStatistics();
+
+        stats.time = elapsed(tbegin);
+    }
+
+    /// Update the statistics of the surrogate that depend on its cells and records.
+    auto updateStatistics() -> void
+    {
+        stats.records = records.size();
+        stats.leaves = 0;
+        stats.unconverged = 0;
+        stats.memory = 0;
+        for(auto const& node : nodes)
+        {
+            if(node.children != 0)
+                continue;
+            stats.leaves += 1;
+            stats.unconverged += !node.converged || node.record == npos;
+        }
+        for(auto const& record : records)
+            stats.memory += record.size() * sizeof(double) + record.iprimary.size() * sizeof(Index);
+    }
+
+    //=================================================================================================================
+    //
+    // METHODS TO EVALUATE THE SURROGATE
+    //
+    //=================================================================================================================
+
+    /// Predict the chemical equilibrium state at given conditions, setting `outside` to true if these are outside the box.
+    auto predict(ChemicalState& state, EquilibriumConditions const& conditions, bool& outside) const -> bool
+    {
+        outside = false;
+
+        if(nodes.empty())
+            return false;
+
+        const VectorXd w = conditions.inputValuesGetOrCompute(state).cast<double>().matrix();
+        const VectorXd c = conditions.initialComponentAmountsGetOrCompute(state).matrix();
+
+        auto coordinate = [&](Index k) { return dims[k].iw < Nw ? w[dims[k].iw] : c[dims[k].ic]; };
+
+        // Check the conditions are inside the box
+        for(auto k = 0; k < dims.size(); ++k)
+        {
+            const auto x = coordinate(k);
+            if(!(x >= dims[k].lower && x <= dims[k].upper))
+            {
+                outside = true;
+                return false;
+            }
+        }
+
+        // Find the leaf cell containing the conditions
+        Index inode = 0;
+        while(nodes[inode].children != 0)
+        {
+            auto const& node = nodes[inode];
+            inode = node.children + (coordinate(node.dim) < node.split ? 0 : 1);
+        }
+
+        auto const& leaf = nodes[inode];
+
+        if(!leaf.converged || leaf.record == npos)
+            return false;
+
+        auto const& record = records[leaf.record];
+
+        VectorXd dwc(Nw + Nc);
+        dwc << w - record.w0, c - record.c0;
+
+        // Check the changes in the conditions not spanned by the box, whose prediction errors are not controlled by the refinement of the cells
+        VectorXd dwcoff = dwc;
+        for(auto const& dim : dims)
+            dwcoff[dim.iw < Nw ? dim.iw : Nw + dim.ic] = 0.0;
+
+        if(!dwcoff.isZero(0.0))
+        {
+            const VectorXd dmu = record.dmudwc * dwcoff;
+            for(auto j = 0; j < dmu.size(); ++j)
+                if(std::abs(dmu[j]) >= options.reltol_offbox * std::abs(record.mu0[j]) + options.abstol_offbox)
+                    return false;
+        }
+
+        // Check the predicted species amounts are positive or at least very small negative values
+        VectorXd n = record.n0 + record.dndwc * dwc;
+
+        if(n.minCoeff() <= options.reltol_negative_amounts * n.sum())
+            return false;
+
+        n = n.cwiseMax(options.equilibrium.epsilon);
+
+        setPredictedState(state, record, n, w, c, dwc);
+
+        return true;
+    }
+
+    auto solve(ChemicalState& state) -> EquilibriumSurrogateResult
+    {
+        conditions.temperature(state.temperature());
+        conditions.pressure(state.pressure());
+        return solve(state, conditions);
+    }
+
+    auto solve(ChemicalState& state, EquilibriumConditions const& conditions) -> EquilibriumSurrogateResult
+    {
+        EquilibriumSurrogateResult result;
+
+        result.predicted = predict(state, conditions, result.outside);
+
+        if(result.predicted)
+        {
+            stats.predictions += 1;
+            return result;
+        }
+
+        result.fallback = solver.solve(state, conditions);
+
+        stats.fallbacks += 1;
+
+        return result;
+    }
+
+    //=================================================================================================================
+    //
+    // METHODS TO SAVE AND LOAD THE SURROGATE
+    //
+    //=================================================================================================================
+
+    auto save(String const& filepath) const -> void
+    {
+        std::ofstream file(filepath, std::ios::binary);
+        errorif(!file, "Could not create the file `", filepath, "` to save the EquilibriumSurrogate object.");
+
+        file.write(surrogateIdentifier.data(), surrogateIdentifier.size());
+        writeUInt64(file, surrogateVersion);
+
+        writeStrings(file, vectorize(specs.system().species(), RKT_LAMBDA(x, x.name())));
+        writeStrings(file, specs.inputs());
+        writeStrings(file, specs.namesConservativeComponents());
+
+        writeUInt64(file, dims.size());
+        for(auto const& dim : dims)
+        {
+            writeStrings(file, { dim.name });
+            writeUInt64(file, dim.iw);
+            writeUInt64(file, dim.ic);
+            writeDouble(file, dim.lower);
+            writeDouble(file, dim.upper);
+        }
+
+        writeUInt64(file, nodes.size());
+        for(auto const& node : nodes)
+        {
+            writeUInt64(file, node.dim);
+            writeDouble(file, node.split);
+            writeUInt64(file, node.children);
+            writeUInt64(file, node.record);
+            writeUInt64(file, node.converged);
+        }
+
+        writeUInt64(file, records.size());
+        for(auto const& record : records)
+        {
+            for(auto const& mat : { &record.n0, &record.p0, &record.q0, &record.w0, &record.c0, &record.u0, &record.mu0 })
+                writeMatrix(file, *mat);
+            for(auto const& mat : { &record.dndwc, &record.dpdwc, &record.dqdwc, &record.dudwc, &record.dmudwc })
+                writeMatrix(file, *mat);
+            writeUInt64(file, record.iprimary.size());
+            for(auto const i : record.iprimary)
+                writeUInt64(file, i);
+        }
+
+        writeUInt64(file, stats.depth);
+        writeUInt64(file, stats.equilibriums);
+        writeDouble(file, stats.time);
+
+        errorif(!file, "Could not write the EquilibriumSurrogate object to the file `", filepath, "`.");
+    }
+
+    auto load(String const& filepath) -> void
+    {
+        std::ifstream file(filepath, std::ios::binary);
+        errorif(!file, "Could not open the file `", filepath, "` to load an EquilibriumSurrogate object.");
+
+        String identifier(surrogateIdentifier.size(), '\0');
+        file.read(identifier.data(), identifier.size());
+        errorif(identifier != surrogateIdentifier, "The file `", filepath, "` does not contain an EquilibriumSurrogate object.");
+
+        const auto version = readUInt64(file);
+        errorif(version > surrogateVersion, "The file `", filepath, "` has version ", version, " of the format of EquilibriumSurrogate objects, but only versions up to ", surrogateVersion, " are supported.");
+
+        const auto species = readStrings(file);
+        const auto inputs = readStrings(file);
+        const auto components = readStrings(file);
+
+        errorif(species != vectorize(specs.system().species(), RKT_LAMBDA(x, x.name())), "The EquilibriumSurrogate object in the file `", filepath, "` was built with a chemical system with different species.");
+        errorif(inputs != specs.inputs(), "The EquilibriumSurrogate object in the file `", filepath, "` was built with different input variables in the equilibrium specifications.");
+        errorif(components != specs.namesConservativeComponents(), "The EquilibriumSurrogate object in the file `", filepath, "` was built with different conservative components in the equilibrium specifications.");
+
+        Vec<Dimension> newdims(readUInt64(file));
+        for(auto& dim : newdims)
+        {
+            dim.name = readStrings(file).at(0);
+            dim.iw = readUInt64(file);
+            dim.ic = readUInt64(file);
+            dim.lower = readDouble(file);
+            dim.upper = readDouble(file);
+        }
+
+        Vec<Node> newnodes(readUInt64(file));
+        for(auto& node : newnodes)
+        {
+            node.dim = readUInt64(file);
+            node.split = readDouble(file);
+            node.children = readUInt64(file);
+            node.record = readUInt64(file);
+            node.converged = readUInt64(file);
+        }
+
+        Vec<Record> newrecords(readUInt64(file));
+        for(auto& record : newrecords)
+        {
+            for(auto mat : { &record.n0, &record.p0, &record.q0, &record.w0, &record.c0, &record.u0, &record.mu0 })
+                *mat = readMatrix(file);
+            for(auto mat : { &record.dndwc, &record.dpdwc, &record.dqdwc, &record.dudwc, &record.dmudwc })
+                *mat = readMatrix(file);
+            record.iprimary.resize(readUInt64(file));
+            for(auto& i : record.iprimary)
+                i = readUInt64(file);
+        }
+
+        const auto depth = readUInt64(file);
+        const auto equilibriums = readUInt64(file);
+        const auto time = readDouble(file);
+
+        errorif(!file, "The file `", filepath, "` with an EquilibriumSurrogate object is truncated or corrupted.");
+
+        dims = std::move(newdims);
+        nodes = std::move(newnodes);
+        records = std::move(newrecords);
+
+        stats = {};
+        stats.depth = depth;
+        stats.equilibriums = equilibriums;
+        stats.time = time;
+
+        updateStatistics();
+    }
+};
+
+EquilibriumSurrogate::EquilibriumSurrogate(EquilibriumSpecs const& specs)
+: pimpl(new Impl(specs))
+{}
+
+EquilibriumSurrogate::EquilibriumSurrogate(EquilibriumSurrogate const& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+EquilibriumSurrogate::~EquilibriumSurrogate()
+{}
+
+auto EquilibriumSurrogate::operator=(EquilibriumSurrogate other) -> EquilibriumSurrogate&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto EquilibriumSurrogate::setOptions(EquilibriumSurrogateOptions const& options) -> void
+{
+    pimpl->setOptions(options);
+}
+
+auto EquilibriumSurrogate::addTemperatureDimension(double lower, double upper, String const& unit) -> void
+{
+    pimpl->addInputDimension("T", units::convert(lower, unit, "K"), units::convert(upper, unit, "K"));
+}
+
+auto EquilibriumSurrogate::addPressureDimension(double lower, double upper, String const& unit) -> void
+{
+    pimpl->addInputDimension("P", units::convert(lower, unit, "Pa"), units::convert(upper, unit, "Pa"));
+}
+
+auto EquilibriumSurrogate::addInputDimension(String const& input, double lower, double upper) -> void
+{
+    pimpl->addInputDimension(input, lower, upper);
+}
+
+auto EquilibriumSurrogate::addComponentDimension(String const& component, double lower, double upper) -> void
+{
+    pimpl->addComponentDimension(component, lower, upper);
+}
+
+auto EquilibriumSurrogate::build(ChemicalState const& state0) -> void
+{
+    pimpl->build(state0, EquilibriumConditions(pimpl->specs));
+}
+
+auto EquilibriumSurrogate::build(ChemicalState const& state0, EquilibriumConditions const& conditions) -> void
+{
+    pimpl->build(state0, conditions);
+}
+
+auto EquilibriumSurrogate::predict(ChemicalState& state, EquilibriumConditions const& conditions) const -> bool
+{
+    bool outside = false;
+    return pimpl->predict(state, conditions, outside);
+}
+
+auto EquilibriumSurrogate::solve(ChemicalState& state) -> EquilibriumSurrogateResult
+{
+    return pimpl->solve(state);
+}
+
+auto EquilibriumSurrogate::solve(ChemicalState& state, EquilibriumConditions const& conditions) -> EquilibriumSurrogateResult
+{
+    return pimpl->solve(state, conditions);
+}
+
+auto EquilibriumSurrogate::statistics() const -> EquilibriumSurrogateStatistics
+{
+    return pimpl->stats;
+}
+
+auto EquilibriumSurrogate::save(String const& filepath) const -> void
+{
+    pimpl->save(filepath);
+}
+
+auto EquilibriumSurrogate::load(String const& filepath) -> void
+{
+    pimpl->load(filepath);
+}
+
+} // namespace Reaktoro
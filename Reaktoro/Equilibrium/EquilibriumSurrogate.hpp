@@ -0,0 +1,226 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+// Reaktoro includes
+#include <Reaktoro/Common/Types.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumOptions.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumResult.hpp>
+
+namespace Reaktoro {
+
+// Forward declarations
+class ChemicalState;
+class EquilibriumConditions;
+class EquilibriumSpecs;
+
+/// The options for building and evaluating an EquilibriumSurrogate object.
+struct EquilibriumSurrogateOptions
+{
+    /// The options for the chemical equilibrium calculations when building the surrogate and when falling back to the solver.
+    EquilibriumOptions equilibrium;
+
+    /// The number of threads used to build the surrogate (zero means the number of hardware threads).
+    Index threads = 0;
+
+    /// The relative tolerance for the errors in the predicted amounts of the species when refining the cells of the surrogate.
+    /// The error in the amount of a species at a test point of a cell is
+    /// acceptable if it is below `reltol * n + abstol * sum(n)`, with *n*
+    /// the amounts computed by the equilibrium solver at the test point.
+    double reltol = 0.01;
+
+    /// The absolute tolerance, relative to the total amount of species, for the errors in the predicted amounts of the species when refining the cells of the surrogate.
+    double abstol = 1.0e-8;
+
+    /// The relative tolerance for the predicted changes in the chemical potentials of the primary species due to conditions not spanned by the dimensions of the surrogate.
+    /// The surrogate controls the prediction errors only along its
+    /// dimensions. Changes in the other input variables and component amounts
+    /// with respect to those used to build the surrogate are accepted if they
+    /// pass the same test used in SmartEquilibriumSolver.
+    double reltol_offbox = 0.005;
+
+    /// The absolute tolerance for the predicted changes in the chemical potentials of the primary species due to conditions not spanned by the dimensions of the surrogate (in J/mol).
+    double abstol_offbox = 0.01;
+
+    /// The relative tolerance for negative species amounts in the predicted chemical equilibrium states (see SmartEquilibriumOptions::reltol_negative_amounts).
+    double reltol_negative_amounts = -1.0e-14;
+
+    /// The maximum number of times a cell can be bisected when building the surrogate.
+    Index max_depth = 20;
+
+    /// The maximum number of cells created when building the surrogate.
+    Index max_cells = 100000;
+};
+
+/// The statistics of the construction and usage of an EquilibriumSurrogate object.
+struct EquilibriumSurrogateStatistics
+{
+    /// The number of records with the equilibrium states and sensitivity derivatives stored in the surrogate.
+    Index records = 0;
+
+    /// The number of cells in the surrogate that cannot be divided further.
+    Index leaves = 0;
+
+    /// The number of leaf cells whose prediction errors could not be brought below the tolerances, for which the solver is always used.
+    Index unconverged = 0;
+
+    /// The maximum number of times a cell was bisected.
+    Index depth = 0;
+
+    /// The number of equilibrium calculations performed to build the surrogate.
+    Index equilibriums = 0;
+
+    /// The memory used to store the records of the surrogate (in bytes).
+    Index memory = 0;
+
+    /// The time spent to build the surrogate (in s).
+    double time = 0.0;
+
+    /// The number of accepted predictions since the surrogate was built or loaded.
+    Index predictions = 0;
+
+    /// The number of calculations performed with the equilibrium solver since the surrogate was built or loaded.
+    Index fallbacks = 0;
+};
+
+/// The result of a chemical equilibrium calculation with an EquilibriumSurrogate object.
+struct EquilibriumSurrogateResult
+{
+    /// The indication whether the chemical equilibrium state was predicted by the surrogate.
+    bool predicted = false;
+
+    /// The indication whether the conditions of the calculation were outside the box covered by the surrogate.
+    bool outside = false;
+
+    /// The result of the equilibrium solver, used when the prediction was not accepted.
+    EquilibriumResult fallback;
+};
+
+/// Used to build and evaluate a lookup-table surrogate of chemical equilibrium calculations over a box of conditions.
+/// The box is spanned by input variables (e.g., temperature and pressure)
+/// and amounts of conservative components (e.g., chemical elements), and it
+/// is divided recursively in a k-d tree of cells. Every cell stores the
+/// chemical equilibrium state at its center together with its sensitivity
+/// derivatives (see EquilibriumSensitivity), from which first-order Taylor
+/// predictions are made (see EquilibriumPredictor). When building the
+/// surrogate, the predictions of a cell are compared against the equilibrium
+/// solver at the centers of its faces, and the cell is bisected along the
+/// dimension with the largest errors until these are within the tolerances in
+/// EquilibriumSurrogateOptions. Finding the cell containing given conditions
+/// takes a number of steps equal to the depth of the tree, logarithmic in its
+/// number of cells. The equilibrium solver is used instead of a prediction
+/// when the conditions are outside the box, when the cell could not be
+/// refined enough, or when the prediction fails the tests on negative
+/// species amounts and on changes in conditions not spanned by the box.
+/// Unlike SmartEquilibriumSolver, which learns during a simulation, the
+/// surrogate is built beforehand and never changes while it is used, so that
+/// it can be saved to a file and shared by many threads (see @ref predict,
+/// but note that @ref solve can only be used from one thread at a time).
+/// ~~~{.cpp}
+/// EquilibriumSurrogate surrogate(specs);
+/// surrogate.addTemperatureDimension(25.0, 90.0, "celsius");
+/// surrogate.addComponentDimension("C", 0.01, 1.0);
+/// surrogate.build(state);
+/// surrogate.save("surrogate.rkt");
+/// ~~~
+class EquilibriumSurrogate
+{
+public:
+    /// Construct an EquilibriumSurrogate object with given chemical equilibrium specifications.
+    explicit EquilibriumSurrogate(EquilibriumSpecs const& specs);
+
+    /// Construct a copy of an EquilibriumSurrogate object.
+    EquilibriumSurrogate(EquilibriumSurrogate const& other);
+
+    /// Destroy this EquilibriumSurrogate object.
+    ~EquilibriumSurrogate();
+
+    /// Assign a copy of an EquilibriumSurrogate object to this.
+    auto operator=(EquilibriumSurrogate other) -> EquilibriumSurrogate&;
+
+    /// Set the options for building and evaluating the surrogate.
+    auto setOptions(EquilibriumSurrogateOptions const& options) -> void;
+
+    /// Add temperature as a dimension of the box covered by the surrogate (temperature must be an input variable).
+    auto addTemperatureDimension(double lower, double upper, String const& unit="K") -> void;
+
+    /// Add pressure as a dimension of the box covered by the surrogate (pressure must be an input variable).
+    auto addPressureDimension(double lower, double upper, String const& unit="Pa") -> void;
+
+    /// Add an input variable in the equilibrium specifications as a dimension of the box covered by the surrogate.
+    /// @param input The name of the input variable (e.g., `T`, `P`, `pH`).
+    /// @param lower The lower bound of the input variable in the box.
+    /// @param upper The upper bound of the input variable in the box.
+    auto addInputDimension(String const& input, double lower, double upper) -> void;
+
+    /// Add the amount of a conservative component as a dimension of the box covered by the surrogate.
+    /// @param component The name of the component (the symbol of a chemical element, `Z` for electric charge, or the id of a reactivity constraint).
+    /// @param lower The lower bound of the amount of the component in the box (in mol).
+    /// @param upper The upper bound of the amount of the component in the box (in mol).
+    auto addComponentDimension(String const& component, double lower, double upper) -> void;
+
+    /// Build the surrogate over its box using the equilibrium solver.
+    /// @param state0 The initial state used for the conditions not spanned by the box and as initial guess.
+    auto build(ChemicalState const& state0) -> void;
+
+    /// Build the surrogate over its box using the equilibrium solver.
+    /// @param state0 The initial state used for the conditions not spanned by the box and as initial guess.
+    /// @param conditions The values of the input variables not spanned by the box.
+    auto build(ChemicalState const& state0, EquilibriumConditions const& conditions) -> void;
+
+    /// Predict the chemical equilibrium state at given conditions without falling back to the equilibrium solver.
+    /// This method does not change the surrogate and can be called concurrently from many threads.
+    /// @param[in,out] state The chemical state used to evaluate the conditions (in) and the predicted equilibrium state if accepted (out)
+    /// @param conditions The conditions at which the chemical equilibrium state is predicted
+    /// @return True if the prediction was accepted, otherwise false and `state` is not changed.
+    auto predict(ChemicalState& state, EquilibriumConditions const& conditions) const -> bool;
+
+    /// Equilibrate a chemical state with the surrogate, falling back to the equilibrium solver if needed (temperature and pressure taken from the state).
+    /// This method is not thread-safe (see the other @ref solve method).
+    /// @param[in,out] state The initial guess for the calculation (in) and the computed equilibrium state (out)
+    auto solve(ChemicalState& state) -> EquilibriumSurrogateResult;
+
+    /// Equilibrate a chemical state with the surrogate, falling back to the equilibrium solver if needed.
+    /// This method is not thread-safe, because it updates the counters of
+    /// predictions and fallbacks in the statistics of the surrogate and uses
+    /// its single equilibrium solver for the fallbacks. To use the surrogate
+    /// from many threads, call @ref predict in each thread and, if the
+    /// prediction is not accepted, use an EquilibriumSolver object owned by
+    /// that thread.
+    /// @param[in,out] state The initial guess for the calculation (in) and the computed equilibrium state (out)
+    /// @param conditions The specified constraint conditions to be attained at chemical equilibrium
+    auto solve(ChemicalState& state, EquilibriumConditions const& conditions) -> EquilibriumSurrogateResult;
+
+    /// Return the statistics of the construction and usage of the surrogate.
+    auto statistics() const -> EquilibriumSurrogateStatistics;
+
+    /// Save the surrogate to a binary file.
+    auto save(String const& filepath) const -> void;
+
+    /// Load the surrogate from a binary file created with @ref save, replacing its dimensions and records.
+    /// The file must have been created with equilibrium specifications identical to those of this surrogate.
+    auto load(String const& filepath) -> void;
+
+private:
+    struct Impl;
+
+    Ptr<Impl> pimpl;
+};
+
+} // namespace Reaktoro
@@ -0,0 +1,80 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// pybind11 includes
+#include <Reaktoro/pybind11.hxx>
+
+// Reaktoro includes
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumConditions.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSpecs.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSurrogate.hpp>
+using namespace Reaktoro;
+
+void exportEquilibriumSurrogate(py::module& m)
+{
+    py::class_<EquilibriumSurrogateOptions>(m, "EquilibriumSurrogateOptions")
+        .def(py::init<>())
+        .def_readwrite("equilibrium", &EquilibriumSurrogateOptions::equilibrium, "The options for the chemical equilibrium calculations when building the surrogate and when falling back to the solver.")
+        .def_readwrite("threads", &EquilibriumSurrogateOptions::threads, "The number of threads used to build the surrogate (zero means the number of hardware threads).")
+        .def_readwrite("reltol", &EquilibriumSurrogateOptions::reltol, "The relative tolerance for the errors in the predicted amounts of the species when refining the cells of the surrogate.")
+        .def_readwrite("abstol", &EquilibriumSurrogateOptions::abstol, "The absolute tolerance, relative to the total amount of species, for the errors in the predicted amounts of the species when refining the cells of the surrogate.")
+        .def_readwrite("reltol_offbox", &EquilibriumSurrogateOptions::reltol_offbox, "The relative tolerance for the predicted changes in the chemical potentials of the primary species due to conditions not spanned by the dimensions of the surrogate.")
+        .def_readwrite("abstol_offbox", &EquilibriumSurrogateOptions::abstol_offbox, "The absolute tolerance for the predicted changes in the chemical potentials of the primary species due to conditions not spanned by the dimensions of the surrogate (in J/mol).")
+        .def_readwrite("reltol_negative_amounts", &EquilibriumSurrogateOptions::reltol_negative_amounts, "The relative tolerance for negative species amounts in the predicted chemical equilibrium states.")
+        .def_readwrite("max_depth", &EquilibriumSurrogateOptions::max_depth, "The maximum number of times a cell can be bisected when building the surrogate.")
+        .def_readwrite("max_cells", &EquilibriumSurrogateOptions::max_cells, "The maximum number of cells created when building the surrogate.")
+        ;
+
+    py::class_<EquilibriumSurrogateStatistics>(m, "EquilibriumSurrogateStatistics")
+        .def(py::init<>())
+        .def_readwrite("records", &EquilibriumSurrogateStatistics::records, "The number of records with the equilibrium states and sensitivity derivatives stored in the surrogate.")
+        .def_readwrite("leaves", &EquilibriumSurrogateStatistics::leaves, "The number of cells in the surrogate that cannot be divided further.")
+        .def_readwrite("unconverged", &EquilibriumSurrogateStatistics::unconverged, "The number of leaf cells whose prediction errors could not be brought below the tolerances.")
+        .def_readwrite("depth", &EquilibriumSurrogateStatistics::depth, "The maximum number of times a cell was bisected.")
+        .def_readwrite("equilibriums", &EquilibriumSurrogateStatistics::equilibriums, "The number of equilibrium calculations performed to build the surrogate.")
+        .def_readwrite("memory", &EquilibriumSurrogateStatistics::memory, "The memory used to store the records of the surrogate (in bytes).")
+        .def_readwrite("time", &EquilibriumSurrogateStatistics::time, "The time spent to build the surrogate (in s).")
+        .def_readwrite("predictions", &EquilibriumSurrogateStatistics::predictions, "The number of accepted predictions since the surrogate was built or loaded.")
+        .def_readwrite("fallbacks", &EquilibriumSurrogateStatistics::fallbacks, "The number of calculations performed with the equilibrium solver since the surrogate was built or loaded.")
+        ;
+
+    py::class_<EquilibriumSurrogateResult>(m, "EquilibriumSurrogateResult")
+        .def(py::init<>())
+        .def_readwrite("predicted", &EquilibriumSurrogateResult::predicted, "The indication whether the chemical equilibrium state was predicted by the surrogate.")
+        .def_readwrite("outside", &EquilibriumSurrogateResult::outside, "The indication whether the conditions of the calculation were outside the box covered by the surrogate.")
+        .def_readwrite("fallback", &EquilibriumSurrogateResult::fallback, "The result of the equilibrium solver, used when the prediction was not accepted.")
+        ;
+
+    py::class_<EquilibriumSurrogate>(m, "EquilibriumSurrogate")
+        .def(py::init<EquilibriumSpecs const&>())
+        .def("setOptions", &EquilibriumSurrogate::setOptions, "Set the options for building and evaluating the surrogate.")
+        .def("addTemperatureDimension", &EquilibriumSurrogate::addTemperatureDimension, "Add temperature as a dimension of the box covered by the surrogate.", py::arg("lower"), py::arg("upper"), py::arg("unit")="K")
+        .def("addPressureDimension", &EquilibriumSurrogate::addPressureDimension, "Add pressure as a dimension of the box covered by the surrogate.", py::arg("lower"), py::arg("upper"), py::arg("unit")="Pa")
+        .def("addInputDimension", &EquilibriumSurrogate::addInputDimension, "Add an input variable in the equilibrium specifications as a dimension of the box covered by the surrogate.")
+        .def("addComponentDimension", &EquilibriumSurrogate::addComponentDimension, "Add the amount of a conservative component as a dimension of the box covered by the surrogate.")
+        .def("build", py::overload_cast<ChemicalState const&>(&EquilibriumSurrogate::build), py::call_guard<py::gil_scoped_release>(), "Build the surrogate over its box using the equilibrium solver.")
+        .def("build", py::overload_cast<ChemicalState const&, EquilibriumConditions const&>(&EquilibriumSurrogate::build), py::call_guard<py::gil_scoped_release>(), "Build the surrogate over its box using the equilibrium solver.")
+        .def("predict", &EquilibriumSurrogate::predict, "Predict the chemical equilibrium state at given conditions without falling back to the equilibrium solver.")
+        .def("solve", py::overload_cast<ChemicalState&>(&EquilibriumSurrogate::solve), "Equilibrate a chemical state with the surrogate, falling back to the equilibrium solver if needed.")
+        .def("solve", py::overload_cast<ChemicalState&, EquilibriumConditions const&>(&EquilibriumSurrogate::solve), "Equilibrate a chemical state with the surrogate, falling back to the equilibrium solver if needed.")
+        .def("statistics", &EquilibriumSurrogate::statistics, "Return the statistics of the construction and usage of the surrogate.")
+        .def("save", &EquilibriumSurrogate::save, "Save the surrogate to a binary file.")
+        .def("load", &EquilibriumSurrogate::load, "Load the surrogate from a binary file created with save.")
+        ;
+}
@@ -0,0 +1,225 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// Catch includes
+#include <catch2/catch.hpp>
+
+// C++ includes
+#include <cstdio>
+
+// Reaktoro includes
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/Database.hpp>
+#include <Reaktoro/Core/Phases.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumConditions.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSolver.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSpecs.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSurrogate.hpp>
+using namespace Reaktoro;
+
+TEST_CASE("Testing EquilibriumSurrogate", "[EquilibriumSurrogate]")
+{
+    Database db({
+        Species("H2O"     ).withStandardGibbsEnergy( -237181.72),
+        Species("H+"      ).withStandardGibbsEnergy(       0.00),
+        Species("OH-"     ).withStandardGibbsEnergy( -157297.48),
+        Species("Ca++"    ).withStandardGibbsEnergy( -552790.08),
+        Species("CO2"     ).withStandardGibbsEnergy( -385974.00),
+        Species("HCO3-"   ).withStandardGibbsEnergy( -586939.89),
+        Species("CO3--"   ).withStandardGibbsEnergy( -527983.14),
+        Species("CaCO3(s)").withStandardGibbsEnergy(-1129177.92),
+    });
+
+    Phases phases(db);
+    phases.add( AqueousPhase("H2O H+ OH- Ca++ CO2 HCO3- CO3--") );
+    phases.add( MineralPhase("CaCO3(s)") );
+
+    ChemicalSystem system(phases);
+
+    EquilibriumSpecs specs(system);
+    specs.temperature();
+    specs.pressure();
+    specs.pH();
+
+    ChemicalState state0(system);
+    state0.setSpeciesAmounts(1e-16);
+    state0.setSpeciesAmount("H2O", 55.508, "mol");
+    state0.setSpeciesAmount("CO2", 0.01, "mol");
+    state0.setSpeciesAmount("CaCO3(s)", 0.1, "mol");
+
+    EquilibriumSurrogateOptions options;
+    options.threads = 2;
+    options.max_depth = 10;
+    options.max_cells = 2000;
+
+    EquilibriumSurrogate surrogate(specs);
+    surrogate.setOptions(options);
+    surrogate.addTemperatureDimension(25.0, 90.0, "celsius");
+    surrogate.addInputDimension("pH", 7.0, 9.0);
+
+    EquilibriumConditions conditions0(specs);
+    conditions0.pressure(1.0, "bar");
+
+    surrogate.build(state0, conditions0);
+
+    const auto stats = surrogate.statistics();
+
+    CHECK( stats.records > 0 );
+    CHECK( stats.leaves >= stats.records );
+    CHECK( stats.leaves == stats.records + stats.unconverged );
+    CHECK( stats.equilibriums > stats.records );
+    CHECK( stats.depth > 0 );
+    CHECK( stats.memory > 0 );
+
+    EquilibriumSolver solver(specs);
+
+    // Return the largest error in the species amounts of a state relative to those of another, in units of the tolerances in the options
+    auto error = [&](ChemicalState const& state, ChemicalState const& exact)
+    {
+        const ArrayXd n = state.speciesAmounts().cast<double>();
+        const ArrayXd nexact = exact.speciesAmounts().cast<double>();
+        return ((n - nexact).abs() / (options.reltol * nexact.abs() + options.abstol * nexact.sum())).maxCoeff();
+    };
+
+    // Return the conditions at given temperature (in celsius) and pH
+    auto conditionsAt = [&](double T, double pH)
+    {
+        EquilibriumConditions conditions(specs);
+        conditions.temperature(T, "celsius");
+        conditions.pressure(1.0, "bar");
+        conditions.pH(pH);
+        return conditions;
+    };
+
+    SECTION("Checking the predictions inside the box against the equilibrium solver")
+    {
+        Index accepted = 0;
+
+        for(auto T : { 27.0, 41.0, 58.0, 73.0, 88.0 })
+        {
+            for(auto pH : { 7.1, 7.6, 8.3, 8.9 })
+            {
+                INFO("T = " << T << " celsius, pH = " << pH);
+
+                const auto conditions = conditionsAt(T, pH);
+
+                ChemicalState state(state0);
+                if(!surrogate.predict(state, conditions))
+                    continue;
+
+                accepted += 1;
+
+                ChemicalState exact(state0);
+                REQUIRE( solver.solve(exact, conditions).succeeded() );
+
+                CHECK( state.temperature() == Approx(T + 273.15) );
+                CHECK( error(state, exact) < 4.0 ); // the errors are controlled at the faces of the cells, so allow some slack inside them
+            }
+        }
+
+        CHECK( accepted > 10 );
+    }
+
+    SECTION("Checking the fallback to the equilibrium solver outside the box")
+    {
+        const auto conditions = conditionsAt(50.0, 10.0);
+
+        ChemicalState state(state0);
+        CHECK_FALSE( surrogate.predict(state, conditions) );
+
+        const auto result = surrogate.solve(state, conditions);
+
+        CHECK( result.outside );
+        CHECK_FALSE( result.predicted );
+        CHECK( result.fallback.succeeded() );
+        CHECK( surrogate.statistics().fallbacks == 1 );
+        CHECK( surrogate.statistics().predictions == 0 );
+
+        ChemicalState inside(state0);
+        const auto resultinside = surrogate.solve(inside, conditionsAt(50.0, 8.0));
+
+        CHECK_FALSE( resultinside.outside );
+        CHECK( surrogate.statistics().predictions + surrogate.statistics().fallbacks == 2 );
+    }
+
+    SECTION("Checking the fallback to the equilibrium solver with large changes in the conditions not spanned by the box")
+    {
+        const auto conditions = conditionsAt(50.0, 8.0);
+
+        ChemicalState state(state0);
+        state.setSpeciesAmount("CO2", 1.0, "mol"); // a hundredfold increase in the amount of carbon dioxide
+
+        CHECK_FALSE( surrogate.predict(state, conditions) );
+    }
+
+    SECTION("Checking the surrogate after saving and loading it")
+    {
+        const auto filepath = "EquilibriumSurrogate.test.rkt";
+
+        surrogate.save(filepath);
+
+        EquilibriumSurrogate loaded(specs);
+        loaded.setOptions(options);
+        loaded.load(filepath);
+
+        std::remove(filepath);
+
+        CHECK( loaded.statistics().records == stats.records );
+        CHECK( loaded.statistics().leaves == stats.leaves );
+        CHECK( loaded.statistics().depth == stats.depth );
+        CHECK( loaded.statistics().equilibriums == stats.equilibriums );
+
+        for(auto T : { 33.0, 66.0 })
+        {
+            for(auto pH : { 7.4, 8.6 })
+            {
+                const auto conditions = conditionsAt(T, pH);
+
+                ChemicalState state1(state0);
+                ChemicalState state2(state0);
+
+                const auto predicted1 = surrogate.predict(state1, conditions);
+                const auto predicted2 = loaded.predict(state2, conditions);
+
+                CHECK( predicted1 == predicted2 );
+                if(predicted1 && predicted2)
+                    CHECK( state1.speciesAmounts().isApprox(state2.speciesAmounts()) );
+            }
+        }
+
+        EquilibriumSpecs otherspecs(system);
+        otherspecs.temperature();
+        otherspecs.pressure();
+
+        EquilibriumSurrogate other(otherspecs);
+        surrogate.save(filepath);
+        CHECK_THROWS( other.load(filepath) ); // different input variables
+        std::remove(filepath);
+    }
+
+    SECTION("Checking errors in the specification of the dimensions")
+    {
+        EquilibriumSurrogate other(specs);
+        CHECK_THROWS( other.build(state0, conditions0) ); // no dimensions
+        CHECK_THROWS( other.addInputDimension("Eh", 0.0, 1.0) ); // not an input variable
+        CHECK_THROWS( other.addComponentDimension("Na", 0.0, 1.0) ); // not a component
+        CHECK_THROWS( other.addInputDimension("pH", 9.0, 7.0) ); // inverted bounds
+        other.addComponentDimension("Ca", 0.01, 1.0);
+        CHECK_THROWS( other.addComponentDimension("Ca", 0.1, 2.0) ); // duplicate dimension
+    }
+}
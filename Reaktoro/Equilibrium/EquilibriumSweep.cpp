@@ -0,0 +1,485 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "EquilibriumSweep.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Algorithms.hpp>
+#include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Common/TimeUtils.hpp>
+#include <Reaktoro/Common/Units.hpp>
+#include <Reaktoro/Core/ChemicalQuantity.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+#include <Reaktoro/Core/Utils.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumConditions.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumResult.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSolver.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSpecs.hpp>
+
+namespace Reaktoro {
+namespace {
+
+/// Return the product of given dimensions.
+auto product(Indices const& dims) -> Index
+{
+    return std::accumulate(dims.begin(), dims.end(), Index(1), std::multiplies<Index>());
+}
+
+/// Compute the multi-index of the point at given position along a boustrophedon path through a box with given dimensions.
+/// The last dimension varies the fastest, and the direction along a dimension
+/// reverses every time the dimension before it advances, so that consecutive
+/// positions along the path differ by one step along a single dimension.
+auto boustrophedon(Index pos, Indices const& dims, Indices& idx) -> void
+{
+    Index stride = 1; // the number of points in the box spanned by the dimensions after j
+    for(auto j = dims.size(); j-- > 0; )
+    {
+        const auto passes = pos / stride; // the number of steps taken along dimension j, including those of the previous passes
+        const auto digit = passes % dims[j];
+        const auto reversed = (passes / dims[j]) % 2 == 1; // odd passes along dimension j go backwards
+        idx[j] = reversed ? dims[j] - 1 - digit : digit;
+        stride *= dims[j];
+    }
+}
+
+/// Compute the multi-index of the point at given position in a box with given dimensions, with the last dimension varying the fastest.
+auto unravel(Index pos, Indices const& dims, Indices& idx) -> void
+{
+    for(auto j = dims.size(); j-- > 0; )
+    {
+        idx[j] = pos % dims[j];
+        pos /= dims[j];
+    }
+}
+
+/// Return the position of the point with given multi-index in a box with given dimensions, with the last dimension varying the fastest.
+auto ravel(Indices const& idx, Indices const& dims) -> Index
+{
+    Index pos = 0;
+    for(auto j = 0; j < dims.size(); ++j)
+        pos = pos * dims[j] + idx[j];
+    return pos;
+}
+
+/// Return the extents of the tiles along each dimension of a grid so that a tile has at most given number of points and is as close to a cube as possible.
+auto tileExtents(Indices const& dims, Index tilesize) -> Indices
+{
+    const auto D = dims.size();
+
+    Indices order(D);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](auto a, auto b) { return dims[a] < dims[b]; });
+
+    // Distribute the points of the tile among the dimensions, starting with the shortest ones, whose unused share goes to the longer ones
+    Indices extents(D);
+    auto budget = static_cast<double>(std::max<Index>(tilesize, 1));
+    for(auto k = 0; k < D; ++k)
+    {
+        const auto j = order[k];
+        const auto share = std::floor(std::pow(budget, 1.0 / (D - k)) + 1e-8);
+        extents[j] = std::min<Index>(dims[j], std::max<Index>(share, 1));
+        budget = std::max(budget / extents[j], 1.0);
+    }
+
+    return extents;
+}
+
+} // namespace
+
+struct EquilibriumSweep::Impl
+{
+    /// An axis of the grid of conditions.
+    struct Axis
+    {
+        /// The name of the axis, used as the name of its column in the results.
+        String name;
+
+        /// The values along the axis (in the units of the input variable or in mol).
+        ArrayXd values;
+
+        /// The index of the input variable along the axis (or the number of input variables if this is an axis of species amounts).
+        Index iinput = 0;
+
+        /// The index of the species whose initial amount varies along the axis (or the number of species if this is an axis of an input variable).
+        Index ispecies = 0;
+
+        /// The amounts of the conservative components in one mole of the species along the axis.
+        ArrayXd c;
+    };
+
+    /// The specifications of the equilibrium problems at the grid points.
+    EquilibriumSpecs specs;
+
+    /// The options of the sweep.
+    EquilibriumSweepOptions options;
+
+    /// The axes of the grid of conditions.
+    Vec<Axis> axes;
+
+    /// The chemical quantities computed at every grid point.
+    Strings quantities;
+
+    /// The results of the last sweep.
+    Table results;
+
+    /// Construct an EquilibriumSweep::Impl object.
+    Impl(EquilibriumSpecs const& specs)
+    : specs(specs)
+    {}
+
+    /// Add an axis to the grid after checking its name is unique and it has values.
+    auto addAxis(Axis const& axis) -> void
+    {
+        errorif(axis.values.size() == 0, "Expecting at least one value along the axis `", axis.name, "` in EquilibriumSweep.");
+        for(auto const& other : axes)
+            errorif(other.name == axis.name, "There is already an axis named `", axis.name, "` in EquilibriumSweep.");
+        axes.push_back(axis);
+    }
+
+    auto addInputAxis(String const& input, ArrayXdConstRef const& values) -> void
+    {
+        auto const& inputs = specs.inputs();
+        const auto iinput = index(inputs, input);
+        errorif(iinput >= inputs.size(), "Cannot add an axis along `", input, "` in EquilibriumSweep because this is not an input variable in your equilibrium specifications.");
+
+        Axis axis;
+        axis.name = input;
+        axis.values = values;
+        axis.iinput = iinput;
+        axis.ispecies = specs.system().species().size();
+        addAxis(axis);
+    }
+
+    auto addSpeciesAmountAxis(StringOrIndex const& species, ArrayXdConstRef const& values, String const& unit) -> void
+    {
+        auto const& system = specs.system();
+        const auto ispecies = detail::resolveSpeciesIndexOrRaiseError(system, species, "Cannot add an axis of species amounts in EquilibriumSweep.");
+
+        // The amounts of the conservative components in one mole of the species (including those introduced by the equilibrium specifications)
+        VectorXd n = VectorXd::Zero(system.species().size());
+        n[ispecies] = 1.0;
+        EquilibriumConditions conditions(specs);
+        conditions.setInitialComponentAmountsFromSpeciesAmounts(n);
+
+        Axis axis;
+        axis.name = system.species(ispecies).name();
+        axis.values = units::convert(ArrayXd(values), unit, "mol");
+        axis.iinput = specs.inputs().size();
+        axis.ispecies = ispecies;
+        axis.c = conditions.initialComponentAmounts();
+        addAxis(axis);
+    }
+
+    auto numPoints() const -> Index
+    {
+        Index count = axes.empty() ? 0 : 1;
+        for(auto const& axis : axes)
+            count *= axis.values.size();
+        return count;
+    }
+
+    auto run(ChemicalState const& state0, EquilibriumConditions const& conditions0) -> EquilibriumSweepResult
+    {
+        errorif(axes.empty(), "Expecting at least one axis in EquilibriumSweep before computing the equilibrium states along the grid.");
+
+        const auto tbegin = time();
+
+        auto const& system = specs.system();
+
+        const auto D = axes.size();
+        const auto N = numPoints();
+        const auto Nq = quantities.size();
+        const auto Nw = specs.inputs().size();
+
+        Indices dims(D);
+        for(auto j = 0; j < D; ++j)
+            dims[j] = axes[j].values.size();
+
+        //======================================================================
+        // Prepare the conditions shared by all grid points
+        //======================================================================
+
+        EquilibriumConditions base(conditions0);
+
+        // Temperature and pressure not given by the axes nor by the conditions are taken from the initial state (so that warm starts do not change them)
+        if(contains(specs.inputs(), String("T")) && std::isnan(base.inputValue("T").val()))
+            base.temperature(state0.temperature());
+        if(contains(specs.inputs(), String("P")) && std::isnan(base.inputValue("P").val()))
+            base.pressure(state0.pressure());
+
+        const ArrayXd c0 = base.initialComponentAmountsGetOrCompute(state0);
+        const ArrayXd n0 = state0.speciesAmounts();
+
+        //======================================================================
+        // Divide the grid into tiles (independently of the number of threads, so that the results are too)
+        //======================================================================
+
+        const auto extents = tileExtents(dims, options.tilesize);
+
+        Indices tiledims(D);
+        for(auto j = 0; j < D; ++j)
+            tiledims[j] = (dims[j] + extents[j] - 1) / extents[j];
+
+        const auto numtiles = product(tiledims);
+
+        Index numthreads = options.threads;
+        if(numthreads == 0)
+            numthreads = std::max<Index>(std::thread::hardware_concurrency(), 1);
+        numthreads = std::max<Index>(std::min(numthreads, numtiles), 1);
+
+        //======================================================================
+        // Compute the grid points tile by tile across a pool of threads
+        //======================================================================
+
+        Vec<double> values(N * Nq, std::numeric_limits<double>::quiet_NaN());
+        Vec<char> succeeded(N, false);
+        Vec<char> warmstarted(N, false);
+        Vec<char> fellback(N, false);
+        Vec<long> iterations(N, 0);
+
+        std::atomic<Index> next = 0;
+        std::exception_ptr error;
+        std::mutex errormutex;
+
+        auto worker = [&]
+        {
+            try
+            {
+                EquilibriumSolver solver(specs);
+                EquilibriumConditions conditions(base);
+                ChemicalState state(state0);
+                ChemicalQuantity quantity(system);
+
+                solver.setOptions(options.equilibrium);
+
+                Vec<ChemicalQuantity::Function> functions;
+                for(auto const& q : quantities)
+                    functions.push_back(quantity.function(q));
+
+                Indices tile(D), local(D), global(D), sizes(D);
+                ArrayXd c(c0.size());
+
+                for(auto t = next++; t < numtiles; t = next++)
+                {
+                    unravel(t, tiledims, tile);
+                    for(auto j = 0; j < D; ++j)
+                        sizes[j] = std::min(extents[j], dims[j] - tile[j] * extents[j]);
+
+                    bool previous = false; // true if `state` holds the equilibrium state of the previous point along the path
+
+                    const auto Npoints = product(sizes);
+
+                    for(auto k = 0; k < Npoints; ++k)
+                    {
+                        boustrophedon(k, sizes, local);
+                        for(auto j = 0; j < D; ++j)
+                            global[j] = tile[j] * extents[j] + local[j];
+
+                        // Set the input variables and the amounts of the components at the grid point
+                        c = c0;
+                        for(auto j = 0; j < D; ++j)
+                        {
+                            auto const& axis = axes[j];
+                            const auto value = axis.values[global[j]];
+                            if(axis.iinput < Nw)
+                                conditions.setInputVariable(axis.iinput, value);
+                            else c += axis.c * (value - n0[axis.ispecies]);
+                        }
+                        conditions.setInitialComponentAmounts(c);
+
+                        EquilibriumResult result;
+
+                        const auto warmstart = options.warmstart && previous;
+
+                        auto coldstart = !warmstart;
+
+                        if(warmstart)
+                        {
+                            result = solver.solve(state, conditions);
+                            coldstart = !result.succeeded();
+                        }
+
+                        if(coldstart)
+                        {
+                            state = state0;
+                            for(auto j = 0; j < D; ++j)
+                            {
+                                auto const& axis = axes[j];
+                                const auto value = axis.values[global[j]];
+                                if(axis.iinput == Nw)
+                                    state.setSpeciesAmount(axis.ispecies, value);
+                                else if(axis.name == "T")
+                                    state.temperature(value);
+                                else if(axis.name == "P")
+                                    state.pressure(value);
+                            }
+                            result = solver.solve(state, conditions);
+                        }
+
+                        const auto i = ravel(global, dims);
+
+                        succeeded[i] = result.succeeded();
+                        warmstarted[i] = !coldstart;
+                        fellback[i] = warmstart && coldstart;
+                        iterations[i] = result.iterations();
+
+                        previous = result.succeeded();
+
+                        if(!result.succeeded())
+                            continue;
+
+                        quantity.update(state);
+                        for(auto j = 0; j < Nq; ++j)
+                            values[i * Nq + j] = functions[j]();
+                    }
+                }
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(errormutex);
+                if(!error)
+                    error = std::current_exception();
+                next = numtiles; // stop the other threads as soon as they finish their current tile
+            }
+        };
+
+        Vec<std::thread> threads;
+        for(auto i = 1; i < numthreads; ++i)
+            threads.emplace_back(worker);
+        worker(); // the calling thread is also part of the pool
+        for(auto& thread : threads)
+            thread.join();
+
+        if(error)
+            std::rethrow_exception(error);
+
+        //======================================================================
+        // Collect the results in the order of the grid points
+        //======================================================================
+
+        EquilibriumSweepResult stats;
+
+        results = Table();
+
+        Indices idx(D);
+
+        for(auto i = 0; i < N; ++i)
+        {
+            unravel(i, dims, idx);
+            for(auto j = 0; j < D; ++j)
+                results.column(axes[j].name).appendFloat(axes[j].values[idx[j]]);
+            results.column("Succeeded").appendBoolean(succeeded[i]);
+            results.column("WarmStart").appendBoolean(warmstarted[i]);
+            results.column("Iterations").appendInteger(iterations[i]);
+            for(auto j = 0; j < Nq; ++j)
+                results.column(quantities[j]).appendFloat(values[i * Nq + j]);
+
+            stats.succeeded += succeeded[i];
+            stats.warmstarts += warmstarted[i];
+            stats.fallbacks += fellback[i];
+            stats.iterations += iterations[i];
+        }
+
+        stats.points = N;
+        stats.tiles = numtiles;
+        stats.threads = numthreads;
+        stats.time = elapsed(tbegin);
+
+        return stats;
+    }
+};
+
+EquilibriumSweep::EquilibriumSweep(EquilibriumSpecs const& specs)
+: pimpl(new Impl(specs))
+{}
+
+EquilibriumSweep::EquilibriumSweep(EquilibriumSweep const& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+EquilibriumSweep::~EquilibriumSweep()
+{}
+
+auto EquilibriumSweep::operator=(EquilibriumSweep other) -> EquilibriumSweep&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto EquilibriumSweep::setOptions(EquilibriumSweepOptions const& options) -> void
+{
+    pimpl->options = options;
+}
+
+auto EquilibriumSweep::addTemperatureAxis(ArrayXdConstRef const& values, String const& unit) -> void
+{
+    pimpl->addInputAxis("T", units::convert(ArrayXd(values), unit, "K"));
+}
+
+auto EquilibriumSweep::addPressureAxis(ArrayXdConstRef const& values, String const& unit) -> void
+{
+    pimpl->addInputAxis("P", units::convert(ArrayXd(values), unit, "Pa"));
+}
+
+auto EquilibriumSweep::addInputAxis(String const& input, ArrayXdConstRef const& values) -> void
+{
+    pimpl->addInputAxis(input, values);
+}
+
+auto EquilibriumSweep::addSpeciesAmountAxis(StringOrIndex const& species, ArrayXdConstRef const& values, String const& unit) -> void
+{
+    pimpl->addSpeciesAmountAxis(species, values, unit);
+}
+
+auto EquilibriumSweep::addQuantity(String const& quantity) -> void
+{
+    pimpl->quantities.push_back(quantity);
+}
+
+auto EquilibriumSweep::numPoints() const -> Index
+{
+    return pimpl->numPoints();
+}
+
+auto EquilibriumSweep::run(ChemicalState const& state0) -> EquilibriumSweepResult
+{
+    return pimpl->run(state0, EquilibriumConditions(pimpl->specs));
+}
+
+auto EquilibriumSweep::run(ChemicalState const& state0, EquilibriumConditions const& conditions) -> EquilibriumSweepResult
+{
+    return pimpl->run(state0, conditions);
+}
+
+auto EquilibriumSweep::results() const -> Table const&
+{
+    return pimpl->results;
+}
+
+} // namespace Reaktoro
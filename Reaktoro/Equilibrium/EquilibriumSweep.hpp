@@ -0,0 +1,179 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+// Reaktoro includes
+#include <Reaktoro/Common/Matrix.hpp>
+#include <Reaktoro/Common/Table.hpp>
+#include <Reaktoro/Common/Types.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumOptions.hpp>
+
+namespace Reaktoro {
+
+// Forward declarations
+class ChemicalState;
+class EquilibriumConditions;
+class EquilibriumSpecs;
+
+/// The options for the sweep of equilibrium calculations over a grid of conditions with EquilibriumSweep.
+struct EquilibriumSweepOptions
+{
+    /// The number of threads used to compute the tiles of the grid (zero means the number of hardware threads).
+    Index threads = 0;
+
+    /// The maximum number of grid points in a tile.
+    /// The first point of a tile starts from the given initial state and every
+    /// other point starts from the equilibrium state of its neighbour along
+    /// the path through the tile. Larger tiles mean fewer of these cold starts,
+    /// smaller tiles a better balance of work among the threads. The tiles do
+    /// not depend on the number of threads, so a grid with fewer tiles than
+    /// threads leaves some threads idle.
+    Index tilesize = 256;
+
+    /// The flag that indicates if each grid point starts from the equilibrium state of its neighbour.
+    /// If false, every grid point starts from the given initial state, which
+    /// is mainly useful to benchmark the benefit of the continuation.
+    bool warmstart = true;
+
+    /// The options for the equilibrium calculations at the grid points.
+    EquilibriumOptions equilibrium;
+};
+
+/// The statistics of the last sweep of equilibrium calculations with EquilibriumSweep.
+struct EquilibriumSweepResult
+{
+    /// The number of grid points in the sweep.
+    Index points = 0;
+
+    /// The number of grid points whose equilibrium calculation succeeded.
+    Index succeeded = 0;
+
+    /// The number of grid points that succeeded starting from the equilibrium state of a neighbour.
+    Index warmstarts = 0;
+
+    /// The number of grid points whose calculation from the state of a neighbour failed and was repeated from the initial state.
+    Index fallbacks = 0;
+
+    /// The total number of iterations of the equilibrium calculations.
+    Index iterations = 0;
+
+    /// The number of tiles the grid was divided into.
+    Index tiles = 0;
+
+    /// The number of threads used in the sweep.
+    Index threads = 0;
+
+    /// The time spent in the sweep (in s).
+    double time = 0.0;
+};
+
+/// Used to compute chemical equilibrium states over a grid of conditions.
+/// The grid is the tensor product of axes added with methods such as
+/// @ref addTemperatureAxis, @ref addInputAxis and @ref addSpeciesAmountAxis, and it
+/// is divided into tiles computed in parallel. Within a tile, the grid points
+/// are visited along a boustrophedon path (the direction along an axis
+/// reverses every time the next axis advances), so that consecutive points
+/// differ by one step along a single axis and each equilibrium calculation
+/// starts from the equilibrium state of its neighbour. Because every tile
+/// starts from the given initial state, the results do not depend on the
+/// number of threads nor on the order in which the tiles are computed.
+/// The results are stored in a Table object with one row per grid point (with
+/// the last added axis varying the fastest), containing the values along the
+/// axes, the columns `Succeeded`, `WarmStart` and `Iterations`, and the
+/// chemical quantities added with @ref addQuantity (see ChemicalQuantity).
+/// ~~~{.cpp}
+/// EquilibriumSpecs specs(system);
+/// specs.temperature();
+/// specs.pressure();
+///
+/// EquilibriumSweep sweep(specs);
+/// sweep.addTemperatureAxis(ArrayXd::LinSpaced(100, 25.0, 300.0), "celsius");
+/// sweep.addPressureAxis(ArrayXd::LinSpaced(100, 1.0, 1000.0), "bar");
+/// sweep.addSpeciesAmountAxis("CO2", ArrayXd::LinSpaced(21, 0.0, 2.0), "mol");
+/// sweep.addQuantity("pH");
+/// sweep.addQuantity("speciesAmount(Calcite)");
+/// sweep.run(state);
+///
+/// sweep.results().save("sweep.txt");
+/// ~~~
+class EquilibriumSweep
+{
+public:
+    /// Construct an EquilibriumSweep object with given specifications of the equilibrium problems.
+    explicit EquilibriumSweep(EquilibriumSpecs const& specs);
+
+    /// Construct a copy of an EquilibriumSweep object.
+    EquilibriumSweep(EquilibriumSweep const& other);
+
+    /// Destroy this EquilibriumSweep object.
+    ~EquilibriumSweep();
+
+    /// Assign a copy of an EquilibriumSweep object to this.
+    auto operator=(EquilibriumSweep other) -> EquilibriumSweep&;
+
+    /// Set the options of the sweep.
+    auto setOptions(EquilibriumSweepOptions const& options) -> void;
+
+    /// Add an axis along the temperature, which must be an input variable in the equilibrium specifications.
+    /// @param values The values of temperature along the axis.
+    /// @param unit The unit of the given values of temperature.
+    auto addTemperatureAxis(ArrayXdConstRef const& values, String const& unit="K") -> void;
+
+    /// Add an axis along the pressure, which must be an input variable in the equilibrium specifications.
+    /// @param values The values of pressure along the axis.
+    /// @param unit The unit of the given values of pressure.
+    auto addPressureAxis(ArrayXdConstRef const& values, String const& unit="Pa") -> void;
+
+    /// Add an axis along an input variable in the equilibrium specifications (e.g., `T`, `P`, `pH`, or the id of a Param object).
+    /// @param input The name of the input variable.
+    /// @param values The values of the input variable along the axis, in the units expected by the equilibrium specifications.
+    auto addInputAxis(String const& input, ArrayXdConstRef const& values) -> void;
+
+    /// Add an axis along the initial amount of a species, such as a titrant added to the system.
+    /// The initial amounts of the other species are those in the initial state given to @ref run.
+    /// @param species The name or index of the species.
+    /// @param values The initial amounts of the species along the axis.
+    /// @param unit The unit of the given amounts of the species.
+    auto addSpeciesAmountAxis(StringOrIndex const& species, ArrayXdConstRef const& values, String const& unit="mol") -> void;
+
+    /// Add a chemical quantity to be computed at every grid point (e.g., `pH`, `speciesAmount(Calcite units=mmol)`).
+    auto addQuantity(String const& quantity) -> void;
+
+    /// Return the number of grid points in the sweep.
+    auto numPoints() const -> Index;
+
+    /// Compute the equilibrium states at all grid points.
+    /// @param state0 The initial state used for the values not given by the axes and for the first point of every tile.
+    auto run(ChemicalState const& state0) -> EquilibriumSweepResult;
+
+    /// Compute the equilibrium states at all grid points.
+    /// @param state0 The initial state used for the values not given by the axes and for the first point of every tile.
+    /// @param conditions The values of the input variables not given by the axes.
+    auto run(ChemicalState const& state0, EquilibriumConditions const& conditions) -> EquilibriumSweepResult;
+
+    /// Return the results of the last sweep, with one row per grid point.
+    auto results() const -> Table const&;
+
+private:
+    struct Impl;
+
+    Ptr<Impl> pimpl;
+};
+
+} // namespace Reaktoro
@@ -0,0 +1,64 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// pybind11 includes
+#include <Reaktoro/pybind11.hxx>
+
+// Reaktoro includes
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumConditions.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSpecs.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSweep.hpp>
+using namespace Reaktoro;
+
+void exportEquilibriumSweep(py::module& m)
+{
+    py::class_<EquilibriumSweepOptions>(m, "EquilibriumSweepOptions")
+        .def(py::init<>())
+        .def_readwrite("threads", &EquilibriumSweepOptions::threads, "The number of threads used to compute the tiles of the grid (zero means the number of hardware threads).")
+        .def_readwrite("tilesize", &EquilibriumSweepOptions::tilesize, "The maximum number of grid points in a tile.")
+        .def_readwrite("warmstart", &EquilibriumSweepOptions::warmstart, "The flag that indicates if each grid point starts from the equilibrium state of its neighbour.")
+        .def_readwrite("equilibrium", &EquilibriumSweepOptions::equilibrium, "The options for the equilibrium calculations at the grid points.")
+        ;
+
+    py::class_<EquilibriumSweepResult>(m, "EquilibriumSweepResult")
+        .def(py::init<>())
+        .def_readwrite("points", &EquilibriumSweepResult::points, "The number of grid points in the sweep.")
+        .def_readwrite("succeeded", &EquilibriumSweepResult::succeeded, "The number of grid points whose equilibrium calculation succeeded.")
+        .def_readwrite("warmstarts", &EquilibriumSweepResult::warmstarts, "The number of grid points that succeeded starting from the equilibrium state of a neighbour.")
+        .def_readwrite("fallbacks", &EquilibriumSweepResult::fallbacks, "The number of grid points whose calculation from the state of a neighbour failed and was repeated from the initial state.")
+        .def_readwrite("iterations", &EquilibriumSweepResult::iterations, "The total number of iterations of the equilibrium calculations.")
+        .def_readwrite("tiles", &EquilibriumSweepResult::tiles, "The number of tiles the grid was divided into.")
+        .def_readwrite("threads", &EquilibriumSweepResult::threads, "The number of threads used in the sweep.")
+        .def_readwrite("time", &EquilibriumSweepResult::time, "The time spent in the sweep (in s).")
+        ;
+
+    py::class_<EquilibriumSweep>(m, "EquilibriumSweep")
+        .def(py::init<EquilibriumSpecs const&>())
+        .def("setOptions", &EquilibriumSweep::setOptions, "Set the options of the sweep.")
+        .def("addTemperatureAxis", &EquilibriumSweep::addTemperatureAxis, "Add an axis along the temperature.", py::arg("values"), py::arg("unit")="K")
+        .def("addPressureAxis", &EquilibriumSweep::addPressureAxis, "Add an axis along the pressure.", py::arg("values"), py::arg("unit")="Pa")
+        .def("addInputAxis", &EquilibriumSweep::addInputAxis, "Add an axis along an input variable in the equilibrium specifications.")
+        .def("addSpeciesAmountAxis", &EquilibriumSweep::addSpeciesAmountAxis, "Add an axis along the initial amount of a species.", py::arg("species"), py::arg("values"), py::arg("unit")="mol")
+        .def("addQuantity", &EquilibriumSweep::addQuantity, "Add a chemical quantity to be computed at every grid point.")
+        .def("numPoints", &EquilibriumSweep::numPoints, "Return the number of grid points in the sweep.")
+        .def("run", py::overload_cast<ChemicalState const&>(&EquilibriumSweep::run), py::call_guard<py::gil_scoped_release>(), "Compute the equilibrium states at all grid points.")
+        .def("run", py::overload_cast<ChemicalState const&, EquilibriumConditions const&>(&EquilibriumSweep::run), py::call_guard<py::gil_scoped_release>(), "Compute the equilibrium states at all grid points.")
+        .def("results", &EquilibriumSweep::results, return_internal_ref, "Return the results of the last sweep, with one row per grid point.")
+        ;
+}
@@ -0,0 +1,195 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// Catch includes
+#include <catch2/catch.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Core/ChemicalQuantity.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/Database.hpp>
+#include <Reaktoro/Core/Phases.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumConditions.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumResult.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSolver.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSpecs.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSweep.hpp>
+using namespace Reaktoro;
+
+TEST_CASE("Testing EquilibriumSweep", "[EquilibriumSweep]")
+{
+    Database db({
+        Species("H2O"     ).withStandardGibbsEnergy( -237181.72),
+        Species("H+"      ).withStandardGibbsEnergy(       0.00),
+        Species("OH-"     ).withStandardGibbsEnergy( -157297.48),
+        Species("Ca++"    ).withStandardGibbsEnergy( -552790.08),
+        Species("CO2"     ).withStandardGibbsEnergy( -385974.00),
+        Species("HCO3-"   ).withStandardGibbsEnergy( -586939.89),
+        Species("CO3--"   ).withStandardGibbsEnergy( -527983.14),
+        Species("CaCO3(s)").withStandardGibbsEnergy(-1129177.92),
+    });
+
+    Phases phases(db);
+    phases.add( AqueousPhase("H2O H+ OH- Ca++ CO2 HCO3- CO3--") );
+    phases.add( MineralPhase("CaCO3(s)") );
+
+    ChemicalSystem system(phases);
+
+    EquilibriumSpecs specs(system);
+    specs.temperature();
+    specs.pressure();
+
+    ChemicalState state0(system);
+    state0.setSpeciesAmounts(1e-16);
+    state0.setSpeciesAmount("H2O", 55.508, "mol");
+    state0.setSpeciesAmount("CaCO3(s)", 1.0, "mol");
+
+    const ArrayXd temperatures = ArrayXd::LinSpaced(5, 25.0, 85.0);
+    const ArrayXd amounts = ArrayXd::LinSpaced(7, 1.0, 7.0) * 1e-2;
+
+    EquilibriumSweep sweep(specs);
+    sweep.addTemperatureAxis(temperatures, "celsius");
+    sweep.addSpeciesAmountAxis("CO2", amounts, "mol");
+    sweep.addQuantity("pH");
+    sweep.addQuantity("elementMolality(Ca)");
+
+    CHECK( sweep.numPoints() == 35 );
+
+    SECTION("Checking the grid points against equilibrium calculations done one by one")
+    {
+        EquilibriumSweepOptions options;
+        options.threads = 2;
+        options.tilesize = 6;
+        sweep.setOptions(options);
+
+        const auto result = sweep.run(state0);
+
+        CHECK( result.points == 35 );
+        CHECK( result.succeeded == 35 );
+        CHECK( result.warmstarts > 0 );
+        CHECK( result.threads == 2 );
+        CHECK( result.tiles > 1 );
+
+        auto const& table = sweep.results();
+
+        CHECK( table.column("T").rows() == 35 );
+        CHECK( table.column("CO2").rows() == 35 );
+        CHECK( table.column("Iterations").rows() == 35 );
+
+        EquilibriumSolver solver(specs);
+        ChemicalQuantity quantity(system);
+
+        for(auto i = 0; i < temperatures.size(); ++i)
+        {
+            for(auto j = 0; j < amounts.size(); ++j)
+            {
+                const auto row = i * amounts.size() + j; // the last axis varies the fastest
+
+                INFO("T = " << temperatures[i] << " celsius, n(CO2) = " << amounts[j] << " mol");
+
+                CHECK( table.column("T").floats()[row] == Approx(temperatures[i] + 273.15) );
+                CHECK( table.column("CO2").floats()[row] == Approx(amounts[j]) );
+                CHECK( table.column("Succeeded").booleans()[row] );
+
+                ChemicalState state(state0);
+                state.temperature(temperatures[i], "celsius");
+                state.setSpeciesAmount("CO2", amounts[j], "mol");
+
+                REQUIRE( solver.solve(state).succeeded() );
+
+                quantity.update(state);
+
+                CHECK( table.column("pH").floats()[row] == Approx(quantity.value("pH")).epsilon(1e-6) );
+                CHECK( table.column("elementMolality(Ca)").floats()[row] == Approx(quantity.value("elementMolality(Ca)")).epsilon(1e-6) );
+            }
+        }
+    }
+
+    SECTION("Checking the results do not depend on the number of threads")
+    {
+        for(auto tilesize : { Index(8), EquilibriumSweepOptions().tilesize })
+        {
+            INFO("tilesize = " << tilesize);
+
+            EquilibriumSweepOptions options;
+            options.tilesize = tilesize;
+
+            options.threads = 1;
+            sweep.setOptions(options);
+            const auto result1 = sweep.run(state0);
+            const auto pH1 = sweep.results().column("pH").floats();
+            const auto iters1 = sweep.results().column("Iterations").integers();
+
+            options.threads = 3;
+            sweep.setOptions(options);
+            const auto result3 = sweep.run(state0);
+            const auto pH3 = sweep.results().column("pH").floats();
+            const auto iters3 = sweep.results().column("Iterations").integers();
+
+            CHECK( result1.tiles == result3.tiles );
+            CHECK( pH1 == pH3 );
+            CHECK( iters1 == iters3 );
+        }
+    }
+
+    SECTION("Checking the continuation reduces the number of iterations")
+    {
+        EquilibriumSweepOptions options;
+        options.threads = 1;
+        options.tilesize = 35;
+
+        options.warmstart = false;
+        sweep.setOptions(options);
+        const auto cold = sweep.run(state0);
+
+        options.warmstart = true;
+        sweep.setOptions(options);
+        const auto warm = sweep.run(state0);
+
+        CHECK( cold.warmstarts == 0 );
+        CHECK( warm.warmstarts == 34 );
+        CHECK( warm.tiles == 1 );
+        CHECK( warm.iterations < cold.iterations );
+    }
+
+    SECTION("Checking the sweep along an input variable given in the conditions")
+    {
+        EquilibriumSweep sweepP(specs);
+        sweepP.addInputAxis("P", ArrayXd::LinSpaced(4, 1.0e5, 1.0e7));
+        sweepP.addQuantity("pressure(units=bar)");
+
+        EquilibriumConditions conditions(specs);
+        conditions.temperature(50.0, "celsius");
+
+        const auto result = sweepP.run(state0, conditions);
+
+        CHECK( result.succeeded == 4 );
+        CHECK( sweepP.results().column("pressure(units=bar)").floats()[3] == Approx(100.0) );
+    }
+
+    SECTION("Checking errors in the specification of the axes")
+    {
+        EquilibriumSweep other(specs);
+        CHECK_THROWS( other.run(state0) ); // no axes
+        CHECK_THROWS( other.addInputAxis("pH", ArrayXd::LinSpaced(3, 4.0, 6.0)) ); // not an input variable
+        CHECK_THROWS( other.addSpeciesAmountAxis("NaCl", amounts) ); // not a species in the system
+        CHECK_THROWS( other.addTemperatureAxis(ArrayXd()) ); // no values
+        other.addTemperatureAxis(temperatures);
+        CHECK_THROWS( other.addInputAxis("T", temperatures) ); // duplicate axis
+    }
+}
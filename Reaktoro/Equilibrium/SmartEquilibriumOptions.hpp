@@ -50,6 +50,33 @@ struct SmartEquilibriumOptions
 
     /// The step length used to discretize pressure in the temperature-pressure space when storing learned calculations (in Pa).
     double pressure_step = 25.0e+5;
+
+    /// The number of records in a cluster blended together when none of them alone passes the acceptance test (values below 2 disable blending).
+    /// When no record in a cluster produces an acceptable first-order Taylor
+    /// prediction on its own, the predictions of the records with the smallest
+    /// predicted changes in the chemical potentials of the primary species are
+    /// blended using inverse-distance weights (the distance of a record being
+    /// the norm of these changes). The blended prediction is accepted if the
+    /// chemical potentials of the primary species predicted by each blended
+    /// record deviate from their blend by less than the tolerances @ref reltol
+    /// and @ref abstol. In other words, the records must agree on the
+    /// predicted chemical potentials at the new conditions. Interpolating
+    /// between records in this way increases the rate of accepted predictions
+    /// in regions where the equilibrium states vary strongly with the input
+    /// conditions.
+    Index num_blended_records = 0;
+
+    /// The maximum number of records of learned calculations that can be stored (zero means no limit).
+    /// Whenever a learning operation causes this limit to be exceeded, records
+    /// are evicted until it is satisfied. The evicted records are the least
+    /// used ones in the clusters that have not been used for the longest time.
+    /// Clusters and temperature-pressure grid cells left without records are
+    /// removed. The record just learned is never evicted.
+    Index max_records = 0;
+
+    /// The maximum memory used to store the records of learned calculations (in bytes, zero means no limit).
+    /// This limit is enforced the same way as @ref max_records.
+    Index max_memory = 0;
 };
 
 } // namespace Reaktoro
@@ -30,6 +30,9 @@ void exportSmartEquilibriumOptions(py::module& m)
         .def_readwrite("reltol_negative_amounts", &SmartEquilibriumOptions::reltol_negative_amounts, "The relative tolerance for negative species amounts when predicting with first-order Taylor approximation.")
         .def_readwrite("reltol", &SmartEquilibriumOptions::reltol, "The relative tolerance used in the acceptance test for the predicted chemical equilibrium state.")
         .def_readwrite("abstol", &SmartEquilibriumOptions::abstol, "The absolute tolerance used in the acceptance test for the predicted chemical equilibrium state.")
+        .def_readwrite("num_blended_records", &SmartEquilibriumOptions::num_blended_records, "The number of records in a cluster blended together when none of them alone passes the acceptance test (values below 2 disable blending).")
+        .def_readwrite("max_records", &SmartEquilibriumOptions::max_records, "The maximum number of records of learned calculations that can be stored (zero means no limit).")
+        .def_readwrite("max_memory", &SmartEquilibriumOptions::max_memory, "The maximum memory used to store the records of learned calculations (in bytes, zero means no limit).")
         ;
 }
 
@@ -40,6 +40,7 @@ auto SmartEquilibriumTiming::operator+=(const SmartEquilibriumTiming& other) ->
 auto SmartEquilibriumResultDuringPrediction::operator+=(const SmartEquilibriumResultDuringPrediction& other) -> SmartEquilibriumResultDuringPrediction&
 {
     accepted = other.accepted;
+    blended = other.blended;
     failed_with_species = other.failed_with_species;
     failed_with_amount = other.failed_with_amount;
     failed_with_chemical_potential = other.failed_with_chemical_potential;
@@ -50,6 +51,8 @@ auto SmartEquilibriumResultDuringPrediction::operator+=(const SmartEquilibriumRe
 auto SmartEquilibriumResultDuringLearning::operator+=(const SmartEquilibriumResultDuringLearning& other) -> SmartEquilibriumResultDuringLearning&
 {
     solve +=other.solve;
+    evicted_records += other.evicted_records;
+    evicted_clusters += other.evicted_clusters;
 
     return *this;
 }
@@ -73,6 +73,9 @@ struct SmartEquilibriumResultDuringPrediction
     /// The indication whether the smart equilibrium prediction was accepted.
     bool accepted = false;
 
+    /// The indication whether the accepted prediction was blended from several records (see SmartEquilibriumOptions::num_blended_records).
+    bool blended = false;
+
     /// The name of the species that caused the smart approximation to fail.
     String failed_with_species;
 
@@ -93,10 +96,47 @@ struct SmartEquilibriumResultDuringLearning
     /// The result of the conventional iterative chemical equilibrium calculation in the learning operation.
     EquilibriumResult solve;
 
+    /// The number of records evicted after the learning operation to satisfy the storage limits.
+    Index evicted_records = 0;
+
+    /// The number of clusters removed after the learning operation because all their records were evicted.
+    Index evicted_clusters = 0;
+
     /// Self addition assignment to accumulate results.
     auto operator+=(const SmartEquilibriumResultDuringLearning& other) -> SmartEquilibriumResultDuringLearning&;
 };
 
+/// Used to provide statistics of the learned calculations stored in a smart chemical equilibrium solver.
+struct SmartEquilibriumStatistics
+{
+    /// The number of records of learned calculations currently stored.
+    Index records = 0;
+
+    /// The number of clusters of records currently stored.
+    Index clusters = 0;
+
+    /// The memory used to store the records of learned calculations (in bytes).
+    Index memory = 0;
+
+    /// The number of calculations performed with an accepted prediction.
+    Index predictions = 0;
+
+    /// The number of calculations performed with a learning operation.
+    Index learnings = 0;
+
+    /// The number of calculations performed with an accepted prediction blended from several records.
+    Index blended_predictions = 0;
+
+    /// The number of records evicted so far to satisfy the storage limits.
+    Index evicted_records = 0;
+
+    /// The number of clusters removed so far because all their records were evicted.
+    Index evicted_clusters = 0;
+
+    /// Return the fraction of calculations performed with an accepted prediction.
+    auto hitRate() const -> double { return predictions + learnings ? double(predictions) / (predictions + learnings) : 0.0; }
+};
+
 /// Used to describe the result of a smart chemical equilibrium calculation.
 struct SmartEquilibriumResult
 {
@@ -44,6 +44,7 @@ void exportSmartEquilibriumResult(py::module& m)
     py::class_<SmartEquilibriumResultDuringPrediction>(m, "SmartEquilibriumResultDuringPrediction")
         .def(py::init<>())
         .def_readwrite("accepted", &SmartEquilibriumResultDuringPrediction::accepted)
+        .def_readwrite("blended", &SmartEquilibriumResultDuringPrediction::blended)
         .def_readwrite("failed_with_species", &SmartEquilibriumResultDuringPrediction::failed_with_species)
         .def_readwrite("failed_with_amount", &SmartEquilibriumResultDuringPrediction::failed_with_amount)
         .def_readwrite("failed_with_chemical_potential", &SmartEquilibriumResultDuringPrediction::failed_with_chemical_potential)
@@ -53,9 +54,24 @@ void exportSmartEquilibriumResult(py::module& m)
     py::class_<SmartEquilibriumResultDuringLearning>(m, "SmartEquilibriumResultDuringLearning")
         .def(py::init<>())
         .def_readwrite("solve", &SmartEquilibriumResultDuringLearning::solve)
+        .def_readwrite("evicted_records", &SmartEquilibriumResultDuringLearning::evicted_records, "The number of records evicted after the learning operation to satisfy the storage limits.")
+        .def_readwrite("evicted_clusters", &SmartEquilibriumResultDuringLearning::evicted_clusters, "The number of clusters removed after the learning operation because all their records were evicted.")
         .def(py::self += py::self)
         ;
 
+    py::class_<SmartEquilibriumStatistics>(m, "SmartEquilibriumStatistics")
+        .def(py::init<>())
+        .def_readwrite("records", &SmartEquilibriumStatistics::records, "The number of records of learned calculations currently stored.")
+        .def_readwrite("clusters", &SmartEquilibriumStatistics::clusters, "The number of clusters of records currently stored.")
+        .def_readwrite("memory", &SmartEquilibriumStatistics::memory, "The memory used to store the records of learned calculations (in bytes).")
+        .def_readwrite("predictions", &SmartEquilibriumStatistics::predictions, "The number of calculations performed with an accepted prediction.")
+        .def_readwrite("learnings", &SmartEquilibriumStatistics::learnings, "The number of calculations performed with a learning operation.")
+        .def_readwrite("blended_predictions", &SmartEquilibriumStatistics::blended_predictions, "The number of calculations performed with an accepted prediction blended from several records.")
+        .def_readwrite("evicted_records", &SmartEquilibriumStatistics::evicted_records, "The number of records evicted so far to satisfy the storage limits.")
+        .def_readwrite("evicted_clusters", &SmartEquilibriumStatistics::evicted_clusters, "The number of clusters removed so far because all their records were evicted.")
+        .def("hitRate", &SmartEquilibriumStatistics::hitRate, "Return the fraction of calculations performed with an accepted prediction.")
+        ;
+
     py::class_<SmartEquilibriumResult>(m, "SmartEquilibriumResult")
         .def(py::init<>())
         .def("succeeded", &SmartEquilibriumResult::succeeded, "Return true if the calculation succeeded.")
@@ -17,14 +17,21 @@
 
 #include "SmartEquilibriumSolver.hpp"
 
+// C++ includes
+#include <algorithm>
+#include <limits>
+
+// Optima includes
+#include <Optima/State.hpp>
+
 // Reaktoro includes
+#include <Reaktoro/Common/Algorithms.hpp>
 #include <Reaktoro/Common/Exception.hpp>
 #include <Reaktoro/Common/Profiling.hpp>
 #include <Reaktoro/Core/ChemicalProps.hpp>
 #include <Reaktoro/Core/ChemicalState.hpp>
 #include <Reaktoro/Core/ChemicalSystem.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumConditions.hpp>
-#include <Reaktoro/Equilibrium/EquilibriumPredictor.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumRestrictions.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumSensitivity.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumSolver.hpp>
@@ -45,6 +52,39 @@ auto sround(double num, double step) -> long
     return round(num / step) * step;
 }
 
+/// The view of the data of a learned record stored contiguously in the storage of its cluster.
+struct RecordView
+{
+    VectorXdConstMap n0;    ///< The species amounts *n* at the reference equilibrium state.
+    VectorXdConstMap p0;    ///< The control variables *p* at the reference equilibrium state.
+    VectorXdConstMap q0;    ///< The control variables *q* at the reference equilibrium state.
+    VectorXdConstMap w0;    ///< The input variables *w* at the reference equilibrium state.
+    VectorXdConstMap c0;    ///< The component amounts *c* at the reference equilibrium state.
+    VectorXdConstMap u0;    ///< The chemical properties *u* at the reference equilibrium state.
+    MatrixXdConstMap dndwc; ///< The derivatives of *n* with respect to *(w, c)* at the reference equilibrium state.
+    MatrixXdConstMap dpdwc; ///< The derivatives of *p* with respect to *(w, c)* at the reference equilibrium state.
+    MatrixXdConstMap dqdwc; ///< The derivatives of *q* with respect to *(w, c)* at the reference equilibrium state.
+    MatrixXdConstMap dudwc; ///< The derivatives of *u* with respect to *(w, c)* at the reference equilibrium state.
+    VectorXdConstMap y0;    ///< The Lagrange multipliers *y* in the Optima state at the reference equilibrium state.
+    VectorXdConstMap z0;    ///< The stabilities *z* of the species in the Optima state at the reference equilibrium state.
+
+    /// Construct a RecordView object with given pointer to the data block of the record and its layout.
+    RecordView(double const* data, SmartEquilibriumSolver::RecordLayout const& layout)
+    : n0(data, layout.Nn),
+      p0(n0.data() + n0.size(), layout.Np),
+      q0(p0.data() + p0.size(), layout.Nq),
+      w0(q0.data() + q0.size(), layout.Nw),
+      c0(w0.data() + w0.size(), layout.Nc),
+      u0(c0.data() + c0.size(), layout.Nu),
+      dndwc(u0.data() + u0.size(), layout.Nn, layout.Nw + layout.Nc),
+      dpdwc(dndwc.data() + dndwc.size(), layout.Np, layout.Nw + layout.Nc),
+      dqdwc(dpdwc.data() + dpdwc.size(), layout.Nq, layout.Nw + layout.Nc),
+      dudwc(dqdwc.data() + dqdwc.size(), layout.Nu, layout.Nw + layout.Nc),
+      y0(dudwc.data() + dudwc.size(), layout.Ny),
+      z0(y0.data() + y0.size(), layout.Nz)
+    {}
+};
+
 } // namespace detail
 
 struct SmartEquilibriumSolver::Impl
@@ -62,9 +102,26 @@ struct SmartEquilibriumSolver::Impl
     /// The temperature-pressure grid containing learned calculations for speficic temperature-pressure intervals.
     SmartEquilibriumSolver::Grid grid;
 
+    /// The layout of the data of the learned records.
+    SmartEquilibriumSolver::RecordLayout layout;
+
+    /// The statistics of the learned calculations stored in the solver.
+    SmartEquilibriumStatistics stats;
+
+    /// The number of doubles stored in the packed chemical potential data of the primary species in all clusters.
+    Index numprimarydata = 0;
+
+    /// The index of temperature in *w* (equal to the number of input variables if temperature is unknown and thus in *p*).
+    const Index iTw;
+
+    /// The index of pressure in *w* (equal to the number of input variables if pressure is unknown and thus in *p*).
+    const Index iPw;
+
     /// Construct a SmartEquilibriumSolver::Impl object with given equilibrium problem specifications.
     Impl(EquilibriumSpecs const& specs)
-    : solver(specs), sensitivity(specs), conditions(specs)
+    : solver(specs), sensitivity(specs), conditions(specs),
+      iTw(index(specs.inputs(), "T")),
+      iPw(index(specs.inputs(), "P"))
     {
         // Initialize the equilibrium solver with the default options
         setOptions(options);
@@ -103,6 +160,14 @@ struct SmartEquilibriumSolver::Impl
         if(!result.prediction.accepted)
             timeit( learn(state, conditions), result.timing.learning= )
 
+        // Update the number of calculations performed with prediction and learning
+        if(result.prediction.accepted)
+            stats.predictions += 1;
+        else stats.learnings += 1;
+
+        if(result.prediction.blended)
+            stats.blended_predictions += 1;
+
         result.timing.solve = toc(SOLVE_STEP);
 
         return result;
@@ -168,8 +233,11 @@ struct SmartEquilibriumSolver::Impl
         //---------------------------------------------------------------------
         tic(STORAGE_STEP)
 
-        // Create an equilibrium predictor object with computed equilibrium state and its sensitivities
-        EquilibriumPredictor predictor(state, sensitivity);
+        errorif(state.equilibrium().w().size() == 0,
+            "SmartEquilibriumSolver expects the chemical equilibrium calculation to produce input variables *w*.");
+
+        errorif(sensitivity.dudw().size() == 0 || sensitivity.dudc().size() == 0,
+            "SmartEquilibriumSolver expects the chemical equilibrium calculation to produce the derivatives of the chemical properties *u*.");
 
         // Round temperature and pressure according to their respective step lengths for discretization
         const auto iT = detail::sround(state.temperature().val(), options.temperature_step);
@@ -189,8 +257,9 @@ struct SmartEquilibriumSolver::Impl
         if(icluster < cell.clusters.size())
         {
             auto& cluster = cell.clusters[icluster];
-            cluster.records.push_back({ state, conditions, sensitivity, predictor });
+            appendRecord(cluster, state);
             cluster.priority.extend();
+            cluster.lastused = calculationNumber();
         }
         else
         {
@@ -198,18 +267,274 @@ struct SmartEquilibriumSolver::Impl
             Cluster cluster;
             cluster.iprimary = iprimary;
             cluster.label = label;
-            cluster.records.push_back({ state, conditions, sensitivity, predictor });
+            cluster.equilibrium = state.equilibrium();
+            appendRecord(cluster, state);
             cluster.priority.extend();
+            cluster.lastused = calculationNumber();
 
             // Append the new cluster and initialize its connectivity and priority
             cell.clusters.push_back(cluster);
             cell.connectivity.extend();
             cell.priority.extend();
+
+            stats.clusters += 1;
         }
 
+        // Evict records if the storage limits are exceeded (but not the one just learned)
+        evictRecords({iT, iP}, icluster);
+
         result.timing.learning_storage = toc(STORAGE_STEP);
     }
 
+    /// Append the data of a learned chemical equilibrium state and its sensitivity derivatives to the storage of a cluster.
+    auto appendRecord(Cluster& cluster, ChemicalState const& state) -> void
+    {
+        auto const& equilibrium = state.equilibrium();
+        auto const& optstate = equilibrium.optimaState();
+
+        const VectorXd u = state.props();
+
+        layout.Nn = state.speciesAmounts().size();
+        layout.Np = equilibrium.p().size();
+        layout.Nq = equilibrium.q().size();
+        layout.Nw = equilibrium.w().size();
+        layout.Nc = equilibrium.c().size();
+        layout.Nu = u.size();
+        layout.Ny = optstate.ye.size();
+        layout.Nz = optstate.s.size();
+
+        const auto offset = cluster.data.size();
+        cluster.data.resize(offset + layout.size());
+
+        auto ptr = cluster.data.data() + offset;
+
+        auto push = [&](auto const& mat)
+        {
+            MatrixXdMap(ptr, mat.rows(), mat.cols()) = mat;
+            ptr += mat.size();
+        };
+
+        push(state.speciesAmounts().matrix().cast<double>());
+        push(equilibrium.p().matrix());
+        push(equilibrium.q().matrix());
+        push(equilibrium.w().matrix());
+        push(equilibrium.c().matrix());
+        push(u);
+        push(sensitivity.dndw());
+        push(sensitivity.dndc());
+        push(sensitivity.dpdw());
+        push(sensitivity.dpdc());
+        push(sensitivity.dqdw());
+        push(sensitivity.dqdc());
+        push(sensitivity.dudw());
+        push(sensitivity.dudc());
+        push(optstate.ye);
+        push(optstate.s);
+
+        assert(ptr == cluster.data.data() + cluster.data.size());
+
+        // Append the chemical potentials of the primary species and their derivatives to the packed data used in the error test
+        const auto Nwc = layout.Nw + layout.Nc;
+        const auto Npr = cluster.iprimary.size();
+
+        VectorXd wc0(Nwc);
+        wc0 << equilibrium.w().matrix(), equilibrium.c().matrix();
+
+        const auto dmuoffset = cluster.dmudwc.size();
+        cluster.dmudwc.resize(dmuoffset + Nwc * Npr);
+
+        MatrixXdMap dmudwc(cluster.dmudwc.data() + dmuoffset, Nwc, Npr);
+
+        for(auto j = 0; j < Npr; ++j)
+        {
+            const auto iu = layout.Nu - layout.Nn + cluster.iprimary[j]; // the index of the chemical potential of the primary species in *u*
+            dmudwc.col(j).head(layout.Nw) = sensitivity.dudw().row(iu).transpose();
+            dmudwc.col(j).tail(layout.Nc) = sensitivity.dudc().row(iu).transpose();
+            cluster.mu0.push_back(u[iu]);
+            cluster.dmu0.push_back(dmudwc.col(j).dot(wc0));
+        }
+
+        numprimarydata += (Nwc + 2) * Npr;
+
+        cluster.numrecords += 1;
+
+        stats.records += 1;
+    }
+
+    /// Return the number of the current calculation (used to identify stale clusters).
+    auto calculationNumber() const -> Index
+    {
+        return stats.predictions + stats.learnings + 1;
+    }
+
+    /// Return the memory used to store the records of learned calculations (in bytes).
+    auto memory() const -> Index
+    {
+        return (stats.records * layout.size() + numprimarydata) * sizeof(double);
+    }
+
+    /// Return true if the stored records exceed the limits on their number or memory.
+    auto storageLimitsExceeded() const -> bool
+    {
+        return (options.max_records && stats.records > options.max_records) ||
+               (options.max_memory && memory() > options.max_memory);
+    }
+
+    /// Evict records until the storage limits are satisfied.
+    /// The evicted records are the least used ones in the clusters that have
+    /// not been used for the longest time. The record just learned, which is
+    /// the last one in the cluster with index `keepcluster` in the grid cell
+    /// `keepcell`, is never evicted.
+    auto evictRecords(Pair<long, long> const& keepcell, Index keepcluster) -> void
+    {
+        while(storageLimitsExceeded())
+        {
+            // Find the cluster not used for the longest time that has a record that can be evicted
+            Cell* victimcell = nullptr;
+            Pair<long, long> victimkey;
+            Index victimcluster = 0;
+
+            for(auto& [key, cell] : grid.cells)
+            {
+                for(auto i = 0; i < cell.clusters.size(); ++i)
+                {
+                    auto const& cluster = cell.clusters[i];
+                    if(key == keepcell && i == keepcluster && cluster.numrecords == 1)
+                        continue; // skip the cluster whose only record is the one just learned
+                    if(victimcell == nullptr || cluster.lastused < victimcell->clusters[victimcluster].lastused)
+                    {
+                        victimcell = &cell;
+                        victimkey = key;
+                        victimcluster = i;
+                    }
+                }
+            }
+
+            // Stop if the record just learned is the only one stored
+            if(victimcell == nullptr)
+                break;
+
+            auto& cell = *victimcell;
+            auto& cluster = cell.clusters[victimcluster];
+
+            // Find the least used record in the cluster (skipping the record just learned, the last one in its cluster)
+            const auto keep = victimkey == keepcell && victimcluster == keepcluster;
+            auto const& order = cluster.priority.order();
+            const auto irecord = *std::find_if(order.rbegin(), order.rend(),
+                [&](Index i) { return !keep || i != cluster.numrecords - 1; });
+
+            // Remove the data and the priority of the evicted record
+            const auto size = layout.size();
+            cluster.data.erase(cluster.data.begin() + irecord * size, cluster.data.begin() + (irecord + 1) * size);
+
+            // Remove the packed chemical potential data of the primary species of the evicted record
+            const auto Npr = cluster.iprimary.size();
+            const auto Nwc = layout.Nw + layout.Nc;
+            cluster.dmudwc.erase(cluster.dmudwc.begin() + irecord * Npr * Nwc, cluster.dmudwc.begin() + (irecord + 1) * Npr * Nwc);
+            cluster.mu0.erase(cluster.mu0.begin() + irecord * Npr, cluster.mu0.begin() + (irecord + 1) * Npr);
+            cluster.dmu0.erase(cluster.dmu0.begin() + irecord * Npr, cluster.dmu0.begin() + (irecord + 1) * Npr);
+            numprimarydata -= (Nwc + 2) * Npr;
+            cluster.priority.remove(irecord);
+            cluster.numrecords -= 1;
+
+            stats.records -= 1;
+            stats.evicted_records += 1;
+            result.learning.evicted_records += 1;
+
+            // Remove the cluster if it has no more records (and the grid cell if it has no more clusters)
+            if(cluster.numrecords == 0)
+            {
+                cell.clusters.erase(cell.clusters.begin() + victimcluster);
+                cell.connectivity.remove(victimcluster);
+                cell.priority.remove(victimcluster);
+
+                stats.clusters -= 1;
+                stats.evicted_clusters += 1;
+                result.learning.evicted_clusters += 1;
+
+                if(victimkey == keepcell && victimcluster < keepcluster)
+                    keepcluster -= 1;
+
+                if(cell.clusters.empty())
+                    grid.cells.erase(victimkey);
+            }
+        }
+    }
+
+    /// Return a view of the data of a record stored in a cluster.
+    auto record(Cluster const& cluster, Index irecord) const -> detail::RecordView
+    {
+        return detail::RecordView(cluster.data.data() + irecord * layout.size(), layout);
+    }
+
+    /// Perform a first-order Taylor prediction of the chemical state using a record in a cluster and given changes *(dw, dc)* in the input conditions.
+    auto predictState(ChemicalState& state, Cluster const& cluster, detail::RecordView const& record, VectorXdConstRef dwc) const -> void
+    {
+        const VectorXd n = record.n0 + record.dndwc * dwc;
+        const VectorXd p = record.p0 + record.dpdwc * dwc;
+        const VectorXd q = record.q0 + record.dqdwc * dwc;
+        const VectorXd u = record.u0 + record.dudwc * dwc;
+        const VectorXd w = record.w0 + dwc.head(layout.Nw);
+        const VectorXd c = record.c0 + dwc.tail(layout.Nc);
+
+        setPredictedState(state, cluster, n, p, q, u, w, c, record.y0, record.z0);
+    }
+
+    /// Perform a blend of the first-order Taylor predictions of the chemical state using several records in a cluster with given weights at given input conditions *(w, c)*.
+    auto predictStateBlended(ChemicalState& state, Cluster const& cluster, Indices const& irecords, VectorXdConstRef weights, VectorXdConstRef w, VectorXdConstRef c) const -> void
+    {
+        VectorXd n = VectorXd::Zero(layout.Nn);
+        VectorXd p = VectorXd::Zero(layout.Np);
+        VectorXd q = VectorXd::Zero(layout.Nq);
+        VectorXd u = VectorXd::Zero(layout.Nu);
+        VectorXd y = VectorXd::Zero(layout.Ny);
+        VectorXd z = VectorXd::Zero(layout.Nz);
+        VectorXd dwc(layout.Nw + layout.Nc);
+
+        for(auto k = 0; k < irecords.size(); ++k)
+        {
+            const auto record = this->record(cluster, irecords[k]);
+
+            dwc.head(layout.Nw) = w - record.w0;
+            dwc.tail(layout.Nc) = c - record.c0;
+
+            n += weights[k] * (record.n0 + record.dndwc * dwc);
+            p += weights[k] * (record.p0 + record.dpdwc * dwc);
+            q += weights[k] * (record.q0 + record.dqdwc * dwc);
+            u += weights[k] * (record.u0 + record.dudwc * dwc);
+            y += weights[k] * record.y0;
+            z += weights[k] * record.z0;
+        }
+
+        setPredictedState(state, cluster, n, p, q, u, w, c, y, z);
+    }
+
+    /// Set the chemical state with given predicted values of *n*, *p*, *q*, *u*, the input conditions *(w, c)* and the values of *y* and *z* in the Optima state.
+    auto setPredictedState(ChemicalState& state, Cluster const& cluster, VectorXdConstRef n, VectorXdConstRef p, VectorXdConstRef q, VectorXdConstRef u, VectorXdConstRef w, VectorXdConstRef c, VectorXdConstRef y, VectorXdConstRef z) const -> void
+    {
+        const auto Nw = layout.Nw;
+
+        state.setSpeciesAmounts(n.array());
+        state.props().update(u.array());
+        state.equilibrium() = cluster.equilibrium.value();
+
+        // Use the Lagrange multipliers and stabilities of the records used in the prediction instead of those of the first record learned in the cluster
+        auto optstate = state.equilibrium().optimaState();
+        optstate.ye = y;
+        optstate.s = z;
+        state.equilibrium().setOptimaState(optstate);
+        state.equilibrium().setControlVariablesP(p.array());
+        state.equilibrium().setControlVariablesQ(q.array());
+        state.equilibrium().setInputVariables(w.array());
+        state.equilibrium().setInitialComponentAmounts(c.array());
+
+        const auto T = iTw < Nw ? w[iTw] : p[0]; // get temperature from given *w* or predicted *p*
+        const auto P = iPw < Nw ? w[iPw] : iTw < Nw ? p[0] : p[1]; // get pressure from given *w* or predicted *p* (if T is also unknown, P is in p[1])
+
+        state.setTemperature(T);
+        state.setPressure(P);
+    }
+
     /// Perform a prediction operation in which a chemical equilibrium state is predicted using a first-order Taylor approximation.
     auto predict(ChemicalState& state, EquilibriumConditions const& conditions) -> void
     {
@@ -237,36 +562,84 @@ struct SmartEquilibriumSolver::Impl
         const auto wvals = conditions.inputValuesGetOrCompute(state);
         const auto cvals = conditions.initialComponentAmountsGetOrCompute(state);
 
-        const auto w = wvals.cast<double>();
-        const auto c = cvals.cast<double>();
+        const VectorXd w = wvals.cast<double>().matrix();
+        const VectorXd c = cvals.cast<double>().matrix();
 
-        // Auxiliary vectors used in the lambda function below to avoid repeated memory allocation
-        VectorXd dw;
-        VectorXd dc;
+        const auto Nwc = layout.Nw + layout.Nc;
 
-        // The function that checks if a record in the grid pass the error test.
-        auto pass_error_test = [&](Record const& record) mutable -> bool
+        // The input conditions *(w, c)* of the chemical state being predicted
+        VectorXd wc(Nwc);
+        wc << w, c;
+
+        // Auxiliary vectors used below to avoid repeated memory allocation
+        VectorXd dwc(Nwc);
+        VectorXd dmu;
+
+        // The function that computes the predicted changes in the chemical potentials of the primary species for all records in a cluster at once.
+        // This is a single matrix-vector product over the packed derivatives of the cluster, instead of one dot product per primary species per record.
+        auto predict_chemical_potential_changes = [&](Cluster const& cluster) mutable -> void
         {
-            // The primary species at the reference chemical state
-            auto const& iprimary0 = record.state.equilibrium().indicesPrimarySpecies();
+            const auto numcols = cluster.mu0.size();
+            const auto dmudwc = MatrixXdConstMap(cluster.dmudwc.data(), Nwc, numcols);
+            const auto dmu0 = VectorXdConstMap(cluster.dmu0.data(), numcols);
+            dmu.resize(numcols);
+            dmu.noalias() = dmudwc.transpose() * wc;
+            dmu -= dmu0;
+        };
+
+        // The function that checks if a record in a cluster pass the error test (using the changes in chemical potentials computed above).
+        auto pass_error_test = [&](Cluster const& cluster, Index irecord) -> bool
+        {
+            const auto Npr = cluster.iprimary.size();
+            const auto mu0 = VectorXdConstMap(cluster.mu0.data() + irecord * Npr, Npr);
+            const auto dmui = dmu.segment(irecord * Npr, Npr);
+
+            using std::abs;
+
+            for(auto j = 0; j < Npr; ++j)
+                if(abs(dmui[j]) >= options.reltol*abs(mu0[j]) + options.abstol)
+                    return false;
+
+            return true;
+        };
 
-            // The equilibrium predictor calculator at the reference state
-            auto const& predictor0 = record.predictor;
+        // Auxiliary vectors with the indices and the normalized weights of the blended records (sorted in descending order of weights)
+        Indices iblended;
+        VectorXd weights;
 
-            const auto w0 = record.state.equilibrium().w();
-            const auto c0 = record.state.equilibrium().c();
+        // The function that checks if the blend of the records in a cluster nearest to the current conditions pass the error test (using the changes in chemical potentials computed above).
+        // The distance of a record is the norm of its predicted changes in the chemical potentials of the primary species and its weight is the inverse of its squared distance.
+        // The error of the blend is estimated with the spread of the chemical potentials predicted by each blended record at the current conditions around their blend,
+        // which, unlike the weighted changes in chemical potentials, cannot be made small by records whose changes have opposite signs.
+        auto pass_error_test_blended = [&](Cluster const& cluster) -> bool
+        {
+            const auto Npr = cluster.iprimary.size();
+            const auto Nb = std::min<Index>(options.num_blended_records, cluster.numrecords);
+
+            iblended = range<Index>(cluster.numrecords);
+            std::partial_sort(iblended.begin(), iblended.begin() + Nb, iblended.end(), [&](Index l, Index r)
+                { return dmu.segment(l * Npr, Npr).squaredNorm() < dmu.segment(r * Npr, Npr).squaredNorm(); });
+            iblended.resize(Nb);
 
-            dw = w - w0;
-            dc = c - c0;
+            weights.resize(Nb);
+            for(auto k = 0; k < Nb; ++k)
+                weights[k] = 1.0 / std::max(dmu.segment(iblended[k] * Npr, Npr).squaredNorm(), std::numeric_limits<double>::min());
+            weights /= weights.sum();
 
             using std::abs;
 
-            for(auto ispecies : iprimary0)
+            for(auto j = 0; j < Npr; ++j)
             {
-                const auto mu0 = predictor0.speciesChemicalPotentialReference(ispecies);
-                const auto mu1 = predictor0.speciesChemicalPotentialPredicted(ispecies, dw, dc);
-                if(abs(mu1 - mu0) >= options.reltol*abs(mu0) + options.abstol)
-                    return false;
+                // The chemical potential of the j-th primary species predicted by the k-th blended record
+                auto muj = [&](Index k) { return cluster.mu0[iblended[k] * Npr + j] + dmu[iblended[k] * Npr + j]; };
+
+                double mujblend = 0.0;
+                for(auto k = 0; k < Nb; ++k)
+                    mujblend += weights[k] * muj(k);
+
+                for(auto k = 0; k < Nb; ++k)
+                    if(abs(muj(k) - mujblend) >= options.reltol*abs(mujblend) + options.abstol)
+                        return false;
             }
 
             return true;
@@ -303,25 +676,78 @@ struct SmartEquilibriumSolver::Impl
         //---------------------------------------------------------------------
         tic(SEARCH_STEP)
 
+        // The function that accepts the predicted chemical state if its species amounts are acceptable and then updates the priorities of the used cluster and record.
+        auto accept_prediction = [&](Index jcluster, Index irecord) -> bool
+        {
+            // Check if all projected species amounts are positive or at least very small negative values
+            auto const& n = state.speciesAmounts();
+
+            const double nmin = n.minCoeff();
+            const double nsum = n.sum();
+
+            if(nmin <= options.reltol_negative_amounts * nsum)
+                return false; // continue searching for a another record that produces positive amounts only or tolerable negative values
+
+            result.timing.prediction_search = toc(SEARCH_STEP);
+
+            //---------------------------------------------------------------------
+            // After the search is finished successfully
+            //---------------------------------------------------------------------
+
+            // Assign small positive values to all negative amounts
+            for(auto i = 0; i < n.size(); ++i)
+                if(n[i] < 0.0)
+                    state.setSpeciesAmount(i, options.learning.epsilon);
+
+            //---------------------------------------------------------------------
+            // DATABASE PRIORITY UPDATE STEP DURING THE PREDICTION PROCESS
+            //---------------------------------------------------------------------
+            tic(PRIORITY_UPDATE_STEP)
+
+            // Increment priority of the current record (irecord) in the current cluster (jcluster)
+            cell.clusters[jcluster].priority.increment(irecord);
+
+            // Mark the current cluster (jcluster) as used in this calculation
+            cell.clusters[jcluster].lastused = calculationNumber();
+
+            // Increment priority of the current cluster (jcluster) with respect to starting cluster (icluster)
+            cell.connectivity.increment(icluster, jcluster);
+
+            // Increment priority of the current cluster (jcluster)
+            cell.priority.increment(jcluster);
+
+            // Mark the predicted state as accepted
+            result.prediction.accepted = true;
+
+            result.timing.prediction_priority_update = toc(PRIORITY_UPDATE_STEP);
+
+            return true;
+        };
+
         // Iterate over all clusters (starting with icluster)
         for(auto jcluster : clusters_ordering)
         {
-            // Fetch records from the cluster and the order they have to be processed in
-            auto const& records = cell.clusters[jcluster].records;
-            auto const& records_ordering = cell.clusters[jcluster].priority.order();
+            // Fetch the cluster and the order its records have to be processed in
+            auto const& cluster = cell.clusters[jcluster];
+            auto const& records_ordering = cluster.priority.order();
+
+            //---------------------------------------------------------------------
+            // ERROR CONTROL STEP DURING THE PREDICTION PROCESS
+            //---------------------------------------------------------------------
+            tic(ERROR_CONTROL_STEP)
+
+            // Compute the predicted changes in the chemical potentials of the primary species for all records in the cluster
+            predict_chemical_potential_changes(cluster);
+
+            result.timing.prediction_error_control += toc(ERROR_CONTROL_STEP);
 
             // Iterate over all records in current cluster (using the order based on the priorities)
             for(auto irecord : records_ordering)
             {
-                auto const& record = records[irecord];
-
-                //---------------------------------------------------------------------
-                // ERROR CONTROL STEP DURING THE PREDICTION PROCESS
-                //---------------------------------------------------------------------
                 tic(ERROR_CONTROL_STEP)
 
                 // Check if the current record passes the error test
-                const auto success = pass_error_test(record);
+                const auto success = pass_error_test(cluster, irecord);
 
                 result.timing.prediction_error_control += toc(ERROR_CONTROL_STEP);
 
@@ -332,52 +758,44 @@ struct SmartEquilibriumSolver::Impl
                     //---------------------------------------------------------------------
                     tic(TAYLOR_STEP)
 
-                    auto const& predictor0 = record.predictor;
+                    const auto record = this->record(cluster, irecord);
 
-                    predictor0.predict(state, conditions);
+                    dwc.head(layout.Nw) = w - record.w0;
+                    dwc.tail(layout.Nc) = c - record.c0;
 
-                    result.timing.prediction_taylor = toc(TAYLOR_STEP);
-
-                    // Check if all projected species amounts are positive or at least very small negative values
-                    auto const& n = state.speciesAmounts();
-
-                    const double nmin = n.minCoeff();
-                    const double nsum = n.sum();
-
-                    if(nmin <= options.reltol_negative_amounts * nsum)
-                        continue; // continue searching for a another record that produces positive amounts only or tolerable negative values
+                    predictState(state, cluster, record, dwc);
 
-                    result.timing.prediction_search = toc(SEARCH_STEP);
-
-                    //---------------------------------------------------------------------
-                    // After the search is finished successfully
-                    //---------------------------------------------------------------------
+                    result.timing.prediction_taylor = toc(TAYLOR_STEP);
 
-                    // Assign small positive values to all negative amounts
-                    for(auto i = 0; i < n.size(); ++i)
-                        if(n[i] < 0.0)
-                            state.setSpeciesAmount(i, options.learning.epsilon);
+                    if(accept_prediction(jcluster, irecord))
+                        return;
+                }
+            }
 
-                    //---------------------------------------------------------------------
-                    // DATABASE PRIORITY UPDATE STEP DURING THE PREDICTION PROCESS
-                    //---------------------------------------------------------------------
-                    tic(PRIORITY_UPDATE_STEP)
+            // Blend the predictions of the nearest records in the cluster if none of them alone was accepted
+            if(options.num_blended_records > 1 && cluster.numrecords > 1)
+            {
+                tic(ERROR_CONTROL_STEP)
 
-                    // Increment priority of the current record (irecord) in the current cluster (jcluster)
-                    cell.clusters[jcluster].priority.increment(irecord);
+                // Check if the blended records pass the error test
+                const auto success = pass_error_test_blended(cluster);
 
-                    // Increment priority of the current cluster (jcluster) with respect to starting cluster (icluster)
-                    cell.connectivity.increment(icluster, jcluster);
+                result.timing.prediction_error_control += toc(ERROR_CONTROL_STEP);
 
-                    // Increment priority of the current cluster (jcluster)
-                    cell.priority.increment(jcluster);
+                if(success)
+                {
+                    tic(TAYLOR_STEP)
 
-                    // Mark the predicted state as accepted
-                    result.prediction.accepted = true;
+                    predictStateBlended(state, cluster, iblended, weights, w, c);
 
-                    result.timing.prediction_priority_update = toc(PRIORITY_UPDATE_STEP);
+                    result.timing.prediction_taylor = toc(TAYLOR_STEP);
 
-                    return;
+                    // Accept the blended prediction crediting the record with the largest weight
+                    if(accept_prediction(jcluster, iblended[0]))
+                    {
+                        result.prediction.blended = true;
+                        return;
+                    }
                 }
             }
         }
@@ -397,6 +815,14 @@ struct SmartEquilibriumSolver::Impl
         options = opts;
         solver.setOptions(opts.learning);
     }
+
+    /// Return the statistics of the learned calculations stored in the solver.
+    auto statistics() const -> SmartEquilibriumStatistics
+    {
+        auto res = stats;
+        res.memory = memory();
+        return res;
+    }
 };
 
 SmartEquilibriumSolver::SmartEquilibriumSolver(ChemicalSystem const& system)
@@ -471,4 +897,9 @@ auto SmartEquilibriumSolver::setOptions(SmartEquilibriumOptions const& options)
     pimpl->setOptions(options);
 }
 
+auto SmartEquilibriumSolver::statistics() const -> SmartEquilibriumStatistics
+{
+    return pimpl->statistics();
+}
+
 } // namespace Reaktoro
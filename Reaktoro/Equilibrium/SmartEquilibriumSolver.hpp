@@ -23,7 +23,6 @@
 #include <Reaktoro/Common/Types.hpp>
 #include <Reaktoro/Core/ChemicalState.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumConditions.hpp>
-#include <Reaktoro/Equilibrium/EquilibriumPredictor.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumSensitivity.hpp>
 #include <Reaktoro/ODML/ClusterConnectivity.hpp>
 #include <Reaktoro/ODML/PriorityQueue.hpp>
@@ -38,6 +37,7 @@ class EquilibriumRestrictions;
 class EquilibriumSpecs;
 struct SmartEquilibriumOptions;
 struct SmartEquilibriumResult;
+struct SmartEquilibriumStatistics;
 
 /// Used for calculating chemical equilibrium states using an on-demand machine learning (ODML) strategy.
 class SmartEquilibriumSolver
@@ -123,20 +123,46 @@ public:
     /// Set the options of the equilibrium solver.
     auto setOptions(SmartEquilibriumOptions const& options) -> void;
 
-    /// The record of the knowledge database containing input, output, and derivatives data.
-    struct Record
+    /// Return the statistics of the learned calculations stored in the equilibrium solver.
+    auto statistics() const -> SmartEquilibriumStatistics;
+
+    /// The layout of the data of a record in the knowledge database containing input, output, and derivatives data.
+    /// The data of a record is stored as a contiguous block of doubles in the
+    /// storage of its cluster (see Cluster::data), in the following order: the
+    /// species amounts *n*, the control variables *p* and *q*, the input
+    /// variables *w*, the component amounts *c*, the chemical properties *u*,
+    /// the derivatives of *n*, *p*, *q* and *u* with respect to *(w, c)*
+    /// (each as a column-major matrix), and the Lagrange multipliers *y* and
+    /// stabilities *z* of the species in the Optima state of the record (used
+    /// to warm start calculations from a predicted state).
+    struct RecordLayout
     {
-        /// The fully calculated chemical equilibrium state.
-        ChemicalState state;
+        /// The number of species in the chemical system.
+        Index Nn = 0;
 
-        /// The conditions at which the chemical equilibrium state was calculated.
-        EquilibriumConditions conditions;
+        /// The number of *p* control variables.
+        Index Np = 0;
 
-        /// The sensitivity derivatives at the calculated chemical equilibrium state.
-        EquilibriumSensitivity sensitivity;
+        /// The number of *q* control variables.
+        Index Nq = 0;
 
-        /// The predictor of chemical equilibrium states at given new conditions.
-        EquilibriumPredictor predictor;
+        /// The number of input variables *w*.
+        Index Nw = 0;
+
+        /// The number of components with amounts *c*.
+        Index Nc = 0;
+
+        /// The number of chemical properties in *u*.
+        Index Nu = 0;
+
+        /// The number of Lagrange multipliers *y* in the Optima state.
+        Index Ny = 0;
+
+        /// The number of stabilities *z* in the Optima state.
+        Index Nz = 0;
+
+        /// Return the number of doubles in the data block of a record.
+        auto size() const -> Index { return (Nn + Np + Nq + Nu) * (1 + Nw + Nc) + Nw + Nc + Ny + Nz; }
     };
 
     /// The cluster storing learned input-output data with same classification.
@@ -148,8 +174,27 @@ public:
         /// The hash of the indices of the primary species for this cluster.
         Index label = 0;
 
-        /// The records stored in this cluster with learning data.
-        Deque<Record> records;
+        /// The equilibrium data of the first chemical state learned in this cluster (used for the predicted states in this cluster, with *p*, *q*, *w*, *c*, *y* and *z* taken from the records used in the prediction).
+        Optional<ChemicalState::Equilibrium> equilibrium;
+
+        /// The data of the records stored in this cluster (one block of RecordLayout::size() doubles per record).
+        Vec<double> data;
+
+        /// The number of records stored in this cluster.
+        Index numrecords = 0;
+
+        /// The derivatives of the chemical potentials of the primary species with respect to *(w, c)* in all records, packed for the error test of all records at once.
+        /// This is a column-major matrix with `Nw + Nc` rows and one column per primary species per record (i.e., the column `irecord*Np + j` corresponds to the *j*-th primary species in record `irecord`).
+        Vec<double> dmudwc;
+
+        /// The chemical potentials of the primary species in all records (one entry per column in @ref dmudwc).
+        Vec<double> mu0;
+
+        /// The products of the columns in @ref dmudwc with the reference *(w, c)* of their records (one entry per column in @ref dmudwc).
+        Vec<double> dmu0;
+
+        /// The number of the last calculation in which this cluster was used for learning or prediction (used to identify stale clusters for eviction).
+        Index lastused = 0;
 
         /// The priority queue for the records based on their usage count.
         PriorityQueue priority;
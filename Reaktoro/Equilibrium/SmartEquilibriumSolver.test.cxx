@@ -115,4 +115,224 @@ TEST_CASE("Testing SmartEquilibriumSolver", "[SmartEquilibriumSolver]")
         CHECK( result.learned() );
         CHECK( result.iterations() == 17 );
     }
+
+    WHEN("the number of stored records is limited - calcite and water")
+    {
+        SupcrtDatabase db("supcrtbl");
+
+        AqueousPhase solution("H2O(aq) H+ OH- Ca+2 HCO3- CO3-2 CO2(aq)");
+        solution.setActivityModel(ActivityModelPitzer());
+
+        MineralPhase calcite("Calcite");
+
+        ChemicalSystem system(db, solution, calcite);
+
+        SmartEquilibriumOptions options;
+        options.max_records = 1;
+
+        SmartEquilibriumSolver solver(system);
+        solver.setOptions(options);
+
+        SmartEquilibriumResult result;
+
+        auto createState = [&](double T)
+        {
+            ChemicalState state(system);
+            state.temperature(T, "celsius");
+            state.pressure(1.0, "bar");
+            state.set("H2O(aq)", 1.0, "kg");
+            state.set("Calcite", 1.0, "mol");
+            return state;
+        };
+
+        ChemicalState state = createState(25.0);
+
+        result = solver.solve(state); // learned and stored as the first record
+
+        CHECK( result.learned() );
+        CHECK( result.learning.evicted_records == 0 );
+        CHECK( solver.statistics().records == 1 );
+
+        state = createState(25.0);
+
+        result = solver.solve(state); // predicted using the first record
+
+        CHECK( result.predicted() );
+
+        state = createState(80.0);
+
+        result = solver.solve(state); // learned in another temperature-pressure grid cell, causing the first record to be evicted
+
+        CHECK( result.learned() );
+        CHECK( result.learning.evicted_records == 1 );
+        CHECK( result.learning.evicted_clusters == 1 );
+
+        auto stats = solver.statistics();
+
+        CHECK( stats.records == 1 );
+        CHECK( stats.clusters == 1 );
+        CHECK( stats.memory > 0 );
+        CHECK( stats.predictions == 1 );
+        CHECK( stats.learnings == 2 );
+        CHECK( stats.evicted_records == 1 );
+        CHECK( stats.evicted_clusters == 1 );
+        CHECK( stats.hitRate() == Approx(1.0/3.0) );
+
+        state = createState(25.0);
+
+        result = solver.solve(state); // learned again, since the first record was evicted
+
+        CHECK( result.learned() );
+        CHECK( solver.statistics().records == 1 );
+        CHECK( solver.statistics().evicted_records == 2 );
+    }
+
+    WHEN("the predicted state is warm started from the record used in the prediction - calcite and water")
+    {
+        SupcrtDatabase db("supcrtbl");
+
+        AqueousPhase solution("H2O(aq) H+ OH- Ca+2 HCO3- CO3-2 CO2(aq)");
+        solution.setActivityModel(ActivityModelPitzer());
+
+        MineralPhase calcite("Calcite");
+
+        ChemicalSystem system(db, solution, calcite);
+
+        SmartEquilibriumOptions options;
+        options.reltol = 0.0;
+        options.abstol = 1.0; // in J/mol, small enough so that the record learned at 22 celsius cannot be used at 31 celsius
+
+        SmartEquilibriumSolver solver(system);
+        solver.setOptions(options);
+
+        SmartEquilibriumResult result;
+
+        auto createState = [&](double T)
+        {
+            ChemicalState state(system);
+            state.temperature(T, "celsius");
+            state.pressure(1.0, "bar");
+            state.set("H2O(aq)", 1.0, "kg");
+            state.set("Calcite", 1.0, "mol");
+            return state;
+        };
+
+        // Learn two records at temperatures 22 and 31 celsius, both in the same cluster of the same temperature-pressure grid cell
+        ChemicalState learned22 = createState(22.0);
+        ChemicalState learned31 = createState(31.0);
+
+        CHECK( solver.solve(learned22).learned() );
+        CHECK( solver.solve(learned31).learned() );
+        CHECK( solver.statistics().clusters == 1 );
+
+        // Predict the state at 31 celsius, which uses the second record and not the first one learned in the cluster
+        ChemicalState state = createState(31.0);
+
+        result = solver.solve(state);
+
+        CHECK( result.predicted() );
+
+        // The Optima state used to warm start calculations must be that of the record used in the prediction
+        CHECK( state.equilibrium().elementChemicalPotentials().isApprox(learned31.equilibrium().elementChemicalPotentials()) );
+        CHECK( state.equilibrium().speciesStabilities().isApprox(learned31.equilibrium().speciesStabilities()) );
+        CHECK_FALSE( state.equilibrium().elementChemicalPotentials().isApprox(learned22.equilibrium().elementChemicalPotentials()) );
+    }
+
+    WHEN("the predictions of several records are blended - calcite and water")
+    {
+        SupcrtDatabase db("supcrtbl");
+
+        AqueousPhase solution("H2O(aq) H+ OH- Ca+2 HCO3- CO3-2 CO2(aq)");
+        solution.setActivityModel(ActivityModelPitzer());
+
+        MineralPhase calcite("Calcite");
+
+        ChemicalSystem system(db, solution, calcite);
+
+        EquilibriumSolver exactsolver(system);
+
+        SmartEquilibriumResult result;
+
+        auto createState = [&](double T)
+        {
+            ChemicalState state(system);
+            state.temperature(T, "celsius");
+            state.pressure(1.0, "bar");
+            state.set("H2O(aq)", 1.0, "kg");
+            state.set("Calcite", 1.0, "mol");
+            return state;
+        };
+
+        // Create a smart solver with given absolute tolerance and learn two records at temperatures 22 and 31 celsius, both in the same temperature-pressure grid cell (between 295 K and 305 K)
+        auto createSolver = [&](double abstol)
+        {
+            SmartEquilibriumOptions options;
+            options.num_blended_records = 2;
+            options.reltol = 0.0;
+            options.abstol = abstol; // in J/mol
+
+            SmartEquilibriumSolver solver(system);
+            solver.setOptions(options);
+
+            for(auto T : { 22.0, 31.0 })
+            {
+                ChemicalState state = createState(T);
+
+                result = solver.solve(state);
+
+                CHECK( result.succeeded() );
+                CHECK( result.learned() );
+            }
+
+            return solver;
+        };
+
+        // At the midpoint temperature, the predicted changes in chemical potentials of each record alone (for a temperature change of 4.5 K) fail the acceptance test
+        // with an absolute tolerance of 150 J/mol, whereas the chemical potentials predicted by the two records differ by much less than that and their blend is accepted
+        SECTION("when the records agree on the predicted chemical potentials within the tolerance")
+        {
+            SmartEquilibriumSolver solver = createSolver(150.0);
+
+            ChemicalState state = createState(26.5);
+
+            ChemicalState exactstate = state;
+            exactsolver.solve(exactstate);
+
+            result = solver.solve(state);
+
+            CHECK( result.succeeded() );
+            CHECK( result.predicted() );
+            CHECK( result.prediction.blended );
+
+            CHECK( largestRelativeDifference(state.speciesAmounts(), exactstate.speciesAmounts()) < 0.05 );
+            CHECK( largestRelativeDifferenceLogScale(state.speciesAmounts(), exactstate.speciesAmounts()) < 0.005 );
+
+            auto stats = solver.statistics();
+
+            CHECK( stats.learnings == 2 );
+            CHECK( stats.predictions == 1 );
+            CHECK( stats.blended_predictions == 1 );
+        }
+
+        // With an absolute tolerance of 1e-6 J/mol, the chemical potentials predicted by the two records at the midpoint temperature differ by more than the tolerance,
+        // so the blended prediction must be rejected and a learning operation performed instead
+        SECTION("when the records disagree on the predicted chemical potentials by more than the tolerance")
+        {
+            SmartEquilibriumSolver solver = createSolver(1.0e-6);
+
+            ChemicalState state = createState(26.5);
+
+            result = solver.solve(state);
+
+            CHECK( result.succeeded() );
+            CHECK( result.learned() );
+            CHECK_FALSE( result.prediction.blended );
+
+            auto stats = solver.statistics();
+
+            CHECK( stats.learnings == 3 );
+            CHECK( stats.predictions == 0 );
+            CHECK( stats.blended_predictions == 0 );
+        }
+    }
 }
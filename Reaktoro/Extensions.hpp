@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <Reaktoro/Extensions/Interpreter.hpp>
 #include <Reaktoro/Extensions/Nasa.hpp>
 #include <Reaktoro/Extensions/Phreeqc.hpp>
 #include <Reaktoro/Extensions/PorousMedia.hpp>
@@ -18,6 +18,7 @@
 // pybind11 includes
 #include <Reaktoro/pybind11.hxx>
 
+void exportExtensionInterpreter(py::module& m);
 void exportExtensionNasa(py::module& m);
 void exportExtensionPhreeqc(py::module& m);
 void exportExtensionPorousMedia(py::module& m);
@@ -26,6 +27,7 @@ void exportExtensionThermoFun(py::module& m);
 
 void exportExtensions(py::module& m)
 {
+    exportExtensionInterpreter(m);
     exportExtensionNasa(m);
     exportExtensionPhreeqc(m);
     exportExtensionPorousMedia(m);
@@ -1,135 +1,531 @@
-// // Reaktoro is a unified framework for modeling chemically reactive systems.
-// //
-// // Copyright © 2014-2022 Allan Leal
-// //
-// // This library is free software; you can redistribute it and/or
-// // modify it under the terms of the GNU Lesser General Public
-// // License as published by the Free Software Foundation; either
-// // version 2.1 of the License, or (at your option) any later version.
-// //
-// // This library is distributed in the hope that it will be useful,
-// // but WITHOUT ANY WARRANTY; without even the implied warranty of
-// // MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
-// // Lesser General Public License for more details.
-// //
-// // You should have received a copy of the GNU Lesser General Public License
-// // along with this library. If not, see <http://www.gnu.org/licenses/>.
-
-// #include "Interpreter.hpp"
-
-// // Reaktoro includes
-// #include <Reaktoro/Common/StringList.hpp>
-// #include <Reaktoro/Core/ChemicalState.hpp>
-// #include <Reaktoro/Core/ChemicalSystem.hpp>
-// #include <Reaktoro/Core/Database.hpp>
-// #include <Reaktoro/Equilibrium/EquilibriumProblem.hpp>
-// #include <Reaktoro/Equilibrium/EquilibriumUtils.hpp>
-// #include <Reaktoro/Thermodynamics/Core/ChemicalEditor.hpp>
-
-// #include <fstream>
-
-// namespace Reaktoro {
-
-// struct Interpreter::Impl
-// {
-//     ChemicalSystem system;
-
-//     std::map<std::string, ChemicalState> states;
-
-//     auto execute(json input) -> void
-//     {
-//         initializeChemicalSystem(input["system"]);
-//         executeCalculations(input["calculations"]);
-//     }
-
-//     auto initializeChemicalSystem(json node) -> void
-//     {
-//         auto dbname = node["database"].get<std::string>();
-//         auto elements = node["elements"].get<std::vector<std::string>>();
-
-//         SupcrtDatabase database(dbname);
-//         ChemicalEditor editor(database);
-//         editor.initializePhasesWithElements(elements);
-
-//         system = ChemicalSystem(editor);
-//     }
-
-//     auto executeCalculations(json node) -> void
-//     {
-//         for(auto item : node)
-//         {
-//             if(item.count("equilibrium"))
-//                 calculateEquilibrium(item["equilibrium"]);
-//         }
-//     }
-
-//     auto calculateEquilibrium(json node) -> void
-//     {
-//         EquilibriumProblem problem(system);
-//         problem.setTemperature(node["temperature"]["value"], node["temperature"]["units"]);
-//         problem.setPressure(node["pressure"]["value"], node["pressure"]["units"]);
-//         for(auto item : node["substances"])
-//             problem.add(item["substance"], item["quantity"], item["units"]);
-
-//         ChemicalState state = equilibrate(problem);
-
-//         std::string stateref = "default";
-//         if(node.count("stateReference"))
-//             stateref = node["stateReference"];
-
-//         states.insert({stateref, equilibrate(problem)});
-//     }
-// };
-
-// Interpreter::Interpreter()
-// : pimpl(new Interpreter::Impl())
-// {}
-
-// Interpreter::Interpreter(const Interpreter& other)
-// : pimpl(new Interpreter::Impl(*other.pimpl))
-// {}
-
-// Interpreter::~Interpreter()
-// {}
-
-// auto Interpreter::operator=(Interpreter other) -> Interpreter&
-// {
-//     pimpl = std::move(other.pimpl);
-//     return *this;
-// }
-
-// auto Interpreter::executeJsonObject(json input) -> void
-// {
-//     pimpl->execute(input);
-// }
-
-// auto Interpreter::executeJsonString(std::string input) -> void
-// {
-//     json jsoninput = json::parse(input);
-//     executeJsonObject(jsoninput);
-// }
-
-// auto Interpreter::executeJsonFile(std::string input) -> void
-// {
-//     json jsoninput;
-//     std::ifstream file(input, std::ios_base::in);
-//     file >> jsoninput;
-//     executeJsonObject(jsoninput);
-// }
-
-// auto Interpreter::system() -> const ChemicalSystem&
-// {
-//     return pimpl->system;
-// }
-
-// auto Interpreter::states() -> const std::map<std::string, ChemicalState>&
-// {
-//     return pimpl->states;
-// }
-
-// auto Interpreter::state(std::string reference) -> const ChemicalState&
-// {
-//     return pimpl->states.at(reference);
-// }
-
-// } // namespace Reaktoro
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "Interpreter.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Common/StringUtils.hpp>
+#include <Reaktoro/Common/Table.hpp>
+#include <Reaktoro/Common/TimeUtils.hpp>
+#include <Reaktoro/Common/Units.hpp>
+#include <Reaktoro/Core/ChemicalQuantity.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+#include <Reaktoro/Core/Data.hpp>
+#include <Reaktoro/Core/Phases.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumConditions.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumOptions.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumResult.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSolver.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSpecs.hpp>
+#include <Reaktoro/Extensions/Nasa/NasaDatabase.hpp>
+#include <Reaktoro/Extensions/Phreeqc/PhreeqcDatabase.hpp>
+#include <Reaktoro/Extensions/Supcrt/SupcrtDatabase.hpp>
+#include <Reaktoro/Extensions/ThermoFun/ThermoFunDatabase.hpp>
+#include <Reaktoro/Models/ActivityModels.hpp>
+#include <Reaktoro/Utils/Material.hpp>
+
+namespace Reaktoro {
+namespace {
+
+/// Return the value in a node such as `60 celsius` converted to given units (or the number in the node, assumed in these units).
+auto parseValue(Data const& node, String const& units) -> double
+{
+    if(!node.isString())
+        return node.asFloat();
+    const auto words = split(node.asString());
+    errorif(words.size() != 2, "Expecting a value followed by its units (e.g., `60 celsius`) in the scenario input, but got `", node.asString(), "`.");
+    return units::convert(tofloat(words[0]), words[1], units);
+}
+
+/// Return the single key-value pair in a node such as `Supcrt: supcrtbl`.
+auto parseKeyValue(Data const& node, String const& context) -> Pair<String, Data>
+{
+    errorifnot(node.isDict() && node.asDict().size() == 1, "Expecting a single key-value pair in the `", context, "` entry of the scenario input, but got:\n", node.dump());
+    auto const& [key, value] = *node.asDict().begin();
+    return { key, value };
+}
+
+/// Return the thermodynamic database described in a node such as `Supcrt: supcrtbl`.
+auto createDatabase(Data const& node) -> Database
+{
+    const auto [type, value] = parseKeyValue(node, "Database");
+    const auto name = value.asString();
+    if(type == "Supcrt") return SupcrtDatabase(name);
+    if(type == "Phreeqc") return PhreeqcDatabase(name);
+    if(type == "PhreeqcFile") return PhreeqcDatabase::fromFile(name);
+    if(type == "ThermoFun") return ThermoFunDatabase(name);
+    if(type == "ThermoFunFile") return ThermoFunDatabase::fromFile(name);
+    if(type == "Nasa") return NasaDatabase(name);
+    if(type == "File") return Database::fromFile(name);
+    errorif(true, "The database type `", type, "` in the scenario input is not supported. The supported types are Supcrt, Phreeqc, PhreeqcFile, ThermoFun, ThermoFunFile, Nasa, and File.");
+    return {};
+}
+
+/// Return the activity model with given name (e.g., `Davies`, `PengRobinson`).
+auto createActivityModel(String const& name) -> ActivityModelGenerator
+{
+    if(name == "IdealAqueous") return ActivityModelIdealAqueous();
+    if(name == "IdealGas") return ActivityModelIdealGas();
+    if(name == "Davies") return ActivityModelDavies();
+    if(name == "DebyeHuckel") return ActivityModelDebyeHuckel();
+    if(name == "DebyeHuckelPHREEQC") return ActivityModelDebyeHuckelPHREEQC();
+    if(name == "HKF") return ActivityModelHKF();
+    if(name == "Pitzer") return ActivityModelPitzer();
+    if(name == "SpycherPruessEnnis") return ActivityModelSpycherPruessEnnis();
+    if(name == "SpycherReed") return ActivityModelSpycherReed();
+    if(name == "VanDerWaals") return ActivityModelVanDerWaals();
+    if(name == "RedlichKwong") return ActivityModelRedlichKwong();
+    if(name == "SoaveRedlichKwong") return ActivityModelSoaveRedlichKwong();
+    if(name == "PengRobinson") return ActivityModelPengRobinson();
+    if(name == "PengRobinsonPhreeqc") return ActivityModelPengRobinsonPhreeqc();
+    errorif(true, "The activity model `", name, "` in the scenario input is not supported.");
+    return {};
+}
+
+/// Return a phase (or a generator of phases) described in a node with either `Species` or `Speciate` (and optionally `Exclude` and `ActivityModel`).
+template<typename PhaseType>
+auto createPhase(Data const& node) -> PhaseType
+{
+    if(node.isString())
+        return PhaseType(StringList(node.asString()));
+
+    auto phase = [&]
+    {
+        if(!node.exists("Speciate"))
+            return PhaseType(StringList(node.required("Species").asString()));
+        if(node.exists("Exclude"))
+            return PhaseType(speciate(node["Speciate"].asString()), exclude(node["Exclude"].asString()));
+        return PhaseType(speciate(node["Speciate"].asString()));
+    }();
+
+    if(node.exists("ActivityModel"))
+        phase.set(createActivityModel(node["ActivityModel"].asString()));
+
+    return phase;
+}
+
+/// Return the chemical system described in a node with `Database` and `Phases`.
+auto createChemicalSystem(Data const& node) -> ChemicalSystem
+{
+    const auto db = createDatabase(node.required("Database"));
+
+    Phases phases(db);
+
+    for(auto const& item : node.required("Phases").asList())
+    {
+        const auto [type, spec] = parseKeyValue(item, "Phases");
+        if(type == "Aqueous") phases.add(createPhase<AqueousPhase>(spec));
+        else if(type == "Gaseous") phases.add(createPhase<GaseousPhase>(spec));
+        else if(type == "Liquid") phases.add(createPhase<LiquidPhase>(spec));
+        else if(type == "Minerals") phases.add(createPhase<MineralPhases>(spec));
+        else if(type == "Mineral") phases.add(MineralPhase(spec.asString()));
+        else errorif(true, "The phase type `", type, "` in the scenario input is not supported. The supported types are Aqueous, Gaseous, Liquid, Minerals, and Mineral.");
+    }
+
+    return ChemicalSystem(phases);
+}
+
+/// A scenario in the scenario input.
+struct Scenario
+{
+    /// The name of the scenario.
+    String name;
+
+    /// The temperature of the scenario (in K).
+    double T;
+
+    /// The pressure of the scenario (in Pa).
+    double P;
+
+    /// The recipe of the scenario, with the substances and species that are mixed.
+    Material material;
+
+    /// The amounts of the conservative components (elements and charge) in the recipe.
+    ArrayXd b;
+};
+
+/// Return the distance between two scenarios, used to decide whether one can be warm-started from the other.
+/// The distance sums the temperature difference (in units of 100 K), the difference in the logarithm of
+/// pressures, and the 1-norm of the difference in component amounts relative to the largest of the two.
+auto distance(Scenario const& a, Scenario const& b) -> double
+{
+    const auto dT = std::abs(a.T - b.T) / 100.0;
+    const auto dP = std::abs(std::log(a.P / b.P));
+    const auto scale = std::max({ a.b.abs().sum(), b.b.abs().sum(), 1e-16 });
+    const auto db = (a.b - b.b).abs().sum() / scale;
+    return dT + dP + db;
+}
+
+} // namespace
+
+struct Interpreter::Impl
+{
+    /// The chemical system constructed in the last execution.
+    ChemicalSystem system;
+
+    /// The results of the scenarios in the last execution.
+    Table results;
+
+    /// The names of the scenarios in the last execution.
+    Strings names;
+
+    /// The equilibrium states of the scenarios in the last execution (if stored).
+    Vec<ChemicalState> states;
+
+    /// The statistics of the last execution.
+    InterpreterStatistics stats;
+
+    auto execute(Data const& input) -> void
+    {
+        stats = {};
+
+        const auto tbegin = time();
+
+        system = createChemicalSystem(input.required("System"));
+
+        stats.time_system = elapsed(tbegin);
+
+        //======================================================================
+        // Parse the options, the output specification, and the scenarios
+        //======================================================================
+
+        const auto options = input.exists("Options") ? input["Options"] : Data();
+
+        Index numthreads = 0;
+        double maxdistance = 0.1;
+        Index maxiterswarmstart = 0;
+        bool storestates = false;
+
+        if(options.isDict())
+        {
+            options.optional("Threads").to(numthreads);
+            options.optional("WarmStartDistance").to(maxdistance);
+            options.optional("WarmStartMaxIterations").to(maxiterswarmstart);
+            options.optional("StoreStates").to(storestates);
+        }
+
+        String outputfile;
+        Strings quantities;
+
+        if(input.exists("Output"))
+        {
+            auto const& output = input["Output"];
+            output.optional("File").to(outputfile);
+            if(output.exists("Quantities"))
+                for(auto const& item : output["Quantities"].asList())
+                    quantities.push_back(item.asString());
+        }
+
+        if(quantities.empty())
+            for(auto const& species : system.species())
+                quantities.push_back("speciesAmount(" + species.name() + ")");
+
+        Vec<Scenario> scenarios;
+
+        for(auto const& node : input.required("Scenarios").asList())
+        {
+            Scenario scenario{ "", 298.15, 1.0e5, Material(system), {} };
+            scenario.name = node.exists("Name") ? node["Name"].asString() : std::to_string(scenarios.size());
+            if(node.exists("Temperature")) scenario.T = parseValue(node["Temperature"], "K");
+            if(node.exists("Pressure")) scenario.P = parseValue(node["Pressure"], "Pa");
+            for(auto const& [substance, value] : node.required("Recipe").asDict())
+            {
+                const auto words = value.isString() ? split(value.asString()) : Strings{};
+                errorif(words.size() > 2 || words.size() == 1, "Expecting a value followed by its units (e.g., `1 kg`) for substance ", substance, " in the recipe of scenario ", scenario.name, ".");
+                if(words.empty()) scenario.material.add(substance, value.asFloat(), "mol");
+                else scenario.material.add(substance, tofloat(words[0]), words[1].c_str());
+            }
+            scenario.b = scenario.material.componentAmounts();
+            scenarios.push_back(std::move(scenario));
+        }
+
+        const auto N = scenarios.size();
+        const auto Nq = quantities.size();
+
+        //======================================================================
+        // Order the scenarios by similarity so that each can be warm-started from the previous one
+        //======================================================================
+
+        // Sorting lexicographically on temperature, pressure and component
+        // amounts places scenarios that sweep these conditions next to each
+        // other, which is the common case in large batches of scenarios.
+        Indices ordering(N);
+        std::iota(ordering.begin(), ordering.end(), 0);
+        std::stable_sort(ordering.begin(), ordering.end(), [&](Index i, Index j)
+        {
+            auto const& a = scenarios[i];
+            auto const& b = scenarios[j];
+            if(a.T != b.T) return a.T < b.T;
+            if(a.P != b.P) return a.P < b.P;
+            return std::lexicographical_compare(a.b.begin(), a.b.end(), b.b.begin(), b.b.end());
+        });
+
+        //======================================================================
+        // Execute the scenarios across a pool of threads
+        //======================================================================
+
+        if(numthreads == 0)
+            numthreads = std::max<Index>(std::thread::hardware_concurrency(), 1);
+        numthreads = std::max<Index>(std::min(numthreads, N), 1);
+
+        // Each thread takes chunks of consecutive scenarios in the ordering, so
+        // that warm-starts are possible, while several chunks per thread keep
+        // the load balanced when some scenarios converge more slowly than others.
+        const auto chunksize = std::max<Index>(N / (4 * numthreads), 1);
+
+        Vec<double> values(N * Nq, std::numeric_limits<double>::quiet_NaN());
+        Vec<char> succeeded(N, false);
+        Vec<char> warmstarted(N, false);
+        Vec<char> fellback(N, false);
+        Vec<long> iterations(N, 0);
+
+        states.assign(storestates ? N : 0, ChemicalState(system));
+
+        std::atomic<Index> next = 0;
+        std::exception_ptr error;
+        std::mutex errormutex;
+
+        const auto specs = EquilibriumSpecs::TP(system);
+
+        auto worker = [&]
+        {
+            try
+            {
+                EquilibriumSolver solver(specs);
+                EquilibriumSolver warmsolver(specs); // the solver for warm-started calculations, with their maximum number of iterations (if any)
+                EquilibriumConditions conditions(specs);
+                ChemicalState state(system);
+                ChemicalQuantity quantity(system);
+
+                if(maxiterswarmstart > 0)
+                {
+                    EquilibriumOptions opts;
+                    opts.optima.maxiters = maxiterswarmstart;
+                    warmsolver.setOptions(opts);
+                }
+
+                Vec<ChemicalQuantity::Function> functions;
+                for(auto const& q : quantities)
+                    functions.push_back(quantity.function(q));
+
+                const Scenario* previous = nullptr; // the scenario whose equilibrium state is in `state`
+
+                for(auto begin = next.fetch_add(chunksize); begin < N; begin = next.fetch_add(chunksize))
+                {
+                    const auto end = std::min(begin + chunksize, N);
+                    for(auto k = begin; k < end; ++k)
+                    {
+                        const auto i = ordering[k];
+                        auto const& scenario = scenarios[i];
+
+                        conditions.temperature(scenario.T);
+                        conditions.pressure(scenario.P);
+                        conditions.setInitialComponentAmounts(scenario.b);
+
+                        EquilibriumResult result;
+
+                        const auto warmstart = previous && distance(*previous, scenario) <= maxdistance;
+
+                        auto coldstart = !warmstart;
+
+                        if(warmstart)
+                        {
+                            result = warmsolver.solve(state, conditions);
+                            coldstart = !result.succeeded();
+                        }
+
+                        if(coldstart)
+                        {
+                            state = scenario.material.initialState(scenario.T, scenario.P);
+                            result = solver.solve(state, conditions);
+                        }
+
+                        succeeded[i] = result.succeeded();
+                        warmstarted[i] = !coldstart;
+                        fellback[i] = warmstart && coldstart;
+                        iterations[i] = result.iterations();
+
+                        previous = result.succeeded() ? &scenario : nullptr;
+
+                        if(!result.succeeded())
+                            continue;
+
+                        quantity.update(state);
+                        for(auto j = 0; j < Nq; ++j)
+                            values[i * Nq + j] = functions[j]();
+
+                        if(storestates)
+                            states[i] = state;
+                    }
+                }
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(errormutex);
+                if(!error)
+                    error = std::current_exception();
+                next = N; // stop the other threads as soon as they finish their current chunk
+            }
+        };
+
+        const auto tscenarios = time();
+
+        Vec<std::thread> threads;
+        for(auto i = 1; i < numthreads; ++i)
+            threads.emplace_back(worker);
+        worker(); // the calling thread is also part of the pool
+        for(auto& thread : threads)
+            thread.join();
+
+        if(error)
+            std::rethrow_exception(error);
+
+        stats.time_scenarios = elapsed(tscenarios);
+
+        //======================================================================
+        // Collect the results in the order of the scenarios in the input
+        //======================================================================
+
+        names.clear();
+        results = Table();
+
+        for(auto const& scenario : scenarios)
+            names.push_back(scenario.name);
+
+        for(auto i = 0; i < N; ++i)
+        {
+            results.column("Scenario").appendString(names[i]);
+            results.column("Succeeded").appendBoolean(succeeded[i]);
+            results.column("WarmStart").appendBoolean(warmstarted[i]);
+            results.column("Iterations").appendInteger(iterations[i]);
+            for(auto j = 0; j < Nq; ++j)
+                results.column(quantities[j]).appendFloat(values[i * Nq + j]);
+
+            stats.succeeded += succeeded[i];
+            stats.warmstarts += warmstarted[i];
+            stats.fallbacks += fellback[i];
+            stats.iterations += iterations[i];
+        }
+
+        stats.scenarios = N;
+        stats.threads = numthreads;
+
+        if(outputfile.empty())
+            return;
+
+        const auto toutput = time();
+
+        const auto extension = lowercase(split(outputfile, ".").back());
+
+        if(extension == "csv")
+        {
+            Table::OutputOptions opts;
+            opts.delimiter = ",";
+            results.save(outputfile, opts);
+        }
+        else if(extension == "txt")
+            results.save(outputfile);
+        else results.saveBinary(outputfile);
+
+        stats.time_output = elapsed(toutput);
+    }
+
+    auto state(String const& scenario) const -> ChemicalState const&
+    {
+        errorif(states.empty(), "Cannot return the chemical state of scenario ", scenario, " because option StoreStates was not set to true in the scenario input.");
+        const auto it = std::find(names.begin(), names.end(), scenario);
+        errorif(it == names.end(), "There is no scenario named ", scenario, " in the last executed scenario input.");
+        return states[it - names.begin()];
+    }
+};
+
+Interpreter::Interpreter()
+: pimpl(new Impl())
+{}
+
+Interpreter::Interpreter(Interpreter const& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+Interpreter::~Interpreter()
+{}
+
+auto Interpreter::operator=(Interpreter other) -> Interpreter&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto Interpreter::execute(Data const& input) -> void
+{
+    pimpl->execute(input);
+}
+
+auto Interpreter::executeString(String const& input) -> void
+{
+    pimpl->execute(Data::parse(input));
+}
+
+auto Interpreter::executeFile(String const& path) -> void
+{
+    pimpl->execute(Data::load(path));
+}
+
+auto Interpreter::system() const -> ChemicalSystem const&
+{
+    return pimpl->system;
+}
+
+auto Interpreter::results() const -> Table const&
+{
+    return pimpl->results;
+}
+
+auto Interpreter::scenarios() const -> Strings const&
+{
+    return pimpl->names;
+}
+
+auto Interpreter::states() const -> Vec<ChemicalState> const&
+{
+    return pimpl->states;
+}
+
+auto Interpreter::state(String const& scenario) const -> ChemicalState const&
+{
+    return pimpl->state(scenario);
+}
+
+auto Interpreter::statistics() const -> InterpreterStatistics const&
+{
+    return pimpl->stats;
+}
+
+} // namespace Reaktoro
@@ -15,64 +15,140 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with this library. If not, see <http://www.gnu.org/licenses/>.
 
-#pragma once
 
-// C++ includes
-#include <map>
-#include <memory>
-#include <string>
-#include <fstream>
+#pragma once
 
 // Reaktoro includes
-#include <Reaktoro/Common/Json.hpp>
+#include <Reaktoro/Common/Types.hpp>
 
 namespace Reaktoro {
 
 // Forward declarations
 class ChemicalState;
 class ChemicalSystem;
+class Data;
+class Table;
+
+/// The statistics of the last batch of scenarios executed by an Interpreter object.
+struct InterpreterStatistics
+{
+    /// The number of scenarios executed.
+    Index scenarios = 0;
+
+    /// The number of scenarios whose equilibrium calculation succeeded.
+    Index succeeded = 0;
+
+    /// The number of scenarios that succeeded starting from the equilibrium state of a similar, previously executed scenario.
+    Index warmstarts = 0;
+
+    /// The number of scenarios whose calculation from the state of a similar scenario failed and was repeated from their initial state.
+    Index fallbacks = 0;
+
+    /// The total number of iterations of the equilibrium calculations.
+    Index iterations = 0;
 
-/// Used to interpret json files containing defined calculations.
+    /// The number of threads used to execute the scenarios.
+    Index threads = 0;
+
+    /// The time spent constructing the chemical system (in s).
+    double time_system = 0.0;
+
+    /// The time spent executing the scenarios (in s).
+    double time_scenarios = 0.0;
+
+    /// The time spent writing the results to the output file (in s).
+    double time_output = 0.0;
+};
+
+/// Used to execute batches of equilibrium calculations described in JSON or YAML scenario files.
+/// The chemical system is constructed once, and all scenarios are then executed
+/// across a pool of threads, each with its own equilibrium solver. Scenarios are
+/// ordered by similarity of temperature, pressure and composition, so that each
+/// thread can start a calculation from the equilibrium state of the previous,
+/// similar scenario. The results are collected in a columnar Table, in the
+/// order of the scenarios in the input, and optionally written to a file. An
+/// example of input is shown below.
+/// ~~~yaml
+/// System:
+///   Database:
+///     Supcrt: supcrtbl
+///   Phases:
+///     - Aqueous:
+///         Speciate: H O C Na Cl Ca
+///         ActivityModel: Davies
+///     - Gaseous:
+///         Species: CO2(g) H2O(g)
+///         ActivityModel: PengRobinson
+///     - Minerals: Calcite Halite
+/// Options:
+///   Threads: 4                  # zero or absent to use all hardware threads
+///   WarmStartDistance: 0.1      # the maximum distance between scenarios for warm-starts
+///   WarmStartMaxIterations: 0   # the maximum iterations of a warm-start before a cold start (zero for no limit)
+/// Output:
+///   File: results.rkt           # binary output, unless extension is csv or txt
+///   Quantities: [pH, speciesMolality(Ca+2), phaseAmount(Calcite)]
+/// Scenarios:
+///   - Name: brine-1
+///     Temperature: 60 celsius
+///     Pressure: 100 bar
+///     Recipe:
+///       H2O: 1 kg
+///       NaCl: 1 mol
+///       CO2: 0.5 mol
+///       Calcite: 10 mol
+/// ~~~
+/// The results table has columns `Scenario`, `Succeeded`, `WarmStart`, and
+/// `Iterations`, followed by one column per quantity (see ChemicalQuantity for
+/// the supported quantities). If no quantities are given, the amounts of all
+/// species are output.
 class Interpreter
 {
 public:
-    /// Construct a default Interpreter instance.
+    /// Construct a default Interpreter object.
     Interpreter();
 
-    /// Construct a copy of an Interpreter instance.
-    Interpreter(const Interpreter& other);
+    /// Construct a copy of an Interpreter object.
+    Interpreter(Interpreter const& other);
 
-    /// Destroy this Interpreter instance.
-    virtual ~Interpreter();
+    /// Destroy this Interpreter object.
+    ~Interpreter();
 
-    /// Assing another Interpreter instance to this.
+    /// Assign another Interpreter object to this.
     auto operator=(Interpreter other) -> Interpreter&;
 
-    /// Execute an input script.
-    /// @param input The input json object.
-    auto executeJsonObject(json input) -> void;
+    /// Execute the scenarios described in a Data object.
+    auto execute(Data const& input) -> void;
+
+    /// Execute the scenarios described in a JSON or YAML formatted string.
+    auto executeString(String const& input) -> void;
+
+    /// Execute the scenarios described in a JSON or YAML file (with extension `json`, `yaml` or `yml`).
+    auto executeFile(String const& path) -> void;
+
+    /// Return the chemical system constructed in the last execution.
+    auto system() const -> ChemicalSystem const&;
 
-    /// Execute an input script.
-    /// @param input The json-formatted input string.
-    auto executeJsonString(std::string input) -> void;
+    /// Return the results of the scenarios in the last execution, one row per scenario.
+    auto results() const -> Table const&;
 
-    /// Execute an input script.
-    /// @param input The name of the json-formatted input file.
-    auto executeJsonFile(std::string input) -> void;
+    /// Return the names of the scenarios in the last execution.
+    auto scenarios() const -> Strings const&;
 
-    /// Return the constructed chemical system.
-    auto system() -> const ChemicalSystem&;
+    /// Return the equilibrium states of the scenarios in the last execution.
+    /// These are only stored if option `StoreStates` is set to true in the input.
+    auto states() const -> Vec<ChemicalState> const&;
 
-    /// Return all saved chemical states during the execution.
-    auto states() -> const std::map<std::string, ChemicalState>&;
+    /// Return the equilibrium state of the scenario with given name in the last execution.
+    /// These are only stored if option `StoreStates` is set to true in the input.
+    auto state(String const& scenario) const -> ChemicalState const&;
 
-    /// Return the saved chemical state with given reference name.
-    auto state(std::string reference) -> const ChemicalState&;
+    /// Return the statistics of the last execution.
+    auto statistics() const -> InterpreterStatistics const&;
 
 private:
     struct Impl;
 
-    std::unique_ptr<Impl> pimpl;
+    Ptr<Impl> pimpl;
 };
 
 } // namespace Reaktoro
@@ -0,0 +1,57 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// pybind11 includes
+#include <Reaktoro/pybind11.hxx>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Table.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+#include <Reaktoro/Core/Data.hpp>
+#include <Reaktoro/Extensions/Interpreter/Interpreter.hpp>
+using namespace Reaktoro;
+
+void exportInterpreter(py::module& m)
+{
+    py::class_<InterpreterStatistics>(m, "InterpreterStatistics")
+        .def(py::init<>())
+        .def_readwrite("scenarios", &InterpreterStatistics::scenarios)
+        .def_readwrite("succeeded", &InterpreterStatistics::succeeded)
+        .def_readwrite("warmstarts", &InterpreterStatistics::warmstarts)
+        .def_readwrite("fallbacks", &InterpreterStatistics::fallbacks)
+        .def_readwrite("iterations", &InterpreterStatistics::iterations)
+        .def_readwrite("threads", &InterpreterStatistics::threads)
+        .def_readwrite("time_system", &InterpreterStatistics::time_system)
+        .def_readwrite("time_scenarios", &InterpreterStatistics::time_scenarios)
+        .def_readwrite("time_output", &InterpreterStatistics::time_output)
+        ;
+
+    py::class_<Interpreter>(m, "Interpreter")
+        .def(py::init<>())
+        .def("execute", &Interpreter::execute, "Execute the scenarios described in a Data object.")
+        .def("executeString", &Interpreter::executeString, "Execute the scenarios described in a JSON or YAML formatted string.")
+        .def("executeFile", &Interpreter::executeFile, "Execute the scenarios described in a JSON or YAML file.")
+        .def("system", &Interpreter::system, return_internal_ref, "Return the chemical system constructed in the last execution.")
+        .def("results", &Interpreter::results, return_internal_ref, "Return the results of the scenarios in the last execution, one row per scenario.")
+        .def("scenarios", &Interpreter::scenarios, return_internal_ref, "Return the names of the scenarios in the last execution.")
+        .def("states", &Interpreter::states, return_internal_ref, "Return the equilibrium states of the scenarios in the last execution.")
+        .def("state", &Interpreter::state, return_internal_ref, "Return the equilibrium state of the scenario with given name in the last execution.")
+        .def("statistics", &Interpreter::statistics, return_internal_ref, "Return the statistics of the last execution.")
+        ;
+}
@@ -0,0 +1,152 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// Catch includes
+#include <catch2/catch.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Table.hpp>
+#include <Reaktoro/Core/ChemicalQuantity.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+#include <Reaktoro/Core/Data.hpp>
+#include <Reaktoro/Extensions/Interpreter/Interpreter.hpp>
+#include <Reaktoro/Utils/Material.hpp>
+using namespace Reaktoro;
+
+namespace test {
+
+const auto input = R"(
+System:
+  Database:
+    Supcrt: supcrtbl
+  Phases:
+    - Aqueous:
+        Speciate: H O C Na Cl Ca
+        ActivityModel: Davies
+    - Gaseous:
+        Species: CO2(g) H2O(g)
+    - Minerals: Calcite
+Options:
+  Threads: 2
+  StoreStates: true
+Output:
+  Quantities: [pH, speciesAmount(CO2(g)), phaseAmount(Calcite)]
+Scenarios:
+  - Name: s1
+    Temperature: 25 celsius
+    Pressure: 1 bar
+    Recipe: { H2O: 1 kg, NaCl: 0.10 mol, CO2: 1.0 mol, Calcite: 1 mol }
+  - Name: s2
+    Temperature: 25 celsius
+    Pressure: 1 bar
+    Recipe: { H2O: 1 kg, NaCl: 0.11 mol, CO2: 1.0 mol, Calcite: 1 mol }
+  - Name: s3
+    Temperature: 60 celsius
+    Pressure: 100 bar
+    Recipe: { H2O: 1 kg, NaCl: 1.00 mol, CO2: 1.0 mol, Calcite: 1 mol }
+  - Name: s4
+    Temperature: 25 celsius
+    Pressure: 1 bar
+    Recipe: { H2O: 1 kg, NaCl: 0.12 mol, CO2: 1.0 mol, Calcite: 1 mol }
+  - Name: s5
+    Temperature: 333.15
+    Pressure: 100 bar
+    Recipe: { H2O: 1 kg, NaCl: 1.05 mol, CO2: 1.0 mol, Calcite: 1 mol }
+)";
+
+} // namespace test
+
+TEST_CASE("Testing Interpreter", "[Interpreter]")
+{
+    Interpreter interpreter;
+    interpreter.executeString(test::input);
+
+    auto const& system = interpreter.system();
+    auto const& results = interpreter.results();
+    auto const& stats = interpreter.statistics();
+
+    CHECK( interpreter.scenarios() == Strings{"s1", "s2", "s3", "s4", "s5"} );
+    CHECK( interpreter.states().size() == 5 );
+
+    CHECK( results.rows() == 5 );
+    CHECK( results.cols() == 7 );
+
+    CHECK( stats.scenarios == 5 );
+    CHECK( stats.succeeded == 5 );
+    CHECK( stats.warmstarts > 0 );
+    CHECK( stats.threads == 2 );
+
+    // Compare the results with those of independent calculations, one scenario at a time
+    const Vec<Tuple<double, double, double>> conditions = {
+        { 25.0,   1.0, 0.10 },
+        { 25.0,   1.0, 0.11 },
+        { 60.0, 100.0, 1.00 },
+        { 25.0,   1.0, 0.12 },
+        { 60.0, 100.0, 1.05 },
+    };
+
+    for(auto i = 0; i < conditions.size(); ++i)
+    {
+        const auto [T, P, nNaCl] = conditions[i];
+
+        Material material(system);
+        material.add("H2O", 1.0, "kg");
+        material.add("NaCl", nNaCl, "mol");
+        material.add("CO2", 1.0, "mol");
+        material.add("Calcite", 1.0, "mol");
+
+        ChemicalState state = material.equilibrate(T, "celsius", P, "bar");
+
+        ChemicalQuantity quantity(state);
+
+        INFO("scenario: " << interpreter.scenarios()[i]);
+        CHECK( results.column("Succeeded").booleans()[i] );
+        CHECK( results["pH"][i] == Approx(quantity("pH")) );
+        CHECK( results["speciesAmount(CO2(g))"][i] == Approx(quantity("speciesAmount(CO2(g))")) );
+        CHECK( results["phaseAmount(Calcite)"][i] == Approx(quantity("phaseAmount(Calcite)")) );
+        CHECK( interpreter.state(interpreter.scenarios()[i]).temperature() == Approx(T + 273.15) );
+    }
+
+    CHECK_THROWS( interpreter.state("unknown") );
+
+    // Limit warm-starts to a single iteration so that they fail and the scenarios are repeated from their initial states.
+    // With one thread, the scenarios are executed in the order s1, s2, s4, s3, s5, and s2, s4 and s5 are warm-started.
+    Data input = Data::parse(test::input);
+    input["Options"]["Threads"] = 1;
+    input["Options"]["WarmStartMaxIterations"] = 1;
+
+    interpreter.execute(input);
+
+    CHECK( stats.scenarios == 5 );
+    CHECK( stats.succeeded == 5 );
+    CHECK( stats.warmstarts == 0 );
+    CHECK( stats.fallbacks == 3 );
+
+    for(auto i = 0; i < conditions.size(); ++i)
+    {
+        INFO("scenario: " << interpreter.scenarios()[i]);
+        CHECK( results.column("Succeeded").booleans()[i] );
+        CHECK_FALSE( results.column("WarmStart").booleans()[i] );
+    }
+
+    input = Data::parse(test::input);
+    input["System"]["Phases"].add(Data::parse("Plasma: H O"));
+
+    CHECK_THROWS( interpreter.execute(input) );
+}
@@ -229,4 +229,9 @@ auto SmartKineticsSolver::setOptions(SmartKineticsOptions const& options) -> voi
     pimpl->setOptions(options);
 }
 
+auto SmartKineticsSolver::statistics() const -> SmartEquilibriumStatistics
+{
+    return pimpl->ksolver.statistics();
+}
+
 } // namespace Reaktoro
@@ -33,6 +33,7 @@ class EquilibriumSpecs;
 class KineticsSensitivity;
 struct SmartKineticsOptions;
 struct SmartKineticsResult;
+struct SmartEquilibriumStatistics;
 
 /// Used for chemical kinetics calculations.
 class SmartKineticsSolver
@@ -126,6 +127,9 @@ public:
     /// Set the options of the kinetics solver.
     auto setOptions(SmartKineticsOptions const& options) -> void;
 
+    /// Return the statistics of the learned calculations stored in the kinetics solver.
+    auto statistics() const -> SmartEquilibriumStatistics;
+
 private:
     struct Impl;
 
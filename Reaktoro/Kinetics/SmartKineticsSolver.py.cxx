@@ -46,5 +46,6 @@ void exportSmartKineticsSolver(py::module& m)
         .def("solve", py::overload_cast<ChemicalState&, KineticsSensitivity&, real const&, EquilibriumConditions const&, EquilibriumRestrictions const&>(&SmartKineticsSolver::solve), "React a chemical state for a given time interval respecting given constraint conditions and reactivity restrictions and compute sensitivity derivatives.", py::arg("state"), py::arg("sensitivity"), py::arg("dt"), py::arg("conditions"), py::arg("restrictions"))
 
         .def("setOptions", &SmartKineticsSolver::setOptions)
+        .def("statistics", &SmartKineticsSolver::statistics, "Return the statistics of the learned calculations stored in the kinetics solver.")
         ;
 }
@@ -0,0 +1,128 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include "VectorMath.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Common/Real.hpp>
+
+namespace Reaktoro {
+namespace {
+
+static_assert(autodiff::detail::NumberTraits<real>::Order == 1,
+    "The vectorized math functions expect `real` to carry a single derivative lane.");
+
+/// The number of entries processed per block, small enough for the lanes to stay in the L1 cache.
+constexpr Index blocksize = 64;
+
+/// The type used to view a block of a lane as an Eigen array.
+using Lane = Eigen::Map<ArrayXd>;
+
+/// Apply a lane-wise function to every entry in `x` and store the result in `res`.
+/// The function `fn(v, d, f, df)` computes the values `f` and the derivatives
+/// `df` of the results from the values `v` and the derivatives `d` of the
+/// arguments.
+template<typename LaneFunction>
+auto apply(ArrayXrConstRef x, ArrayXrRef res, LaneFunction const& fn) -> void
+{
+    const auto size = x.size();
+
+    double vbuf[blocksize];
+    double dbuf[blocksize];
+    double fbuf[blocksize];
+    double dfbuf[blocksize];
+
+    for(Index offset = 0; offset < size; offset += blocksize)
+    {
+        const auto n = std::min(blocksize, size - offset);
+
+        for(Index i = 0; i < n; ++i)
+        {
+            vbuf[i] = x[offset + i][0];
+            dbuf[i] = x[offset + i][1];
+        }
+
+        Lane v(vbuf, n);
+        Lane d(dbuf, n);
+        Lane f(fbuf, n);
+        Lane df(dfbuf, n);
+
+        fn(v, d, f, df);
+
+        for(Index i = 0; i < n; ++i)
+        {
+            res[offset + i][0] = fbuf[i];
+            res[offset + i][1] = dfbuf[i];
+        }
+    }
+}
+
+} // namespace
+
+namespace detail {
+
+auto errorSizeMismatch(Index xsize, Index ressize) -> void
+{
+    errorif(true, "Expecting the result array and the other array arguments to have the same size of the argument array (", xsize, ") but got an array with size ", ressize, ".");
+}
+
+auto vexpPacked(ArrayXrConstRef x, ArrayXrRef res) -> void
+{
+    apply(x, res, [](Lane const& v, Lane const& d, Lane& f, Lane& df)
+    {
+        f = v.exp();
+        df = f * d;
+    });
+}
+
+auto vlogPacked(ArrayXrConstRef x, ArrayXrRef res) -> void
+{
+    apply(x, res, [](Lane const& v, Lane const& d, Lane& f, Lane& df)
+    {
+        f = v.log();
+        df = d / v;
+    });
+}
+
+auto vsqrtPacked(ArrayXrConstRef x, ArrayXrRef res) -> void
+{
+    apply(x, res, [](Lane const& v, Lane const& d, Lane& f, Lane& df)
+    {
+        f = v.sqrt();
+        df = 0.5 * d / f;
+    });
+}
+
+auto vpowPacked(ArrayXrConstRef x, double a, ArrayXrRef res) -> void
+{
+    const auto c0 = a * std::pow(0.0, a - 1.0); // the factor a*x^(a-1) at x = 0, in which case a*f/x below is 0/0
+
+    apply(x, res, [=](Lane const& v, Lane const& d, Lane& f, Lane& df)
+    {
+        f = v.pow(a);
+        df = (v != 0.0).select(a * f / v, c0) * d;
+    });
+}
+
+} // namespace detail
+
+} // namespace Reaktoro
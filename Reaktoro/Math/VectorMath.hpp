@@ -0,0 +1,179 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Reaktoro includes
+#include <Reaktoro/Common/Matrix.hpp>
+#include <Reaktoro/Common/Real.hpp>
+
+namespace Reaktoro {
+
+// The functions below evaluate elementary functions over arrays of `real`
+// numbers. The values and the derivatives of the entries are split into two
+// contiguous lanes of `double` numbers, processed in blocks using the
+// vectorized (SIMD) packet math of Eigen, and combined back using the chain
+// rule. This is done only when the SIMD registers hold at least four `double`
+// numbers (e.g., AVX, see option REAKTORO_ENABLE_SIMD) and the arrays are not
+// too small; otherwise, the scalar functions of autodiff are applied entry by
+// entry in inline loops, as in `x.exp()` or `x.log()`, so that the default
+// build runs the same code as before. Use these functions in the loops over
+// species of activity models. The result array can be the argument array.
+
+namespace detail {
+
+/// Whether the lanes are processed using packet math. With fewer than 4 numbers per register, the packet math does not outperform libm.
+constexpr bool vectorized = Eigen::internal::packet_traits<double>::size >= 4;
+
+/// The minimum number of entries for the lanes to be processed using packet math. Below this, splitting and combining the lanes does not pay off.
+constexpr Index minsize = 16;
+
+/// Return true if the lanes of an array with given number of entries are processed using packet math.
+constexpr auto packed(Index size) -> bool { return vectorized && size >= minsize; }
+
+/// Throw an error if the result array (or another array argument) does not have the same size of the argument array.
+auto errorSizeMismatch(Index xsize, Index ressize) -> void;
+
+/// Compute `exp(x)` for every entry in `x` using packet math.
+auto vexpPacked(ArrayXrConstRef x, ArrayXrRef res) -> void;
+
+/// Compute `log(x)` for every entry in `x` using packet math.
+auto vlogPacked(ArrayXrConstRef x, ArrayXrRef res) -> void;
+
+/// Compute `sqrt(x)` for every entry in `x` using packet math.
+auto vsqrtPacked(ArrayXrConstRef x, ArrayXrRef res) -> void;
+
+/// Compute `pow(x, a)` for every entry in `x` using packet math.
+auto vpowPacked(ArrayXrConstRef x, double a, ArrayXrRef res) -> void;
+
+} // namespace detail
+
+/// Return true if the functions below use packet math for arrays with given number of entries.
+/// Use this function to keep a single-pass scalar loop, in which the
+/// elementary functions are evaluated as the entries are needed, whenever
+/// the functions below would only evaluate them entry by entry as well.
+constexpr auto vpacked(Index size) -> bool { return detail::packed(size); }
+
+/// Compute `exp(x)` for every entry in `x`.
+/// @param x The array with the arguments
+/// @param[out] res The array with the results
+inline auto vexp(ArrayXrConstRef x, ArrayXrRef res) -> void
+{
+    if(res.size() != x.size())
+        detail::errorSizeMismatch(x.size(), res.size());
+    if(detail::packed(x.size()))
+        return detail::vexpPacked(x, res);
+    for(Index i = 0; i < x.size(); ++i)
+        res[i] = exp(x[i]);
+}
+
+/// Compute `log(x)` for every entry in `x`.
+/// @param x The array with the arguments
+/// @param[out] res The array with the results
+inline auto vlog(ArrayXrConstRef x, ArrayXrRef res) -> void
+{
+    if(res.size() != x.size())
+        detail::errorSizeMismatch(x.size(), res.size());
+    if(detail::packed(x.size()))
+        return detail::vlogPacked(x, res);
+    for(Index i = 0; i < x.size(); ++i)
+        res[i] = log(x[i]);
+}
+
+/// Compute `y + log(x)` for every entry in `x` and `y`.
+/// Use this function for the ln activities of solutes, computed as the sum of
+/// their ln activity coefficients and ln molalities. Without packet math, this
+/// is the single-pass expression `res = y + x.log()`. The result array can be
+/// the array `x`, but not the array `y`.
+/// @param y The array with the terms added to the logarithms
+/// @param x The array with the arguments of the logarithms
+/// @param[out] res The array with the results
+inline auto vaddlog(ArrayXrConstRef y, ArrayXrConstRef x, ArrayXrRef res) -> void
+{
+    if(res.size() != x.size())
+        detail::errorSizeMismatch(x.size(), res.size());
+    if(y.size() != x.size())
+        detail::errorSizeMismatch(x.size(), y.size());
+    if(detail::packed(x.size()))
+    {
+        detail::vlogPacked(x, res);
+        res += y;
+        return;
+    }
+    res = y + x.log();
+}
+
+/// Compute `sqrt(x)` for every entry in `x`.
+/// @param x The array with the arguments
+/// @param[out] res The array with the results
+inline auto vsqrt(ArrayXrConstRef x, ArrayXrRef res) -> void
+{
+    if(res.size() != x.size())
+        detail::errorSizeMismatch(x.size(), res.size());
+    if(detail::packed(x.size()))
+        return detail::vsqrtPacked(x, res);
+    for(Index i = 0; i < x.size(); ++i)
+        res[i] = sqrt(x[i]);
+}
+
+/// Compute `pow(x, a)` for every entry in `x`.
+/// @param x The array with the arguments
+/// @param a The exponent
+/// @param[out] res The array with the results
+inline auto vpow(ArrayXrConstRef x, double a, ArrayXrRef res) -> void
+{
+    if(res.size() != x.size())
+        detail::errorSizeMismatch(x.size(), res.size());
+    if(detail::packed(x.size()))
+        return detail::vpowPacked(x, a, res);
+    for(Index i = 0; i < x.size(); ++i)
+        res[i] = pow(x[i], a);
+}
+
+/// Return `exp(x)` for every entry in `x`.
+inline auto vexp(ArrayXrConstRef x) -> ArrayXr
+{
+    ArrayXr res(x.size());
+    vexp(x, res);
+    return res;
+}
+
+/// Return `log(x)` for every entry in `x`.
+inline auto vlog(ArrayXrConstRef x) -> ArrayXr
+{
+    ArrayXr res(x.size());
+    vlog(x, res);
+    return res;
+}
+
+/// Return `sqrt(x)` for every entry in `x`.
+inline auto vsqrt(ArrayXrConstRef x) -> ArrayXr
+{
+    ArrayXr res(x.size());
+    vsqrt(x, res);
+    return res;
+}
+
+/// Return `pow(x, a)` for every entry in `x`.
+inline auto vpow(ArrayXrConstRef x, double a) -> ArrayXr
+{
+    ArrayXr res(x.size());
+    vpow(x, a, res);
+    return res;
+}
+
+} // namespace Reaktoro
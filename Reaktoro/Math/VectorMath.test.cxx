@@ -0,0 +1,193 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+// Catch includes
+#include <catch2/catch.hpp>
+
+// C++ includes
+#include <random>
+
+// Reaktoro includes
+#include <Reaktoro/Common/Real.hpp>
+#include <Reaktoro/Math/VectorMath.hpp>
+using namespace Reaktoro;
+
+namespace test {
+
+/// Return an array of `real` numbers with values uniformly distributed in [a, b] and derivatives in [-1, 1].
+auto createRandomArray(Index size, double a, double b) -> ArrayXr
+{
+    std::mt19937 gen(size);
+    std::uniform_real_distribution<double> val(a, b);
+    std::uniform_real_distribution<double> der(-1.0, 1.0);
+
+    ArrayXr x(size);
+    for(Index i = 0; i < size; ++i)
+    {
+        x[i] = val(gen);
+        x[i][1] = der(gen);
+    }
+    return x;
+}
+
+} // namespace test
+
+TEST_CASE("Testing VectorMath module", "[VectorMath]")
+{
+    const auto size = GENERATE(1, 7, 64, 203, 1000); // sizes below, equal to, and above the internal block size
+
+    INFO("size = " << size);
+
+    const auto tol = 1e-14; // the expected accuracy of the vectorized functions relative to libm
+
+    ArrayXr res(size);
+
+    SECTION("Testing vexp")
+    {
+        const ArrayXr x = test::createRandomArray(size, -700.0, 700.0);
+
+        vexp(x, res);
+
+        for(Index i = 0; i < size; ++i)
+        {
+            const auto v = x[i][0];
+            const auto d = x[i][1];
+            CHECK( res[i][0] == Approx(std::exp(v)).epsilon(tol) );
+            CHECK( res[i][1] == Approx(std::exp(v) * d).epsilon(tol) );
+        }
+    }
+
+    SECTION("Testing vlog")
+    {
+        const ArrayXr x = test::createRandomArray(size, 1e-300, 1e+300);
+
+        vlog(x, res);
+
+        for(Index i = 0; i < size; ++i)
+        {
+            const auto v = x[i][0];
+            const auto d = x[i][1];
+            CHECK( res[i][0] == Approx(std::log(v)).epsilon(tol) );
+            CHECK( res[i][1] == Approx(d / v).epsilon(tol) );
+        }
+
+        // Check the results for tiny arguments, such as mole fractions of species with nearly zero amounts
+        const ArrayXr y = test::createRandomArray(size, 1e-300, 1e-16);
+
+        vlog(y, res);
+
+        for(Index i = 0; i < size; ++i)
+            CHECK( res[i][0] == Approx(std::log(y[i][0])).epsilon(tol) );
+    }
+
+    SECTION("Testing vaddlog")
+    {
+        const ArrayXr x = test::createRandomArray(size, 1.5, 1e+2); // all terms below positive to avoid cancellation errors
+        const ArrayXr y = test::createRandomArray(size + 1, 0.5, 10.0).head(size);
+
+        vaddlog(y, x, res);
+
+        for(Index i = 0; i < size; ++i)
+        {
+            const auto v = x[i][0];
+            const auto d = x[i][1];
+            CHECK( res[i][0] == Approx(y[i][0] + std::log(v)).epsilon(tol) );
+            CHECK( res[i][1] == Approx(y[i][1] + d / v).epsilon(tol) );
+        }
+
+        ArrayXr wrong(size + 1);
+
+        CHECK_THROWS( vaddlog(wrong, x, res) );
+    }
+
+    SECTION("Testing vsqrt")
+    {
+        const ArrayXr x = test::createRandomArray(size, 0.0, 1e+6);
+
+        vsqrt(x, res);
+
+        for(Index i = 0; i < size; ++i)
+        {
+            const auto v = x[i][0];
+            const auto d = x[i][1];
+            CHECK( res[i][0] == Approx(std::sqrt(v)).epsilon(tol) );
+            CHECK( res[i][1] == Approx(0.5 * d / std::sqrt(v)).epsilon(tol) );
+        }
+    }
+
+    SECTION("Testing vpow")
+    {
+        const ArrayXr x = test::createRandomArray(size, 1e-6, 1e+3);
+
+        for(auto a : { -3.0, -0.1, 0.2, 0.5, 2.0, 3.7 })
+        {
+            INFO("a = " << a);
+
+            vpow(x, a, res);
+
+            for(Index i = 0; i < size; ++i)
+            {
+                const auto v = x[i][0];
+                const auto d = x[i][1];
+                CHECK( res[i][0] == Approx(std::pow(v, a)).epsilon(tol) );
+                CHECK( res[i][1] == Approx(a * std::pow(v, a - 1) * d).epsilon(tol) );
+            }
+        }
+
+        // Check the derivative at zero, for which a*x^(a-1) is evaluated directly
+        ArrayXr zero = ArrayXr::Zero(size);
+        zero[0][1] = 1.0;
+
+        vpow(zero, 2.0, res);
+
+        CHECK( res[0][0] == 0.0 );
+        CHECK( res[0][1] == 0.0 );
+    }
+
+    SECTION("Testing the agreement with the element-wise operations on ArrayXr")
+    {
+        const ArrayXr x = test::createRandomArray(size, 1.5, 10.0); // all terms below positive to avoid cancellation errors
+
+        const ArrayXr expected = x.log() + x.exp() * x.sqrt();
+        const ArrayXr actual = vlog(x) + vexp(x) * vsqrt(x);
+
+        for(Index i = 0; i < size; ++i)
+        {
+            CHECK( actual[i][0] == Approx(expected[i][0]).epsilon(tol) );
+            CHECK( actual[i][1] == Approx(expected[i][1]).epsilon(tol) );
+        }
+    }
+
+    SECTION("Testing the computation in place and the check on the size of the result")
+    {
+        ArrayXr x = test::createRandomArray(size, 0.1, 10.0);
+
+        const ArrayXr expected = vexp(x);
+
+        vexp(x, x);
+
+        for(Index i = 0; i < size; ++i)
+        {
+            CHECK( x[i][0] == expected[i][0] );
+            CHECK( x[i][1] == expected[i][1] );
+        }
+
+        ArrayXr wrong(size + 1);
+
+        CHECK_THROWS( vexp(x, wrong) );
+    }
+}
@@ -19,6 +19,7 @@
 
 // Reaktoro includes
 #include <Reaktoro/Common/Constants.hpp>
+#include <Reaktoro/Math/VectorMath.hpp>
 #include <Reaktoro/Models/ActivityModels/Support/AqueousMixture.hpp>
 #include <Reaktoro/Water/WaterConstants.hpp>
 
@@ -87,8 +88,13 @@ auto activityModelDavies(const SpeciesList& species, ActivityModelDaviesParams p
         auto& ln_g = props.ln_g;
         auto& ln_a = props.ln_a;
 
+        // The ln molalities of all species, computed all at once into `ln_a` if packet math pays off and otherwise one by one in the loops below
+        const auto packed = vpacked(m.size());
+        if(packed)
+            vlog(m, ln_a);
+        auto ln_m = [&](Index i) -> real { return packed ? ln_a[i] : log(m[i]); };
+
         // Auxiliary variables
-        const auto ln_m = m.log();
         const auto xw = x[iwater];
         const auto ln_xw = log(xw);
         const auto I2 = I*I;
@@ -119,7 +125,7 @@ auto activityModelDavies(const SpeciesList& species, ActivityModelDaviesParams p
             ln_g[ispecies] = sigmac * zi*zi;
 
             // Calculate the ln activity of the current charged species
-            ln_a[ispecies] = ln_g[ispecies] + ln_m[ispecies];
+            ln_a[ispecies] = ln_g[ispecies] + ln_m(ispecies);
 
             // Calculate the contribution of current charged species to the ln activity of water
             ln_a[iwater] -= Mw * (m[ispecies] + m[ispecies]*ln_g[ispecies] + Gammac);
@@ -135,7 +141,7 @@ auto activityModelDavies(const SpeciesList& species, ActivityModelDaviesParams p
             ln_g[ispecies] = sigman;
 
             // Calculate the ln activity coefficient of the current neutral species
-            ln_a[ispecies] = ln_g[ispecies] + ln_m[ispecies];
+            ln_a[ispecies] = ln_g[ispecies] + ln_m(ispecies);
 
             // Calculate the contribution of current neutral species to the ln activity of water
             ln_a[iwater] -= Mw * m[ispecies];
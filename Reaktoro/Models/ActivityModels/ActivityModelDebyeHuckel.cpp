@@ -19,6 +19,7 @@
 
 // Reaktoro includes
 #include <Reaktoro/Common/Constants.hpp>
+#include <Reaktoro/Math/VectorMath.hpp>
 #include <Reaktoro/Models/ActivityModels/Support/AqueousMixture.hpp>
 #include <Reaktoro/Water/WaterConstants.hpp>
 
@@ -330,6 +331,10 @@ auto activityModelDebyeHuckel(const SpeciesList& species, ActivityModelDebyeHuck
     auto stateptr = std::make_shared<AqueousMixtureState>();
     auto mixtureptr = std::make_shared<AqueousMixture>(mixture);
 
+    // The Lambda parameters of the charged species and their natural logarithms (kept here to avoid heap memory allocation in every evaluation)
+    ArrayXr Lambda(num_charged_species);
+    ArrayXr ln_Lambda(num_charged_species);
+
     // Define the activity model function of the aqueous mixture
     ActivityModel fn = [=](ActivityPropsRef props, ActivityModelArgs args) mutable
     {
@@ -357,8 +362,13 @@ auto activityModelDebyeHuckel(const SpeciesList& species, ActivityModelDebyeHuck
         auto& ln_g = props.ln_g;
         auto& ln_a = props.ln_a;
 
+        // The ln molalities of all species, computed all at once into `ln_a` if packet math pays off and otherwise one by one in the loops below
+        const auto packed = vpacked(m.size());
+        if(packed)
+            vlog(m, ln_a);
+        auto ln_m = [&](Index i) -> real { return packed ? ln_a[i] : log(m[i]); };
+
         // Auxiliary variables
-        const auto ln_m = m.log();
         const auto xw = x[iwater];
         const auto ln_xw = log(xw);
         const auto mSigma = nwo * (1 - xw)/xw;
@@ -371,6 +381,15 @@ auto activityModelDebyeHuckel(const SpeciesList& species, ActivityModelDebyeHuck
         const auto B = 50.29158649 * sqrt_rho/sqrt_T_epsilon;
         const auto sigmacoeff = (2.0/3.0)*A*I*sqrtI;
 
+        // The Lambda parameters of the Debye-Huckel activity coefficient model for all charged species and their natural logarithms (computed all at once only if packet math pays off)
+        const auto packedLambda = vpacked(num_charged_species);
+        if(packedLambda)
+        {
+            for(Index i = 0; i < num_charged_species; ++i)
+                Lambda[i] = 1.0 + aions[i]*B*sqrtI;
+            vlog(Lambda, ln_Lambda);
+        }
+
         // Set the first contribution to the activity of water
         ln_a[iwater] = mSigma;
 
@@ -387,16 +406,16 @@ auto activityModelDebyeHuckel(const SpeciesList& species, ActivityModelDebyeHuck
             const auto z = charges[i];
 
             // Update the Lambda parameter of the Debye-Huckel activity coefficient model
-            const auto Lambda = 1.0 + aions[i]*B*sqrtI;
+            const real Lambdai = packedLambda ? Lambda[i] : 1.0 + aions[i]*B*sqrtI;
 
             // Update the sigma parameter of the current ion
-            const real sigma = (aions[i] != 0.0) ? 3.0*pow(Lambda - 1, -3) * ((Lambda - 1)*(Lambda - 3) + 2*log(Lambda)) : real(2.0);
+            const real sigma = (aions[i] != 0.0) ? 3.0*pow(Lambdai - 1, -3) * ((Lambdai - 1)*(Lambdai - 3) + 2*(packedLambda ? ln_Lambda[i] : log(Lambdai))) : real(2.0);
 
             // Calculate the ln activity coefficient of the current charged species
-            ln_g[ispecies] = ln10 * (-A*z*z*sqrtI/Lambda + bions[i]*I);
+            ln_g[ispecies] = ln10 * (-A*z*z*sqrtI/Lambdai + bions[i]*I);
 
             // Calculate the ln activity of the current charged species
-            ln_a[ispecies] = ln_g[ispecies] + ln_m[ispecies];
+            ln_a[ispecies] = ln_g[ispecies] + ln_m(ispecies);
 
             // Calculate the contribution of current ion to the ln activity of water
             ln_a[iwater] += msi*ln_g[ispecies] + sigmacoeff*sigma*ln10 - I2*bions[i]/(z*z)*ln10;
@@ -418,7 +437,7 @@ auto activityModelDebyeHuckel(const SpeciesList& species, ActivityModelDebyeHuck
             ln_g[ispecies] = ln10 * bneutral[i] * I;
 
             // Calculate the ln activity coefficient of the current neutral species
-            ln_a[ispecies] = ln_g[ispecies] + ln_m[ispecies];
+            ln_a[ispecies] = ln_g[ispecies] + ln_m(ispecies);
         }
     };
 
@@ -26,6 +26,7 @@
 #include <Reaktoro/Common/Index.hpp>
 #include <Reaktoro/Common/NamingUtils.hpp>
 #include <Reaktoro/Math/BilinearInterpolator.hpp>
+#include <Reaktoro/Math/VectorMath.hpp>
 #include <Reaktoro/Models/ActivityModels/Support/AqueousMixture.hpp>
 #include <Reaktoro/Water/WaterConstants.hpp>
 
@@ -450,7 +451,7 @@ auto activityModelHKF(const SpeciesList& species) -> ActivityModel
         }
 
         // Set the activities of the solutes (molality scale)
-        props.ln_a = props.ln_g + m.log();
+        vaddlog(props.ln_g, m, props.ln_a);
 
         // Set the activity of water (in mole fraction scale)
         if(xw != 1.0) props.ln_a[iwater] = ln10 * Mw * phi;
@@ -18,6 +18,7 @@
 #include "ActivityModelIdealAqueous.hpp"
 
 // Reaktoro includes
+#include <Reaktoro/Math/VectorMath.hpp>
 #include <Reaktoro/Water/WaterConstants.hpp>
 
 namespace Reaktoro {
@@ -41,7 +42,7 @@ auto ActivityModelIdealAqueous() -> ActivityModelGenerator
             props.som = StateOfMatter::Liquid;
 
             props = 0.0;
-            props.ln_a = m.log();
+            vlog(m, props.ln_a);
             props.ln_a[iw] = -(1 - xw)/xw; // consistent to Gibbs-Duhem conditions
         };
 
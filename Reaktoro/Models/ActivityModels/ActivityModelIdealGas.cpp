@@ -19,6 +19,7 @@
 
 // Reaktoro includes
 #include <Reaktoro/Common/Constants.hpp>
+#include <Reaktoro/Math/VectorMath.hpp>
 
 namespace Reaktoro {
 
@@ -43,7 +44,8 @@ auto ActivityModelIdealGas() -> ActivityModelGenerator
             props.Vx  =  R*T/P; // identical to entire volume, since V0 = 0 for gases
             props.VxT =  props.Vx/T;
             props.VxP = -props.Vx/P;
-            props.ln_a = x.log() + log(Pbar);
+            vlog(x, props.ln_a);
+            props.ln_a += log(Pbar);
         };
 
         return fn;
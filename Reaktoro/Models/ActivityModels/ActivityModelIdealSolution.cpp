@@ -17,6 +17,9 @@
 
 #include "ActivityModelIdealSolution.hpp"
 
+// Reaktoro includes
+#include <Reaktoro/Math/VectorMath.hpp>
+
 namespace Reaktoro {
 
 auto ActivityModelIdealSolution(StateOfMatter stateofmatter) -> ActivityModelGenerator
@@ -29,7 +32,7 @@ auto ActivityModelIdealSolution(StateOfMatter stateofmatter) -> ActivityModelGen
             props.som = stateofmatter;
 
             props = 0.0;
-            props.ln_a = args.x.log();
+            vlog(args.x, props.ln_a);
         };
 
         return fn;
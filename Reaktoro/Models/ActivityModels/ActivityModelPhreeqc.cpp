@@ -30,6 +30,7 @@
 #include <Reaktoro/Extensions/Phreeqc/PhreeqcLegacy.hpp>
 #include <Reaktoro/Extensions/Phreeqc/PhreeqcUtils.hpp>
 #include <Reaktoro/Extensions/Phreeqc/PhreeqcWater.hpp>
+#include <Reaktoro/Math/VectorMath.hpp>
 #include <Reaktoro/Models/ActivityModels/Support/AqueousMixture.hpp>
 #include <Reaktoro/Water/WaterConstants.hpp>
 
@@ -275,7 +276,7 @@ auto createActivityModelPhreeqc(SpeciesList const& species, PhreeqcDatabase cons
         props.ln_g = lg * ln10;
 
         // Set the activities of the species
-        props.ln_a = props.ln_g + log(aqstate.m);
+        vaddlog(props.ln_g, aqstate.m, props.ln_a);
 
         // Set the activitiy of water
         props.ln_a[iw] = log(1.0 - 0.017/Mw * (1.0 - xw)/xw);
@@ -37,6 +37,7 @@
 #include <Reaktoro/Core/Embedded.hpp>
 #include <Reaktoro/Extensions/Phreeqc/PhreeqcWater.hpp>
 #include <Reaktoro/Math/BilinearInterpolator.hpp>
+#include <Reaktoro/Math/VectorMath.hpp>
 #include <Reaktoro/Models/ActivityModels/Support/AqueousMixture.hpp>
 #include <Reaktoro/Serialization/Models/ActivityModels.hpp>
 #include <Reaktoro/Water/WaterConstants.hpp>
@@ -516,15 +517,19 @@ auto determineMuCoeffs(double z1, double z2, double z3, Index i1, Index i2, Inde
 }
 
 /// The function \eq{g(x) = 2[1-(1+x)e^{-x}]/x^2} in the Pitzer model (see Eq. 11 of Plummer et al 1988).
-auto G(real const& x) -> real
+/// @param x The argument \eq{x}
+/// @param expmx The value of \eq{e^{-x}}, computed for all parameters at once with @ref vexp
+auto G(real const& x, real const& expmx) -> real
 {
-    return x == 0.0 ? x : 2.0*(1.0 - (1.0 + x)*exp(-x))/(x*x);
+    return x == 0.0 ? x : 2.0*(1.0 - (1.0 + x)*expmx)/(x*x);
 }
 
 /// The function \eq{g^\prime(x) = -2\left[1-\left(1+x+\dfrac{1}{2}x^2\right)e^{-x}\right]/x^2} in the Pitzer model (see Eq. 12 of Plummer et al 1988).
-auto GP(real const& x) -> real
+/// @param x The argument \eq{x}
+/// @param expmx The value of \eq{e^{-x}}, computed for all parameters at once with @ref vexp
+auto GP(real const& x, real const& expmx) -> real
 {
-    return x == 0.0 ? x : -2.0*(1.0 - (1.0 + x + 0.5*x*x)*exp(-x))/(x*x);
+    return x == 0.0 ? x : -2.0*(1.0 - (1.0 + x + 0.5*x*x)*expmx)/(x*x);
 }
 
 /// Compute J0 and J1 exactly as computed in PHREEQC v3.3.7 using a numerical
@@ -665,6 +670,11 @@ struct PitzerModel
     ArrayXr thetaE;   ///< The current values of the parameters \eq{^{E}\theta_{ij}(I)} associated to the \eq{\theta_{ij}} parameters.
     ArrayXr thetaEP;  ///< The current values of the parameters \eq{^{E}\theta_{ij}^{\prime}(I)} associated to the \eq{\theta_{ij}} parameters.
 
+    ArrayXr X1; ///< The current arguments \eq{x = \alpha_1\sqrt{I}} of the functions g(x) and g'(x) for the \eq{\beta^{(1)}_{ij}} parameters.
+    ArrayXr E1; ///< The current values of \eq{e^{-x}} for the arguments in @ref X1.
+    ArrayXr X2; ///< The current arguments \eq{x = \alpha_2\sqrt{I}} of the functions g(x) and g'(x) for the \eq{\beta^{(2)}_{ij}} parameters.
+    ArrayXr E2; ///< The current values of \eq{e^{-x}} for the arguments in @ref X2.
+
     Fn<real(real const&, real const&)> Aphi; ///< The function that computes the Debye-huckel parameter \eq{A^\phi(T, P)} in the Pitzer model.
 
     /// Construct a default Pitzer object.
@@ -722,6 +732,11 @@ struct PitzerModel
         for(auto const& entry : params.beta2)
             alpha2.push_back(determineAlpha2(entry.formulas[0], entry.formulas[1], params.alpha2));
 
+        X1.resize(beta1.size());
+        E1.resize(beta1.size());
+        X2.resize(beta2.size());
+        E2.resize(beta2.size());
+
         auto const& ications = solution.indicesCations();
         auto const& ianions = solution.indicesAnions();
 
@@ -860,26 +875,46 @@ struct PitzerModel
             OSMOT += M[i0] * M[i1] * param.value;
         }
 
+        // The arguments \eq{x = \alpha_1\sqrt{I}} of the functions g(x) and g'(x) for the beta1 parameters and their values of exp(-x)
+        for(auto i = 0; i < X1.size(); ++i)
+        {
+            X1[i] = alpha1[i] * DI;
+            E1[i] = -X1[i];
+        }
+        vexp(E1, E1);
+
         for(auto const& [i, param] : enumerate(beta1))
         {
             auto const i0 = param.ispecies[0];
             auto const i1 = param.ispecies[1];
 
-            F += M[i0] * M[i1] * param.value * GP(alpha1[i] * DI)/I;
-            LGAMMA[i0] += M[i1] * 2.0 * param.value * G(alpha1[i] * DI);
-            LGAMMA[i1] += M[i0] * 2.0 * param.value * G(alpha1[i] * DI);
-            OSMOT += M[i0] * M[i1] * param.value * exp(-alpha1[i] * DI);
+            auto const g = G(X1[i], E1[i]);
+
+            F += M[i0] * M[i1] * param.value * GP(X1[i], E1[i])/I;
+            LGAMMA[i0] += M[i1] * 2.0 * param.value * g;
+            LGAMMA[i1] += M[i0] * 2.0 * param.value * g;
+            OSMOT += M[i0] * M[i1] * param.value * E1[i];
         }
 
+        // The arguments \eq{x = \alpha_2\sqrt{I}} of the functions g(x) and g'(x) for the beta2 parameters and their values of exp(-x)
+        for(auto i = 0; i < X2.size(); ++i)
+        {
+            X2[i] = alpha2[i] * DI;
+            E2[i] = -X2[i];
+        }
+        vexp(E2, E2);
+
         for(auto const& [i, param] : enumerate(beta2))
         {
             auto const i0 = param.ispecies[0];
             auto const i1 = param.ispecies[1];
 
-            F += M[i0] * M[i1] * param.value * GP(alpha2[i] * DI)/I;
-            LGAMMA[i0] += M[i1] * 2.0 * param.value * G(alpha2[i] * DI);
-            LGAMMA[i1] += M[i0] * 2.0 * param.value * G(alpha2[i] * DI);
-            OSMOT += M[i0] * M[i1] * param.value * exp(-alpha2[i] * DI);
+            auto const g = G(X2[i], E2[i]);
+
+            F += M[i0] * M[i1] * param.value * GP(X2[i], E2[i])/I;
+            LGAMMA[i0] += M[i1] * 2.0 * param.value * g;
+            LGAMMA[i1] += M[i0] * 2.0 * param.value * g;
+            OSMOT += M[i0] * M[i1] * param.value * E2[i];
         }
 
         for(auto const& param : Cphi)
@@ -1034,7 +1069,7 @@ auto createActivityModelPitzer(SpeciesList const& species, ActivityModelParamsPi
         props.ln_g = pzstate.ln_gamma;
 
         // Set the activities of the solutes
-        props.ln_a = props.ln_g + log(aqstate.m);
+        vaddlog(props.ln_g, aqstate.m, props.ln_a);
 
         // Set the activitiy of water
         props.ln_a[iH2O] = pzstate.ln_aw;
@@ -26,6 +26,7 @@
 #include <Reaktoro/Common/Exception.hpp>
 #include <Reaktoro/Core/StateOfMatter.hpp>
 #include <Reaktoro/Math/Roots.hpp>
+#include <Reaktoro/Math/VectorMath.hpp>
 
 //=================================================================================================
 // == REFERENCE ==
@@ -62,6 +63,7 @@ auto EquationModelVanDerWaals() -> EquationModel
     eqmodel.epsilon = 0.0;
     eqmodel.Omega   = 1.0/8.0;
     eqmodel.Psi     = 27.0/64.0;
+    eqmodel.type    = EquationModelType::VanDerWaals;
 
     eqmodel.alphafn = [](AlphaModelArgs const& args) -> Alpha
     {
@@ -78,6 +80,7 @@ auto EquationModelRedlichKwong() -> EquationModel
     eqmodel.epsilon = 0.0;
     eqmodel.Omega   = 0.08664;
     eqmodel.Psi     = 0.42748;
+    eqmodel.type    = EquationModelType::RedlichKwong;
 
     eqmodel.alphafn = [](AlphaModelArgs const& args) -> Alpha
     {
@@ -100,6 +103,7 @@ auto EquationModelSoaveRedlichKwong() -> EquationModel
     eqmodel.epsilon = 0.0;
     eqmodel.Omega   = 0.08664;
     eqmodel.Psi     = 0.42748;
+    eqmodel.type    = EquationModelType::SoaveRedlichKwong;
 
     eqmodel.alphafn = [](AlphaModelArgs const& args) -> Alpha
     {
@@ -127,6 +131,7 @@ auto EquationModelPengRobinsonAux(Index year) -> EquationModel
     eqmodel.epsilon = 1.0 - 1.4142135623730951;
     eqmodel.Omega   = 0.0777960739;
     eqmodel.Psi     = 0.457235529;
+    eqmodel.type    = year == 76 ? EquationModelType::PengRobinson76 : EquationModelType::PengRobinson78;
 
     Fn<real(real const&)> mPR76 = [](real const& omega) -> real
     {
@@ -283,6 +288,131 @@ auto determinePhysicalStateOneRealRoot(double a, double b, double e, double s, d
     return (Pmin != Pmin) ? StateOfMatter::Supercritical : (P < Pmin) ? StateOfMatter::Gas : StateOfMatter::Liquid;
 }
 
+/// Return the coefficient \eq{m} in the \eq{\alpha(T_r;\omega)} function of a built-in cubic equation of state (zero if not applicable).
+auto alphaCoefficient(EquationModelType type, real const& omega) -> real
+{
+    switch(type)
+    {
+    case EquationModelType::SoaveRedlichKwong:
+        return 0.480 + 1.574*omega - 0.176*omega*omega;
+    case EquationModelType::PengRobinson76:
+        return 0.374640 + 1.54226*omega - 0.269920*omega*omega;
+    case EquationModelType::PengRobinson78:
+        return omega < 0.491 ?
+            0.374640 + 1.54226*omega - 0.269920*omega*omega :
+            0.379642 + 1.48503*omega - 0.164423*omega*omega + 0.016666*omega*omega*omega;
+    default:
+        return 0.0;
+    }
+}
+
+/// Compute the \eq{\alpha(T_r;\omega)} functions of all substances for a built-in cubic equation of state.
+/// @param T The temperature (in K)
+/// @param TrT The reciprocal of the critical temperatures of the substances, i.e., \eq{dT_r/dT} (in 1/K)
+/// @param m The coefficients \eq{m} in the \eq{\alpha(T_r;\omega)} functions of the substances
+/// @param[out] alpha The values of \eq{\alpha(T_r;\omega)} of the substances
+/// @param[out] alphaT The first-order temperature derivatives of \eq{\alpha(T_r;\omega)} of the substances
+/// @param[out] alphaTT The second-order temperature derivatives of \eq{\alpha(T_r;\omega)} of the substances
+template<EquationModelType type>
+auto computeAlphas(real const& T, ArrayXrConstRef TrT, ArrayXrConstRef m, ArrayXrRef alpha, ArrayXrRef alphaT, ArrayXrRef alphaTT) -> void
+{
+    const auto size = TrT.size();
+
+    if constexpr(type == EquationModelType::VanDerWaals)
+    {
+        alpha.fill(1.0);
+        alphaT.fill(0.0);
+        alphaTT.fill(0.0);
+    }
+    else if constexpr(type == EquationModelType::RedlichKwong)
+    {
+        // Use alphaT and alpha to temporarily store Tr and sqrt(Tr) of all substances, with the square roots evaluated at once
+        alphaT = T*TrT;
+        vsqrt(alphaT, alpha);
+
+        for(auto k = 0; k < size; ++k)
+        {
+            const real Tr = alphaT[k];
+            const real alphak = 1.0/alpha[k];
+            const real alphaTr = -0.5/Tr * alphak;
+            const real alphaTrTr = -0.5/Tr * (alphaTr - alphak/Tr);
+            alpha[k]   = alphak;
+            alphaT[k]  = alphaTr*TrT[k];
+            alphaTT[k] = alphaTrTr*TrT[k]*TrT[k];
+        }
+    }
+    else // Soave-Redlich-Kwong and Peng-Robinson differ only in m
+    {
+        // Use alphaT and alpha to temporarily store Tr and sqrt(Tr) of all substances, with the square roots evaluated at once
+        alphaT = T*TrT;
+        vsqrt(alphaT, alpha);
+
+        for(auto k = 0; k < size; ++k)
+        {
+            const real Tr = alphaT[k];
+            const real sqrtTr = alpha[k];
+            const real aux = 1.0 + m[k]*(1.0 - sqrtTr);
+            const real auxTr = -0.5*m[k]/sqrtTr;
+            const real auxTrTr = 0.25*m[k]/(Tr*sqrtTr);
+            alpha[k]   = aux*aux;
+            alphaT[k]  = 2.0*aux*auxTr * TrT[k];
+            alphaTT[k] = 2.0*(auxTr*auxTr + aux*auxTrTr) * TrT[k]*TrT[k];
+        }
+    }
+}
+
+/// Compute the \eq{\alpha(T_r;\omega)} functions of all substances for a built-in cubic equation of state (see @ref computeAlphas).
+auto computeAlphas(EquationModelType type, real const& T, ArrayXrConstRef TrT, ArrayXrConstRef m, ArrayXrRef alpha, ArrayXrRef alphaT, ArrayXrRef alphaTT) -> void
+{
+    switch(type)
+    {
+    case EquationModelType::VanDerWaals:       return computeAlphas<EquationModelType::VanDerWaals>(T, TrT, m, alpha, alphaT, alphaTT);
+    case EquationModelType::RedlichKwong:      return computeAlphas<EquationModelType::RedlichKwong>(T, TrT, m, alpha, alphaT, alphaTT);
+    case EquationModelType::SoaveRedlichKwong: return computeAlphas<EquationModelType::SoaveRedlichKwong>(T, TrT, m, alpha, alphaT, alphaTT);
+    case EquationModelType::PengRobinson76:    return computeAlphas<EquationModelType::PengRobinson76>(T, TrT, m, alpha, alphaT, alphaTT);
+    case EquationModelType::PengRobinson78:    return computeAlphas<EquationModelType::PengRobinson78>(T, TrT, m, alpha, alphaT, alphaTT);
+    default: errorif(true, "Expecting a built-in cubic equation of state when computing its alpha functions.");
+    }
+}
+
+/// Return the type of the built-in cubic equation of state if its alpha function agrees with EquationModel::alphafn, otherwise EquationModelType::Custom.
+auto checkEquationModelType(EquationModel const& eqmodel, ArrayXrConstRef Tcr, ArrayXrConstRef omega) -> EquationModelType
+{
+    const auto type = eqmodel.type;
+
+    if(type == EquationModelType::Custom)
+        return type;
+
+    const auto size = Tcr.size();
+
+    ArrayXr TrT = 1.0/Tcr;
+    ArrayXr m(size);
+    for(auto k = 0; k < size; ++k)
+        m[k] = alphaCoefficient(type, omega[k]);
+
+    ArrayXr alpha(size), alphaT(size), alphaTT(size);
+
+    auto agree = [](real const& a, real const& b)
+    {
+        return abs(a - b) <= 1e-10 * std::max(abs(a), abs(b)) + 1e-300;
+    };
+
+    // Compare the built-in and the given alpha functions at a few temperatures (below and above the critical temperatures)
+    for(auto T : { 200.0, 400.0, 800.0 })
+    {
+        computeAlphas(type, T, TrT, m, alpha, alphaT, alphaTT);
+        for(auto k = 0; k < size; ++k)
+        {
+            const real Tr = T*TrT[k];
+            const auto res = eqmodel.alphafn({ Tr, TrT[k], omega[k] });
+            if(!agree(res.alpha, alpha[k]) || !agree(res.alphaT, alphaT[k]) || !agree(res.alphaTT, alphaTT[k]))
+                return EquationModelType::Custom;
+        }
+    }
+
+    return type;
+}
+
 /// Return the critical temperatures of the substances as an array, checking if their values are valid.
 auto getCriticalTemperatures(Vec<Substance> const& substances) -> ArrayXr
 {
@@ -346,6 +476,21 @@ struct Equation::Impl
     /// The chemical formulas of the substances in the fluid phase.
     Strings const substances;
 
+    /// The type of the cubic equation of state (EquationModelType::Custom if EquationModel::alphafn needs to be used).
+    EquationModelType const type;
+
+    /// The reciprocal of the critical temperatures of the species, i.e., \eq{dT_r/dT} (in 1/K).
+    ArrayXr TrT;
+
+    /// The coefficients \eq{m} in the built-in \eq{\alpha(T_r;\omega)} functions of the species.
+    ArrayXr m;
+
+    /// The factors \eq{R^2T_\mathrm{cr}^2/P_\mathrm{cr}} of the species, which multiply \eq{\Psi\alpha} in Eq. (3.45).
+    ArrayXr afactor;
+
+    /// The factors \eq{RT_\mathrm{cr}/P_\mathrm{cr}} of the species, which multiply \eq{\Omega} in Eq. (3.44).
+    ArrayXr bfactor;
+
     // Auxiliary arrays
 
     ArrayXr a;
@@ -358,6 +503,9 @@ struct Equation::Impl
     ArrayXr abar;
     ArrayXr abarT;
     ArrayXr bbar;
+    ArrayXr sqrta;
+    ArrayXr g;
+    ArrayXr h;
     Bip bip;
 
     /// Construct an Equation::Impl object.
@@ -367,10 +515,18 @@ struct Equation::Impl
       Tcr(detail::getCriticalTemperatures(eqspecs.substances)),
       Pcr(detail::getCriticalPressures(eqspecs.substances)),
       omega(detail::getAccentricFactors(eqspecs.substances)),
-      substances(detail::createSubstanceList(eqspecs.substances))
+      substances(detail::createSubstanceList(eqspecs.substances)),
+      type(eqspecs.eqmodel.alphafn.initialized() ? detail::checkEquationModelType(eqspecs.eqmodel, Tcr, omega) : EquationModelType::Custom)
     {
         errorifnot(eqspecs.eqmodel.alphafn.initialized(), "The alpha function in CubicEOS::EquationSpecs::alphafn has not been initialized.");
 
+        TrT = 1.0/Tcr;
+        m = zeros(nspecies);
+        for(auto k = 0; k < nspecies; ++k)
+            m[k] = detail::alphaCoefficient(type, omega[k]);
+        afactor = R*R*Tcr*Tcr/Pcr;
+        bfactor = R*Tcr/Pcr;
+
         a       = zeros(nspecies);
         aT      = zeros(nspecies);
         aTT     = zeros(nspecies);
@@ -381,6 +537,9 @@ struct Equation::Impl
         abar    = zeros(nspecies);
         abarT   = zeros(nspecies);
         bbar    = zeros(nspecies);
+        sqrta   = zeros(nspecies);
+        g       = zeros(nspecies);
+        h       = zeros(nspecies);
         bip.k   = zeros(nspecies, nspecies);
         bip.kT  = zeros(nspecies, nspecies);
         bip.kTT = zeros(nspecies, nspecies);
@@ -399,73 +558,113 @@ struct Equation::Impl
         auto const& Psi     = eqspecs.eqmodel.Psi.value();
         auto const& alphafn = eqspecs.eqmodel.alphafn;
 
-        // Calculate the parameters `a` and `b` of the cubic equation of state for each species
-        for(auto k = 0; k < nspecies; ++k)
+        // Calculate the alpha functions of the species, using the packed array implementation of the built-in ones if possible
+        if(type != EquationModelType::Custom)
+            detail::computeAlphas(type, T, TrT, m, alpha, alphaT, alphaTT);
+        else
         {
-            const auto factor = Psi*R*R*(Tcr[k]*Tcr[k])/Pcr[k]; // factor in Eq. (3.45) multiplying alpha
-            const auto TrT = 1.0/Tcr[k];
-            const auto Tr = T * TrT;
-            const auto [alphak, alphaTk, alphaTTk] = alphafn({ Tr, TrT, omega[k] });
-            alpha[k]   = alphak;
-            alphaT[k]  = alphaTk;
-            alphaTT[k] = alphaTTk;
-            a[k]       = factor*alphak; // see Eq. (3.45)
-            aT[k]      = factor*alphaTk;
-            aTT[k]     = factor*alphaTTk;
-            b[k]       = Omega*R*Tcr[k]/Pcr[k]; // Eq. (3.44)
+            for(auto k = 0; k < nspecies; ++k)
+            {
+                const real Tr = T * TrT[k];
+                const auto [alphak, alphaTk, alphaTTk] = alphafn({ Tr, TrT[k], omega[k] });
+                alpha[k]   = alphak;
+                alphaT[k]  = alphaTk;
+                alphaTT[k] = alphaTTk;
+            }
         }
 
+        // Calculate the parameters `a` and `b` of the cubic equation of state for each species
+        a   = Psi*afactor*alpha; // see Eq. (3.45)
+        aT  = Psi*afactor*alphaT;
+        aTT = Psi*afactor*alphaTT;
+        b   = Omega*bfactor; // Eq. (3.44)
+
         // Calculate the binary interaction parameters and its temperature derivatives
         if(eqspecs.bipmodel.initialized())
             eqspecs.bipmodel(bip, { substances, T, Tcr, Pcr, omega, a, aT, aTT, alpha, alphaT, alphaTT, b });
 
+        // Calculate sqrt(a[i]) and the auxiliary ratios g[i] = aT[i]/(2a[i]) and h[i] = aTT[i]/a[i] so that
+        //     sqrt(a[i]*a[j])      = sqrta[i]*sqrta[j]
+        //     sqrt(a[i]*a[j])_T    = sqrta[i]*sqrta[j]*(g[i] + g[j])
+        //     sqrt(a[i]*a[j])_TT   = sqrta[i]*sqrta[j]*(0.5*(h[i] + h[j]) + 2*g[i]*g[j] - g[i]*g[i] - g[j]*g[j])
+        // without evaluating square roots and divisions for every pair of species
+        vsqrt(a, sqrta);
+        for(auto k = 0; k < nspecies; ++k)
+        {
+            g[k] = 0.5*aT[k]/a[k];
+            h[k] = aTT[k]/a[k];
+        }
+
         // Calculate the parameter `amix` of the phase and the partial molar parameters `abar` of each species
         real amix = {};
         real amixT = {};
         real amixTT = {};
-        abar.fill(0.0);
-        abarT.fill(0.0);
-        for(auto i = 0; i < nspecies; ++i)
+
+        if(!eqspecs.bipmodel.initialized())
         {
-            for(auto j = 0; j < nspecies; ++j)
+            // With no binary interaction parameters, aij = sqrt(a[i]*a[j]) and amix = (sum(x[i]*sqrt(a[i])))^2, which is computed in linear time
+            real u = {};
+            real uT = {};
+            real uTT = {};
+            for(auto k = 0; k < nspecies; ++k)
             {
-                auto const r   = 1.0 - bip.k(i, j);
-                auto const rT  = -bip.kT(i, j);
-                auto const rTT = -bip.kTT(i, j);
-
-                auto const s   = sqrt(a[i]*a[j]); // Eq. (13.93)
-                auto const sT  = 0.5*s/(a[i]*a[j]) * (aT[i]*a[j] + a[i]*aT[j]);
-                auto const sTT = 0.5*s/(a[i]*a[j]) * (aTT[i]*a[j] + 2*aT[i]*aT[j] + a[i]*aTT[j]) - sT*sT/s;
-
-                auto const aij   = r*s;
-                auto const aijT  = rT*s + r*sT;
-                auto const aijTT = rTT*s + 2.0*rT*sT + r*sTT;
+                u   += x[k] * sqrta[k];
+                uT  += x[k] * sqrta[k] * g[k];                      // sqrt(a[k])_T  = sqrt(a[k])*g[k]
+                uTT += x[k] * sqrta[k] * (0.5*h[k] - g[k]*g[k]);    // sqrt(a[k])_TT = sqrt(a[k])*(0.5*h[k] - g[k]*g[k])
+            }
 
-                amix   += x[i] * x[j] * aij; // Eq. (13.92) of Smith et al. (2017)
-                amixT  += x[i] * x[j] * aijT;
-                amixTT += x[i] * x[j] * aijTT;
+            amix   = u*u; // Eq. (13.92) of Smith et al. (2017) with kij = 0
+            amixT  = 2.0*u*uT;
+            amixTT = 2.0*(uT*uT + u*uTT);
 
-                abar[i]  += 2 * x[j] * aij;  // see Eq. (13.94)
-                abarT[i] += 2 * x[j] * aijT;
+            for(auto i = 0; i < nspecies; ++i)
+            {
+                abar[i]  = 2.0*sqrta[i]*u - amix; // see Eq. (13.94)
+                abarT[i] = 2.0*sqrta[i]*(g[i]*u + uT) - amixT;
             }
         }
-
-        // Finalize the calculation of `abar` and `abarT`
-        for(auto i = 0; i < nspecies; ++i)
+        else
         {
-            abar[i] -= amix;
-            abarT[i] -= amixT;
+            abar.fill(0.0);
+            abarT.fill(0.0);
+            for(auto i = 0; i < nspecies; ++i)
+            {
+                for(auto j = 0; j < nspecies; ++j)
+                {
+                    auto const r   = 1.0 - bip.k(i, j);
+                    auto const rT  = -bip.kT(i, j);
+                    auto const rTT = -bip.kTT(i, j);
+
+                    auto const s   = sqrta[i]*sqrta[j]; // Eq. (13.93)
+                    auto const sT  = s*(g[i] + g[j]);
+                    auto const sTT = s*(0.5*(h[i] + h[j]) + 2.0*g[i]*g[j] - g[i]*g[i] - g[j]*g[j]);
+
+                    auto const aij   = r*s;
+                    auto const aijT  = rT*s + r*sT;
+                    auto const aijTT = rTT*s + 2.0*rT*sT + r*sTT;
+
+                    amix   += x[i] * x[j] * aij; // Eq. (13.92) of Smith et al. (2017)
+                    amixT  += x[i] * x[j] * aijT;
+                    amixTT += x[i] * x[j] * aijTT;
+
+                    abar[i]  += 2 * x[j] * aij;  // see Eq. (13.94)
+                    abarT[i] += 2 * x[j] * aijT;
+                }
+            }
+
+            // Finalize the calculation of `abar` and `abarT`
+            for(auto i = 0; i < nspecies; ++i)
+            {
+                abar[i] -= amix;
+                abarT[i] -= amixT;
+            }
         }
 
         // Calculate the parameters bba[i] and bmix of the cubic equation of state
         //     bbar[i] = Omega*R*Tc[i]/Pc[i] as shown in Eq. (3.44)
         //     bmix = sum(x[i] * bbar[i])
-        real bmix = {};
-        for(auto i = 0; i < nspecies; ++i)
-        {
-            bbar[i] = Omega*R*Tcr[i]/Pcr[i]; // see Eq. (13.95) and unnumbered equation before Eq. (13.99)
-            bmix += x[i] * bbar[i];  // Eq. (13.91) of Smith et al. (2017)
-        }
+        bbar = b; // see Eq. (13.95) and unnumbered equation before Eq. (13.99)
+        const real bmix = (x * bbar).sum(); // Eq. (13.91) of Smith et al. (2017)
 
         // Calculate the temperature and pressure derivatives of bmix
         const auto bmixT = 0.0; // no temperature dependence!
@@ -497,8 +696,8 @@ struct Equation::Impl
         const real BP = (epsilon*sigma - epsilon - sigma)*(2*beta*betaP) + qP*beta - (epsilon + sigma - q)*betaP;
         const real CP = -epsilon*sigma*(3*beta*beta*betaP) - qP*beta*beta - (epsilon*sigma + q)*(2*beta*betaP);
 
-        // Calculate cubic roots using cardano's method
-        auto roots = realRoots(cardano(A, B, C));
+        // Calculate cubic roots using cardano's method in double precision (derivatives are recovered below)
+        auto roots = realRoots(cardano(A.val(), B.val(), C.val()));
 
         // Ensure there are either 1 or 3 real roots!
         assert(roots.size() == 1 || roots.size() == 3);
@@ -519,6 +718,11 @@ struct Equation::Impl
             Z = roots[0];
         }
 
+        // Apply one Newton step on the cubic polynomial with autodiff coefficients to recover the derivatives of Z (implicit function theorem)
+        const real dFdZ = 3*Z*Z + 2*A*Z + B;
+        if(dFdZ != 0.0)
+            Z -= (Z*Z*Z + A*Z*Z + B*Z + C)/dFdZ;
+
         // Calculate ZT := (dZ/dT)_P and ZP := (dZ/dP)_T
         const real ZT = -(AT*Z*Z + BT*Z + CT)/(3*Z*Z + 2*A*Z + B); // === (ZZZ + A*ZZ + B*Z + C)_T = 3*ZZ*ZT + AT*ZZ + 2*A*Z*ZT + BT*Z + B*ZT + CT = 0 => (3*ZZ + 2*A*Z + B)*ZT = -(AT*ZZ + BT*Z + CT)
         const real ZP = -(AP*Z*Z + BP*Z + CP)/(3*Z*Z + 2*A*Z + B); // === (ZZZ + A*ZZ + B*Z + C)_P = 3*ZZ*ZP + AP*ZZ + 2*A*Z*ZP + BP*Z + B*ZP + CP = 0 => (3*ZZ + 2*A*Z + B)*ZP = -(AP*ZZ + BP*Z + CP)
@@ -103,6 +103,20 @@ struct AlphaModelArgs
 /// The signature of functions that evaluates \eq{\alpha(T_r;\omega)} functions for a cubic equation of state.
 using AlphaModel = Model<Alpha(AlphaModelArgs const&)>;
 
+/// The classic cubic equations of state whose \eq{\alpha(T_r;\omega)} functions are known in advance.
+/// These are used to evaluate the \eq{\alpha(T_r;\omega)} functions of all
+/// substances at once, in a loop over packed arrays, instead of calling
+/// EquationModel::alphafn for each substance.
+enum class EquationModelType
+{
+    Custom,            ///< The cubic equation of state has a custom \eq{\alpha(T_r;\omega)} function, which is evaluated with EquationModel::alphafn.
+    VanDerWaals,       ///< The van der Waals (1873) cubic equation of state.
+    RedlichKwong,      ///< The Redlich-Kwong (1949) cubic equation of state.
+    SoaveRedlichKwong, ///< The Soave-Redlich-Kwong (1972) cubic equation of state.
+    PengRobinson76,    ///< The Peng-Robinson (1976) cubic equation of state.
+    PengRobinson78,    ///< The Peng-Robinson (1978) cubic equation of state.
+};
+
 /// The necessary constants \eq{\epsilon}, \eq{\sigma}, \eq{\Omega}, \eq{\Psi} and function \eq{\alpha(T_r;\omega)} that uniquely define a cubic equation of state.
 /// We consider the following general form for a cubic equation of state \sup{\cite Smith2005}:
 /// \eqc{P=\frac{RT}{V-b}-\frac{a(T)}{(V+\epsilon b)(V+\sigma b)}}
@@ -133,6 +147,12 @@ struct EquationModel
     Param Omega;        ///< The constant \eq{\Omega} in the cubic equation of state.
     Param Psi;          ///< The constant \eq{\Psi} in the cubic equation of state.
     AlphaModel alphafn; ///< The function \eq{\alpha(T_r;\omega)} in the cubic equation of state.
+
+    /// The type of the cubic equation of state if its \eq{\alpha(T_r;\omega)} function is a built-in one.
+    /// If this is not EquationModelType::Custom, the built-in \eq{\alpha(T_r;\omega)}
+    /// function is evaluated instead of @ref alphafn, once it has been
+    /// checked at construction of Equation that both agree.
+    EquationModelType type = EquationModelType::Custom;
 };
 
 /// Return a cubic equation model representative of the van der Waals (1873) cubic equation of state.
@@ -214,6 +214,70 @@ TEST_CASE("Testing CubicEOS::Equation class", "[CubicEOS]")
     }
 }
 
+TEST_CASE("Testing CubicEOS::Equation with built-in and custom alpha functions", "[CubicEOS]")
+{
+    const Vec<CubicEOS::Substance> substances = {
+        CubicEOS::Substance{"CO2", 304.20,  73.83e5, 0.2240},
+        CubicEOS::Substance{"H2O", 647.10, 220.55e5, 0.3450},
+        CubicEOS::Substance{"CH4", 190.60,  45.99e5, 0.0120},
+        CubicEOS::Substance{"H2S", 373.53,  89.63e5, 0.0942},
+    };
+
+    const Vec<CubicEOS::EquationModel> eqmodels = {
+        CubicEOS::EquationModelVanDerWaals(),
+        CubicEOS::EquationModelRedlichKwong(),
+        CubicEOS::EquationModelSoaveRedlichKwong(),
+        CubicEOS::EquationModelPengRobinson76(),
+        CubicEOS::EquationModelPengRobinson78(),
+    };
+
+    const auto bipmodel = GENERATE(false, true);
+
+    ArrayXr x = {{0.70, 0.10, 0.15, 0.05}};
+
+    CubicEOS::Props props1;
+    CubicEOS::Props props2;
+
+    for(auto const& eqmodel : eqmodels)
+    {
+        CHECK( eqmodel.type != CubicEOS::EquationModelType::Custom );
+
+        CubicEOS::EquationSpecs eqspecs1{substances, eqmodel};
+        CubicEOS::EquationSpecs eqspecs2{substances, eqmodel};
+
+        eqspecs2.eqmodel.type = CubicEOS::EquationModelType::Custom; // force the use of EquationModel::alphafn
+
+        if(bipmodel)
+        {
+            eqspecs1.bipmodel = CubicEOS::BipModelPhreeqc({"CO2", "H2O", "CH4", "H2S"});
+            eqspecs2.bipmodel = eqspecs1.bipmodel;
+        }
+
+        CubicEOS::Equation equation1(eqspecs1);
+        CubicEOS::Equation equation2(eqspecs2);
+
+        for(auto T : { 283.15, 333.15, 500.0 })
+        {
+            for(auto P : { 1.0e5, 100.0e5, 300.0e5 })
+            {
+                equation1.compute(props1, T, P, x);
+                equation2.compute(props2, T, P, x);
+
+                CHECK( props1.V     == Approx(props2.V) );
+                CHECK( props1.VT    == Approx(props2.VT) );
+                CHECK( props1.VP    == Approx(props2.VP) );
+                CHECK( props1.Gres  == Approx(props2.Gres) );
+                CHECK( props1.Hres  == Approx(props2.Hres) );
+                CHECK( props1.Cpres == Approx(props2.Cpres) );
+                CHECK( props1.som   == props2.som );
+
+                for(auto i = 0; i < x.size(); ++i)
+                    CHECK( props1.ln_phi[i] == Approx(props2.ln_phi[i]) );
+            }
+        }
+    }
+}
+
 // Temperatures (in °C) from Table 6 of Duan et al (1992)
 const Vec<double> temperatures = { 0, 100, 200, 300, 400, 500, 600, 800, 1000, 1200 };
 
@@ -17,9 +17,8 @@
 
 #include "ClusterConnectivity.hpp"
 
-// C++ includes
+#include <algorithm>
 #include <cassert>
-#include <limits>
 
 namespace Reaktoro {
 
@@ -33,26 +32,32 @@ auto ClusterConnectivity::size() const -> Index
 
 auto ClusterConnectivity::extend() -> void
 {
-    // Extend the priority queue in each row of the connectivity matrix of the clusters
-    for(auto& row : matrix)
-        row.extend();
+    // Append an empty list of observed transitions for the new cluster
+    transitions.emplace_back();
 
     // Extend the priority queue that keeps track the most used clusters
     queue.extend();
+}
 
-    // The ordering of the most used clusters that will be used for the new cluster
-    auto const& order = queue.order();
-
-    // Create priorities for the priority queue of the new cluster
-    Deque<Index> priorities(order.size(), 0);
-
-    // Set the priority of the new cluster (the last one) to infinity,
-    // to ensure it is always the first one to be visited as we
-    // go from cluster to cluster
-    priorities.back() = std::numeric_limits<Index>::infinity();
-
-    // Append the new priority queue for the new cluster
-    matrix.push_back(PriorityQueue::withInitialPrioritiesAndOrder(priorities, order));
+auto ClusterConnectivity::remove(Index icluster) -> void
+{
+    assert(icluster < size());
+
+    // Remove the observed transitions from the removed cluster
+    transitions.erase(transitions.begin() + icluster);
+
+    // Remove the observed transitions to the removed cluster and renumber the clusters after it
+    for(auto& row : transitions)
+    {
+        row.erase(std::remove_if(row.begin(), row.end(),
+            [&](auto const& entry) { return entry.first == icluster; }), row.end());
+        for(auto& entry : row)
+            if(entry.first > icluster)
+                --entry.first;
+    }
+
+    // Remove the removed cluster from the priority queue that keeps track the most used clusters
+    queue.remove(icluster);
 }
 
 auto ClusterConnectivity::increment(Index icluster, Index jcluster) -> void
@@ -62,16 +67,62 @@ auto ClusterConnectivity::increment(Index icluster, Index jcluster) -> void
 
     // Increment jcluster when starting from icluster (if icluster is below number of clusters!)
     if(icluster < size())
-        matrix[icluster].increment(jcluster);
+    {
+        auto& row = transitions[icluster];
+
+        // Find the transition from icluster to jcluster, or register it if not observed before
+        auto k = std::find_if(row.begin(), row.end(), [&](auto const& entry) { return entry.first == jcluster; }) - row.begin();
+        if(k == row.size())
+            row.push_back({ jcluster, 0 });
+
+        row[k].second += 1;
+
+        // Move the incremented transition forward to keep the transitions in descending order of usage count
+        for(; k > 0 && row[k - 1].second < row[k].second; --k)
+            std::swap(row[k - 1], row[k]);
+    }
 
     // Increment usage count of jcluster
     queue.increment(jcluster);
 }
 
-auto ClusterConnectivity::order(Index icluster) const -> Deque<Index> const&
+auto ClusterConnectivity::order(Index icluster) const -> Vec<Index> const&
+{
+    if(icluster >= size())
+        return queue.order();
+
+    mark += 1;
+    marks.resize(size(), 0);
+    ordering.clear();
+
+    auto append = [&](Index jcluster)
+    {
+        if(marks[jcluster] == mark)
+            return;
+        marks[jcluster] = mark;
+        ordering.push_back(jcluster);
+    };
+
+    // The starting cluster is always the first one to be visited
+    append(icluster);
+
+    // Followed by the clusters reached from the starting cluster (most used transitions first)
+    for(auto const& [jcluster, count] : transitions[icluster])
+        append(jcluster);
+
+    // Followed by all remaining clusters (most used clusters first)
+    for(auto jcluster : queue.order())
+        append(jcluster);
+
+    return ordering;
+}
+
+auto ClusterConnectivity::numTransitions() const -> Index
 {
-    return icluster < size() ? matrix[icluster].order() : queue.order();
+    Index count = 0;
+    for(auto const& row : transitions)
+        count += row.size();
+    return count;
 }
 
 } // namespace Reaktoro
-
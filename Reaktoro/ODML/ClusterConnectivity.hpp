@@ -17,13 +17,15 @@
 
 #pragma once
 
-// Reaktoro includes
 #include <Reaktoro/Common/Types.hpp>
 #include <Reaktoro/ODML/PriorityQueue.hpp>
 
 namespace Reaktoro {
 
-// The connectivity matrix of the clusters.
+/// Used to track the transitions between clusters and the order in which clusters are visited.
+/// Only the transitions actually observed from one cluster to another are
+/// stored, so that memory grows with the number of observed transitions
+/// rather than quadratically with the number of clusters.
 class ClusterConnectivity
 {
 public:
@@ -36,6 +38,11 @@ public:
     /// Extend the connectivity matrix following creation of a new cluster.
     auto extend() -> void;
 
+    /// Shrink the connectivity matrix following removal of a cluster.
+    /// The indices of the clusters after the removed one are decremented by one.
+    /// @param icluster The index of the removed cluster.
+    auto remove(Index icluster) -> void;
+
     /// Increment the rank/usage count for the connectivity from one cluster to another.
     /// @param icluster The index of the starting cluster.
     /// @param jcluster The index of the cluster which usage count is incremented.
@@ -46,17 +53,33 @@ public:
     auto increment(Index icluster, Index jcluster) -> void;
 
     /// Return the order of clusters for a given starting cluster.
+    /// The starting cluster comes first, followed by the clusters reached from
+    /// it in descending order of usage count, and then all remaining clusters
+    /// in descending order of their total usage counts.
     /// @param icluster The index of the starting cluster.
     /// @note If index `icluster` is equal or greater than number of clusters,
     /// then an ordering based on usage count of clusters is returned.
-    auto order(Index icluster) const -> Deque<Index> const&;
+    /// @warning The returned reference is invalidated by the next call to this method.
+    auto order(Index icluster) const -> Vec<Index> const&;
+
+    /// Return the number of observed transitions from one cluster to another.
+    auto numTransitions() const -> Index;
 
 private:
-    /// The connectivity of each cluster with others in terms of priority queue for visitation.
-    Deque<PriorityQueue> matrix;
+    /// The observed transitions from each cluster to others as pairs of target cluster index and usage count, in descending order of usage count.
+    Vec<Vec<Pair<Index, Index>>> transitions;
 
     /// The ordering of clusters based on their usage count.
     PriorityQueue queue;
+
+    /// The auxiliary ordering of clusters returned in method @ref order (to avoid memory allocation).
+    mutable Vec<Index> ordering;
+
+    /// The auxiliary marks used to identify clusters already in the ordering above (a cluster is marked if its entry is equal to @ref mark).
+    mutable Vec<Index> marks;
+
+    /// The current mark used to identify clusters already in the ordering above (incremented on every call to @ref order).
+    mutable Index mark = 0;
 };
 
 } // namespace Reaktoro
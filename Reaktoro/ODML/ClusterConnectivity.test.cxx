@@ -0,0 +1,104 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+// Catch includes
+#include <catch2/catch.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/ODML/ClusterConnectivity.hpp>
+using namespace Reaktoro;
+
+TEST_CASE("Testing ClusterConnectivity", "[ClusterConnectivity]")
+{
+    ClusterConnectivity connectivity;
+
+    for(auto i = 0; i < 4; ++i)
+        connectivity.extend();
+
+    CHECK( connectivity.size() == 4 );
+    CHECK( connectivity.numTransitions() == 0 );
+
+    SECTION("Testing the order without observed transitions")
+    {
+        CHECK( connectivity.order(0) == Vec<Index>{0, 1, 2, 3} );
+        CHECK( connectivity.order(2) == Vec<Index>{2, 0, 1, 3} ); // the starting cluster comes first
+        CHECK( connectivity.order(4) == Vec<Index>{0, 1, 2, 3} ); // no starting cluster
+    }
+
+    SECTION("Testing the order after increments")
+    {
+        connectivity.increment(0, 2);
+        connectivity.increment(0, 3);
+        connectivity.increment(0, 3);
+        connectivity.increment(1, 1);
+        connectivity.increment(1, 1);
+        connectivity.increment(1, 1);
+
+        CHECK( connectivity.numTransitions() == 3 );
+
+        // The starting cluster first, then the clusters reached from it (most used transitions first), then the remaining clusters (most used first)
+        CHECK( connectivity.order(0) == Vec<Index>{0, 3, 2, 1} );
+        CHECK( connectivity.order(1) == Vec<Index>{1, 3, 2, 0} );
+        CHECK( connectivity.order(2) == Vec<Index>{2, 1, 3, 0} );
+        CHECK( connectivity.order(3) == Vec<Index>{3, 1, 2, 0} );
+
+        // The order based only on the usage counts of the clusters (1 used 3 times, 3 used 2 times, 2 used once)
+        CHECK( connectivity.order(4) == Vec<Index>{1, 3, 2, 0} );
+
+        // Check transitions without a starting cluster only change the usage counts of the clusters
+        connectivity.increment(4, 0);
+        connectivity.increment(4, 0);
+        connectivity.increment(4, 0);
+        connectivity.increment(4, 0);
+
+        CHECK( connectivity.numTransitions() == 3 );
+        CHECK( connectivity.order(4) == Vec<Index>{0, 1, 3, 2} );
+        CHECK( connectivity.order(2) == Vec<Index>{2, 0, 1, 3} );
+        CHECK( connectivity.order(0) == Vec<Index>{0, 3, 2, 1} );
+    }
+
+    SECTION("Testing remove renumbers the clusters after the removed one")
+    {
+        connectivity.increment(0, 2);
+        connectivity.increment(0, 3);
+        connectivity.increment(0, 3);
+        connectivity.increment(3, 1);
+        connectivity.increment(2, 1);
+
+        CHECK( connectivity.numTransitions() == 4 );
+
+        connectivity.remove(1);
+
+        CHECK( connectivity.size() == 3 );
+        CHECK( connectivity.numTransitions() == 2 ); // the transitions to the removed cluster are also removed
+
+        // Former clusters 2 and 3 are now 1 and 2
+        CHECK( connectivity.order(0) == Vec<Index>{0, 2, 1} );
+        CHECK( connectivity.order(1) == Vec<Index>{1, 2, 0} );
+        CHECK( connectivity.order(2) == Vec<Index>{2, 1, 0} );
+        CHECK( connectivity.order(3) == Vec<Index>{2, 1, 0} );
+
+        // Check the renumbered clusters can be extended and incremented
+        connectivity.extend();
+        connectivity.increment(3, 0);
+        connectivity.increment(3, 0);
+        connectivity.increment(3, 0);
+
+        CHECK( connectivity.order(3) == Vec<Index>{3, 0, 2, 1} );
+        CHECK( connectivity.order(1) == Vec<Index>{1, 0, 2, 3} );
+    }
+}
@@ -17,7 +17,6 @@
 
 #include "PriorityQueue.hpp"
 
-// C++ includes
 #include <algorithm>
 #include <cassert>
 #include <numeric>
@@ -33,29 +32,32 @@ auto PriorityQueue::withInitialSize(Index size) -> PriorityQueue
     queue._priorities.resize(size, 0);
     queue._order.resize(size);
     std::iota(queue._order.begin(), queue._order.end(), 0);
+    queue.updatePositions();
     return queue;
 }
 
-auto PriorityQueue::withInitialPriorities(Deque<Index> const& priorities) -> PriorityQueue
+auto PriorityQueue::withInitialPriorities(Vec<Index> const& priorities) -> PriorityQueue
 {
     const auto size = priorities.size();
     PriorityQueue queue = PriorityQueue::withInitialSize(size);
     queue._priorities = priorities;
-    std::sort(queue._order.begin(), queue._order.end(),
+    std::stable_sort(queue._order.begin(), queue._order.end(),
         [&](Index l, Index r) { return priorities[l] > priorities[r]; });
+    queue.updatePositions();
     return queue;
 }
 
-auto PriorityQueue::withInitialOrder(Deque<Index> const& order) -> PriorityQueue
+auto PriorityQueue::withInitialOrder(Vec<Index> const& order) -> PriorityQueue
 {
     const auto size = order.size();
     PriorityQueue queue;
     queue._priorities.resize(size, 0);
     queue._order = order;
+    queue.updatePositions();
     return queue;
 }
 
-auto PriorityQueue::withInitialPrioritiesAndOrder(Deque<Index> const& priorities, Deque<Index> const& order) -> PriorityQueue
+auto PriorityQueue::withInitialPrioritiesAndOrder(Vec<Index> const& priorities, Vec<Index> const& order) -> PriorityQueue
 {
     assert(priorities.size() == order.size());
     PriorityQueue queue;
@@ -63,6 +65,7 @@ auto PriorityQueue::withInitialPrioritiesAndOrder(Deque<Index> const& priorities
     queue._order = order;
     std::stable_sort(queue._order.begin(), queue._order.end(),
         [&](Index l, Index r) { return priorities[l] > priorities[r]; });
+    queue.updatePositions();
     return queue;
 }
 
@@ -75,52 +78,68 @@ auto PriorityQueue::reset() -> void
 {
     std::fill(_priorities.begin(), _priorities.end(), 0);
     std::iota(_order.begin(), _order.end(), 0);
+    updatePositions();
 }
 
 auto PriorityQueue::increment(Index identity) -> void
 {
+    assert(identity < size());
+
     // == EXAMPLE OF WHAT HAPPENS IN THIS METHOD ==
-    // PRIORITIES BEFORE INCREMENTING: 13  5  3  2  2 (2) 1  --- incrementing from 2 to 3
-    //  PRIORITIES AFTER INCREMENTING: 13  5  3 [2] 2 (3) 1  --- (3) needs to be swapped with [2]
-    //       PRIORITIES AFTER SORTING: 13  5  3 (3) 2 [2] 1
-    _priorities[identity] += 1;
-
-    // == CORNER CASES:
-    // IF identity = 0 (the priority of the very first element is increased)
-    // NO SORTING IS APPLIED (THE CHANGE IN PRIORITIES DIDN'T AFFECT THE ORDER)
-    // PRIORITIES BEFORE INCREMENTING: (13)  5  3  2  2  2  1    --- incrementing from 13 to 14
-    //  PRIORITIES AFTER INCREMENTING: (14)  5  3  2  2  3  1  --- (14) does not need to be swapped with anyone
-
-    // == CORNER CASES:
-    // IF _priorities[identity - 1] >= _priorities[identity]
-    // NO SORTING IS APPLIED (THE CHANGE IN PRIORITIES DIDN'T AFFECT THE ORDER)
-    // PRIORITIES BEFORE INCREMENTING: 13  5 (3)  2  2  2  1    --- incrementing from 3 to 4
-    //  PRIORITIES AFTER INCREMENTING: 13  5 (4)  2  2  3  1  --- (4) is still smaller than 5, it does not need to be swapped with anyone
-
-    // Avoid sorting if the identity == 0 (the priority of the very first element is increased)
-    // or if the increase of priority does not ruin the order in _priorities
-    if(!((identity == 0) || (_priorities[identity - 1] >= _priorities[identity]))){
-        std::sort(_order.begin(), _order.begin() + identity + 1,
-                  [&](Index l, Index r) { return _priorities[l] > _priorities[r]; });
-    }
-    //std::sort(_order.begin(), _order.begin() + identity + 1,
-    //    [&](Index l, Index r) { return _priorities[l] > _priorities[r]; });
+    // PRIORITIES BEFORE INCREMENTING: 13  5  3 [2] 2 (2) 1  --- incrementing from 2 to 3
+    //  PRIORITIES AFTER INCREMENTING: 13  5  3 [2] 2 (3) 1  --- (3) needs to be swapped with [2], the first entity with the old priority 2
+    //       PRIORITIES AFTER SWAPPING: 13  5  3 (3) 2 [2] 1
+    const auto priority = _priorities[identity]++;
+
+    // The current position of the entity in the order
+    const auto pos = _positions[identity];
+
+    // The position of the first entity in the order with the same old priority of the incremented entity
+    const auto first = std::partition_point(_order.begin(), _order.begin() + pos,
+        [&](Index i) { return _priorities[i] > priority; }) - _order.begin();
+
+    // Swap the incremented entity with the first entity of same old priority (no-op if they are the same)
+    const auto other = _order[first];
+    std::swap(_order[first], _order[pos]);
+    std::swap(_positions[identity], _positions[other]);
 }
 
 auto PriorityQueue::extend() -> void
 {
+    _positions.push_back(_order.size());
+    _order.push_back(_priorities.size());
     _priorities.push_back(0);
-    _order.push_back(_order.size());
 }
 
-auto PriorityQueue::priorities() const -> Deque<Index> const&
+auto PriorityQueue::remove(Index identity) -> void
+{
+    assert(identity < size());
+
+    _order.erase(_order.begin() + _positions[identity]);
+    _priorities.erase(_priorities.begin() + identity);
+
+    for(auto& i : _order)
+        if(i > identity)
+            --i;
+
+    updatePositions();
+}
+
+auto PriorityQueue::priorities() const -> Vec<Index> const&
 {
     return _priorities;
 }
 
-auto PriorityQueue::order() const -> Deque<Index> const&
+auto PriorityQueue::order() const -> Vec<Index> const&
 {
     return _order;
 }
 
+auto PriorityQueue::updatePositions() -> void
+{
+    _positions.resize(_order.size());
+    for(auto k = 0; k < _order.size(); ++k)
+        _positions[_order[k]] = k;
+}
+
 } // namespace Reaktoro
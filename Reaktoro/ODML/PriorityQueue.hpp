@@ -17,12 +17,15 @@
 
 #pragma once
 
-// Reaktoro includes
 #include <Reaktoro/Common/Types.hpp>
 
 namespace Reaktoro {
 
-// A queue organized based on priorities that can change dynamically.
+/// Used to track the priorities (usage counts) of entities and their order of visitation.
+/// The priorities and the order of the entities are stored in contiguous arrays.
+/// Incrementing the priority of an entity swaps it with the first entity of
+/// equal priority in the order (found with a binary search), so that no sorting
+/// is ever needed to keep the order consistent with the priorities.
 class PriorityQueue
 {
 public:
@@ -33,15 +36,15 @@ public:
     static auto withInitialSize(Index size) -> PriorityQueue;
 
     /// Return a PriorityQueue instance with given initial priorities.
-    static auto withInitialPriorities(Deque<Index> const& priorities) -> PriorityQueue;
+    static auto withInitialPriorities(Vec<Index> const& priorities) -> PriorityQueue;
 
     /// Return a PriorityQueue instance with an initial order and zero priorities.
-    static auto withInitialOrder(Deque<Index> const& order) -> PriorityQueue;
+    static auto withInitialOrder(Vec<Index> const& order) -> PriorityQueue;
 
     /// Return a PriorityQueue instance with given initial priorities and order.
     /// @note A stable sort algorithm is applied to ensure consistency between
     /// given order and priorities.
-    static auto withInitialPrioritiesAndOrder(Deque<Index> const& priorities, Deque<Index> const& order) -> PriorityQueue;
+    static auto withInitialPrioritiesAndOrder(Vec<Index> const& priorities, Vec<Index> const& order) -> PriorityQueue;
 
     /// Return the size of the priority queue.
     auto size() const -> Index;
@@ -56,18 +59,29 @@ public:
     /// Extend the queue with the introduction of a new tracked entity.
     auto extend() -> void;
 
+    /// Remove a tracked entity from the queue.
+    /// The indices of the tracked entities after the removed one are decremented by one.
+    /// @param identity The index of the tracked entity.
+    auto remove(Index identity) -> void;
+
     /// Return the current priorities of each tracked entity in the queue.
-    auto priorities() const -> Deque<Index> const&;
+    auto priorities() const -> Vec<Index> const&;
 
     /// Return the current order of the tracked entities in the queue.
-    auto order() const -> Deque<Index> const&;
+    auto order() const -> Vec<Index> const&;
 
 private:
     /// The priorities/usage count of each tracked entity in the priority queue.
-    Deque<Index> _priorities;
+    Vec<Index> _priorities;
 
     /// The order of the tracked entities based on their current priorities.
-    Deque<Index> _order;
+    Vec<Index> _order;
+
+    /// The position of each tracked entity in the order of the priority queue.
+    Vec<Index> _positions;
+
+    /// Update the positions of the tracked entities after a change in their order.
+    auto updatePositions() -> void;
 };
 
 } // namespace Reaktoro
@@ -0,0 +1,137 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+// Catch includes
+#include <catch2/catch.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/ODML/PriorityQueue.hpp>
+using namespace Reaktoro;
+
+TEST_CASE("Testing PriorityQueue", "[PriorityQueue]")
+{
+    SECTION("Testing construction with initial size")
+    {
+        auto queue = PriorityQueue::withInitialSize(4);
+
+        CHECK( queue.size() == 4 );
+        CHECK( queue.priorities() == Vec<Index>{0, 0, 0, 0} );
+        CHECK( queue.order() == Vec<Index>{0, 1, 2, 3} );
+    }
+
+    SECTION("Testing construction with initial priorities")
+    {
+        auto queue = PriorityQueue::withInitialPriorities({1, 3, 1, 2});
+
+        CHECK( queue.priorities() == Vec<Index>{1, 3, 1, 2} );
+        CHECK( queue.order() == Vec<Index>{1, 3, 0, 2} ); // entities with equal priorities keep their relative order
+    }
+
+    SECTION("Testing construction with initial priorities and order")
+    {
+        auto queue = PriorityQueue::withInitialPrioritiesAndOrder({1, 3, 1, 2}, {2, 1, 0, 3});
+
+        CHECK( queue.order() == Vec<Index>{1, 3, 2, 0} ); // entities 2 and 0 have equal priorities and keep their given relative order
+    }
+
+    SECTION("Testing the order is consistent with the priorities after increments")
+    {
+        auto queue = PriorityQueue::withInitialSize(5);
+
+        queue.increment(3);
+
+        CHECK( queue.priorities() == Vec<Index>{0, 0, 0, 1, 0} );
+        CHECK( queue.order() == Vec<Index>{3, 1, 2, 0, 4} ); // entity 3 is swapped with entity 0, the first one with the old priority 0
+
+        queue.increment(4);
+
+        CHECK( queue.order() == Vec<Index>{3, 4, 2, 0, 1} ); // entity 4 is swapped with entity 1, the first one with the old priority 0
+
+        queue.increment(4);
+
+        CHECK( queue.order() == Vec<Index>{4, 3, 2, 0, 1} ); // entity 4 is swapped with entity 3, the first one with the old priority 1
+
+        queue.increment(4);
+        queue.increment(0);
+        queue.increment(0);
+
+        CHECK( queue.priorities() == Vec<Index>{2, 0, 0, 1, 3} );
+        CHECK( queue.order() == Vec<Index>{4, 0, 3, 2, 1} );
+
+        // Check the order is sorted by priorities in descending order
+        auto const& priorities = queue.priorities();
+        auto const& order = queue.order();
+        for(auto k = 1; k < order.size(); ++k)
+            CHECK( priorities[order[k - 1]] >= priorities[order[k]] );
+    }
+
+    SECTION("Testing extend")
+    {
+        auto queue = PriorityQueue::withInitialSize(2);
+
+        queue.increment(1);
+        queue.extend();
+
+        CHECK( queue.size() == 3 );
+        CHECK( queue.priorities() == Vec<Index>{0, 1, 0} );
+        CHECK( queue.order() == Vec<Index>{1, 0, 2} );
+
+        queue.increment(2);
+        queue.increment(2);
+
+        CHECK( queue.order() == Vec<Index>{2, 1, 0} );
+    }
+
+    SECTION("Testing remove renumbers the entities after the removed one")
+    {
+        auto queue = PriorityQueue::withInitialPriorities({4, 1, 3, 2});
+
+        CHECK( queue.order() == Vec<Index>{0, 2, 3, 1} );
+
+        queue.remove(1);
+
+        CHECK( queue.size() == 3 );
+        CHECK( queue.priorities() == Vec<Index>{4, 3, 2} );
+        CHECK( queue.order() == Vec<Index>{0, 1, 2} ); // former entities 2 and 3 are now 1 and 2
+
+        queue.remove(0);
+
+        CHECK( queue.priorities() == Vec<Index>{3, 2} );
+        CHECK( queue.order() == Vec<Index>{0, 1} );
+
+        // Check increments still work after the removals (positions of the entities were updated)
+        queue.increment(1);
+        queue.increment(1);
+
+        CHECK( queue.priorities() == Vec<Index>{3, 4} );
+        CHECK( queue.order() == Vec<Index>{1, 0} );
+    }
+
+    SECTION("Testing reset")
+    {
+        auto queue = PriorityQueue::withInitialPriorities({1, 3, 2});
+
+        queue.reset();
+
+        CHECK( queue.priorities() == Vec<Index>{0, 0, 0} );
+        CHECK( queue.order() == Vec<Index>{0, 1, 2} );
+
+        queue.increment(2);
+
+        CHECK( queue.order() == Vec<Index>{2, 1, 0} );
+    }
+}
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <Reaktoro/Serialization/Checkpoint.hpp>
 #include <Reaktoro/Serialization/Common.hpp>
 #include <Reaktoro/Serialization/Core.hpp>
 #include <Reaktoro/Serialization/Models.hpp>
@@ -18,12 +18,14 @@
 // pybind11 includes
 #include <Reaktoro/pybind11.hxx>
 
+void exportSerializationCheckpoint(py::module& m);
 void exportSerializationCommon(py::module& m);
 void exportSerializationCore(py::module& m);
 void exportSerializationModels(py::module& m);
 
 void exportSerialization(py::module& m)
 {
+    exportSerializationCheckpoint(m);
     exportSerializationCommon(m);
     exportSerializationCore(m);
     exportSerializationModels(m);
@@ -0,0 +1,469 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "Checkpoint.hpp"
+
+// C++ includes
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+// Optima includes
+#include <Optima/State.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Common/ArrayStream.hpp>
+#include <Reaktoro/Common/Exception.hpp>
+#include <Reaktoro/Core/ChemicalProps.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+
+namespace Reaktoro {
+namespace {
+
+/// The identifier at the beginning of binary checkpoint files of chemical states.
+const String checkpointIdentifier = "RKTSTATE";
+
+/// The identifier at the end of binary checkpoint files of chemical states that have been properly closed.
+const String checkpointIndexIdentifier = "RKTINDEX";
+
+/// The version of the format of binary checkpoint files of chemical states.
+const std::uint64_t checkpointVersion = 1;
+
+/// The size of the header of binary checkpoint files (identifier, version, fingerprint, number of species and elements).
+const std::uint64_t checkpointHeaderSize = 40;
+
+/// The size of the footer of closed binary checkpoint files (number of records, position of their index, and identifier).
+const std::uint64_t checkpointFooterSize = 24;
+
+/// The bit in the flags of a record indicating it contains warm-start data of an equilibrium calculation.
+const std::uint64_t recordHasEquilibrium = 1;
+
+/// The bit in the flags of a record indicating it contains chemical properties.
+const std::uint64_t recordHasProps = 2;
+
+/// The type of arrays of indices in a binary stream, with 64-bit integers on all platforms.
+using ArrayXi64 = Eigen::Array<std::int64_t, Eigen::Dynamic, 1>;
+
+/// Write an unsigned 64-bit integer to a binary stream.
+auto writeUInt64(std::ostream& out, std::uint64_t value) -> void
+{
+    out.write(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+/// Read an unsigned 64-bit integer from a binary stream.
+auto readUInt64(std::istream& in) -> std::uint64_t
+{
+    std::uint64_t value = 0;
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+}
+
+/// Write a double value to a binary stream.
+auto writeDouble(std::ostream& out, double value) -> void
+{
+    out.write(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+/// Read a double value from a binary stream.
+auto readDouble(std::istream& in) -> double
+{
+    double value = 0.0;
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+}
+
+/// Write an array of values of type `Binary` prefixed by its length to a binary stream.
+template<typename Binary, typename Array>
+auto writeArray(std::ostream& out, Array const& array) -> void
+{
+    writeUInt64(out, array.size());
+    for(auto i = 0; i < array.size(); ++i)
+    {
+        const auto value = static_cast<Binary>(array[i]);
+        out.write(reinterpret_cast<char const*>(&value), sizeof(value));
+    }
+}
+
+/// Read an array of values of type `Binary` prefixed by its length from a binary stream.
+template<typename Array>
+auto readArray(std::istream& in) -> Array
+{
+    using Binary = typename Array::Scalar;
+    Array array(readUInt64(in));
+    in.read(reinterpret_cast<char*>(array.data()), array.size() * sizeof(Binary));
+    return array;
+}
+
+/// Write strings prefixed by their number to a binary stream, padded to a multiple of 8 bytes.
+auto writeStrings(std::ostream& out, Strings const& strs) -> void
+{
+    writeUInt64(out, strs.size());
+    Index size = 0;
+    for(auto const& str : strs)
+    {
+        writeUInt64(out, str.size());
+        out.write(str.data(), str.size());
+        size += str.size();
+    }
+    const char zeros[8] = {};
+    out.write(zeros, (8 - size % 8) % 8);
+}
+
+/// Read strings prefixed by their number from a binary stream, padded to a multiple of 8 bytes.
+auto readStrings(std::istream& in) -> Strings
+{
+    Strings strs(readUInt64(in));
+    Index size = 0;
+    for(auto& str : strs)
+    {
+        str.resize(readUInt64(in));
+        in.read(str.data(), str.size());
+        size += str.size();
+    }
+    in.ignore((8 - size % 8) % 8);
+    return strs;
+}
+
+/// Return a fingerprint of the species in a chemical system, used to check that a checkpoint file corresponds to it.
+/// This is the 64-bit FNV-1a hash of the names of the species, which is identical on all platforms.
+auto fingerprint(ChemicalSystem const& system) -> std::uint64_t
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for(auto const& species : system.species())
+    {
+        for(auto const ch : species.name() + ";")
+        {
+            hash ^= static_cast<unsigned char>(ch);
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+/// Write a chemical state as a record (without its size prefix) to a binary stream.
+auto writeChemicalState(std::ostream& out, ChemicalState const& state, CheckpointOptions const& options) -> void
+{
+    auto const& equilibrium = state.equilibrium();
+
+    const auto hasequilibrium = options.equilibrium && !equilibrium.empty();
+
+    writeUInt64(out, (hasequilibrium ? recordHasEquilibrium : 0) | (options.props ? recordHasProps : 0));
+    writeDouble(out, double(state.temperature()));
+    writeDouble(out, double(state.pressure()));
+    writeArray<double>(out, state.speciesAmounts());
+
+    if(hasequilibrium)
+    {
+        auto const& optstate = equilibrium.optimaState();
+        writeStrings(out, equilibrium.namesInputVariables());
+        writeStrings(out, equilibrium.namesControlVariablesP());
+        writeStrings(out, equilibrium.namesControlVariablesQ());
+        writeArray<double>(out, equilibrium.inputVariables());
+        writeArray<double>(out, equilibrium.initialComponentAmounts());
+        writeUInt64(out, optstate.dims.x);
+        writeUInt64(out, optstate.dims.p);
+        writeUInt64(out, optstate.dims.be);
+        writeUInt64(out, optstate.dims.c);
+        writeArray<double>(out, optstate.x);
+        writeArray<double>(out, optstate.p);
+        writeArray<double>(out, optstate.ye);
+        writeArray<double>(out, optstate.s);
+        writeArray<std::int64_t>(out, optstate.jb);
+        writeArray<std::int64_t>(out, optstate.jn);
+    }
+
+    if(options.props)
+    {
+        ArrayStream<double> stream;
+        state.props().serialize(stream);
+        writeArray<double>(out, stream.data());
+    }
+}
+
+/// Read a chemical state from a record (without its size prefix) in a binary stream.
+auto readChemicalState(std::istream& in, ChemicalState& state) -> void
+{
+    const auto flags = readUInt64(in);
+    const auto T = readDouble(in);
+    const auto P = readDouble(in);
+    const auto n = readArray<ArrayXd>(in);
+
+    errorif(n.size() != state.system().species().size(), "Expecting ", state.system().species().size(), " species amounts in a record of the checkpoint file, but got ", n.size(), ".");
+
+    state.setTemperature(T);
+    state.setPressure(P);
+    state.setSpeciesAmounts(n);
+
+    auto& equilibrium = state.equilibrium();
+
+    equilibrium.reset();
+
+    if(flags & recordHasEquilibrium)
+    {
+        equilibrium.setNamesInputVariables(readStrings(in));
+        equilibrium.setNamesControlVariablesP(readStrings(in));
+        equilibrium.setNamesControlVariablesQ(readStrings(in));
+        equilibrium.setInputVariables(readArray<ArrayXd>(in));
+        equilibrium.setInitialComponentAmounts(readArray<ArrayXd>(in));
+
+        // Only these dimensions are set in the Optima::State objects of equilibrium calculations (see EquilibriumSolver)
+        Optima::Dims dims;
+        dims.x  = readUInt64(in);
+        dims.p  = readUInt64(in);
+        dims.be = readUInt64(in);
+        dims.c  = readUInt64(in);
+
+        Optima::State optstate(dims);
+        optstate.x = readArray<VectorXd>(in);
+        optstate.p = readArray<VectorXd>(in);
+        optstate.ye = readArray<VectorXd>(in);
+        optstate.s = readArray<VectorXd>(in);
+        optstate.jb = readArray<ArrayXi64>(in).cast<Optima::Index>();
+        optstate.jn = readArray<ArrayXi64>(in).cast<Optima::Index>();
+
+        equilibrium.setOptimaState(optstate);
+    }
+
+    if(flags & recordHasProps)
+        state.props().update(readArray<ArrayXd>(in));
+}
+
+} // namespace
+
+struct CheckpointWriter::Impl
+{
+    /// The fingerprint of the species in the chemical system.
+    const std::uint64_t sysfingerprint;
+
+    /// The number of species in the chemical system.
+    const Index numspecies;
+
+    /// The options for writing the chemical states.
+    const CheckpointOptions options;
+
+    /// The checkpoint file.
+    std::ofstream file;
+
+    /// The positions of the records of the chemical states written so far.
+    Vec<std::uint64_t> offsets;
+
+    /// The buffer in which a record is assembled before it is written to the checkpoint file.
+    std::ostringstream record;
+
+    Impl(ChemicalSystem const& system, String const& filepath, CheckpointOptions const& options)
+    : sysfingerprint(fingerprint(system)), numspecies(system.species().size()), options(options)
+    {
+        file.open(filepath, std::ios::binary | std::ios::trunc);
+        errorif(!file.is_open(), "Could not create the checkpoint file `", filepath, "`.");
+
+        file.write(checkpointIdentifier.data(), checkpointIdentifier.size());
+        writeUInt64(file, checkpointVersion);
+        writeUInt64(file, sysfingerprint);
+        writeUInt64(file, system.species().size());
+        writeUInt64(file, system.elements().size());
+    }
+
+    ~Impl()
+    {
+        close();
+    }
+
+    auto write(ChemicalState const& state) -> void
+    {
+        errorif(!file.is_open(), "Cannot write a chemical state to a checkpoint file that has been closed.");
+        errorif(state.system().species().size() != numspecies || fingerprint(state.system()) != sysfingerprint,
+            "Cannot write a chemical state to a checkpoint file of a chemical system with different species.");
+
+        record.str("");
+        writeChemicalState(record, state, options);
+        const auto data = record.str();
+
+        offsets.push_back(file.tellp());
+        writeUInt64(file, data.size());
+        file.write(data.data(), data.size());
+    }
+
+    auto close() -> void
+    {
+        if(!file.is_open())
+            return;
+
+        const std::uint64_t indexoffset = file.tellp();
+        for(auto const& offset : offsets)
+            writeUInt64(file, offset);
+
+        writeUInt64(file, offsets.size());
+        writeUInt64(file, indexoffset);
+        file.write(checkpointIndexIdentifier.data(), checkpointIndexIdentifier.size());
+        file.close();
+    }
+};
+
+CheckpointWriter::CheckpointWriter(ChemicalSystem const& system, String const& filepath, CheckpointOptions const& options)
+: pimpl(new Impl(system, filepath, options))
+{}
+
+CheckpointWriter::~CheckpointWriter()
+{}
+
+auto CheckpointWriter::write(ChemicalState const& state) -> void
+{
+    pimpl->write(state);
+}
+
+auto CheckpointWriter::write(Vec<ChemicalState> const& states) -> void
+{
+    for(auto const& state : states)
+        pimpl->write(state);
+}
+
+auto CheckpointWriter::size() const -> Index
+{
+    return pimpl->offsets.size();
+}
+
+auto CheckpointWriter::close() -> void
+{
+    pimpl->close();
+}
+
+struct CheckpointReader::Impl
+{
+    /// The chemical system of the chemical states in the checkpoint file.
+    const ChemicalSystem system;
+
+    /// The checkpoint file.
+    std::ifstream file;
+
+    /// The positions of the records of the chemical states in the checkpoint file.
+    Vec<std::uint64_t> offsets;
+
+    Impl(ChemicalSystem const& system, String const& filepath)
+    : system(system)
+    {
+        file.open(filepath, std::ios::binary);
+        errorif(!file.is_open(), "Could not open the checkpoint file `", filepath, "`.");
+
+        String identifier(checkpointIdentifier.size(), '\0');
+        file.read(identifier.data(), identifier.size());
+        errorif(identifier != checkpointIdentifier, "The file `", filepath, "` is not a checkpoint file of chemical states.");
+
+        const auto version = readUInt64(file);
+        errorif(version > checkpointVersion, "The checkpoint file `", filepath, "` has version ", version, " of the format, but only versions up to ", checkpointVersion, " are supported.");
+
+        const auto sysfingerprint = readUInt64(file);
+        const auto numspecies = readUInt64(file);
+        readUInt64(file); // the number of elements, which is implied by the species
+
+        errorif(numspecies != system.species().size() || sysfingerprint != fingerprint(system),
+            "The chemical states in the checkpoint file `", filepath, "` are not of the given chemical system, "
+            "which has different species.");
+
+        file.seekg(0, std::ios::end);
+        const std::uint64_t filesize = file.tellg();
+
+        // Read the index of the records at the end of the file, if the file was properly closed
+        if(filesize >= checkpointHeaderSize + checkpointFooterSize)
+        {
+            file.seekg(filesize - checkpointFooterSize);
+            const auto count = readUInt64(file);
+            const auto indexoffset = readUInt64(file);
+            String footer(checkpointIndexIdentifier.size(), '\0');
+            file.read(footer.data(), footer.size());
+            if(footer == checkpointIndexIdentifier && indexoffset + count * sizeof(std::uint64_t) + checkpointFooterSize == filesize)
+            {
+                offsets.resize(count);
+                file.seekg(indexoffset);
+                file.read(reinterpret_cast<char*>(offsets.data()), count * sizeof(std::uint64_t));
+                return;
+            }
+        }
+
+        // Otherwise, locate the complete records from their sizes, in a single pass through the file
+        file.clear();
+        std::uint64_t offset = checkpointHeaderSize;
+        while(offset + sizeof(std::uint64_t) <= filesize)
+        {
+            file.seekg(offset);
+            const auto size = readUInt64(file);
+            if(offset + sizeof(std::uint64_t) + size > filesize)
+                break; // the last record is incomplete
+            offsets.push_back(offset);
+            offset += sizeof(std::uint64_t) + size;
+        }
+    }
+
+    auto read(Index i, ChemicalState& state) -> void
+    {
+        errorif(i >= offsets.size(), "Cannot read the chemical state with index ", i, " from a checkpoint file with ", offsets.size(), " chemical states.");
+        file.clear();
+        file.seekg(offsets[i] + sizeof(std::uint64_t));
+        readChemicalState(file, state);
+        errorif(!file, "Could not read the chemical state with index ", i, " from the checkpoint file, which seems to be corrupted.");
+    }
+};
+
+CheckpointReader::CheckpointReader(ChemicalSystem const& system, String const& filepath)
+: pimpl(new Impl(system, filepath))
+{}
+
+CheckpointReader::~CheckpointReader()
+{}
+
+auto CheckpointReader::size() const -> Index
+{
+    return pimpl->offsets.size();
+}
+
+auto CheckpointReader::read(Index i, ChemicalState& state) -> void
+{
+    pimpl->read(i, state);
+}
+
+auto CheckpointReader::read(Index i) -> ChemicalState
+{
+    ChemicalState state(pimpl->system);
+    pimpl->read(i, state);
+    return state;
+}
+
+auto CheckpointReader::read(Index begin, Index end) -> Vec<ChemicalState>
+{
+    errorif(begin > end || end > size(), "Cannot read the chemical states with indices in [", begin, ", ", end, ") from a checkpoint file with ", size(), " chemical states.");
+    Vec<ChemicalState> states(end - begin, ChemicalState(pimpl->system));
+    for(auto i = begin; i < end; ++i)
+        pimpl->read(i, states[i - begin]);
+    return states;
+}
+
+auto saveCheckpoint(String const& filepath, Vec<ChemicalState> const& states, CheckpointOptions const& options) -> void
+{
+    errorif(states.empty(), "Cannot save an empty collection of chemical states to the checkpoint file `", filepath, "`.");
+    CheckpointWriter writer(states.front().system(), filepath, options);
+    writer.write(states);
+    writer.close();
+}
+
+auto loadCheckpoint(String const& filepath, ChemicalSystem const& system) -> Vec<ChemicalState>
+{
+    CheckpointReader reader(system, filepath);
+    return reader.read(0, reader.size());
+}
+
+} // namespace Reaktoro
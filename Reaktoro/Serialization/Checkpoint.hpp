@@ -0,0 +1,122 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+// Reaktoro includes
+#include <Reaktoro/Common/Types.hpp>
+
+namespace Reaktoro {
+
+// Forward declarations
+class ChemicalState;
+class ChemicalSystem;
+
+/// The options for writing chemical states to a binary checkpoint file.
+struct CheckpointOptions
+{
+    /// The boolean flag that indicates if the warm-start data of the last equilibrium calculation of each state should be written.
+    /// This data permits an equilibrium calculation resumed from a restored chemical state to converge as quickly as if it had never been interrupted.
+    bool equilibrium = true;
+
+    /// The boolean flag that indicates if the chemical properties of each state should be written.
+    /// These permit the chemical properties of restored chemical states to be used without their reevaluation,
+    /// at the expense of a checkpoint file that is many times larger.
+    bool props = false;
+};
+
+/// Used to write chemical states to a binary checkpoint file, one at a time.
+/// Each chemical state is written as a record once given, so that large
+/// collections of chemical states (e.g., those of all cells in a reactive
+/// transport simulation) never need to be assembled in memory. An index of
+/// the positions of the records is written to the end of the file when the
+/// writer is closed, which permits individual records to be read later in
+/// any order using CheckpointReader. The file starts with an identifier, the
+/// version of the format and a fingerprint of the species in the chemical
+/// system, and all data in it is aligned to 8 bytes.
+class CheckpointWriter
+{
+public:
+    /// Construct a CheckpointWriter object that creates a checkpoint file for chemical states of a chemical system.
+    /// @param system The chemical system of the chemical states to be written.
+    /// @param filepath The path to the checkpoint file (overwritten if it exists).
+    /// @param options The options for writing the chemical states.
+    CheckpointWriter(ChemicalSystem const& system, String const& filepath, CheckpointOptions const& options = {});
+
+    /// Destroy this CheckpointWriter object, closing its checkpoint file.
+    ~CheckpointWriter();
+
+    /// Write a chemical state to the checkpoint file.
+    auto write(ChemicalState const& state) -> void;
+
+    /// Write chemical states to the checkpoint file.
+    auto write(Vec<ChemicalState> const& states) -> void;
+
+    /// Return the number of chemical states written so far.
+    auto size() const -> Index;
+
+    /// Close the checkpoint file, writing the index of its records.
+    auto close() -> void;
+
+private:
+    struct Impl;
+
+    Ptr<Impl> pimpl;
+};
+
+/// Used to read chemical states from a binary checkpoint file written by CheckpointWriter.
+/// Only the records of the chemical states that are requested are read, so that
+/// a subset of the chemical states can be restored without reading the whole file.
+/// Checkpoint files that have not been properly closed (e.g., because a simulation
+/// was interrupted) can also be read, with their records located in a single pass.
+class CheckpointReader
+{
+public:
+    /// Construct a CheckpointReader object that opens a checkpoint file for chemical states of a chemical system.
+    /// @param system The chemical system of the chemical states in the checkpoint file.
+    /// @param filepath The path to the checkpoint file.
+    CheckpointReader(ChemicalSystem const& system, String const& filepath);
+
+    /// Destroy this CheckpointReader object.
+    ~CheckpointReader();
+
+    /// Return the number of chemical states in the checkpoint file.
+    auto size() const -> Index;
+
+    /// Read the chemical state with given index in the checkpoint file into an existing chemical state.
+    auto read(Index i, ChemicalState& state) -> void;
+
+    /// Read the chemical state with given index in the checkpoint file.
+    auto read(Index i) -> ChemicalState;
+
+    /// Read the chemical states in the range [begin, end) of indices in the checkpoint file.
+    auto read(Index begin, Index end) -> Vec<ChemicalState>;
+
+private:
+    struct Impl;
+
+    Ptr<Impl> pimpl;
+};
+
+/// Save chemical states to a binary checkpoint file (see CheckpointWriter).
+auto saveCheckpoint(String const& filepath, Vec<ChemicalState> const& states, CheckpointOptions const& options = {}) -> void;
+
+/// Load all chemical states in a binary checkpoint file (see CheckpointReader).
+auto loadCheckpoint(String const& filepath, ChemicalSystem const& system) -> Vec<ChemicalState>;
+
+} // namespace Reaktoro
@@ -0,0 +1,55 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// pybind11 includes
+#include <Reaktoro/pybind11.hxx>
+
+// Reaktoro includes
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+#include <Reaktoro/Serialization/Checkpoint.hpp>
+using namespace Reaktoro;
+
+void exportSerializationCheckpoint(py::module& m)
+{
+    py::class_<CheckpointOptions>(m, "CheckpointOptions")
+        .def(py::init<>())
+        .def_readwrite("equilibrium", &CheckpointOptions::equilibrium)
+        .def_readwrite("props", &CheckpointOptions::props)
+        ;
+
+    py::class_<CheckpointWriter>(m, "CheckpointWriter")
+        .def(py::init<ChemicalSystem const&, String const&>())
+        .def(py::init<ChemicalSystem const&, String const&, CheckpointOptions const&>())
+        .def("write", py::overload_cast<ChemicalState const&>(&CheckpointWriter::write), "Write a chemical state to the checkpoint file.")
+        .def("write", py::overload_cast<Vec<ChemicalState> const&>(&CheckpointWriter::write), "Write chemical states to the checkpoint file.")
+        .def("size", &CheckpointWriter::size, "Return the number of chemical states written so far.")
+        .def("close", &CheckpointWriter::close, "Close the checkpoint file, writing the index of its records.")
+        ;
+
+    py::class_<CheckpointReader>(m, "CheckpointReader")
+        .def(py::init<ChemicalSystem const&, String const&>())
+        .def("size", &CheckpointReader::size, "Return the number of chemical states in the checkpoint file.")
+        .def("read", py::overload_cast<Index, ChemicalState&>(&CheckpointReader::read), "Read the chemical state with given index in the checkpoint file into an existing chemical state.")
+        .def("read", py::overload_cast<Index>(&CheckpointReader::read), "Read the chemical state with given index in the checkpoint file.")
+        .def("read", py::overload_cast<Index, Index>(&CheckpointReader::read), "Read the chemical states in the range [begin, end) of indices in the checkpoint file.")
+        ;
+
+    m.def("saveCheckpoint", saveCheckpoint, "Save chemical states to a binary checkpoint file.", py::arg("filepath"), py::arg("states"), py::arg("options") = CheckpointOptions{});
+    m.def("loadCheckpoint", loadCheckpoint, "Load all chemical states in a binary checkpoint file.");
+}
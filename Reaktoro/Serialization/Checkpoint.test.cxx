@@ -0,0 +1,174 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// C++ includes
+#include <filesystem>
+
+// Catch includes
+#include <catch2/catch.hpp>
+
+// Reaktoro includes
+#include <Reaktoro/Core/ChemicalProps.hpp>
+#include <Reaktoro/Core/ChemicalState.hpp>
+#include <Reaktoro/Core/ChemicalSystem.hpp>
+#include <Reaktoro/Core/Phases.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumResult.hpp>
+#include <Reaktoro/Equilibrium/EquilibriumSolver.hpp>
+#include <Reaktoro/Extensions/Supcrt/SupcrtDatabase.hpp>
+#include <Reaktoro/Serialization/Checkpoint.hpp>
+using namespace Reaktoro;
+
+TEST_CASE("Testing binary checkpoint files of chemical states", "[Serialization][Checkpoint]")
+{
+    SupcrtDatabase db("supcrtbl");
+
+    ChemicalSystem system(db, AqueousPhase(speciate("Na Cl C")), GaseousPhase("CO2(g) H2O(g)"));
+
+    EquilibriumSolver solver(system);
+
+    Vec<ChemicalState> states;
+
+    for(auto i = 0; i < 5; ++i)
+    {
+        ChemicalState state(system);
+        state.temperature(25.0 + 10.0 * i, "celsius");
+        state.pressure(1.0 + 10.0 * i, "bar");
+        state.set("H2O(aq)", 1.0, "kg");
+        state.set("Na+", 0.1 * (i + 1), "mol");
+        state.set("Cl-", 0.1 * (i + 1), "mol");
+        state.set("CO2(g)", 1.0, "mol");
+
+        REQUIRE( solver.solve(state).succeeded() );
+
+        states.push_back(state);
+    }
+
+    const auto filepath = (std::filesystem::temp_directory_path() / "reaktoro-checkpoint-test.rkt").string();
+
+    /// Check a restored chemical state is identical to the original one.
+    auto checkRestoredState = [](ChemicalState const& restored, ChemicalState const& original)
+    {
+        CHECK( restored.temperature() == original.temperature() );
+        CHECK( restored.pressure() == original.pressure() );
+        CHECK( (restored.speciesAmounts() == original.speciesAmounts()).all() );
+
+        auto const& req = restored.equilibrium();
+        auto const& oeq = original.equilibrium();
+
+        CHECK( req.namesInputVariables() == oeq.namesInputVariables() );
+        CHECK( req.namesControlVariablesP() == oeq.namesControlVariablesP() );
+        CHECK( req.namesControlVariablesQ() == oeq.namesControlVariablesQ() );
+        CHECK( (req.inputVariables() == oeq.inputVariables()).all() );
+        CHECK( (req.initialComponentAmounts() == oeq.initialComponentAmounts()).all() );
+        CHECK( (req.elementChemicalPotentials() == oeq.elementChemicalPotentials()).all() );
+        CHECK( (req.speciesStabilities() == oeq.speciesStabilities()).all() );
+        CHECK( (req.indicesPrimarySpecies() == oeq.indicesPrimarySpecies()).all() );
+        CHECK( (req.controlVariablesP() == oeq.controlVariablesP()).all() );
+    };
+
+    SECTION("When chemical states are saved and loaded all at once")
+    {
+        saveCheckpoint(filepath, states);
+
+        const auto restored = loadCheckpoint(filepath, system);
+
+        REQUIRE( restored.size() == states.size() );
+
+        for(auto i = 0; i < states.size(); ++i)
+            checkRestoredState(restored[i], states[i]);
+    }
+
+    SECTION("When chemical states are streamed with their properties and read in any order")
+    {
+        CheckpointOptions options;
+        options.props = true;
+
+        CheckpointWriter writer(system, filepath, options);
+        for(auto const& state : states)
+            writer.write(state);
+        writer.close();
+
+        CHECK( writer.size() == states.size() );
+
+        CheckpointReader reader(system, filepath);
+
+        CHECK( reader.size() == states.size() );
+
+        checkRestoredState(reader.read(3), states[3]);
+        checkRestoredState(reader.read(1), states[1]);
+
+        const auto subset = reader.read(2, 4);
+
+        REQUIRE( subset.size() == 2 );
+        checkRestoredState(subset[0], states[2]);
+        checkRestoredState(subset[1], states[3]);
+
+        // The chemical properties are restored without being evaluated again
+        CHECK( (subset[0].props().speciesActivitiesLn() == states[2].props().speciesActivitiesLn()).all() );
+        CHECK( subset[0].props().volume() == states[2].props().volume() );
+
+        CHECK_THROWS( reader.read(5) );
+        CHECK_THROWS( reader.read(4, 6) );
+    }
+
+    SECTION("When restored chemical states are used to warm start equilibrium calculations")
+    {
+        saveCheckpoint(filepath, states);
+
+        auto original = states[2];
+        auto restored = CheckpointReader(system, filepath).read(2);
+
+        original.temperature(original.temperature() + 1.0);
+        restored.temperature(restored.temperature() + 1.0);
+
+        const auto roriginal = EquilibriumSolver(system).solve(original);
+        const auto rrestored = EquilibriumSolver(system).solve(restored);
+
+        CHECK( rrestored.succeeded() );
+        CHECK( rrestored.iterations() == roriginal.iterations() );
+        CHECK( (restored.speciesAmounts() == original.speciesAmounts()).all() );
+    }
+
+    SECTION("When the checkpoint file was not closed because the simulation was interrupted")
+    {
+        saveCheckpoint(filepath, states);
+
+        // Remove the index at the end of the file and part of the last record
+        const auto filesize = std::filesystem::file_size(filepath);
+        std::filesystem::resize_file(filepath, filesize - 24 - 8 * states.size() - 16);
+
+        CheckpointReader reader(system, filepath);
+
+        REQUIRE( reader.size() == states.size() - 1 );
+
+        for(auto i = 0; i < reader.size(); ++i)
+            checkRestoredState(reader.read(i), states[i]);
+    }
+
+    SECTION("When the checkpoint file does not correspond to the chemical system")
+    {
+        saveCheckpoint(filepath, states);
+
+        ChemicalSystem other(db, AqueousPhase(speciate("Na Cl C Ca")));
+
+        CHECK_THROWS( CheckpointReader(other, filepath) );
+        CHECK_THROWS( CheckpointWriter(system, filepath).write(ChemicalState(other)) );
+    }
+
+    std::filesystem::remove(filepath);
+}
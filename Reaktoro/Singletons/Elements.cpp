@@ -153,7 +153,10 @@ const Vec<Element> default_elements =
 
 Elements::Elements()
 : m_elements(detail::default_elements)
-{}
+{
+    for(auto i = 0; i < m_elements.size(); ++i)
+        m_symbols.emplace(m_elements[i].symbol(), i);
+}
 
 Elements::~Elements()
 {}
@@ -177,6 +180,8 @@ auto Elements::elements() -> Vec<Element> const&
 auto Elements::append(Element element) -> void
 {
     auto& elements = instance().m_elements;
+    auto& symbols = instance().m_symbols;
+    symbols.emplace(element.symbol(), elements.size()); // the first element with a symbol is the one found by withSymbol
     elements.emplace_back(std::move(element));
 }
 
@@ -187,11 +192,18 @@ auto Elements::size() -> std::size_t
 
 auto Elements::withSymbol(String symbol) -> Optional<Element>
 {
-    const auto idx = indexfn(data(), [&](auto&& e) { return e.symbol() == symbol; });
+    const auto idx = indexWithSymbol(symbol);
     if(idx < size()) return data()[idx];
     return {};
 }
 
+auto Elements::indexWithSymbol(String const& symbol) -> Index
+{
+    auto const& symbols = instance().m_symbols;
+    const auto it = symbols.find(symbol);
+    return it != symbols.end() ? it->second : size();
+}
+
 auto Elements::withName(String name) -> Optional<Element>
 {
     const auto idx = indexfn(data(), [&](auto&& e) { return e.name() == name; });
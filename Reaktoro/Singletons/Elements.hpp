@@ -55,6 +55,9 @@ public:
     /// Return the element with given symbol.
     static auto withSymbol(String symbol) -> Optional<Element>;
 
+    /// Return the index of the element with given symbol, or the number of elements if not found.
+    static auto indexWithSymbol(String const& symbol) -> Index;
+
     /// Return the element with given name.
     static auto withName(String name) -> Optional<Element>;
 
@@ -80,6 +83,9 @@ private:
     /// The elements stored in the periodic table.
     Vec<Element> m_elements;
 
+    /// The indices of the elements in the periodic table with given symbols, for constant time lookups.
+    Map<String, Index> m_symbols;
+
 private:
     /// Construct a default Elements object [private].
     Elements();
@@ -31,6 +31,7 @@ void exportElements(py::module& m)
         .def_static("append", &Elements::append)
         .def_static("size", &Elements::size)
         .def_static("withSymbol", &Elements::withSymbol)
+        .def_static("indexWithSymbol", &Elements::indexWithSymbol)
         .def_static("withName", &Elements::withName)
         .def_static("withTag", &Elements::withTag)
         .def_static("withTags", &Elements::withTags)
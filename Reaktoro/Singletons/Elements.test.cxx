@@ -168,4 +168,7 @@ TEST_CASE("Testing Elements", "[Elements]")
     REQUIRE(elements_with_tags.size() == 2);
     REQUIRE(elements_with_tags[0].symbol() == "Aa");
     REQUIRE(elements_with_tags[1].symbol() == "Bb");
+
+    REQUIRE(Elements::indexWithSymbol("H") == 0);
+    REQUIRE(Elements::indexWithSymbol("Xy") == Elements::size());
 }
@@ -19,6 +19,7 @@
 
 // C++ includes
 #include <fstream>
+#include <mutex>
 
 // cpp-tabulate includes
 #include <tabulate/table.hpp>
@@ -137,39 +138,20 @@ auto findHydrogenIon(SpeciesList const& species) -> Index
     else return species.findWithFormula("H3O+");
 }
 
-} // namespace
-
-struct AqueousProps::Impl
+/// The data of an AqueousProps object that depends only on the chemical system (shared among all AqueousProps objects of the same system).
+struct AqueousPropsStructure
 {
-    /// The chemical system in which the aqueous phase is.
-    const ChemicalSystem system;
-
     /// The index of the underlying Phase object for the aqueous phase in the system.
-    const Index iphase;
+    Index iphase;
 
     /// The underlying Phase object for the aqueous phase in the system.
-    const Phase phase;
-
-    /// The phase as an aqueous solution.
-    const AqueousMixture aqsolution;
+    Phase phase;
 
     /// The index of the aqueous solvent species H2O in the aqueous phase (not in the system!)
-    const Index iH2O;
+    Index iH2O;
 
     /// The index of chemical species H+ or H3O+ in the aqueous phase (not in the system!)
-    const Index iH;
-
-    /// The chemical properties of the system.
-    ChemicalProps props;
-
-    /// The state of the aqueous solution.
-    AqueousMixtureState aqstate;
-
-    /// The amounts of the species in the aqueous phase (to be used with echelonizer - not for any computation, since it does not have autodiff propagation!).
-    VectorXd naq;
-
-    /// The chemical potentials of the elements in the aqueous phase
-    VectorXr lambda;
+    Index iH;
 
     /// The non-aqueous species in the database for which saturation indices are calculated.
     SpeciesList nonaqueous;
@@ -180,18 +162,16 @@ struct AqueousProps::Impl
     /// The formula matrix of the non-aqueous species for the computation of saturation indices.
     MatrixXd Anon;
 
-    /// The echelon form of the formula matrix `Aaqs` of the aqueous species.
+    /// The echelon form of the formula matrix `Aaqs` of the aqueous species (to be copied and updated by each AqueousProps object).
     Optima::Echelonizer echelonizer;
 
-    // The chemical potential models for the non-aqueous species (as if they were pure phases) for the computation of their saturation indices.
+    /// The default chemical potential models for the non-aqueous species (as if they were pure phases) for the computation of their saturation indices.
     Vec<Fn<real(ChemicalProps const&)>> chemical_potential_models;
 
-    Impl(ChemicalSystem const& system)
-    : system(system),
-      iphase(indexAqueousPhase(system)),
+    /// Construct an AqueousPropsStructure object for the first aqueous phase in a chemical system.
+    AqueousPropsStructure(ChemicalSystem const& system)
+    : iphase(indexAqueousPhase(system)),
       phase(system.phase(iphase)),
-      props(system),
-      aqsolution(phase.species()),
       iH2O(phase.species().findWithFormula("H2O")),
       iH(findHydrogenIon(phase.species()))
     {
@@ -224,6 +204,123 @@ struct AqueousProps::Impl
         // Initialize the chemical potential models for the non-aqueous species, as if they were pure phases
         chemical_potential_models = defaultChemicalPotentialModels(nonaqueous, system);
 
+        // Compute the initial echelon form of formula matrix `Aaqs`
+        echelonizer.compute(Aaqs);
+    }
+};
+
+/// Return the AqueousPropsStructure object of a chemical system, reusing the one created for another AqueousProps object of the same system if still alive.
+auto aqueousPropsStructure(ChemicalSystem const& system) -> SharedPtr<AqueousPropsStructure const>
+{
+    static std::mutex mutex;
+    static Map<void const*, std::weak_ptr<AqueousPropsStructure const>> structures;
+
+    // The key of the chemical system in the registry. ChemicalSystem::id is
+    // not used because it is only unique among the systems created in the
+    // same thread. The address of the data shared by all copies of a
+    // ChemicalSystem object is unique in the process while any of these
+    // copies exists, which is the case while the AqueousProps objects
+    // sharing the structure exist (each keeps a copy of the system).
+    const auto key = static_cast<void const*>(&system.species());
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto& weakptr = structures[key];
+
+    if(auto structure = weakptr.lock())
+        return structure;
+
+    // Remove the entries of chemical systems whose AqueousProps objects no longer exist
+    for(auto it = structures.begin(); it != structures.end();)
+        if(it->second.expired() && it->first != key)
+            it = structures.erase(it);
+        else ++it;
+
+    auto structure = std::make_shared<AqueousPropsStructure const>(system);
+    structures[key] = structure;
+
+    return structure;
+}
+
+} // namespace
+
+struct AqueousProps::Impl
+{
+    /// The chemical system in which the aqueous phase is.
+    const ChemicalSystem system;
+
+    /// The data that depends only on the chemical system (shared among all AqueousProps objects of the same system).
+    const SharedPtr<AqueousPropsStructure const> structure;
+
+    /// The index of the underlying Phase object for the aqueous phase in the system.
+    const Index iphase;
+
+    /// The underlying Phase object for the aqueous phase in the system.
+    Phase const& phase;
+
+    /// The phase as an aqueous solution.
+    const AqueousMixture aqsolution;
+
+    /// The index of the aqueous solvent species H2O in the aqueous phase (not in the system!)
+    const Index iH2O;
+
+    /// The index of chemical species H+ or H3O+ in the aqueous phase (not in the system!)
+    const Index iH;
+
+    /// The non-aqueous species in the database for which saturation indices are calculated.
+    SpeciesList const& nonaqueous;
+
+    /// The formula matrix of the aqueous species in the aqueous phase.
+    MatrixXd const& Aaqs;
+
+    /// The formula matrix of the non-aqueous species for the computation of saturation indices.
+    MatrixXd const& Anon;
+
+    /// The chemical properties of the system.
+    ChemicalProps props;
+
+    /// The state of the aqueous solution.
+    AqueousMixtureState aqstate;
+
+    /// The amounts of the species in the aqueous phase (to be used with echelonizer - not for any computation, since it does not have autodiff propagation!).
+    VectorXd naq;
+
+    /// The chemical potentials of the elements in the aqueous phase
+    VectorXr lambda;
+
+    /// The molalities of the elements in the aqueous phase computed in the last update.
+    ArrayXr me;
+
+    /// The pH of the aqueous phase computed in the last update.
+    real pHval;
+
+    /// The pE of the aqueous phase computed in the last update.
+    real pEval;
+
+    /// The echelon form of the formula matrix `Aaqs` of the aqueous species.
+    Optima::Echelonizer echelonizer;
+
+    // The chemical potential models for the non-aqueous species (as if they were pure phases) for the computation of their saturation indices.
+    Vec<Fn<real(ChemicalProps const&)>> chemical_potential_models;
+
+    Impl(ChemicalSystem const& system)
+    : system(system),
+      structure(aqueousPropsStructure(system)),
+      iphase(structure->iphase),
+      phase(structure->phase),
+      aqsolution(phase.species()),
+      iH2O(structure->iH2O),
+      iH(structure->iH),
+      nonaqueous(structure->nonaqueous),
+      Aaqs(structure->Aaqs),
+      Anon(structure->Anon),
+      props(system),
+      echelonizer(structure->echelonizer),
+      chemical_potential_models(structure->chemical_potential_models)
+    {
+        const auto Naq = phase.species().size();
+        const auto E = phase.elements().size();
+
         // Initialize the aqueous state properties
         aqstate.T = NaN;
         aqstate.P = NaN;
@@ -234,8 +331,10 @@ struct AqueousProps::Impl
         aqstate.m.setConstant(Naq, NaN);
         aqstate.ms.setConstant(Naq, NaN);
 
-        // Compute the initial echelon form of formula matrix `Aaqs`
-        echelonizer.compute(Aaqs);
+        // Initialize the properties computed in each update
+        me.setConstant(E, NaN);
+        pHval = NaN;
+        pEval = NaN;
     }
 
     Impl(ChemicalState const& state)
@@ -293,6 +392,22 @@ struct AqueousProps::Impl
         const auto Rb = R.topRows(ib.size());
         const VectorXr ub = u(ib);
         lambda = Rb.transpose() * ub;
+
+        // Compute the properties that are cheap to evaluate in this same pass (saturation ratios are computed on demand in each call below)
+        const auto E = phase.elements().size();
+        const auto RT = universalGasConstant * T;
+        me = Aaqs.topRows(E) * aqstate.m.matrix();
+        pHval = -aqprops.speciesActivitiesLn()[iH]/ln10;
+        pEval = lambda[E]/(RT*ln10);
+    }
+
+    /// Compute the ln saturation ratio of the i-th non-aqueous species.
+    auto computeSaturationRatioLn(Index i) const -> real
+    {
+        const auto RT = universalGasConstant * props.temperature();
+        const auto ui = chemical_potential_models[i](props);
+        const auto li = Anon.col(i).dot(lambda);
+        return (li - ui)/RT;
     }
 
     auto temperature() const -> real
@@ -328,15 +443,12 @@ struct AqueousProps::Impl
     auto elementMolality(StringOrIndex const& symbol) const -> real
     {
         const auto idx = detail::resolveElementIndexOrRaiseError(phase, symbol);
-        auto const& m = aqstate.m.matrix();
-        return Aaqs.row(idx) * m;
+        return me[idx];
     }
 
     auto elementMolalities() const -> ArrayXr
     {
-        const auto E = phase.elements().size();
-        auto const& m = aqstate.m.matrix();
-        return Aaqs.topRows(E) * m;
+        return me;
     }
 
     auto speciesMolality(StringOrIndex const& name) const -> real
@@ -362,19 +474,12 @@ struct AqueousProps::Impl
 
     auto pH() const -> real
     {
-        auto const& aqprops = props.phaseProps(iphase);
-        auto const& ln_aH = aqprops.speciesActivitiesLn()[iH];
-        return -ln_aH/ln10;
+        return pHval;
     }
 
     auto pE() const -> real
     {
-        const auto T = props.temperature();
-        const auto E = phase.elements().size();
-        const auto lambdaZ = lambda[E];
-        const auto RT = universalGasConstant * T;
-        const auto res = lambdaZ/(RT*ln10);
-        return res;
+        return pEval;
     }
 
     auto Eh() const -> real
@@ -400,22 +505,15 @@ struct AqueousProps::Impl
             "and exist in the thermodynamic database. It must also be composed of chemical elements "
             "present in the aqueous phase. This error will occur, for example, if you are calculating "
             "the saturation ratio of Quartz (SiO2) but the aqueous phase has no species with element Si.");
-        const auto RT = universalGasConstant * props.temperature();
-        const auto ui = chemical_potential_models[i](props);
-        const auto li = Anon.col(i).dot(lambda);
-        const auto lnOmegai = (li - ui)/RT;
-        return lnOmegai;
+        return computeSaturationRatioLn(i);
     }
 
     auto saturationRatiosLn() const -> ArrayXr
     {
-        const auto RT = universalGasConstant * props.temperature();
         const auto num_nonaqueous = nonaqueous.size();
         ArrayXr lnOmega(num_nonaqueous);
-        lnOmega = Anon.transpose() * lambda;
         for(auto i = 0; i < num_nonaqueous; ++i)
-            lnOmega[i] -= chemical_potential_models[i](props);
-        lnOmega /= RT;
+            lnOmega[i] = computeSaturationRatioLn(i);
         return lnOmega;
     }
 };
@@ -33,6 +33,11 @@ class Species;
 class SpeciesList;
 
 /// The chemical properties of an aqueous phase.
+/// The saturation indices and ratios of the non-aqueous species are not
+/// stored in the object. They are computed in each call to the corresponding
+/// methods and only for the requested species. These methods are not
+/// thread-safe, because the activity models set with @ref setActivityModel
+/// keep internal buffers. Use one AqueousProps object per thread instead.
 class AqueousProps
 {
 public:
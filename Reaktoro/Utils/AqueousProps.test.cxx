@@ -15,6 +15,9 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with this library. If not, see <http://www.gnu.org/licenses/>.
 
+// C++ includes
+#include <thread>
+
 // Catch includes
 #include <catch2/catch.hpp>
 
@@ -23,6 +26,7 @@
 #include <Reaktoro/Common/Warnings.hpp>
 #include <Reaktoro/Core/ChemicalState.hpp>
 #include <Reaktoro/Core/ChemicalSystem.hpp>
+#include <Reaktoro/Core/Phases.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumResult.hpp>
 #include <Reaktoro/Equilibrium/EquilibriumSolver.hpp>
 #include <Reaktoro/Models/ActivityModels/ActivityModelCubicEOS.hpp>
@@ -31,6 +35,7 @@
 using namespace Reaktoro;
 
 namespace test { extern auto createChemicalSystem() -> ChemicalSystem; }
+namespace test { extern auto createDatabase() -> Database; }
 
 TEST_CASE("Testing AqueousProps class", "[AqueousProps]")
 {
@@ -278,6 +283,46 @@ TEST_CASE("Testing AqueousProps class", "[AqueousProps]")
         }
     }
 
+    SECTION("Testing AqueousProps objects sharing the same chemical system")
+    {
+        ArrayXd n = ArrayXd::Ones(num_species);
+
+        ChemicalState state(system);
+        state.setTemperature(T, "celsius");
+        state.setPressure(P, "bar");
+        state.setSpeciesAmounts(n);
+
+        aqprops.update(state);
+
+        const ArrayXr lnOmega = aqprops.saturationRatiosLn();
+
+        // Check a copy and a new AqueousProps object for the same system produce the same results
+        AqueousProps copy(aqprops);
+        AqueousProps other(state);
+
+        CHECK( copy.pH()  == Approx(aqprops.pH()) );
+        CHECK( other.pH() == Approx(aqprops.pH()) );
+        CHECK( copy.pE()  == Approx(aqprops.pE()) );
+        CHECK( other.pE() == Approx(aqprops.pE()) );
+        CHECK( copy.elementMolalities().isApprox(aqprops.elementMolalities()) );
+        CHECK( other.elementMolalities().isApprox(aqprops.elementMolalities()) );
+        CHECK( copy.saturationRatiosLn().isApprox(lnOmega) );
+        CHECK( other.saturationRatiosLn().isApprox(lnOmega) );
+
+        // Check saturation ratios computed individually (before and after an update) are consistent with those computed all at once
+        ChemicalState state2(state);
+        state2.setSpeciesAmount("CO2(aq)", 10.0, "mol");
+        other.update(state2);
+
+        CHECK( log(other.saturationRatio("CO(g)")) == Approx(other.saturationRatiosLn()[5]) );
+        CHECK( other.saturationRatiosLn()[5] != Approx(lnOmega[5]) );
+
+        other.update(state);
+
+        CHECK( log(other.saturationRatio(5)) == Approx(lnOmega[5]) );
+        CHECK( other.saturationRatiosLn().isApprox(lnOmega) );
+    }
+
     SECTION("Testing static method AqueousProps::compute")
     {
         ChemicalState state(system);
@@ -313,3 +358,42 @@ TEST_CASE("Testing AqueousProps class", "[AqueousProps]")
         CHECK( aqprops.props().speciesAmount(0) == 123.0 ); // this shows that memoization did not work with the cloned props because it is a different ChemicalProps object with different pointer
     }
 }
+
+TEST_CASE("Testing AqueousProps objects of chemical systems created in different threads", "[AqueousProps]")
+{
+    const Database db = test::createDatabase();
+
+    // Create a chemical system with given aqueous species and its AqueousProps object in a new thread
+    auto createInNewThread = [&](Chars species)
+    {
+        std::unique_ptr<AqueousProps> aqprops;
+        std::thread thread([&]
+        {
+            ChemicalSystem system(db, AqueousPhase(species));
+            aqprops = std::make_unique<AqueousProps>(system);
+        });
+        thread.join();
+        return aqprops;
+    };
+
+    const auto aqprops1 = createInNewThread("H2O(aq) H+(aq) OH-(aq) Na+(aq) Cl-(aq)");
+    const auto aqprops2 = createInNewThread("H2O(aq) H+(aq) OH-(aq)");
+
+    // The ids of chemical systems are only unique within a thread, so these two different systems have the same id
+    CHECK( aqprops1->system().id() == aqprops2->system().id() );
+
+    // Check each AqueousProps object uses the data of its own chemical system
+    CHECK( aqprops1->phase().species().size() == 5 );
+    CHECK( aqprops2->phase().species().size() == 3 );
+
+    ChemicalState state(aqprops2->system());
+    state.setTemperature(25.0, "celsius");
+    state.setPressure(1.0, "bar");
+    state.setSpeciesAmounts(1e-6);
+    state.set("H2O(aq)", 1.0, "kg");
+
+    aqprops2->update(state);
+
+    CHECK( aqprops2->speciesMolalities().size() == 3 );
+    CHECK( aqprops2->elementMolalities().size() == aqprops2->phase().elements().size() );
+}
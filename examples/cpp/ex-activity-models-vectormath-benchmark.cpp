@@ -0,0 +1,182 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+// C++ includes
+#include <iomanip>
+#include <random>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+#include <Reaktoro/Math/VectorMath.hpp>
+using namespace Reaktoro;
+
+/// Return the time (in s) spent per evaluation of the activity model of a phase.
+auto benchmark(Phase const& phase, Index numruns, double& sum) -> double
+{
+    const auto size = phase.species().size();
+
+    ActivityModel fn = phase.activityModel();
+    ActivityProps props = ActivityProps::create(size);
+
+    const auto iH2O = phase.species().findWithFormula("H2O");
+
+    ArrayXr x = ArrayXr::Constant(size, 1e-3);
+    if(iH2O < size)
+        x[iH2O] = 1.0; // the solvent water in aqueous phases
+    x /= x.sum();
+
+    Stopwatch stopwatch;
+    stopwatch.start();
+    for(auto i = 0; i < numruns; ++i)
+    {
+        const auto T = 300.0 + (i % 100);       // vary temperature and pressure to avoid any caching
+        const auto P = 1.0e5 + (i % 50) * 4.0e5;
+        fn(props, { T, P, x });
+        sum += props.ln_a.sum().val();
+    }
+    stopwatch.pause();
+
+    return stopwatch.time() / numruns;
+}
+
+/// Return the times (in s) spent per evaluation of `f(x)` with the element-wise operations on ArrayXr and with the vectorized math functions.
+template<typename ScalarFunction, typename VectorFunction>
+auto benchmark(ScalarFunction const& scalarfn, VectorFunction const& vectorfn, Index size, Index numruns, double& sum) -> Pair<double, double>
+{
+    std::mt19937 generator(size);
+    std::uniform_real_distribution<double> distribution(0.1, 10.0);
+
+    ArrayXr x(size), res(size);
+    for(auto& xi : x)
+        xi = distribution(generator);
+
+    Stopwatch scalar, vector;
+
+    for(auto i = 0; i < numruns; ++i)
+    {
+        x[0] += 1e-12; // avoid the computations below from being hoisted out of the loop
+
+        scalar.start();
+        scalarfn(x, res);
+        scalar.pause();
+        sum += res[size - 1].val();
+
+        vector.start();
+        vectorfn(x, res);
+        vector.pause();
+        sum += res[size - 1].val();
+    }
+
+    return { scalar.time() / numruns, vector.time() / numruns };
+}
+
+int main()
+{
+    // Run this benchmark with Reaktoro built with REAKTORO_ENABLE_SIMD=OFF and then ON to compare the timings of the activity models
+    std::cout << "SIMD instruction sets in use: " << Eigen::SimdInstructionSetsInUse() << std::endl;
+    std::cout << std::endl;
+
+    double sum = 0.0; // used to ensure the computations below are not optimized away
+
+    //======================================================================
+    // The vectorized math functions versus the element-wise operations on ArrayXr
+    //======================================================================
+
+    using std::pow;
+
+    const auto numcalls = 100000;
+
+    const Vec<Tuple<String, Fn<void(ArrayXrConstRef, ArrayXrRef)>, Fn<void(ArrayXrConstRef, ArrayXrRef)>>> functions = {
+        { "exp"     , [](ArrayXrConstRef x, ArrayXrRef res) { res = x.exp(); } , [](ArrayXrConstRef x, ArrayXrRef res) { vexp(x, res); }      },
+        { "log"     , [](ArrayXrConstRef x, ArrayXrRef res) { res = x.log(); } , [](ArrayXrConstRef x, ArrayXrRef res) { vlog(x, res); }      },
+        { "sqrt"    , [](ArrayXrConstRef x, ArrayXrRef res) { res = x.sqrt(); }, [](ArrayXrConstRef x, ArrayXrRef res) { vsqrt(x, res); }     },
+        { "pow(0.2)", [](ArrayXrConstRef x, ArrayXrRef res) { res = x.unaryExpr([](real const& xi) { return pow(xi, 0.2); }); }, [](ArrayXrConstRef x, ArrayXrRef res) { vpow(x, 0.2, res); } },
+    };
+
+    std::cout << "Function  Size  Scalar (μs)  Vector (μs)  Speedup" << std::endl;
+
+    for(auto const& [name, scalarfn, vectorfn] : functions)
+    {
+        for(auto size : { 4, 16, 64, 256 })
+        {
+            const auto [tscalar, tvector] = benchmark(scalarfn, vectorfn, size, numcalls, sum);
+
+            std::cout << std::left << std::setw(10) << name
+                      << std::setw(6) << size
+                      << std::setw(13) << tscalar * 1e6
+                      << std::setw(13) << tvector * 1e6
+                      << tscalar / tvector << std::endl;
+        }
+    }
+
+    std::cout << std::endl;
+
+    //======================================================================
+    // The activity models whose loops over species use the vectorized math functions
+    //======================================================================
+
+    SupcrtDatabase db("supcrtbl");
+
+    const auto elements = "H O C Na Cl Ca Mg K Si S N Fe";
+
+    const Vec<Pair<String, ActivityModelGenerator>> aqmodels = {
+        { "IdealAqueous" , ActivityModelIdealAqueous() },
+        { "Davies"       , ActivityModelDavies() },
+        { "DebyeHuckel"  , ActivityModelDebyeHuckel() },
+        { "HKF"          , ActivityModelHKF() },
+        { "Pitzer"       , ActivityModelPitzer() },
+    };
+
+    const Vec<Pair<String, ActivityModelGenerator>> gasmodels = {
+        { "IdealGas"         , ActivityModelIdealGas() },
+        { "SoaveRedlichKwong", ActivityModelSoaveRedlichKwong() },
+        { "PengRobinson"     , ActivityModelPengRobinson() },
+    };
+
+    const auto numruns = 10000;
+
+    std::cout << "Model              Size  Time (μs)" << std::endl;
+
+    auto print = [&](String const& name, Phase const& phase)
+    {
+        const auto time = benchmark(phase, numruns, sum);
+
+        std::cout << std::left << std::setw(19) << name
+                  << std::setw(6) << phase.species().size()
+                  << time * 1e6 << std::endl;
+    };
+
+    for(auto const& [name, model] : aqmodels)
+    {
+        AqueousPhase solution(speciate(elements), exclude("organic"));
+        solution.setActivityModel(model);
+        ChemicalSystem system(db, solution);
+        print(name, system.phase(0));
+    }
+
+    for(auto const& [name, model] : gasmodels)
+    {
+        GaseousPhase gases(speciate(elements));
+        gases.setActivityModel(model);
+        ChemicalSystem system(db, gases);
+        print(name, system.phase(0));
+    }
+
+    std::cout << "Checksum: " << sum << std::endl;
+
+    return 0;
+}
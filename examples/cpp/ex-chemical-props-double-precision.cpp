@@ -0,0 +1,96 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+int main()
+{
+    // Initialize a thermodynamic database
+    PhreeqcDatabase db("phreeqc.dat");
+
+    // Define the phases of the chemical system
+    AqueousPhase aqueousphase(speciate("H O C Na Cl Ca Mg"));
+    aqueousphase.set(ActivityModelPhreeqc(db));
+
+    GaseousPhase gaseousphase("CO2(g) H2O(g)");
+
+    MineralPhases minerals("Calcite Dolomite Halite");
+
+    // Construct the chemical system
+    ChemicalSystem system(db, aqueousphase, gaseousphase, minerals);
+
+    // Compute an equilibrium state whose chemical properties are post-processed below
+    ChemicalState state(system);
+    state.temperature(60.0, "celsius");
+    state.pressure(100.0, "bar");
+    state.set("H2O"   , 1.00, "kg");
+    state.set("Na+"   , 1.00, "mol");
+    state.set("Cl-"   , 1.00, "mol");
+    state.set("CO2(g)", 2.00, "mol");
+    state.set("Calcite", 1.0, "mol");
+
+    equilibrate(state);
+
+    ChemicalProps const& props = state.props();
+
+    // The serialized chemical properties (e.g., as predicted by EquilibriumPredictor)
+    const VectorXd u = props;
+
+    const auto numruns = 100000;
+
+    ChemicalProps propsr(system); // the chemical properties evaluated with autodiff numbers
+    ChemicalPropsD propsd(system); // the chemical properties evaluated with double numbers
+
+    double sumr = 0.0; // used to ensure the computations below are not optimized away
+    double sumd = 0.0;
+
+    // Post-process the chemical properties using the real-valued path
+    Stopwatch stopwatchr;
+    stopwatchr.start();
+    for(auto i = 0; i < numruns; ++i)
+    {
+        propsr.update(u);
+        sumr += propsr.volume().val();
+        sumr += propsr.gibbsEnergy().val();
+        sumr += propsr.entropy().val();
+        sumr += propsr.elementAmounts().sum().val();
+        sumr += propsr.speciesStandardEntropies().sum().val();
+    }
+    stopwatchr.pause();
+
+    // Post-process the chemical properties using the double-valued path
+    Stopwatch stopwatchd;
+    stopwatchd.start();
+    for(auto i = 0; i < numruns; ++i)
+    {
+        propsd.update(u);
+        sumd += propsd.volume();
+        sumd += propsd.gibbsEnergy();
+        sumd += propsd.entropy();
+        sumd += propsd.elementAmounts().sum();
+        sumd += propsd.speciesStandardEntropies().sum();
+    }
+    stopwatchd.pause();
+
+    std::cout << "ChemicalProps  (real)  : " << stopwatchr.time() << " s" << std::endl;
+    std::cout << "ChemicalPropsD (double): " << stopwatchd.time() << " s" << std::endl;
+    std::cout << "Speedup                : " << stopwatchr.time() / stopwatchd.time() << std::endl;
+    std::cout << "Relative difference    : " << std::abs(sumr - sumd) / std::abs(sumr) << std::endl;
+
+    return 0;
+}
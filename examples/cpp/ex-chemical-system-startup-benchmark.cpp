@@ -0,0 +1,100 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// C++ includes
+#include <iomanip>
+
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+/// Return the time (in s) spent constructing a database, a chemical system from it, and looking up every species by formula.
+auto benchmark(Fn<Database()> const& dbfn, Fn<ChemicalSystem(Database const&)> const& systemfn, Index& numspecies, Index& checksum) -> Tuple<double, double, double>
+{
+    Stopwatch stopwatch;
+
+    stopwatch.start();
+    const auto db = dbfn();
+    stopwatch.pause();
+    const auto tdatabase = stopwatch.time();
+
+    stopwatch.reset();
+    stopwatch.start();
+    const auto system = systemfn(db);
+    stopwatch.pause();
+    const auto tsystem = stopwatch.time();
+
+    // Look up every species in the database by its formula, as done when resolving species across databases and phases
+    const auto& species = db.species();
+    stopwatch.reset();
+    stopwatch.start();
+    for(auto const& s : species)
+        checksum += species.findWithFormula(s.formula());
+    stopwatch.pause();
+    const auto tformulas = stopwatch.time();
+
+    numspecies = system.species().size();
+
+    return { tdatabase, tsystem, tformulas };
+}
+
+int main()
+{
+    const Vec<Tuple<String, Fn<Database()>, Fn<ChemicalSystem(Database const&)>>> cases = {
+        { "supcrtbl-organics",
+            []() -> Database { return SupcrtDatabase("supcrtbl-organics"); },
+            [](Database const& db) { return ChemicalSystem(db, AqueousPhase(speciate("H O C Na Cl Ca Mg K Fe Al Si S N")), GaseousPhase(speciate("H O C S N")), MineralPhases()); } },
+        { "supcrt16-organics",
+            []() -> Database { return SupcrtDatabase("supcrt16-organics"); },
+            [](Database const& db) { return ChemicalSystem(db, AqueousPhase(speciate("H O C Na Cl Ca Mg K Fe Al Si S N")), GaseousPhase(speciate("H O C S N")), MineralPhases()); } },
+        { "thermofun/aq17",
+            []() -> Database { return ThermoFunDatabase("aq17"); },
+            [](Database const& db) { return ChemicalSystem(db, AqueousPhase(speciate("H O C Na Cl Ca Mg K Fe Al Si S")), GaseousPhase(speciate("H O C S")), MineralPhases()); } },
+        { "thermofun/cemdata18",
+            []() -> Database { return ThermoFunDatabase("cemdata18"); },
+            [](Database const& db) { return ChemicalSystem(db, AqueousPhase(speciate("H O K Na S Si Ca Mg Al C Cl")), GaseousPhase(speciate("H O C")), MineralPhases()); } },
+        { "thermofun/psinagra-12-07",
+            []() -> Database { return ThermoFunDatabase("psinagra-12-07"); },
+            [](Database const& db) { return ChemicalSystem(db, AqueousPhase(speciate("H O C Na Cl Ca Mg K Fe Al Si S U")), GaseousPhase(speciate("H O C S")), MineralPhases()); } },
+        { "phreeqc/llnl.dat",
+            []() -> Database { return PhreeqcDatabase("llnl.dat"); },
+            [](Database const& db) { return ChemicalSystem(db, AqueousPhase(speciate("H O C Na Cl Ca Mg K Fe Al Si S N")), GaseousPhase(speciate("H O C S N")), MineralPhases()); } },
+        { "nasa-cea",
+            []() -> Database { return NasaDatabase("nasa-cea"); },
+            [](Database const& db) { return ChemicalSystem(db, GaseousPhase(speciate("H O C N"))); } },
+    };
+
+    Index checksum = 0; // used to ensure the computations below are not optimized away
+
+    std::cout << "Database                   Species  Database (ms)  System (ms)  Formula lookups (ms)" << std::endl;
+
+    for(auto const& [name, dbfn, systemfn] : cases)
+    {
+        Index numspecies = 0;
+        const auto [tdatabase, tsystem, tformulas] = benchmark(dbfn, systemfn, numspecies, checksum);
+
+        std::cout << std::left << std::setw(27) << name
+                  << std::setw(9) << numspecies
+                  << std::setw(15) << tdatabase * 1e3
+                  << std::setw(13) << tsystem * 1e3
+                  << tformulas * 1e3 << std::endl;
+    }
+
+    std::cout << "Checksum: " << checksum << std::endl;
+
+    return 0;
+}
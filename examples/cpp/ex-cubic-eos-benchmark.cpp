@@ -0,0 +1,116 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+/// Return the time (in s) spent per evaluation of a cubic equation of state for given substances.
+auto benchmark(CubicEOS::EquationSpecs const& eqspecs, Index numruns, double& sum) -> double
+{
+    CubicEOS::Equation equation(eqspecs);
+    CubicEOS::Props props;
+
+    const auto size = eqspecs.substances.size();
+
+    ArrayXr x = ArrayXr::Constant(size, 1.0/size);
+
+    Stopwatch stopwatch;
+    stopwatch.start();
+    for(auto i = 0; i < numruns; ++i)
+    {
+        const auto T = 300.0 + (i % 100);       // vary temperature and pressure to avoid any caching
+        const auto P = 1.0e5 + (i % 50) * 4.0e5;
+        equation.compute(props, T, P, x);
+        sum += props.V.val() + props.ln_phi.sum().val();
+    }
+    stopwatch.pause();
+
+    return stopwatch.time() / numruns;
+}
+
+int main()
+{
+    // The CO2-H2O-CH4-H2S gas mixture and a larger mixture with additional hydrocarbons and light gases
+    const Vec<CubicEOS::Substance> gases = {
+        CubicEOS::Substance{"CO2",   304.20,  73.83e5, 0.2240},
+        CubicEOS::Substance{"H2O",   647.10, 220.55e5, 0.3450},
+        CubicEOS::Substance{"CH4",   190.60,  45.99e5, 0.0120},
+        CubicEOS::Substance{"H2S",   373.53,  89.63e5, 0.0942},
+        CubicEOS::Substance{"N2",    126.20,  34.00e5, 0.0380},
+        CubicEOS::Substance{"O2",    154.60,  50.43e5, 0.0220},
+        CubicEOS::Substance{"H2",     33.19,  13.13e5, -0.216},
+        CubicEOS::Substance{"C2H6",  305.30,  48.72e5, 0.1000},
+        CubicEOS::Substance{"C3H8",  369.80,  42.48e5, 0.1520},
+        CubicEOS::Substance{"C4H10", 425.10,  37.96e5, 0.2000},
+        CubicEOS::Substance{"Ar",    150.90,  48.98e5, 0.0000},
+        CubicEOS::Substance{"SO2",   430.80,  78.84e5, 0.2450},
+    };
+
+    const Vec<Pair<String, CubicEOS::EquationModel>> eqmodels = {
+        { "VanDerWaals"       , CubicEOS::EquationModelVanDerWaals() },
+        { "RedlichKwong"      , CubicEOS::EquationModelRedlichKwong() },
+        { "SoaveRedlichKwong" , CubicEOS::EquationModelSoaveRedlichKwong() },
+        { "PengRobinson76"    , CubicEOS::EquationModelPengRobinson76() },
+        { "PengRobinson78"    , CubicEOS::EquationModelPengRobinson78() },
+    };
+
+    const auto numruns = 100000;
+
+    double sum = 0.0; // used to ensure the computations below are not optimized away
+
+    std::cout << "EOS                 Size  Built-in (μs)  Custom (μs)  BIPs (μs)  Speedup" << std::endl;
+
+    for(auto const& [name, eqmodel] : eqmodels)
+    {
+        for(auto size : { 2, 4, 8, 12 })
+        {
+            CubicEOS::EquationSpecs eqspecs;
+            eqspecs.substances = Vec<CubicEOS::Substance>(gases.begin(), gases.begin() + size);
+            eqspecs.eqmodel = eqmodel;
+
+            // The built-in alpha functions and the quadratic mixing rule in linear time (no binary interaction parameters)
+            const auto tbuiltin = benchmark(eqspecs, numruns, sum);
+
+            // The alpha functions evaluated species by species through EquationModel::alphafn
+            eqspecs.eqmodel.type = CubicEOS::EquationModelType::Custom;
+            const auto tcustom = benchmark(eqspecs, numruns, sum);
+
+            // The built-in alpha functions and the quadratic mixing rule with binary interaction parameters (all equal to 0.1)
+            eqspecs.eqmodel.type = eqmodel.type;
+            auto bipfn = [](CubicEOS::Bip& bip, CubicEOS::BipModelArgs const& args) -> void
+            {
+                bip.k.fill(0.1);
+                bip.kT.fill(0.0);
+                bip.kTT.fill(0.0);
+                bip.k.diagonal().fill(0.0);
+            };
+            eqspecs.bipmodel = CubicEOS::BipModel(bipfn);
+            const auto tbips = benchmark(eqspecs, numruns, sum);
+
+            std::cout << std::left << std::setw(20) << name
+                      << std::setw(6) << size
+                      << std::setw(15) << tbuiltin * 1e6
+                      << std::setw(13) << tcustom * 1e6
+                      << std::setw(11) << tbips * 1e6
+                      << tcustom / tbuiltin << std::endl;
+        }
+    }
+
+    std::cout << "Checksum: " << sum << std::endl;
+
+    return 0;
+}
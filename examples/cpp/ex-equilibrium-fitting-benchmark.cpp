@@ -0,0 +1,148 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// C++ includes
+#include <iomanip>
+#include <random>
+#include <thread>
+
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+/// Return a chemical system for calcite solubility in CO2-rich water with new Param objects for the standard Gibbs energies of the species.
+auto createModel() -> EquilibriumFittingModel
+{
+    Map<String, Param> G0;
+    G0["H2O"]      = Param("G0[H2O]"     ,  -237181.72);
+    G0["H+"]       = Param("G0[H+]"      ,        0.00);
+    G0["OH-"]      = Param("G0[OH-]"     ,  -157297.48);
+    G0["Ca++"]     = Param("G0[Ca++]"    ,  -552790.08);
+    G0["CaOH+"]    = Param("G0[CaOH+]"   ,  -717024.00);
+    G0["CaHCO3+"]  = Param("G0[CaHCO3+]" , -1146041.00);
+    G0["CO2"]      = Param("G0[CO2]"     ,  -385974.00);
+    G0["HCO3-"]    = Param("G0[HCO3-]"   ,  -586939.89);
+    G0["CO3--"]    = Param("G0[CO3--]"   ,  -527983.14);
+    G0["CaCO3(s)"] = Param("G0[CaCO3(s)]", -1129177.92);
+
+    Database db;
+    for(auto [key, value] : G0)
+        db.addSpecies( Species(key).withStandardGibbsEnergy(value) );
+
+    Phases phases(db);
+    phases.add( AqueousPhase("H2O H+ OH- Ca++ CaOH+ CaHCO3+ CO2 HCO3- CO3--") );
+    phases.add( MineralPhase("CaCO3(s)") );
+
+    return { ChemicalSystem(phases), { G0["CaCO3(s)"], G0["CaHCO3+"] } };
+}
+
+int main()
+{
+    const VectorXd xtrue{{ -1129177.92, -1146041.00 }};
+    const VectorXd x0 = xtrue + VectorXd{{ 3000.0, -2000.0 }};
+
+    EquilibriumFitting generator(createModel);
+
+    const auto& system = generator.system();
+
+    const auto iH2O = system.species().index("H2O");
+    const auto iH = system.species().index("H+");
+    const auto iCa = system.species().index("Ca++");
+    const auto iCaOH = system.species().index("CaOH+");
+    const auto iCaHCO3 = system.species().index("CaHCO3+");
+
+    // The total molality of calcium and the molality of H+ in the aqueous solution, the measured quantities in the dataset
+    auto molalityCa = [=](ArrayXrConstRef const& n) -> real { return (n[iCa] + n[iCaOH] + n[iCaHCO3]) / (n[iH2O] * 0.018015268); };
+    auto molalityH = [=](ArrayXrConstRef const& n) -> real { return n[iH] / (n[iH2O] * 0.018015268); };
+
+    // The calcite solubility experiments at different temperatures and amounts of dissolved CO2
+    for(auto T = 25.0; T <= 90.0; T += 5.0)
+    {
+        for(auto nCO2 : { 1e-4, 3e-4, 1e-3, 3e-3, 1e-2, 3e-2 })
+        {
+            ChemicalState state(system);
+            state.setSpeciesAmounts(1e-16);
+            state.setSpeciesAmount("H2O", 55.508, "mol");
+            state.setSpeciesAmount("CO2", nCO2, "mol");
+            state.setSpeciesAmount("CaCO3(s)", 1.0, "mol");
+
+            EquilibriumFittingExperiment experiment;
+            experiment.T = T + 273.15;
+            experiment.n = state.speciesAmounts().cast<double>();
+            experiment.observations = { { molalityCa, 0.0, 1.0 }, { molalityH, 0.0, 1.0 } };
+
+            generator.addExperiment(experiment);
+        }
+    }
+
+    // Compute the measured values with the true parameters plus 1% noise
+    const auto Nr = generator.numObservations();
+
+    VectorXd m(Nr);
+    MatrixXd J(Nr, xtrue.size());
+    generator.evaluate(xtrue, m, J);
+
+    std::mt19937 rng(20221019);
+    std::normal_distribution<double> noise(0.0, 0.01);
+
+    Vec<EquilibriumFittingExperiment> experiments;
+    Index offset = 0;
+    for(auto experiment : generator.experiments())
+    {
+        for(auto& observation : experiment.observations)
+        {
+            observation.value = m[offset++] * (1.0 + noise(rng));
+            observation.stddev = 0.01 * observation.value;
+        }
+        experiments.push_back(experiment);
+    }
+
+    std::cout << "Experiments: " << experiments.size() << ", observations: " << Nr << std::endl;
+    std::cout << std::endl;
+    std::cout << "Jacobian            Threads  Iterations  Equilibriums  Time (s)  G0[CaCO3(s)]  G0[CaHCO3+]" << std::endl;
+
+    const auto maxthreads = std::max<Index>(std::thread::hardware_concurrency(), 1);
+
+    for(auto finitedifferences : { false, true })
+    {
+        for(auto threads : { Index(1), maxthreads })
+        {
+            EquilibriumFitting fitting(createModel);
+
+            EquilibriumFittingOptions options;
+            options.threads = threads;
+            options.finitedifferences = finitedifferences;
+            fitting.setOptions(options);
+
+            for(auto const& experiment : experiments)
+                fitting.addExperiment(experiment);
+
+            const auto result = fitting.fit(x0);
+
+            std::cout << std::left << std::setw(20) << (finitedifferences ? "FiniteDifferences" : "Sensitivities")
+                      << std::setw(9) << threads
+                      << std::setw(12) << result.iterations
+                      << std::setw(14) << result.equilibriums
+                      << std::setw(10) << result.time
+                      << std::setw(14) << std::fixed << std::setprecision(2) << result.params[0]
+                      << result.params[1] << std::defaultfloat << std::setprecision(6)
+                      << (result.succeeded ? "" : "  (not converged)") << std::endl;
+        }
+    }
+
+    return 0;
+}
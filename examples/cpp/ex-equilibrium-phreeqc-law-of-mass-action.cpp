@@ -0,0 +1,81 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+int main()
+{
+    // Initialize a thermodynamic database
+    PhreeqcDatabase db("phreeqc.dat");
+
+    // Define aqueous phase
+    AqueousPhase aqueousphase(speciate("H O C Na Cl Ca Mg"));
+    aqueousphase.set(ActivityModelPhreeqc(db));
+
+    // Construct the chemical system with a single aqueous phase
+    ChemicalSystem system(db, aqueousphase);
+
+    // Define initial equilibrium state
+    ChemicalState state0(system);
+    state0.temperature(25.0, "celsius");
+    state0.pressure(1.0, "bar");
+    state0.set("H2O"  , 1.00, "kg");
+    state0.set("Na+"  , 0.50, "mol");
+    state0.set("Cl-"  , 0.50, "mol");
+    state0.set("Ca+2" , 0.01, "mol");
+    state0.set("Mg+2" , 0.05, "mol");
+    state0.set("HCO3-", 0.12, "mol");
+
+    // The temperatures at which the speciation calculations are performed
+    const VectorXd temperatures = linspace(25.0, 90.0, 1000);
+
+    // Benchmark the Gibbs energy minimization and law-of-mass-action methods
+    for(auto method : { EquilibriumMethod::GibbsEnergyMinimization, EquilibriumMethod::LawOfMassAction })
+    {
+        EquilibriumOptions options;
+        options.method = method;
+
+        EquilibriumSolver solver(system);
+        solver.setOptions(options);
+
+        ChemicalState state(state0);
+
+        Stopwatch stopwatch;
+        Index iterations = 0;
+
+        for(auto T : temperatures)
+        {
+            state.temperature(T, "celsius");
+
+            stopwatch.start();
+            auto result = solver.solve(state);
+            stopwatch.pause();
+
+            errorif(result.failed(), "Equilibrium calculation failed at ", T, " celsius.");
+
+            iterations += result.iterations();
+        }
+
+        const auto name = method == EquilibriumMethod::LawOfMassAction ? "LawOfMassAction" : "GibbsEnergyMinimization";
+
+        std::cout << name << ": " << stopwatch.time() << " s (" << iterations << " iterations)" << std::endl;
+        std::cout << "  pH at " << temperatures.tail(1)[0] << " celsius: " << AqueousProps(state).pH() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,176 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// C++ includes
+#include <iomanip>
+#include <random>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+int main()
+{
+    SupcrtDatabase db("supcrtbl");
+
+    AqueousPhase solution("H2O(aq) H+ OH- Na+ Cl- HCO3- CO3-2 CO2(aq)");
+    solution.setActivityModel(chain(
+        ActivityModelHKF(),
+        ActivityModelDrummond("CO2")
+    ));
+
+    GaseousPhase gases("CO2(g) H2O(g)");
+    gases.setActivityModel(ActivityModelPengRobinson());
+
+    ChemicalSystem system(db, solution, gases);
+
+    ChemicalState state0(system);
+    state0.set("H2O(aq)", 1.0, "kg");
+    state0.set("Na+",     1.0, "mol");
+    state0.set("Cl-",     1.0, "mol");
+    state0.set("CO2(g)", 10.0, "mol");
+
+    EquilibriumSpecs specs = EquilibriumSpecs::TP(system);
+
+    // The random temperatures (in celsius) and pressures (in bar) of the calculations, as in a reactive transport simulation visiting the same conditions many times
+    const auto numcalcs = 20000;
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> Tdist(25.0, 90.0);
+    std::uniform_real_distribution<double> Pdist(1.0, 300.0);
+
+    Vec<Pair<double, double>> points(numcalcs);
+    for(auto& [T, P] : points)
+        T = Tdist(generator), P = Pdist(generator);
+
+    // The amount of carbon in the aqueous phase computed with each approach
+    auto carbon = [](ChemicalState const& state) { return state.props().elementAmountInPhase("C", "AqueousPhase").val(); };
+
+    Vec<double> exact(numcalcs), smart(numcalcs), table(numcalcs);
+
+    //======================================================================
+    // The conventional equilibrium solver
+    //======================================================================
+
+    EquilibriumSolver solver(specs);
+    ChemicalState state(state0);
+    Stopwatch stopwatch;
+
+    for(auto i = 0; i < numcalcs; ++i)
+    {
+        state.temperature(points[i].first, "celsius");
+        state.pressure(points[i].second, "bar");
+        stopwatch.start();
+        solver.solve(state);
+        stopwatch.pause();
+        exact[i] = carbon(state);
+    }
+
+    const auto texact = stopwatch.time();
+
+    //======================================================================
+    // The smart equilibrium solver learning during the calculations
+    //======================================================================
+
+    SmartEquilibriumOptions smartoptions;
+    smartoptions.reltol = 0.001;
+
+    SmartEquilibriumSolver smartsolver(specs);
+    smartsolver.setOptions(smartoptions);
+
+    state = state0;
+    stopwatch.reset();
+    Index smartpredictions = 0;
+
+    for(auto i = 0; i < numcalcs; ++i)
+    {
+        state.temperature(points[i].first, "celsius");
+        state.pressure(points[i].second, "bar");
+        stopwatch.start();
+        auto result = smartsolver.solve(state);
+        stopwatch.pause();
+        smartpredictions += result.predicted();
+        smart[i] = carbon(state);
+    }
+
+    const auto tsmart = stopwatch.time();
+
+    //======================================================================
+    // The surrogate built before the calculations
+    //======================================================================
+
+    EquilibriumSurrogateOptions surrogateoptions;
+    surrogateoptions.reltol = 0.001;
+
+    EquilibriumSurrogate surrogate(specs);
+    surrogate.setOptions(surrogateoptions);
+    surrogate.addTemperatureDimension(25.0, 90.0, "celsius");
+    surrogate.addPressureDimension(1.0, 300.0, "bar");
+    surrogate.build(state0);
+
+    state = state0;
+    stopwatch.reset();
+
+    for(auto i = 0; i < numcalcs; ++i)
+    {
+        state.temperature(points[i].first, "celsius");
+        state.pressure(points[i].second, "bar");
+        stopwatch.start();
+        surrogate.solve(state);
+        stopwatch.pause();
+        table[i] = carbon(state);
+    }
+
+    const auto ttable = stopwatch.time();
+
+    const auto stats = surrogate.statistics();
+
+    //======================================================================
+    // The comparison of the approaches
+    //======================================================================
+
+    auto maxerror = [&](Vec<double> const& values)
+    {
+        double error = 0.0;
+        for(auto i = 0; i < numcalcs; ++i)
+            error = std::max(error, std::abs(values[i] - exact[i]) / std::abs(exact[i]));
+        return error;
+    };
+
+    std::cout << "Surrogate: " << stats.records << " records in " << stats.leaves << " cells (" << stats.unconverged << " unconverged, depth " << stats.depth << ")"
+              << ", " << stats.memory / 1024.0 << " KiB, built with " << stats.equilibriums << " equilibrium calculations in " << stats.time << " s" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Method       Time (s)  Time/calc (μs)  Predicted (%)  Max rel. error  Speedup" << std::endl;
+
+    auto report = [&](String const& name, double time, double predicted, double error)
+    {
+        std::cout << std::left << std::setw(13) << name
+                  << std::setw(10) << time
+                  << std::setw(16) << time / numcalcs * 1e6
+                  << std::setw(15) << predicted * 100.0 / numcalcs
+                  << std::setw(16) << error
+                  << texact / time << std::endl;
+    };
+
+    report("Exact", texact, 0.0, 0.0);
+    report("Smart", tsmart, smartpredictions, maxerror(smart));
+    report("Surrogate", ttable, stats.predictions, maxerror(table));
+    report("Surrogate*", ttable + stats.time, stats.predictions, maxerror(table)); // including the time to build the surrogate
+
+    return 0;
+}
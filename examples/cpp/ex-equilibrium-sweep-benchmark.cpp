@@ -0,0 +1,101 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// C++ includes
+#include <iomanip>
+#include <thread>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+int main()
+{
+    SupcrtDatabase db("supcrtbl");
+
+    AqueousPhase aqueousphase(speciate("H O C Na Cl Ca"));
+    aqueousphase.setActivityModel(ActivityModelDavies());
+
+    GaseousPhase gaseousphase("CO2(g) H2O(g)");
+    gaseousphase.setActivityModel(ActivityModelPengRobinson());
+
+    ChemicalSystem system(db, aqueousphase, gaseousphase, MineralPhase("Calcite"));
+
+    EquilibriumSpecs specs(system);
+    specs.temperature();
+    specs.pressure();
+
+    ChemicalState state(system);
+    state.set("H2O", 1.0, "kg");
+    state.set("Calcite", 1.0, "mol");
+    state.set("NaCl", 1.0, "mol");
+
+    // A grid over temperature, pressure and the amount of CO2 titrated into the brine
+    EquilibriumSweep sweep(specs);
+    sweep.addTemperatureAxis(ArrayXd::LinSpaced(20, 25.0, 150.0), "celsius");
+    sweep.addPressureAxis(ArrayXd::LinSpaced(20, 1.0, 300.0), "bar");
+    sweep.addSpeciesAmountAxis("CO2", ArrayXd::LinSpaced(10, 0.0, 3.0), "mol");
+    sweep.addQuantity("pH");
+    sweep.addQuantity("speciesMolality(Ca+2)");
+    sweep.addQuantity("phaseAmount(Calcite)");
+
+    const auto maxthreads = std::max<Index>(std::thread::hardware_concurrency(), 1);
+
+    Vec<Index> numthreads = { 1 };
+    while(numthreads.back() * 2 <= maxthreads)
+        numthreads.push_back(numthreads.back() * 2);
+
+    std::cout << "Grid points: " << sweep.numPoints() << std::endl;
+    std::cout << "Threads  TileSize  Tiles  WarmStarts  Fallbacks  Iterations  Time (s)  Points/s  Speedup" << std::endl;
+
+    double tserial = 0.0;
+
+    // Without continuation, and with continuation along tiles of increasing size
+    const Vec<Pair<bool, Index>> configurations = { {false, 256}, {true, 16}, {true, 256}, {true, 4000} };
+
+    for(auto const& [warmstart, tilesize] : configurations)
+    {
+        for(auto threads : numthreads)
+        {
+            EquilibriumSweepOptions options;
+            options.threads = threads;
+            options.tilesize = tilesize;
+            options.warmstart = warmstart;
+            sweep.setOptions(options);
+
+            const auto result = sweep.run(state);
+
+            if(threads == 1 && !warmstart)
+                tserial = result.time;
+
+            std::cout << std::left << std::setw(9) << result.threads
+                      << std::setw(10) << (warmstart ? std::to_string(tilesize) : "-")
+                      << std::setw(7) << result.tiles
+                      << std::setw(12) << result.warmstarts
+                      << std::setw(11) << result.fallbacks
+                      << std::setw(12) << result.iterations
+                      << std::setw(10) << result.time
+                      << std::setw(10) << result.points / result.time
+                      << tserial / result.time << std::endl;
+        }
+    }
+
+    sweep.results().save("ex-equilibrium-sweep-benchmark.txt");
+
+    return 0;
+}
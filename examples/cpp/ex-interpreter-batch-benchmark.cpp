@@ -0,0 +1,93 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// C++ includes
+#include <iomanip>
+#include <thread>
+
+// Reaktoro includes
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+/// Return a scenario input with a sweep over temperature, pressure and salinity of CO2-saturated brines in contact with calcite.
+auto createScenarioInput(Index numtemperatures, Index numpressures, Index numsalinities) -> Data
+{
+    std::ostringstream input;
+    input << "System:\n";
+    input << "  Database: { Supcrt: supcrtbl }\n";
+    input << "  Phases:\n";
+    input << "    - Aqueous: { Speciate: H O C Na Cl Ca, ActivityModel: Davies }\n";
+    input << "    - Gaseous: { Species: CO2(g) H2O(g), ActivityModel: PengRobinson }\n";
+    input << "    - Minerals: Calcite\n";
+    input << "Output:\n";
+    input << "  Quantities: [pH, speciesMolality(Ca+2), phaseAmount(Calcite)]\n";
+    input << "Scenarios:\n";
+
+    // The scenarios are listed in an order that does not favor warm-starts (salinity varying slowest)
+    for(auto k = 0; k < numsalinities; ++k)
+        for(auto i = 0; i < numtemperatures; ++i)
+            for(auto j = 0; j < numpressures; ++j)
+                input << "  - { Temperature: " << 25.0 + 75.0 * i / numtemperatures << " celsius"
+                      << ", Pressure: " << 1.0 + 200.0 * j / numpressures << " bar"
+                      << ", Recipe: { H2O: 1 kg, NaCl: " << 2.0 * k / numsalinities << " mol, CO2: 2 mol, Calcite: 1 mol } }\n";
+
+    return Data::parse(input.str());
+}
+
+int main()
+{
+    Data input = createScenarioInput(10, 10, 10);
+
+    const auto maxthreads = std::max<Index>(std::thread::hardware_concurrency(), 1);
+
+    Vec<Index> numthreads = { 1 };
+    while(numthreads.back() * 2 <= maxthreads)
+        numthreads.push_back(numthreads.back() * 2);
+
+    std::cout << "Threads  WarmStarts  Scenarios  Iterations  Time (s)  Scenarios/s  Speedup" << std::endl;
+
+    double tserial = 0.0;
+
+    for(auto warmstart : { false, true })
+    {
+        input["Options"]["WarmStartDistance"] = warmstart ? 0.2 : -1.0; // a negative distance disables warm-starts
+
+        for(auto threads : numthreads)
+        {
+            input["Options"]["Threads"] = int(threads);
+
+            Interpreter interpreter;
+            interpreter.execute(input);
+
+            auto const& stats = interpreter.statistics();
+
+            if(threads == 1 && !warmstart)
+                tserial = stats.time_scenarios;
+
+            std::cout << std::left << std::setw(9) << stats.threads
+                      << std::setw(12) << stats.warmstarts
+                      << std::setw(11) << stats.scenarios
+                      << std::setw(12) << stats.iterations
+                      << std::setw(10) << stats.time_scenarios
+                      << std::setw(13) << stats.scenarios / stats.time_scenarios
+                      << tserial / stats.time_scenarios << std::endl;
+        }
+    }
+
+    return 0;
+}
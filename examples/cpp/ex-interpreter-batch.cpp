@@ -0,0 +1,69 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+// Execute the scenarios in a JSON or YAML scenario file, as in:
+//
+//     ex-interpreter-batch [file] [--threads N] [--output path]
+//
+// The number of threads and the output file given in the command line
+// override those in the scenario file. If no file is given, the scenarios in
+// resources/scenarios-co2-brines.yaml are executed.
+int main(int argc, char** argv)
+{
+    String filepath = REAKTORO_EXAMPLES_DIR"/resources/scenarios-co2-brines.yaml";
+    String threads;
+    String output;
+
+    for(auto i = 1; i < argc; ++i)
+    {
+        const String arg = argv[i];
+        if(arg == "--threads" && i + 1 < argc) threads = argv[++i];
+        else if(arg == "--output" && i + 1 < argc) output = argv[++i];
+        else filepath = arg;
+    }
+
+    Data input = Data::load(filepath);
+
+    if(!threads.empty())
+        input["Options"]["Threads"] = std::stoi(threads);
+
+    if(!output.empty())
+        input["Output"]["File"] = output;
+
+    Interpreter interpreter;
+    interpreter.execute(input);
+
+    auto const& stats = interpreter.statistics();
+
+    std::cout << "Scenarios executed: " << stats.scenarios << std::endl;
+    std::cout << "Scenarios succeeded: " << stats.succeeded << std::endl;
+    std::cout << "Scenarios warm-started: " << stats.warmstarts << std::endl;
+    std::cout << "Iterations: " << stats.iterations << std::endl;
+    std::cout << "Threads: " << stats.threads << std::endl;
+    std::cout << "Time constructing the chemical system (s): " << stats.time_system << std::endl;
+    std::cout << "Time executing the scenarios (s): " << stats.time_scenarios << std::endl;
+    std::cout << "Time writing the output (s): " << stats.time_output << std::endl;
+
+    if(interpreter.results().rows() <= 20)
+        std::cout << interpreter.results().dump() << std::endl;
+
+    return stats.succeeded == stats.scenarios ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Reaktoro/Common/TimeUtils.hpp>
+#include <Reaktoro/ODML/ClusterConnectivity.hpp>
+#include <Reaktoro/ODML/PriorityQueue.hpp>
+using namespace Reaktoro;
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+/// Return the time (in s) spent per search along the prediction path of a smart solver with given number of clusters and records per cluster.
+/// The search mimics SmartEquilibriumSolver::predict: it starts from a cluster,
+/// visits clusters in the order given by their connectivity, visits the
+/// records of each cluster in the order given by their priorities until an
+/// acceptable one is found, and then updates all priorities.
+auto benchmark(Index numclusters, Index numrecords, Index numruns, Index& sum) -> double
+{
+    ClusterConnectivity connectivity;
+    PriorityQueue priority;
+    Vec<PriorityQueue> records(numclusters);
+
+    for(auto i = 0; i < numclusters; ++i)
+    {
+        connectivity.extend();
+        priority.extend();
+        for(auto j = 0; j < numrecords; ++j)
+            records[i].extend();
+    }
+
+    std::mt19937 engine(0);
+    std::uniform_int_distribution<Index> anycluster(0, numclusters - 1);
+    std::uniform_int_distribution<Index> neighbour(0, 4);
+    std::uniform_int_distribution<Index> anyrecord(0, numrecords - 1);
+
+    Stopwatch stopwatch;
+    stopwatch.start();
+    for(auto run = 0; run < numruns; ++run)
+    {
+        // The starting cluster and the cluster with the accepted record (most often a nearby one)
+        const auto icluster = anycluster(engine);
+        const auto kcluster = (icluster + neighbour(engine)) % numclusters;
+        const auto krecord = anyrecord(engine);
+
+        for(auto jcluster : connectivity.order(icluster))
+        {
+            sum += jcluster;
+            if(jcluster != kcluster)
+                continue;
+            for(auto irecord : records[jcluster].order())
+            {
+                sum += irecord;
+                if(irecord == krecord)
+                    break;
+            }
+            records[jcluster].increment(krecord);
+            connectivity.increment(icluster, jcluster);
+            priority.increment(jcluster);
+            break;
+        }
+    }
+    stopwatch.pause();
+
+    sum += connectivity.numTransitions();
+
+    return stopwatch.time() / numruns;
+}
+
+int main()
+{
+    const auto numrecords = 100;
+    const auto numruns = 100000;
+
+    Index sum = 0; // used to ensure the computations below are not optimized away
+
+    std::cout << "Clusters  Search (μs)" << std::endl;
+
+    for(auto numclusters : { 10, 100, 1000, 10000 })
+    {
+        const auto t = benchmark(numclusters, numrecords, numruns, sum);
+        std::cout << std::left << std::setw(10) << numclusters << t * 1e6 << std::endl;
+    }
+
+    std::cout << "Checksum: " << sum << std::endl;
+
+    return 0;
+}
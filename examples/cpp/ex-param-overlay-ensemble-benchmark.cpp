@@ -0,0 +1,182 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+
+// C++ includes
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <thread>
+
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+/// The species whose standard Gibbs energies of formation are uncertain in the ensemble.
+const Strings uncertain = { "Calcite", "Dolomite", "Magnesite", "CO2(aq)", "HCO3-" };
+
+/// Return the chemical system used by the ensemble members.
+auto createChemicalSystem(Database const& db) -> ChemicalSystem
+{
+    return ChemicalSystem(db,
+        AqueousPhase(speciate("H O C Na Cl Ca Mg")),
+        GaseousPhase("CO2(g) H2O(g)"),
+        MineralPhases("Calcite Dolomite Magnesite"));
+}
+
+/// Return the Param objects of the standard Gibbs energies of formation of the uncertain species.
+auto uncertainParams(ChemicalSystem const& system) -> Vec<Param>
+{
+    return vectorize(uncertain, RKT_LAMBDA(name, system.species().get(name).standardThermoModel().params()[0]));
+}
+
+/// Return the values of the uncertain parameters of an ensemble member, sampled with 0.1% relative standard deviation.
+auto sampleParams(ArrayXdConstRef const& mean, Index member) -> ArrayXd
+{
+    std::mt19937 rng(member);
+    std::normal_distribution<double> noise(0.0, 1.0e-3);
+    ArrayXd values = mean;
+    for(auto& value : values)
+        value *= 1.0 + noise(rng);
+    return values;
+}
+
+/// Return the initial chemical state of every ensemble member.
+auto initialState(ChemicalSystem const& system) -> ChemicalState
+{
+    ChemicalState state(system);
+    state.temperature(60.0, "celsius");
+    state.pressure(100.0, "bar");
+    state.set("H2O(aq)", 1.0, "kg");
+    state.set("Na+", 1.0, "mol");
+    state.set("Cl-", 1.0, "mol");
+    state.set("CO2(g)", 1.0, "mol");
+    state.set("Calcite", 1.0, "mol");
+    state.set("Dolomite", 0.5, "mol");
+    return state;
+}
+
+/// Return the resident memory of this process (in MB), or zero if not available.
+auto residentMemory() -> double
+{
+    std::ifstream statm("/proc/self/statm");
+    double size = 0.0, resident = 0.0;
+    statm >> size >> resident;
+    return resident * 4096.0 / 1.0e6;
+}
+
+/// The function type that runs the ensemble members assigned to a thread, returning the sum of the computed calcium amounts.
+using EnsembleWorker = Fn<double(std::atomic<Index>& next, Index members)>;
+
+/// Run an ensemble across a pool of threads and return its timing, memory growth, and checksum.
+auto runEnsemble(EnsembleWorker const& worker, Index members, Index numthreads) -> Tuple<double, double, double>
+{
+    const auto memory0 = residentMemory();
+
+    Stopwatch stopwatch;
+    stopwatch.start();
+
+    std::atomic<Index> next = 0;
+    Vec<double> sums(numthreads);
+    Vec<std::thread> threads;
+    for(auto t = 0; t < numthreads; ++t)
+        threads.emplace_back([&, t] { sums[t] = worker(next, members); });
+    for(auto& thread : threads)
+        thread.join();
+
+    stopwatch.pause();
+
+    double checksum = 0.0;
+    for(auto sum : sums)
+        checksum += sum;
+
+    return { stopwatch.time(), residentMemory() - memory0, checksum };
+}
+
+int main()
+{
+    const auto members = 2000;
+    const auto numthreads = std::max<Index>(std::thread::hardware_concurrency(), 1);
+
+    SupcrtDatabase db("supcrtbl");
+
+    const auto system = createChemicalSystem(db);
+
+    const auto params = uncertainParams(system);
+
+    ArrayXd mean(params.size());
+    for(auto i = 0; i < mean.size(); ++i)
+        mean[i] = double(params[i]);
+
+    // Each thread reads the uncertain parameters of the shared chemical system through its own overlay
+    auto overlayworker = [&](std::atomic<Index>& next, Index members)
+    {
+        ParamOverlay overlay(params);
+        ParamOverlayGuard guard(overlay);
+
+        EquilibriumSolver solver(system);
+
+        double sum = 0.0;
+        for(auto i = next++; i < members; i = next++)
+        {
+            overlay.values(sampleParams(mean, i));
+            ChemicalState state = initialState(system);
+            if(solver.solve(state).succeeded())
+                sum += double(state.props().elementAmountInPhase("Ca", "AqueousPhase"));
+        }
+        return sum;
+    };
+
+    // Each thread creates its own copy of the database and chemical system, whose parameters it changes directly
+    auto cloneworker = [&](std::atomic<Index>& next, Index members)
+    {
+        SupcrtDatabase dbclone("supcrtbl");
+        const auto systemclone = createChemicalSystem(dbclone);
+        auto paramsclone = uncertainParams(systemclone);
+
+        EquilibriumSolver solver(systemclone);
+
+        double sum = 0.0;
+        for(auto i = next++; i < members; i = next++)
+        {
+            const auto values = sampleParams(mean, i);
+            for(auto j = 0; j < values.size(); ++j)
+                paramsclone[j] = values[j];
+            ChemicalState state = initialState(systemclone);
+            if(solver.solve(state).succeeded())
+                sum += double(state.props().elementAmountInPhase("Ca", "AqueousPhase"));
+        }
+        return sum;
+    };
+
+    std::cout << "Ensemble of " << members << " members with " << uncertain.size() << " uncertain parameters across " << numthreads << " threads" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Approach     Time (s)  Members/s  Memory growth (MB)  Checksum" << std::endl;
+
+    for(auto const& [name, worker] : { Pair<String, EnsembleWorker>{ "Overlays", overlayworker }, Pair<String, EnsembleWorker>{ "Cloning", cloneworker } })
+    {
+        const auto [time, memory, checksum] = runEnsemble(worker, members, numthreads);
+
+        std::cout << std::left << std::setw(13) << name
+                  << std::setw(10) << time
+                  << std::setw(11) << members / time
+                  << std::setw(20) << memory
+                  << checksum << std::endl;
+    }
+
+    return 0;
+}
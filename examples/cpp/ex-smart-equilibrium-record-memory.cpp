@@ -0,0 +1,153 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+// -----------------------------------------------------------------------------
+// This example measures the memory used per learned record in
+// SmartEquilibriumSolver with its compact layout (one block of doubles per
+// record in the storage of its cluster) and with the previous layout, in which
+// each record stored a ChemicalState, an EquilibriumConditions, an
+// EquilibriumSensitivity and an EquilibriumPredictor object. The memory of the
+// previous layout is measured as the growth of the heap in use when such
+// records are created, which requires glibc (mallinfo2).
+// -----------------------------------------------------------------------------
+
+#include <Reaktoro/Reaktoro.hpp>
+using namespace Reaktoro;
+
+#include <iomanip>
+#include <iostream>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define HEAP_IN_USE_AVAILABLE
+#endif
+
+/// Return the number of bytes currently allocated in the heap (or zero if not available in this platform).
+auto heapInUse() -> Index
+{
+#ifdef HEAP_IN_USE_AVAILABLE
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+/// The record of a learned calculation in the previous layout of SmartEquilibriumSolver.
+struct PreviousRecord
+{
+    ChemicalState state;
+    EquilibriumConditions conditions;
+    EquilibriumSensitivity sensitivity;
+    EquilibriumPredictor predictor;
+};
+
+int main()
+{
+    SupcrtDatabase db("supcrtbl");
+
+    AqueousPhase solution(speciate("H O C Na Cl Ca Mg"));
+    solution.setActivityModel(ActivityModelHKF());
+
+    GaseousPhase gases("CO2(g) H2O(g)");
+    gases.setActivityModel(ActivityModelPengRobinson());
+
+    MineralPhases minerals("Calcite Magnesite Dolomite Halite");
+
+    ChemicalSystem system(db, solution, gases, minerals);
+
+    ChemicalState state0(system);
+    state0.temperature(60.0, "celsius");
+    state0.pressure(100.0, "bar");
+    state0.set("H2O(aq)", 1.0, "kg");
+    state0.set("Na+",     1.0, "mol");
+    state0.set("Cl-",     1.0, "mol");
+    state0.set("CO2(g)",  2.0, "mol");
+    state0.set("Calcite", 1.0, "mol");
+    state0.set("Dolomite", 0.5, "mol");
+
+    const auto temperatures = linspace(25.0, 90.0, 20);
+
+    //-------------------------------------------------------------------------
+    // MEMORY PER RECORD WITH THE COMPACT LAYOUT
+    //-------------------------------------------------------------------------
+    SmartEquilibriumSolver smartsolver(system);
+
+    SmartEquilibriumOptions smartoptions;
+    smartoptions.reltol = 1e-12; // force a learning operation in most calculations, so that there are many records
+    smartsolver.setOptions(smartoptions);
+
+    ChemicalState state(state0);
+
+    for(auto T : temperatures)
+    {
+        state.temperature(T, "celsius");
+        auto result = smartsolver.solve(state);
+        errorif(result.failed(), "Smart equilibrium calculation failed at ", T, " celsius.");
+    }
+
+    const auto stats = smartsolver.statistics();
+    const auto bytesnew = stats.records ? stats.memory / stats.records : 0;
+
+    //-------------------------------------------------------------------------
+    // MEMORY PER RECORD WITH THE PREVIOUS LAYOUT
+    //-------------------------------------------------------------------------
+    EquilibriumSpecs specs(system);
+    specs.temperature();
+    specs.pressure();
+
+    EquilibriumSolver solver(specs);
+
+    EquilibriumConditions conditions(specs);
+    EquilibriumSensitivity sensitivity(specs);
+
+    Deque<PreviousRecord> records;
+
+    Index bytesprevious = 0;
+
+    state = state0;
+
+    for(auto T : temperatures)
+    {
+        conditions.temperature(T, "celsius");
+        conditions.pressure(100.0, "bar");
+
+        auto result = solver.solve(state, sensitivity, conditions);
+        errorif(result.failed(), "Equilibrium calculation failed at ", T, " celsius.");
+
+        const auto before = heapInUse();
+        records.push_back({ state, conditions, sensitivity, EquilibriumPredictor(state, sensitivity) });
+        bytesprevious += heapInUse() - before; // this includes the record object itself, allocated by the deque
+    }
+
+    bytesprevious /= records.size();
+
+    //-------------------------------------------------------------------------
+    // OUTPUT
+    //-------------------------------------------------------------------------
+    std::cout << "Species: " << system.species().size() << std::endl;
+    std::cout << "Records (compact layout): " << stats.records << std::endl;
+    std::cout << std::left << std::setw(20) << "Layout" << "Bytes per record" << std::endl;
+    std::cout << std::left << std::setw(20) << "compact" << bytesnew << std::endl;
+#ifdef HEAP_IN_USE_AVAILABLE
+    std::cout << std::left << std::setw(20) << "previous" << bytesprevious << std::endl;
+    std::cout << "Reduction: " << std::fixed << std::setprecision(1) << 100.0 * (1.0 - double(bytesnew) / bytesprevious) << "%" << std::endl;
+#else
+    std::cout << std::left << std::setw(20) << "previous" << "not measured (requires glibc >= 2.33)" << std::endl;
+#endif
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Reaktoro is a unified framework for modeling chemically reactive systems.
+//
+// Copyright © 2014-2022 Allan Leal
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library. If not, see <http://www.gnu.org/licenses/>.
+
+#include <Reaktoro/Common/Table.hpp>
+#include <Reaktoro/Common/TimeUtils.hpp>
+using namespace Reaktoro;
+
+#include <filesystem>
+#include <iostream>
+
+int main()
+{
+    const auto numcols = 50;
+    const auto numrows = 100000;
+    const auto numchunks = 10; // the number of writes performed with TableWriter (e.g., one per simulation output step)
+
+    const auto dir = std::filesystem::temp_directory_path();
+    const auto csvfile = (dir / "ex-table-output-benchmark.csv").string();
+    const auto binfile = (dir / "ex-table-output-benchmark.rkt").string();
+    const auto streamfile = (dir / "ex-table-output-benchmark-stream.rkt").string();
+
+    // Create a table with numcols columns of floating-point values (e.g., quantities logged in a reactive transport simulation)
+    Table table;
+    for(auto j = 0; j < numcols; ++j)
+    {
+        auto& column = table.column("Quantity" + std::to_string(j));
+        for(auto i = 0; i < numrows; ++i)
+            column << 1.0e-3 * i + j;
+    }
+
+    const auto numbytes = numcols * numrows * sizeof(double);
+
+    Table::OutputOptions opts;
+    opts.delimiter = ",";
+    opts.scientific = true;
+    opts.precision = 16;
+
+    Stopwatch stopwatch;
+
+    stopwatch.start();
+    table.save(csvfile, opts);
+    stopwatch.pause();
+    const auto tcsv = stopwatch.time();
+
+    stopwatch.reset();
+    stopwatch.start();
+    table.saveBinary(binfile);
+    stopwatch.pause();
+    const auto tbin = stopwatch.time();
+
+    // Fill a second table in chunks, writing the new rows after each chunk is appended
+    Table streamed;
+    TableWriter writer(streamfile);
+    stopwatch.reset();
+    for(auto k = 0; k < numchunks; ++k)
+    {
+        for(auto j = 0; j < numcols; ++j)
+        {
+            auto& column = streamed.column("Quantity" + std::to_string(j));
+            for(auto i = k * numrows/numchunks; i < (k + 1) * numrows/numchunks; ++i)
+                column << 1.0e-3 * i + j;
+        }
+        stopwatch.start();
+        writer.write(streamed);
+        stopwatch.pause();
+    }
+    const auto tstream = stopwatch.time();
+
+    stopwatch.reset();
+    stopwatch.start();
+    Table loaded = Table::loadBinary(binfile);
+    stopwatch.pause();
+    const auto tload = stopwatch.time();
+
+    const auto mbps = [&](double t) { return numbytes / t / 1.0e6; };
+
+    std::cout << "Table with " << numcols << " columns and " << numrows << " rows of floats" << std::endl;
+    std::cout << "Text output (CSV)     : " << tcsv << " s (" << mbps(tcsv) << " MB/s, " << std::filesystem::file_size(csvfile) << " bytes)" << std::endl;
+    std::cout << "Binary output         : " << tbin << " s (" << mbps(tbin) << " MB/s, " << std::filesystem::file_size(binfile) << " bytes)" << std::endl;
+    std::cout << "Binary output (stream): " << tstream << " s (" << mbps(tstream) << " MB/s, " << numchunks << " writes)" << std::endl;
+    std::cout << "Binary input          : " << tload << " s (" << mbps(tload) << " MB/s, " << loaded.rows() << " rows)" << std::endl;
+    std::cout << "Speedup of binary over text output: " << tcsv / tbin << std::endl;
+
+    std::filesystem::remove(csvfile);
+    std::filesystem::remove(binfile);
+    std::filesystem::remove(streamfile);
+
+    return 0;
+}